@@ -0,0 +1,441 @@
+/**
+ * @file json_parser.cpp
+ * @brief Implementação do parser JSON SAX de passada única
+ */
+
+#include "json_parser.h"
+#include "json_scan.h"
+#include <cstring>
+
+namespace ipc_project {
+
+namespace {
+
+int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+void appendUtf8(std::string& out, uint32_t code_point) {
+    if (code_point < 0x80) {
+        out.push_back(static_cast<char>(code_point));
+    } else if (code_point < 0x800) {
+        out.push_back(static_cast<char>(0xC0 | (code_point >> 6)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else if (code_point < 0x10000) {
+        out.push_back(static_cast<char>(0xE0 | (code_point >> 12)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    } else {
+        out.push_back(static_cast<char>(0xF0 | (code_point >> 18)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3F)));
+        out.push_back(static_cast<char>(0x80 | (code_point & 0x3F)));
+    }
+}
+
+} // namespace
+
+std::string jsonErrorToString(JSONError error) {
+    switch (error) {
+        case JSONError::NONE: return "none";
+        case JSONError::UNEXPECTED_END: return "unexpected end of input";
+        case JSONError::UNEXPECTED_CHAR: return "unexpected character";
+        case JSONError::BAD_STRING: return "control character in string";
+        case JSONError::BAD_ESCAPE: return "invalid escape sequence";
+        case JSONError::BAD_NUMBER: return "invalid number";
+        case JSONError::TOO_DEEP: return "nesting too deep";
+        case JSONError::TRAILING_DATA: return "trailing data after value";
+        case JSONError::ABORTED: return "aborted by handler";
+    }
+    return "unknown";
+}
+
+std::string JSONParser::errorMessage() const {
+    return jsonErrorToString(error_) + " at offset " + std::to_string(error_offset_);
+}
+
+bool JSONParser::fail(JSONError error) {
+    error_ = error;
+    error_offset_ = pos_;
+    return false;
+}
+
+void JSONParser::skipWhitespace() {
+    while (pos_ < input_.size()) {
+        char c = input_[pos_];
+        if (c != ' ' && c != '\n' && c != '\r' && c != '\t') break;
+        pos_++;
+    }
+}
+
+bool JSONParser::parse(std::string_view input, JSONHandler& handler) {
+    input_ = input;
+    pos_ = 0;
+    error_ = JSONError::NONE;
+    error_offset_ = 0;
+
+    uint64_t object_bits = 0;   // bit d = 1 se o container na profundidade d é objeto
+    size_t depth = 0;
+
+    // Lê "chave": e deixa pos_ no início do valor
+    auto parseKey = [&]() -> bool {
+        skipWhitespace();
+        if (pos_ >= input_.size()) return fail(JSONError::UNEXPECTED_END);
+        if (input_[pos_] != '"') return fail(JSONError::UNEXPECTED_CHAR);
+        if (!parseString(true, handler)) return false;
+        skipWhitespace();
+        if (pos_ >= input_.size()) return fail(JSONError::UNEXPECTED_END);
+        if (input_[pos_] != ':') return fail(JSONError::UNEXPECTED_CHAR);
+        pos_++;
+        return true;
+    };
+
+    while (true) {
+        // Um valor começando em pos_
+        skipWhitespace();
+        if (pos_ >= input_.size()) return fail(JSONError::UNEXPECTED_END);
+
+        bool opened = false;
+        switch (input_[pos_]) {
+            case '{':
+            case '[': {
+                bool is_object = input_[pos_] == '{';
+                if (depth >= MAX_DEPTH) return fail(JSONError::TOO_DEEP);
+                pos_++;
+                if (!(is_object ? handler.onObjectStart() : handler.onArrayStart())) {
+                    return fail(JSONError::ABORTED);
+                }
+                skipWhitespace();
+                if (pos_ < input_.size() && input_[pos_] == (is_object ? '}' : ']')) {
+                    pos_++;
+                    if (!(is_object ? handler.onObjectEnd() : handler.onArrayEnd())) {
+                        return fail(JSONError::ABORTED);
+                    }
+                    break;
+                }
+                if (is_object) object_bits |= (1ull << depth);
+                else object_bits &= ~(1ull << depth);
+                depth++;
+                if (is_object && !parseKey()) return false;
+                opened = true;
+                break;
+            }
+            case '"':
+                if (!parseString(false, handler)) return false;
+                break;
+            case 't':
+                if (!parseLiteral("true")) return false;
+                if (!handler.onBool(true)) return fail(JSONError::ABORTED);
+                break;
+            case 'f':
+                if (!parseLiteral("false")) return false;
+                if (!handler.onBool(false)) return fail(JSONError::ABORTED);
+                break;
+            case 'n':
+                if (!parseLiteral("null")) return false;
+                if (!handler.onNull()) return fail(JSONError::ABORTED);
+                break;
+            default:
+                if (input_[pos_] == '-' || isDigit(input_[pos_])) {
+                    if (!parseNumber(handler)) return false;
+                    break;
+                }
+                return fail(JSONError::UNEXPECTED_CHAR);
+        }
+        if (opened) continue;   // primeiro elemento do container recém-aberto
+
+        // Depois de um valor: separador, fechamento ou fim do texto
+        while (true) {
+            skipWhitespace();
+            if (depth == 0) {
+                if (pos_ != input_.size()) return fail(JSONError::TRAILING_DATA);
+                return true;
+            }
+            if (pos_ >= input_.size()) return fail(JSONError::UNEXPECTED_END);
+
+            bool in_object = (object_bits >> (depth - 1)) & 1;
+            char c = input_[pos_];
+            if (c == ',') {
+                pos_++;
+                if (in_object && !parseKey()) return false;
+                break;
+            }
+            if (c != (in_object ? '}' : ']')) return fail(JSONError::UNEXPECTED_CHAR);
+            pos_++;
+            depth--;
+            if (!(in_object ? handler.onObjectEnd() : handler.onArrayEnd())) {
+                return fail(JSONError::ABORTED);
+            }
+        }
+    }
+}
+
+bool JSONParser::parseString(bool is_key, JSONHandler& handler) {
+    size_t start = ++pos_;      // pula a aspa de abertura
+    bool escaped = false;
+
+    while (true) {
+        pos_ += findJSONSpecial(input_.data() + pos_, input_.size() - pos_);
+        if (pos_ >= input_.size()) return fail(JSONError::UNEXPECTED_END);
+        char c = input_[pos_];
+        if (c == '"') break;
+        if (c == '\\') {
+            // Só acha o fim agora; a validação do escape fica pro decode
+            escaped = true;
+            pos_ += 2;
+            if (pos_ > input_.size()) return fail(JSONError::UNEXPECTED_END);
+            continue;
+        }
+        return fail(JSONError::BAD_STRING);
+    }
+
+    size_t end = pos_++;        // pula a aspa de fechamento
+    std::string_view value = input_.substr(start, end - start);
+    if (escaped) {
+        if (!decodeEscapes(start, end)) return false;
+        value = scratch_;
+    }
+    bool keep_going = is_key ? handler.onKey(value, escaped) : handler.onString(value, escaped);
+    return keep_going || fail(JSONError::ABORTED);
+}
+
+bool JSONParser::decodeEscapes(size_t start, size_t end) {
+    scratch_.clear();
+    scratch_.reserve(end - start);
+
+    size_t i = start;
+    auto bad = [&](size_t at) { pos_ = at; return fail(JSONError::BAD_ESCAPE); };
+    auto readHex4 = [&](size_t at, uint32_t& value) -> bool {
+        if (at + 4 > end) return false;
+        value = 0;
+        for (size_t k = 0; k < 4; ++k) {
+            int digit = hexValue(input_[at + k]);
+            if (digit < 0) return false;
+            value = (value << 4) | static_cast<uint32_t>(digit);
+        }
+        return true;
+    };
+
+    while (i < end) {
+        const void* hit = std::memchr(input_.data() + i, '\\', end - i);
+        size_t next = hit ? static_cast<size_t>(static_cast<const char*>(hit) - input_.data()) : end;
+        scratch_.append(input_.data() + i, next - i);
+        if (next >= end) break;
+
+        size_t escape_at = next;
+        char kind = input_[next + 1];
+        i = next + 2;
+        switch (kind) {
+            case '"': scratch_.push_back('"'); break;
+            case '\\': scratch_.push_back('\\'); break;
+            case '/': scratch_.push_back('/'); break;
+            case 'b': scratch_.push_back('\b'); break;
+            case 'f': scratch_.push_back('\f'); break;
+            case 'n': scratch_.push_back('\n'); break;
+            case 'r': scratch_.push_back('\r'); break;
+            case 't': scratch_.push_back('\t'); break;
+            case 'u': {
+                uint32_t code_point;
+                if (!readHex4(i, code_point)) return bad(escape_at);
+                i += 4;
+                if (code_point >= 0xD800 && code_point <= 0xDBFF) {
+                    // Par substituto: o \uDC00-\uDFFF tem que vir logo em seguida
+                    uint32_t low;
+                    if (i + 2 > end || input_[i] != '\\' || input_[i + 1] != 'u' ||
+                        !readHex4(i + 2, low) || low < 0xDC00 || low > 0xDFFF) {
+                        return bad(escape_at);
+                    }
+                    i += 6;
+                    code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+                } else if (code_point >= 0xDC00 && code_point <= 0xDFFF) {
+                    return bad(escape_at);
+                }
+                appendUtf8(scratch_, code_point);
+                break;
+            }
+            default:
+                return bad(escape_at);
+        }
+    }
+    return true;
+}
+
+bool JSONParser::parseNumber(JSONHandler& handler) {
+    size_t start = pos_;
+    auto digits = [&]() {
+        size_t first = pos_;
+        while (pos_ < input_.size() && isDigit(input_[pos_])) pos_++;
+        return pos_ - first;
+    };
+
+    if (input_[pos_] == '-') pos_++;
+    if (pos_ >= input_.size()) return fail(JSONError::UNEXPECTED_END);
+    if (input_[pos_] == '0') {
+        pos_++;     // zero à esquerda não é permitido
+    } else if (digits() == 0) {
+        return fail(JSONError::BAD_NUMBER);
+    }
+    if (pos_ < input_.size() && input_[pos_] == '.') {
+        pos_++;
+        if (digits() == 0) return fail(JSONError::BAD_NUMBER);
+    }
+    if (pos_ < input_.size() && (input_[pos_] == 'e' || input_[pos_] == 'E')) {
+        pos_++;
+        if (pos_ < input_.size() && (input_[pos_] == '+' || input_[pos_] == '-')) pos_++;
+        if (digits() == 0) return fail(JSONError::BAD_NUMBER);
+    }
+    if (!handler.onNumber(input_.substr(start, pos_ - start))) return fail(JSONError::ABORTED);
+    return true;
+}
+
+bool JSONParser::parseLiteral(std::string_view literal) {
+    if (input_.substr(pos_, literal.size()) != literal) {
+        return fail(pos_ + literal.size() > input_.size() ? JSONError::UNEXPECTED_END
+                                                          : JSONError::UNEXPECTED_CHAR);
+    }
+    pos_ += literal.size();
+    return true;
+}
+
+namespace {
+
+// Handler por trás de forEachField/forEachElement: só olha o primeiro nível do
+// container de topo e pula o resto, guardando o intervalo cru dos aninhados
+class TopLevelWalker : public JSONHandler {
+public:
+    TopLevelWalker(const JSONParser& parser, std::string_view input, bool want_object,
+                   const std::function<bool(std::string_view, const JSONField&)>* on_field,
+                   const std::function<bool(const JSONField&)>* on_element)
+        : parser_(parser), input_(input), want_object_(want_object),
+          on_field_(on_field), on_element_(on_element) {}
+
+    bool wrongType() const { return wrong_type_; }
+
+    bool onObjectStart() override { return openContainer(true); }
+    bool onArrayStart() override { return openContainer(false); }
+    bool onObjectEnd() override { return closeContainer(JSONType::OBJECT); }
+    bool onArrayEnd() override { return closeContainer(JSONType::ARRAY); }
+
+    bool onKey(std::string_view key, bool escaped) override {
+        if (depth_ != 1) return true;
+        // O buffer de escape é reaproveitado pelo valor - a chave precisa de cópia
+        if (escaped) {
+            key_storage_.assign(key);
+            key_ = key_storage_;
+        } else {
+            key_ = key;
+        }
+        return true;
+    }
+
+    bool onString(std::string_view value, bool escaped) override {
+        if (depth_ != 1) return topLevelScalar();
+        JSONField field;
+        field.type = JSONType::STRING;
+        field.text = value;
+        field.escaped = escaped;
+        if (!escaped) field.offset = static_cast<size_t>(value.data() - input_.data());
+        return deliver(field);
+    }
+
+    bool onNumber(std::string_view text) override {
+        if (depth_ != 1) return topLevelScalar();
+        JSONField field;
+        field.type = JSONType::NUMBER;
+        field.text = text;
+        field.offset = static_cast<size_t>(text.data() - input_.data());
+        return deliver(field);
+    }
+
+    bool onBool(bool value) override {
+        if (depth_ != 1) return topLevelScalar();
+        JSONField field;
+        field.type = JSONType::BOOL;
+        field.boolean = value;
+        return deliver(field);
+    }
+
+    bool onNull() override {
+        if (depth_ != 1) return topLevelScalar();
+        return deliver(JSONField{});
+    }
+
+private:
+    // Escalar fora do container de topo só acontece se o topo não for container
+    bool topLevelScalar() {
+        if (depth_ == 0) {
+            wrong_type_ = true;
+            return false;
+        }
+        return true;
+    }
+
+    bool openContainer(bool is_object) {
+        if (depth_ == 0 && is_object != want_object_) {
+            wrong_type_ = true;
+            return false;
+        }
+        if (depth_ == 1) nested_start_ = parser_.position() - 1;   // posição do '{' ou '['
+        depth_++;
+        return true;
+    }
+
+    bool closeContainer(JSONType type) {
+        depth_--;
+        if (depth_ != 1) return true;
+        JSONField field;
+        field.type = type;
+        field.offset = nested_start_;
+        field.text = input_.substr(nested_start_, parser_.position() - nested_start_);
+        return deliver(field);
+    }
+
+    bool deliver(const JSONField& field) {
+        return want_object_ ? (*on_field_)(key_, field) : (*on_element_)(field);
+    }
+
+    const JSONParser& parser_;
+    std::string_view input_;
+    bool want_object_;
+    const std::function<bool(std::string_view, const JSONField&)>* on_field_;
+    const std::function<bool(const JSONField&)>* on_element_;
+    size_t depth_ = 0;
+    size_t nested_start_ = 0;
+    std::string_view key_;
+    std::string key_storage_;
+    bool wrong_type_ = false;
+};
+
+bool walkTopLevel(std::string_view json, bool want_object,
+                  const std::function<bool(std::string_view, const JSONField&)>* on_field,
+                  const std::function<bool(const JSONField&)>* on_element,
+                  JSONError* error) {
+    JSONParser parser;
+    TopLevelWalker walker(parser, json, want_object, on_field, on_element);
+    bool ok = parser.parse(json, walker);
+    if (error) {
+        *error = walker.wrongType() ? JSONError::UNEXPECTED_CHAR : parser.error();
+    }
+    return ok;
+}
+
+} // namespace
+
+bool forEachField(std::string_view json,
+                  const std::function<bool(std::string_view key, const JSONField& field)>& on_field,
+                  JSONError* error) {
+    return walkTopLevel(json, true, &on_field, nullptr, error);
+}
+
+bool forEachElement(std::string_view json,
+                    const std::function<bool(const JSONField& element)>& on_element,
+                    JSONError* error) {
+    return walkTopLevel(json, false, nullptr, &on_element, error);
+}
+
+} // namespace ipc_project
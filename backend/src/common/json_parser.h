@@ -0,0 +1,111 @@
+/**
+ * @file json_parser.h
+ * @brief Parser JSON de passada única no estilo SAX (sem árvore, sem cópia)
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <functional>
+#include <cstddef>
+#include <cstdint>
+
+namespace ipc_project {
+
+// Eventos entregues pelo parser, na ordem em que aparecem no texto.
+// Retornar false de qualquer callback interrompe o parse (erro ABORTED).
+//
+// Strings sem escape chegam como view do próprio texto de entrada - o chamador
+// pode calcular o offset com value.data() - input.data() e fatiar o buffer
+// original sem copiar. Com escape (escaped == true) a view aponta pro buffer
+// interno do parser e só vale até o próximo callback.
+class JSONHandler {
+public:
+    virtual ~JSONHandler() = default;
+
+    virtual bool onObjectStart() { return true; }
+    virtual bool onObjectEnd() { return true; }
+    virtual bool onArrayStart() { return true; }
+    virtual bool onArrayEnd() { return true; }
+    virtual bool onKey(std::string_view key, bool escaped) { (void)key; (void)escaped; return true; }
+    virtual bool onString(std::string_view value, bool escaped) { (void)value; (void)escaped; return true; }
+    virtual bool onNumber(std::string_view text) { (void)text; return true; }   // texto cru, já validado
+    virtual bool onBool(bool value) { (void)value; return true; }
+    virtual bool onNull() { return true; }
+};
+
+enum class JSONError {
+    NONE = 0,
+    UNEXPECTED_END,         // texto acabou no meio de um valor
+    UNEXPECTED_CHAR,        // caractere fora da gramática
+    BAD_STRING,             // caractere de controle cru dentro de string
+    BAD_ESCAPE,             // escape desconhecido ou \u inválido
+    BAD_NUMBER,
+    TOO_DEEP,               // aninhamento passou de MAX_DEPTH
+    TRAILING_DATA,          // lixo depois do valor de topo
+    ABORTED                 // o handler pediu pra parar
+};
+
+std::string jsonErrorToString(JSONError error);
+
+// Parser de passada única: percorre o texto uma vez, sem montar árvore e sem
+// recursão (a pilha de containers é um bitmap). A busca do fim das strings
+// é vetorizada (json_scan.h) - é onde fica quase todo o tempo num body com
+// payload grande. A instância guarda o buffer de escape e pode ser
+// reutilizada entre parses.
+class JSONParser {
+public:
+    static constexpr size_t MAX_DEPTH = 64;
+
+    bool parse(std::string_view input, JSONHandler& handler);
+
+    JSONError error() const { return error_; }
+    size_t errorOffset() const { return error_offset_; }
+    std::string errorMessage() const;
+
+    // Posição atual no texto - válida dentro dos callbacks
+    size_t position() const { return pos_; }
+
+private:
+    bool parseString(bool is_key, JSONHandler& handler);
+    bool parseNumber(JSONHandler& handler);
+    bool parseLiteral(std::string_view literal);
+    bool decodeEscapes(size_t start, size_t end);
+    bool fail(JSONError error);
+    void skipWhitespace();
+
+    std::string_view input_;
+    size_t pos_ = 0;
+    std::string scratch_;       // destino das strings com escape
+    JSONError error_ = JSONError::NONE;
+    size_t error_offset_ = 0;
+};
+
+// Tipo de um campo visto por forEachField
+enum class JSONType { STRING, NUMBER, BOOL, NULL_VALUE, OBJECT, ARRAY };
+
+struct JSONField {
+    JSONType type = JSONType::NULL_VALUE;
+    // STRING: valor já sem escapes; NUMBER: texto cru; OBJECT/ARRAY: texto
+    // cru do container inteiro (pode ser passado de novo pro parser)
+    std::string_view text;
+    bool escaped = false;       // text aponta pro buffer interno (copiar se precisar)
+    bool boolean = false;
+    size_t offset = 0;          // início de text na entrada quando !escaped
+};
+
+// Atalho pro caso comum de body de endpoint: um objeto no topo, campos lidos
+// um a um. Containers aninhados são pulados e entregues como texto cru.
+// Retorna false se o texto não for um objeto JSON válido ou se o callback
+// devolver false.
+bool forEachField(std::string_view json,
+                  const std::function<bool(std::string_view key, const JSONField& field)>& on_field,
+                  JSONError* error = nullptr);
+
+// Mesmo contrato pra arrays de topo: on_element recebe cada elemento
+bool forEachElement(std::string_view json,
+                    const std::function<bool(const JSONField& element)>& on_element,
+                    JSONError* error = nullptr);
+
+} // namespace ipc_project
@@ -0,0 +1,58 @@
+/**
+ * @file json_scan.h
+ * @brief Busca vetorizada dos bytes que precisam de escape em string JSON
+ */
+
+#pragma once
+
+#include <cstddef>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace ipc_project {
+
+// Índice do primeiro byte em [data, data + length) que é aspas, barra invertida
+// ou controle (< 0x20) - ou length se não houver. É o mesmo conjunto pros dois
+// lados: o parser procura onde a string acaba, o writer onde precisa escapar.
+// Anda 32 bytes por vez com AVX2, 16 com SSE2, e termina byte a byte.
+inline size_t findJSONSpecial(const char* data, size_t length) {
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i control_max = _mm256_set1_epi8(0x1F);
+    for (; i + 32 <= length; i += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i special = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, quote),
+                                          _mm256_cmpeq_epi8(chunk, backslash));
+        // byte <= 0x1F sem sinal: max(byte, 0x1F) == 0x1F
+        special = _mm256_or_si256(special,
+                                  _mm256_cmpeq_epi8(_mm256_max_epu8(chunk, control_max), control_max));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(special));
+        if (mask != 0) return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+#elif defined(__SSE2__)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control_max = _mm_set1_epi8(0x1F);
+    for (; i + 16 <= length; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i special = _mm_or_si128(_mm_cmpeq_epi8(chunk, quote),
+                                       _mm_cmpeq_epi8(chunk, backslash));
+        special = _mm_or_si128(special,
+                               _mm_cmpeq_epi8(_mm_max_epu8(chunk, control_max), control_max));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(special));
+        if (mask != 0) return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+#endif
+    for (; i < length; ++i) {
+        unsigned char c = static_cast<unsigned char>(data[i]);
+        if (c < 0x20 || c == '"' || c == '\\') return i;
+    }
+    return length;
+}
+
+} // namespace ipc_project
@@ -0,0 +1,142 @@
+/**
+ * @file json_writer.cpp
+ * @brief Implementação do escritor JSON
+ */
+
+#include "json_writer.h"
+#include "json_scan.h"
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+
+namespace ipc_project {
+
+void appendJSONEscaped(std::string& out, std::string_view s) {
+    static constexpr char HEX[] = "0123456789abcdef";
+    size_t i = 0;
+    while (i < s.size()) {
+        size_t run = findJSONSpecial(s.data() + i, s.size() - i);
+        out.append(s.data() + i, run);
+        i += run;
+        if (i >= s.size()) break;
+
+        unsigned char c = static_cast<unsigned char>(s[i++]);
+        switch (c) {
+            case '"': out.append("\\\"", 2); break;
+            case '\\': out.append("\\\\", 2); break;
+            case '\n': out.append("\\n", 2); break;
+            case '\r': out.append("\\r", 2); break;
+            case '\t': out.append("\\t", 2); break;
+            case '\b': out.append("\\b", 2); break;
+            case '\f': out.append("\\f", 2); break;
+            default: {
+                char escape[6] = {'\\', 'u', '0', '0', HEX[c >> 4], HEX[c & 0xF]};
+                out.append(escape, sizeof(escape));
+            }
+        }
+    }
+}
+
+std::string jsonQuote(std::string_view s) {
+    std::string out;
+    out.reserve(s.size() + 2);
+    out.push_back('"');
+    appendJSONEscaped(out, s);
+    out.push_back('"');
+    return out;
+}
+
+std::string isoTimestampNow() {
+    auto now = std::chrono::system_clock::now();
+    std::time_t seconds = std::chrono::system_clock::to_time_t(now);
+    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000;
+    std::tm utc{};
+    gmtime_r(&seconds, &utc);
+    char buffer[32];
+    size_t length = std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%S", &utc);
+    std::snprintf(buffer + length, sizeof(buffer) - length, ".%03dZ", static_cast<int>(ms));
+    return buffer;
+}
+
+JSONWriter& JSONWriter::key(std::string_view name) {
+    separate();
+    out_.push_back('"');
+    appendJSONEscaped(out_, name);
+    out_.append("\":", 2);
+    need_comma_ = false;
+    return *this;
+}
+
+JSONWriter& JSONWriter::value(std::string_view s) {
+    separate();
+    out_.reserve(out_.size() + s.size() + 2);
+    out_.push_back('"');
+    appendJSONEscaped(out_, s);
+    out_.push_back('"');
+    need_comma_ = true;
+    return *this;
+}
+
+JSONWriter& JSONWriter::value(bool b) {
+    separate();
+    if (b) out_.append("true", 4);
+    else out_.append("false", 5);
+    need_comma_ = true;
+    return *this;
+}
+
+JSONWriter& JSONWriter::value(double d) {
+    if (!std::isfinite(d)) return null();   // JSON não tem NaN nem infinito
+    separate();
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), d);
+    out_.append(buffer, static_cast<size_t>(result.ptr - buffer));
+    need_comma_ = true;
+    return *this;
+}
+
+JSONWriter& JSONWriter::value(double d, int decimals) {
+    if (!std::isfinite(d)) return null();
+    separate();
+    char buffer[352];   // cabe qualquer double em notação fixa
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), d, std::chars_format::fixed, decimals);
+    out_.append(buffer, static_cast<size_t>(result.ptr - buffer));
+    need_comma_ = true;
+    return *this;
+}
+
+JSONWriter& JSONWriter::null() {
+    separate();
+    out_.append("null", 4);
+    need_comma_ = true;
+    return *this;
+}
+
+JSONWriter& JSONWriter::raw(std::string_view json) {
+    separate();
+    out_.append(json);
+    need_comma_ = true;
+    return *this;
+}
+
+JSONWriter& JSONWriter::integer(uint64_t n) {
+    separate();
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), n);
+    out_.append(buffer, static_cast<size_t>(result.ptr - buffer));
+    need_comma_ = true;
+    return *this;
+}
+
+JSONWriter& JSONWriter::integer(int64_t n) {
+    separate();
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), n);
+    out_.append(buffer, static_cast<size_t>(result.ptr - buffer));
+    need_comma_ = true;
+    return *this;
+}
+
+} // namespace ipc_project
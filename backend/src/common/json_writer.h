@@ -0,0 +1,81 @@
+/**
+ * @file json_writer.h
+ * @brief Escritor JSON que anexa direto num buffer, com escape vetorizado
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+
+namespace ipc_project {
+
+// Anexa s em out já escapado (sem as aspas). Os trechos sem nada pra escapar
+// são achados pela busca vetorizada e copiados de uma vez.
+void appendJSONEscaped(std::string& out, std::string_view s);
+
+// Atalho: string JSON completa, com aspas
+std::string jsonQuote(std::string_view s);
+
+// Instante atual em ISO-8601 UTC com milissegundos (campo "timestamp" dos toJSON)
+std::string isoTimestampNow();
+
+// Escritor de JSON em streaming: anexa no std::string do chamador (que pode
+// ser reaproveitado entre respostas) e cuida das vírgulas sozinho. Números
+// saem por std::to_chars - sem locale, sem ostream.
+//
+//   std::string out;
+//   JSONWriter json(out);
+//   json.beginObject().field("name", name).field("sent", 3).endObject();
+class JSONWriter {
+public:
+    explicit JSONWriter(std::string& out) : out_(out) {}
+
+    JSONWriter& beginObject() { separate(); out_.push_back('{'); need_comma_ = false; return *this; }
+    JSONWriter& endObject() { out_.push_back('}'); need_comma_ = true; return *this; }
+    JSONWriter& beginArray() { separate(); out_.push_back('['); need_comma_ = false; return *this; }
+    JSONWriter& endArray() { out_.push_back(']'); need_comma_ = true; return *this; }
+
+    JSONWriter& key(std::string_view name);
+
+    JSONWriter& value(std::string_view s);
+    JSONWriter& value(const char* s) { return value(std::string_view(s)); }
+    JSONWriter& value(const std::string& s) { return value(std::string_view(s)); }
+    JSONWriter& value(bool b);
+    JSONWriter& value(double d);                // representação mais curta que ida-e-volta
+    JSONWriter& value(double d, int decimals);  // casas fixas, tipo "%.3f"
+    JSONWriter& null();
+
+    template <typename T>
+    std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>, JSONWriter&>
+    value(T n) {
+        if constexpr (std::is_signed_v<T>) return integer(static_cast<int64_t>(n));
+        else return integer(static_cast<uint64_t>(n));
+    }
+
+    // Valor já serializado (ex.: toJSON de outra struct)
+    JSONWriter& raw(std::string_view json);
+
+    template <typename T>
+    JSONWriter& field(std::string_view name, const T& v) { key(name); return value(v); }
+    JSONWriter& field(std::string_view name, double d, int decimals) { key(name); return value(d, decimals); }
+    JSONWriter& nullField(std::string_view name) { key(name); return null(); }
+    JSONWriter& rawField(std::string_view name, std::string_view json) { key(name); return raw(json); }
+
+    std::string& buffer() { return out_; }
+
+private:
+    void separate() {
+        if (need_comma_) out_.push_back(',');
+    }
+    JSONWriter& integer(uint64_t n);
+    JSONWriter& integer(int64_t n);
+
+    std::string& out_;
+    bool need_comma_ = false;
+};
+
+} // namespace ipc_project
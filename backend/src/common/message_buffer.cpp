@@ -0,0 +1,323 @@
+/**
+ * @file message_buffer.cpp
+ * @brief Implementação do buffer de mensagem com pool por thread
+ */
+
+#include "message_buffer.h"
+#include <algorithm>
+#include <array>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace ipc_project {
+
+namespace {
+
+// Classes de tamanho do pool (capacidade total do bloco, incluindo headroom)
+constexpr std::array<size_t, 7> SIZE_CLASSES = {
+    256, 1024, 4096, 16 * 1024, 64 * 1024, 256 * 1024, 1024 * 1024
+};
+
+// Blocos maiores que a maior classe não passam pelo pool
+constexpr uint32_t UNPOOLED = UINT32_MAX;
+
+// Máximo de blocos parados por classe em cada thread - evita acumular memória
+constexpr size_t MAX_CACHED_PER_CLASS = 64;
+
+uint32_t sizeClassFor(size_t capacity) {
+    for (uint32_t i = 0; i < SIZE_CLASSES.size(); ++i) {
+        if (capacity <= SIZE_CLASSES[i]) return i;
+    }
+    return UNPOOLED;
+}
+
+} // namespace
+
+// Pool de uma thread. Só a dona mexe nas free lists; as outras threads
+// devolvem blocos pela pilha 'returned' (push com CAS, a dona tira tudo de uma
+// vez com exchange - sem ABA). Fica no heap e vive enquanto houver bloco dele
+// emprestado: 'refs' conta a thread dona + cada bloco fora da free list.
+struct MessageBufferPool {
+    std::array<std::vector<MessageBuffer::Block*>, SIZE_CLASSES.size()> free_lists;
+    MessageBuffer::PoolStats stats;
+    std::atomic<MessageBuffer::Block*> returned{nullptr};
+    std::atomic<size_t> refs{1};
+    std::atomic<bool> closed{false};   // a thread dona já saiu
+
+    // Guarda um bloco na free list da classe (ou solta, se já tem demais)
+    void cache(MessageBuffer::Block* block) {
+        auto& list = free_lists[block->size_class];
+        if (list.size() < MAX_CACHED_PER_CLASS) {
+            list.push_back(block);
+            stats.cached_blocks++;
+        } else {
+            MessageBuffer::freeBlock(block);
+        }
+    }
+
+    // Traz pra free list o que outras threads devolveram
+    void drainReturned() {
+        MessageBuffer::Block* block = returned.exchange(nullptr, std::memory_order_acquire);
+        while (block) {
+            MessageBuffer::Block* next = block->next_free;
+            stats.remote_returns++;
+            cache(block);
+            block = next;
+        }
+    }
+
+    void pushReturned(MessageBuffer::Block* block) {
+        MessageBuffer::Block* head = returned.load(std::memory_order_relaxed);
+        do {
+            block->next_free = head;
+        } while (!returned.compare_exchange_weak(head, block, std::memory_order_release,
+                                                 std::memory_order_relaxed));
+    }
+
+    void unref() {
+        if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            releaseAll();
+            delete this;
+        }
+    }
+
+    void releaseAll() {
+        MessageBuffer::Block* block = returned.exchange(nullptr, std::memory_order_acquire);
+        while (block) {
+            MessageBuffer::Block* next = block->next_free;
+            MessageBuffer::freeBlock(block);
+            block = next;
+        }
+        for (auto& list : free_lists) {
+            for (auto* cached : list) {
+                MessageBuffer::freeBlock(cached);
+            }
+            list.clear();
+        }
+    }
+
+    static MessageBufferPool& local();
+};
+
+namespace {
+
+thread_local MessageBufferPool* current_pool = nullptr;
+
+// Fim da thread: o cache é solto agora, o pool em si quando o último bloco
+// emprestado voltar (quem devolver depois disso solta direto)
+struct PoolHolder {
+    MessageBufferPool* pool = new MessageBufferPool;
+    PoolHolder() { current_pool = pool; }
+    ~PoolHolder() {
+        current_pool = nullptr;
+        pool->closed.store(true, std::memory_order_release);
+        pool->releaseAll();
+        pool->unref();
+    }
+};
+
+} // namespace
+
+MessageBufferPool& MessageBufferPool::local() {
+    thread_local PoolHolder holder;
+    return *holder.pool;
+}
+
+MessageBuffer::Block* MessageBuffer::acquireBlock(size_t capacity) {
+    MessageBufferPool& pool = MessageBufferPool::local();
+    pool.stats.allocations++;
+
+    uint32_t size_class = sizeClassFor(capacity);
+    if (size_class != UNPOOLED) {
+        if (pool.returned.load(std::memory_order_relaxed)) {
+            pool.drainReturned();
+        }
+        auto& list = pool.free_lists[size_class];
+        pool.refs.fetch_add(1, std::memory_order_relaxed);
+        if (!list.empty()) {
+            Block* block = list.back();
+            list.pop_back();
+            pool.stats.pool_hits++;
+            pool.stats.cached_blocks--;
+            block->refs.store(1, std::memory_order_relaxed);
+            return block;
+        }
+        capacity = SIZE_CLASSES[size_class];
+    }
+
+    void* memory = std::malloc(sizeof(Block) + capacity);
+    if (!memory) {
+        if (size_class != UNPOOLED) pool.unref();
+        throw std::bad_alloc();
+    }
+    Block* block = new (memory) Block;
+    block->refs.store(1, std::memory_order_relaxed);
+    block->size_class = size_class;
+    block->capacity = capacity;
+    block->owner = size_class != UNPOOLED ? &pool : nullptr;
+    block->next_free = nullptr;
+    return block;
+}
+
+// Volta pro pool dono: direto na free list se for a mesma thread, pela pilha
+// de devolução se não for. Dono que já saiu não guarda mais nada
+void MessageBuffer::recycleBlock(Block* block) {
+    MessageBufferPool* owner = block->owner;
+    if (!owner) {
+        freeBlock(block);
+        return;
+    }
+    if (owner == current_pool) {
+        owner->cache(block);
+    } else if (owner->closed.load(std::memory_order_acquire)) {
+        freeBlock(block);
+    } else {
+        owner->pushReturned(block);
+    }
+    owner->unref();
+}
+
+void MessageBuffer::freeBlock(Block* block) {
+    block->~Block();
+    std::free(block);
+}
+
+MessageBuffer::MessageBuffer(Block* block, size_t offset, size_t size)
+    : block_(block), offset_(offset), size_(size) {
+}
+
+MessageBuffer::MessageBuffer(const MessageBuffer& other)
+    : block_(other.block_), offset_(other.offset_), size_(other.size_) {
+    if (block_) {
+        block_->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+MessageBuffer::MessageBuffer(MessageBuffer&& other) noexcept
+    : block_(other.block_), offset_(other.offset_), size_(other.size_) {
+    other.block_ = nullptr;
+    other.offset_ = 0;
+    other.size_ = 0;
+}
+
+MessageBuffer& MessageBuffer::operator=(const MessageBuffer& other) {
+    if (this != &other) {
+        if (other.block_) {
+            other.block_->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+        release();
+        block_ = other.block_;
+        offset_ = other.offset_;
+        size_ = other.size_;
+    }
+    return *this;
+}
+
+MessageBuffer& MessageBuffer::operator=(MessageBuffer&& other) noexcept {
+    if (this != &other) {
+        release();
+        block_ = other.block_;
+        offset_ = other.offset_;
+        size_ = other.size_;
+        other.block_ = nullptr;
+        other.offset_ = 0;
+        other.size_ = 0;
+    }
+    return *this;
+}
+
+MessageBuffer::~MessageBuffer() {
+    release();
+}
+
+void MessageBuffer::release() {
+    if (block_ && block_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        recycleBlock(block_);
+    }
+    block_ = nullptr;
+    offset_ = 0;
+    size_ = 0;
+}
+
+MessageBuffer MessageBuffer::allocate(size_t capacity, size_t headroom) {
+    Block* block = acquireBlock(headroom + capacity);
+    return MessageBuffer(block, headroom, 0);
+}
+
+MessageBuffer MessageBuffer::copyOf(std::string_view bytes, size_t headroom) {
+    // +1 de tailroom pro terminador de framing ('\n') sem realocar
+    MessageBuffer buffer = allocate(bytes.size() + 1, headroom);
+    if (!bytes.empty()) {
+        std::memcpy(buffer.data(), bytes.data(), bytes.size());
+    }
+    buffer.size_ = bytes.size();
+    return buffer;
+}
+
+void MessageBuffer::reserve(size_t bytes) {
+    if (block_ && tailroom() >= bytes && unique()) {
+        return;
+    }
+
+    // Troca de bloco: dobra a capacidade pra amortizar leituras incrementais
+    size_t current = block_ ? block_->capacity : 0;
+    size_t needed = offset_ + size_ + bytes;
+    size_t capacity = std::max(needed, current * 2);
+    size_t headroom = block_ ? offset_ : DEFAULT_HEADROOM;
+
+    Block* block = acquireBlock(capacity);
+    if (size_ > 0) {
+        std::memcpy(block->storage() + headroom, data(), size_);
+    }
+    size_t size = size_;
+    release();
+    block_ = block;
+    offset_ = headroom;
+    size_ = size;
+}
+
+void MessageBuffer::append(std::string_view bytes) {
+    reserve(bytes.size());
+    std::memcpy(tail(), bytes.data(), bytes.size());
+    size_ += bytes.size();
+}
+
+char* MessageBuffer::prepend(size_t bytes) {
+    if (!block_ || offset_ < bytes || !unique()) {
+        return nullptr;
+    }
+    offset_ -= bytes;
+    size_ += bytes;
+    return data();
+}
+
+void MessageBuffer::consume(size_t bytes) {
+    if (bytes > size_) bytes = size_;
+    offset_ += bytes;
+    size_ -= bytes;
+}
+
+MessageBuffer MessageBuffer::slice(size_t offset, size_t length) const {
+    if (!block_ || offset > size_) {
+        return MessageBuffer();
+    }
+    if (length > size_ - offset) length = size_ - offset;
+    block_->refs.fetch_add(1, std::memory_order_relaxed);
+    return MessageBuffer(block_, offset_ + offset, length);
+}
+
+bool MessageBuffer::unique() const {
+    return block_ && block_->refs.load(std::memory_order_acquire) == 1;
+}
+
+long MessageBuffer::useCount() const {
+    return block_ ? static_cast<long>(block_->refs.load(std::memory_order_relaxed)) : 0;
+}
+
+MessageBuffer::PoolStats MessageBuffer::threadPoolStats() {
+    return MessageBufferPool::local().stats;
+}
+
+} // namespace ipc_project
@@ -0,0 +1,114 @@
+/**
+ * @file message_buffer.h
+ * @brief Buffer de mensagem com contagem de referência e pool por thread
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace ipc_project {
+
+struct MessageBufferPool;
+
+// Buffer de mensagem compartilhado - copiar o handle só incrementa a referência,
+// os bytes nunca são copiados. Layout do bloco:
+//
+//   [ headroom | dados | tailroom ]
+//
+// O headroom fica reservado pra cabeçalhos de framing (o transporte escreve o
+// cabeçalho na frente dos dados sem realocar). Os blocos vêm de free lists por
+// thread separadas por classe de tamanho, então o caminho quente não chama malloc.
+// Bloco liberado em outra thread (despachante, worker HTTP) volta pro pool de
+// quem alocou, por uma pilha lock-free que o dono esvazia quando precisa.
+class MessageBuffer {
+public:
+    static constexpr size_t DEFAULT_HEADROOM = 64;   // espaço reservado pro framing
+
+    MessageBuffer() = default;
+    MessageBuffer(const MessageBuffer& other);
+    MessageBuffer(MessageBuffer&& other) noexcept;
+    MessageBuffer& operator=(const MessageBuffer& other);
+    MessageBuffer& operator=(MessageBuffer&& other) noexcept;
+    ~MessageBuffer();
+
+    // Pega um bloco do pool com pelo menos 'capacity' bytes depois do headroom
+    static MessageBuffer allocate(size_t capacity, size_t headroom = DEFAULT_HEADROOM);
+
+    // Copia bytes pra um buffer novo (pra quem ainda tem std::string)
+    static MessageBuffer copyOf(std::string_view bytes, size_t headroom = DEFAULT_HEADROOM);
+
+    // Acesso aos dados
+    char* data() { return block_ ? block_->storage() + offset_ : nullptr; }
+    const char* data() const { return block_ ? block_->storage() + offset_ : nullptr; }
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    std::string_view view() const { return std::string_view(data(), size_); }
+    std::string str() const { return std::string(view()); }
+
+    // Espaço livre antes e depois dos dados
+    size_t headroom() const { return offset_; }
+    size_t tailroom() const { return block_ ? block_->capacity - offset_ - size_ : 0; }
+
+    // Ponteiro pro fim dos dados - usado pra ler direto do socket no buffer
+    char* tail() { return data() + size_; }
+    void commit(size_t bytes) { size_ += bytes; }   // marca 'bytes' do tailroom como dados
+
+    // Garante pelo menos 'bytes' de tailroom (pode trocar de bloco - única cópia)
+    void reserve(size_t bytes);
+    void append(std::string_view bytes);
+
+    // Expande os dados pra trás dentro do headroom. Só funciona se o buffer for
+    // dono exclusivo do bloco; retorna nullptr se não couber ou estiver compartilhado
+    char* prepend(size_t bytes);
+
+    // Descarta 'bytes' do início (ex: cabeçalhos HTTP) sem copiar
+    void consume(size_t bytes);
+
+    // Fatia que compartilha o mesmo bloco (sem cópia)
+    MessageBuffer slice(size_t offset, size_t length) const;
+
+    // Se este handle é o único dono do bloco
+    bool unique() const;
+    long useCount() const;
+
+    // Estatísticas do pool da thread atual (pra monitoramento/testes)
+    struct PoolStats {
+        size_t allocations = 0;     // blocos pedidos
+        size_t pool_hits = 0;       // atendidos pela free list
+        size_t cached_blocks = 0;   // blocos parados na free list agora
+        size_t remote_returns = 0;  // devolvidos por outras threads
+    };
+    static PoolStats threadPoolStats();
+
+private:
+    struct Block {
+        std::atomic<uint32_t> refs;
+        uint32_t size_class;        // índice da classe (ou UNPOOLED)
+        size_t capacity;            // bytes em storage (headroom + dados + tailroom)
+        MessageBufferPool* owner;   // pool de quem alocou (nullptr = fora do pool)
+        Block* next_free;           // encadeamento na pilha de devolução
+
+        // Os bytes ficam logo depois do cabeçalho do bloco
+        char* storage() { return reinterpret_cast<char*>(this + 1); }
+    };
+
+    Block* block_ = nullptr;
+    size_t offset_ = 0;             // início dos dados dentro de storage
+    size_t size_ = 0;
+
+    MessageBuffer(Block* block, size_t offset, size_t size);
+    void release();
+
+    static Block* acquireBlock(size_t capacity);
+    static void recycleBlock(Block* block);
+    static void freeBlock(Block* block);
+
+    friend struct MessageBufferPool;
+};
+
+} // namespace ipc_project
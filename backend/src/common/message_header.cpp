@@ -0,0 +1,251 @@
+/**
+ * @file message_header.cpp
+ * @brief Codificação/decodificação do envelope binário das mensagens
+ */
+
+#include "message_header.h"
+#include "json_writer.h"
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <unistd.h>
+#include <sys/uio.h>
+#if defined(__SSE4_2__)
+#include <nmmintrin.h>
+#endif
+
+namespace ipc_project {
+
+namespace {
+
+// Tabela do CRC32C (polinômio refletido 0x82F63B78) gerada em tempo de compilação
+constexpr std::array<uint32_t, 256> makeCrcTable() {
+    std::array<uint32_t, 256> table{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 1) ? (crc >> 1) ^ 0x82F63B78u : crc >> 1;
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+constexpr std::array<uint32_t, 256> CRC_TABLE = makeCrcTable();
+
+// Lê exatamente 'length' bytes - pipes e sockets stream podem entregar em pedaços
+bool readExact(int fd, char* out, size_t length, std::string& error) {
+    size_t done = 0;
+    while (done < length) {
+        ssize_t n = read(fd, out + done, length - done);
+        if (n == 0) {
+            error = done == 0 ? "eof" : "eof_mid_frame";
+            return false;
+        }
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            error = std::string("read: ") + strerror(errno);
+            return false;
+        }
+        done += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+} // namespace
+
+std::string messageTypeToString(MessageType type) {
+    switch (type) {
+        case MessageType::DATA: return "data";
+        case MessageType::CONTROL: return "control";
+        case MessageType::HEARTBEAT: return "heartbeat";
+        case MessageType::BATCH: return "batch";
+    }
+    return "unknown";
+}
+
+uint64_t monotonicNowNs() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+uint32_t computeChecksum(const void* data, size_t length, uint32_t seed) {
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    uint32_t crc = ~seed;
+#if defined(__SSE4_2__)
+    // 8 bytes por instrução no caminho rápido
+    while (length >= 8) {
+        uint64_t chunk;
+        std::memcpy(&chunk, bytes, sizeof(chunk));
+        crc = static_cast<uint32_t>(_mm_crc32_u64(crc, chunk));
+        bytes += 8;
+        length -= 8;
+    }
+    while (length > 0) {
+        crc = _mm_crc32_u8(crc, *bytes++);
+        length--;
+    }
+#else
+    while (length > 0) {
+        crc = CRC_TABLE[(crc ^ *bytes++) & 0xFF] ^ (crc >> 8);
+        length--;
+    }
+#endif
+    return ~crc;
+}
+
+MessageHeader makeHeader(MessageType type, std::string_view payload, uint64_t sequence,
+                         uint32_t flags) {
+    MessageHeader header;
+    header.type = static_cast<uint16_t>(type);
+    header.flags = flags;
+    header.length = static_cast<uint32_t>(payload.size());
+    header.sequence = sequence;
+    header.checksum = computeChecksum(payload.data(), payload.size());
+    header.sender_pid = static_cast<int32_t>(getpid());
+    // Timestamp por último - o mais perto possível do envio
+    header.timestamp_ns = monotonicNowNs();
+    return header;
+}
+
+bool validateHeader(const MessageHeader& header, size_t max_length, std::string& error) {
+    if (header.magic != MessageHeader::MAGIC) {
+        error = "bad_magic";
+        return false;
+    }
+    if (header.version != MessageHeader::VERSION) {
+        error = "unsupported_version_" + std::to_string(header.version);
+        return false;
+    }
+    if (header.length > max_length) {
+        error = "length_too_large";
+        return false;
+    }
+    return true;
+}
+
+bool verifyPayload(const MessageHeader& header, std::string_view payload) {
+    return payload.size() == header.length &&
+           computeChecksum(payload.data(), payload.size()) == header.checksum;
+}
+
+std::string encodeFrame(const MessageHeader& header, std::string_view payload) {
+    std::string frame(sizeof(MessageHeader) + payload.size(), '\0');
+    std::memcpy(frame.data(), &header, sizeof(MessageHeader));
+    if (!payload.empty()) {
+        std::memcpy(frame.data() + sizeof(MessageHeader), payload.data(), payload.size());
+    }
+    return frame;
+}
+
+size_t decodeFrame(std::string_view bytes, MessageHeader& header, std::string_view& payload,
+                   std::string& error) {
+    if (bytes.size() < sizeof(MessageHeader)) {
+        error = "incomplete_header";
+        return 0;
+    }
+    std::memcpy(static_cast<void*>(&header), bytes.data(), sizeof(MessageHeader));
+    if (!validateHeader(header, bytes.size() - sizeof(MessageHeader), error)) {
+        if (error == "length_too_large") error = "incomplete_payload";
+        return 0;
+    }
+    payload = bytes.substr(sizeof(MessageHeader), header.length);
+    if (!verifyPayload(header, payload)) {
+        error = "checksum_mismatch";
+        return 0;
+    }
+    return sizeof(MessageHeader) + header.length;
+}
+
+ssize_t writeFrame(int fd, const MessageHeader& header, const char* payload, size_t length) {
+    struct iovec iov[2] = {
+        { const_cast<MessageHeader*>(&header), sizeof(MessageHeader) },
+        { const_cast<char*>(payload), length }
+    };
+    ssize_t written;
+    do {
+        written = writev(fd, iov, length > 0 ? 2 : 1);
+    } while (written < 0 && errno == EINTR);
+    return written;
+}
+
+bool readFrameInto(int fd, MessageHeader& header, void* payload, size_t capacity,
+                   std::string& error) {
+    if (!readExact(fd, reinterpret_cast<char*>(&header), sizeof(MessageHeader), error)) {
+        return false;
+    }
+    if (!validateHeader(header, capacity, error)) {
+        return false;
+    }
+    return header.length == 0 || readExact(fd, static_cast<char*>(payload), header.length, error);
+}
+
+bool readFrame(int fd, MessageHeader& header, std::string& payload, size_t max_length,
+               std::string& error) {
+    if (!readExact(fd, reinterpret_cast<char*>(&header), sizeof(MessageHeader), error)) {
+        return false;
+    }
+    if (!validateHeader(header, max_length, error)) {
+        return false;
+    }
+    payload.resize(header.length);
+    if (header.length > 0 && !readExact(fd, payload.data(), header.length, error)) {
+        return false;
+    }
+    return true;
+}
+
+std::string MessageHeader::toJSON() const {
+    std::string out;
+    JSONWriter json(out);
+    json.beginObject()
+        .field("magic", magic)
+        .field("version", version)
+        .field("type", messageTypeToString(messageType()))
+        .field("flags", flags)
+        .field("length", length)
+        .field("sequence", sequence)
+        .field("timestamp_ns", timestamp_ns)
+        .field("checksum", checksum)
+        .field("sender_pid", sender_pid)
+        .field("schema_id", schema_id)
+        .endObject();
+    return out;
+}
+
+uint64_t FrameTracker::observe(const MessageHeader& header, uint64_t received_ns) {
+    uint64_t missing = 0;
+    if (frames > 0 && header.sequence > last_sequence + 1) {
+        missing = header.sequence - last_sequence - 1;
+        gaps++;
+        lost += missing;
+    }
+    last_sequence = header.sequence;
+
+    // Relógio monotônico e comum à máquina toda, então a diferença é a latência one-way
+    last_latency_ns = received_ns > header.timestamp_ns ? received_ns - header.timestamp_ns : 0;
+    if (last_latency_ns > max_latency_ns) max_latency_ns = last_latency_ns;
+    frames++;
+    avg_latency_ns += (static_cast<double>(last_latency_ns) - avg_latency_ns) / static_cast<double>(frames);
+    return missing;
+}
+
+std::string FrameTracker::toJSON() const {
+    std::string out;
+    JSONWriter json(out);
+    json.beginObject()
+        .field("frames", frames)
+        .field("gaps", gaps)
+        .field("lost", lost)
+        .field("checksum_errors", checksum_errors)
+        .field("last_sequence", last_sequence)
+        .field("last_latency_ns", last_latency_ns)
+        .field("max_latency_ns", max_latency_ns)
+        .field("avg_latency_ns", avg_latency_ns)
+        .endObject();
+    return out;
+}
+
+} // namespace ipc_project
@@ -0,0 +1,113 @@
+/**
+ * @file message_header.h
+ * @brief Envelope binário das mensagens IPC (cabeçalho fixo de 64 bytes)
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+#include <sys/types.h>
+
+namespace ipc_project {
+
+// Tipo da mensagem carregada no envelope
+enum class MessageType : uint16_t {
+    DATA = 1,           // payload do usuário
+    CONTROL = 2,        // comandos internos (start/stop, ack)
+    HEARTBEAT = 3,      // keep-alive sem payload
+    BATCH = 4           // vários envelopes concatenados no payload
+};
+
+std::string messageTypeToString(MessageType type);
+
+// Flags do envelope (bitmask)
+namespace MessageFlags {
+    constexpr uint32_t NONE = 0;
+    constexpr uint32_t TRUNCATED = 1u << 0;   // payload cortado pelo transporte
+    constexpr uint32_t LAST_IN_BATCH = 1u << 1;
+}
+
+// Cabeçalho que vai na frente de toda mensagem, em todos os mecanismos.
+// Tamanho fixo de uma linha de cache: o leitor lê exatamente 64 bytes, valida
+// e já sabe quantos bytes de payload vêm depois - sem procurar '\n' no texto.
+// Os campos estão na ordem nativa (little-endian): o envelope só trafega entre
+// processos da mesma máquina.
+struct alignas(64) MessageHeader {
+    static constexpr uint32_t MAGIC = 0x4D435049;   // "IPCM" em little-endian
+    static constexpr uint16_t VERSION = 1;
+
+    uint32_t magic = MAGIC;
+    uint16_t version = VERSION;
+    uint16_t type = static_cast<uint16_t>(MessageType::DATA);
+    uint32_t flags = MessageFlags::NONE;
+    uint32_t length = 0;            // bytes de payload depois do cabeçalho
+    uint64_t sequence = 0;          // monotônica por canal - buracos = perda
+    uint64_t timestamp_ns = 0;      // CLOCK_MONOTONIC no envio (latência one-way)
+    uint32_t checksum = 0;          // CRC32C do payload
+    int32_t sender_pid = 0;
+    uint64_t schema_id = 0;         // layout do payload em canais tipados (0 = texto livre)
+    uint8_t reserved[16] = {};      // zerado - espaço pra versões futuras
+
+    MessageType messageType() const { return static_cast<MessageType>(type); }
+    std::string toJSON() const;
+};
+
+static_assert(sizeof(MessageHeader) == 64, "MessageHeader must fill exactly one cache line");
+static_assert(alignof(MessageHeader) == 64, "MessageHeader must be cache-line aligned");
+
+// Relógio usado no timestamp do envelope (comum a todos os processos da máquina)
+uint64_t monotonicNowNs();
+
+// CRC32C (Castagnoli) - usa a instrução SSE4.2 quando o build permite
+uint32_t computeChecksum(const void* data, size_t length, uint32_t seed = 0);
+
+// Monta o cabeçalho pro payload: carimba timestamp, pid e checksum
+MessageHeader makeHeader(MessageType type, std::string_view payload, uint64_t sequence,
+                         uint32_t flags = MessageFlags::NONE);
+
+// Valida magic/versão/tamanho de um cabeçalho recebido. 'error' explica a falha
+bool validateHeader(const MessageHeader& header, size_t max_length, std::string& error);
+
+// Confere o checksum do payload contra o cabeçalho
+bool verifyPayload(const MessageHeader& header, std::string_view payload);
+
+// Serializa cabeçalho + payload num buffer contíguo (ferramentas/testes)
+std::string encodeFrame(const MessageHeader& header, std::string_view payload);
+
+// Decodifica um frame contíguo. Retorna bytes consumidos (0 = inválido/incompleto)
+size_t decodeFrame(std::string_view bytes, MessageHeader& header, std::string_view& payload,
+                   std::string& error);
+
+// Escreve cabeçalho + payload numa syscall só (writev, sem concatenar)
+ssize_t writeFrame(int fd, const MessageHeader& header, const char* payload, size_t length);
+
+// Lê um frame direto num buffer do chamador (sem alocar). O payload precisa
+// caber em 'capacity'; retorna false em EOF, erro ou cabeçalho inválido
+bool readFrameInto(int fd, MessageHeader& header, void* payload, size_t capacity,
+                   std::string& error);
+
+// Lê exatamente um frame de um fd em modo stream (pipe/socket).
+// Retorna false em EOF, erro de leitura ou cabeçalho inválido ('error' diz qual)
+bool readFrame(int fd, MessageHeader& header, std::string& payload, size_t max_length,
+               std::string& error);
+
+// Acompanha a sequência recebida num canal: detecta buracos e mede latência
+struct FrameTracker {
+    uint64_t frames = 0;            // frames aceitos
+    uint64_t gaps = 0;              // vezes que a sequência pulou
+    uint64_t lost = 0;              // total de sequências que não chegaram
+    uint64_t checksum_errors = 0;
+    uint64_t last_sequence = 0;
+    uint64_t last_latency_ns = 0;
+    uint64_t max_latency_ns = 0;
+    double avg_latency_ns = 0.0;
+
+    // Registra um frame. Retorna quantas sequências faltaram antes dele
+    uint64_t observe(const MessageHeader& header, uint64_t received_ns);
+    std::string toJSON() const;
+};
+
+} // namespace ipc_project
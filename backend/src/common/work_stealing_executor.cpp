@@ -0,0 +1,222 @@
+/**
+ * @file work_stealing_executor.cpp
+ * @brief Implementação do pool com roubo de tarefas
+ */
+
+#include "work_stealing_executor.h"
+#include "json_writer.h"
+#include "logger.h"
+#include <algorithm>
+
+namespace ipc_project {
+
+namespace {
+
+// Em qual pool/worker a thread atual roda (nullptr = thread de fora)
+thread_local const WorkStealingExecutor* current_executor = nullptr;
+thread_local size_t current_index = 0;
+
+uint64_t nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
+std::string WorkerStats::toJSON() const {
+    std::string out;
+    JSONWriter json(out);
+    writeJSON(json);
+    return out;
+}
+
+void WorkerStats::writeJSON(JSONWriter& json) const {
+    json.beginObject()
+        .field("index", index)
+        .field("executed", executed)
+        .field("steals", steals)
+        .field("queued", queued)
+        .field("utilization", utilization, 3)
+        .endObject();
+}
+
+std::string ExecutorStats::toJSON() const {
+    std::string out;
+    JSONWriter json(out);
+    json.beginObject()
+        .field("threads", threads)
+        .field("submitted", submitted)
+        .field("executed", executed)
+        .field("steals", steals)
+        .field("rejected", rejected)
+        .field("queued", queued)
+        .key("workers").beginArray();
+    for (const auto& worker : workers) {
+        worker.writeJSON(json);
+    }
+    json.endArray().endObject();
+    return out;
+}
+
+size_t WorkStealingExecutor::defaultThreadCount() {
+    return std::clamp<size_t>(std::thread::hardware_concurrency(), 2, 8);
+}
+
+WorkStealingExecutor::WorkStealingExecutor(size_t threads)
+    : running_(true), pending_(0), next_worker_(0), submitted_(0), rejected_(0),
+      started_at_(std::chrono::steady_clock::now()) {
+    threads = std::max<size_t>(threads, 1);
+    for (size_t i = 0; i < threads; ++i) {
+        workers_.push_back(std::make_unique<Worker>());
+    }
+    // Threads só sobem depois de todos os deques existirem (elas roubam umas das outras)
+    for (size_t i = 0; i < threads; ++i) {
+        workers_[i]->thread = std::thread(&WorkStealingExecutor::workerLoop, this, i);
+    }
+    Logger::getInstance().debug("Executor com " + std::to_string(threads) + " workers", "EXECUTOR");
+}
+
+WorkStealingExecutor::~WorkStealingExecutor() {
+    shutdown();
+}
+
+bool WorkStealingExecutor::submit(Task task) {
+    // De dentro de um worker: fim do próprio deque. De fora: round-robin
+    size_t index = current_executor == this ? current_index
+                                            : next_worker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+    {
+        // running_ é rechecado e a tarefa publicada sob o mesmo lock em que o
+        // worker decide sair: ou o shutdown vem antes e a tarefa é recusada,
+        // ou o worker já vê pending_ > 0 e drena antes de sair
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        if (!running_) {
+            rejected_++;
+            return false;
+        }
+
+        // Conta antes de publicar: um ladrão pode pegar a tarefa antes do push retornar
+        pending_++;
+        submitted_++;
+        std::lock_guard<std::mutex> worker_lock(workers_[index]->mutex);
+        workers_[index]->tasks.push_back(std::move(task));
+    }
+    sleep_cv_.notify_one();
+    return true;
+}
+
+void WorkStealingExecutor::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        if (!running_.exchange(false)) return;
+    }
+    sleep_cv_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) {
+            worker->thread.join();
+        }
+    }
+}
+
+bool WorkStealingExecutor::isRunning() const {
+    return running_;
+}
+
+size_t WorkStealingExecutor::threadCount() const {
+    return workers_.size();
+}
+
+bool WorkStealingExecutor::inWorkerThread() const {
+    return current_executor == this;
+}
+
+ExecutorStats WorkStealingExecutor::getStats() const {
+    ExecutorStats stats;
+    stats.threads = workers_.size();
+    stats.submitted = submitted_;
+    stats.rejected = rejected_;
+    stats.queued = pending_;
+
+    double elapsed_ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - started_at_).count());
+    for (size_t i = 0; i < workers_.size(); ++i) {
+        Worker& worker = *workers_[i];
+        WorkerStats ws;
+        ws.index = i;
+        ws.executed = worker.executed;
+        ws.steals = worker.steals;
+        {
+            std::lock_guard<std::mutex> lock(worker.mutex);
+            ws.queued = worker.tasks.size();
+        }
+        ws.utilization = elapsed_ns > 0 ? std::min(1.0, static_cast<double>(worker.busy_ns) / elapsed_ns) : 0.0;
+        stats.executed += ws.executed;
+        stats.steals += ws.steals;
+        stats.workers.push_back(ws);
+    }
+    return stats;
+}
+
+void WorkStealingExecutor::workerLoop(size_t index) {
+    current_executor = this;
+    current_index = index;
+    std::minstd_rand rng(static_cast<unsigned>(nowNs() ^ (index * 2654435761u)));
+    Worker& self = *workers_[index];
+
+    while (true) {
+        Task task;
+        if (popLocal(index, task) || steal(index, rng, task)) {
+            pending_--;
+            uint64_t start = nowNs();
+            try {
+                task();
+            } catch (const std::exception& e) {
+                Logger::getInstance().error("Tarefa lançou exceção: " + std::string(e.what()), "EXECUTOR");
+            } catch (...) {
+                Logger::getInstance().error("Tarefa lançou exceção desconhecida", "EXECUTOR");
+            }
+            self.busy_ns += nowNs() - start;
+            self.executed++;
+            continue;
+        }
+
+        // Nada em deque nenhum: dorme até chegar tarefa ou desligar.
+        // Desligando, só sai depois de drenar o que já tinha sido aceito
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        if (!running_ && pending_ == 0) return;
+        sleep_cv_.wait(lock, [this] { return pending_ > 0 || !running_; });
+        if (!running_ && pending_ == 0) return;
+    }
+}
+
+// Dono pega do fim (a tarefa mais recente, provavelmente com dados no cache)
+bool WorkStealingExecutor::popLocal(size_t index, Task& task) {
+    Worker& worker = *workers_[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (worker.tasks.empty()) return false;
+    task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    return true;
+}
+
+// Ladrão pega do início (a mais antiga) de uma vítima sorteada, e segue em
+// volta do anel a partir dela até achar trabalho
+bool WorkStealingExecutor::steal(size_t thief, std::minstd_rand& rng, Task& task) {
+    size_t count = workers_.size();
+    if (count < 2) return false;
+
+    size_t start = rng() % count;
+    for (size_t i = 0; i < count; ++i) {
+        size_t victim = (start + i) % count;
+        if (victim == thief) continue;
+        Worker& worker = *workers_[victim];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        if (worker.tasks.empty()) continue;
+        task = std::move(worker.tasks.front());
+        worker.tasks.pop_front();
+        workers_[thief]->steals++;
+        return true;
+    }
+    return false;
+}
+
+} // namespace ipc_project
@@ -0,0 +1,119 @@
+/**
+ * @file work_stealing_executor.h
+ * @brief Pool fixo de threads com deque por worker e roubo de tarefas
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <random>
+#include <cstdint>
+
+namespace ipc_project {
+
+class JSONWriter;
+
+// Números de um worker - pra dimensionar o pool
+struct WorkerStats {
+    size_t index = 0;
+    uint64_t executed = 0;      // tarefas executadas por este worker
+    uint64_t steals = 0;        // tarefas que ele roubou de outro deque
+    size_t queued = 0;          // tarefas no deque dele agora
+    double utilization = 0.0;   // fração do tempo rodando tarefa desde o start (0..1)
+
+    std::string toJSON() const;
+    void writeJSON(JSONWriter& json) const;
+};
+
+struct ExecutorStats {
+    size_t threads = 0;
+    uint64_t submitted = 0;
+    uint64_t executed = 0;
+    uint64_t steals = 0;
+    uint64_t rejected = 0;      // submit depois do shutdown
+    size_t queued = 0;
+    std::vector<WorkerStats> workers;
+
+    std::string toJSON() const;
+};
+
+// Pool de tamanho fixo. Cada worker tem seu deque: tarefa criada dentro de um
+// worker vai pro fim do deque dele (LIFO, cache quente); tarefa de fora é
+// distribuída em round-robin. Worker sem trabalho rouba do início do deque de
+// uma vítima aleatória. Substitui std::thread por requisição - a concorrência
+// fica limitada ao número de workers
+class WorkStealingExecutor {
+public:
+    using Task = std::function<void()>;
+
+    explicit WorkStealingExecutor(size_t threads = defaultThreadCount());
+    ~WorkStealingExecutor();
+
+    WorkStealingExecutor(const WorkStealingExecutor&) = delete;
+    WorkStealingExecutor& operator=(const WorkStealingExecutor&) = delete;
+
+    // Agenda a tarefa. Retorna false se o pool já foi desligado
+    bool submit(Task task);
+
+    // Agenda e devolve o resultado num future (future inválido após shutdown).
+    // Uma tarefa não deve esperar o future de outra do mesmo pool: com todos os
+    // workers esperando ninguém executa
+    template <typename F>
+    auto async(F&& fn) -> std::future<decltype(fn())> {
+        using Result = decltype(fn());
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(fn));
+        std::future<Result> result = task->get_future();
+        if (!submit([task] { (*task)(); })) {
+            return std::future<Result>();
+        }
+        return result;
+    }
+
+    // Para de aceitar tarefas, executa as que já estavam na fila e junta os workers
+    void shutdown();
+    bool isRunning() const;
+
+    size_t threadCount() const;
+    bool inWorkerThread() const;    // se a thread atual é um worker deste pool
+    ExecutorStats getStats() const;
+
+    static size_t defaultThreadCount();   // núcleos, entre 2 e 8
+
+private:
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::atomic<uint64_t> executed{0};
+        std::atomic<uint64_t> steals{0};
+        std::atomic<uint64_t> busy_ns{0};
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<bool> running_;
+    std::atomic<size_t> pending_;          // tarefas em algum deque
+    std::atomic<size_t> next_worker_;      // round-robin das submissões de fora
+    std::atomic<uint64_t> submitted_;
+    std::atomic<uint64_t> rejected_;
+    std::chrono::steady_clock::time_point started_at_;
+
+    // Admissão (running_ + push) e o sono dos workers: um submit que viu o
+    // pool ligado já publicou a tarefa antes de algum worker decidir sair
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_cv_;
+
+    void workerLoop(size_t index);
+    bool popLocal(size_t index, Task& task);
+    bool steal(size_t thief, std::minstd_rand& rng, Task& task);
+};
+
+} // namespace ipc_project
@@ -0,0 +1,446 @@
+/**
+ * @file cross_memory_manager.cpp
+ * @brief Implementacao da transferencia direta entre processos (cross memory attach)
+ */
+
+#include "cross_memory_manager.h"
+#include "../common/json_writer.h"
+#include <iostream>
+#include <cstring>
+#include <errno.h>
+#include <chrono>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/prctl.h>
+
+namespace ipc_project {
+
+std::string crossMemoryModeToString(CrossMemoryMode mode) {
+    return mode == CrossMemoryMode::PULL ? "pull" : "push";
+}
+
+bool stringToCrossMemoryMode(const std::string& str, CrossMemoryMode& mode) {
+    if (str == "push") mode = CrossMemoryMode::PUSH;
+    else if (str == "pull") mode = CrossMemoryMode::PULL;
+    else return false;
+    return true;
+}
+
+// Converte dados da operação atual pro formato JSON (mesmo formato de pipes/sockets)
+std::string CrossMemoryData::toJSON() const {
+    std::string operation_type = "connect";
+    std::string status_type = "success";
+    if (status == "sent") {
+        operation_type = "write";
+    } else if (status == "received") {
+        operation_type = "read";
+    } else if (status.find("error") != std::string::npos) {
+        status_type = "error";
+    }
+
+    std::string out;
+    out.reserve(256 + message.size());
+    JSONWriter json(out);
+    json.beginObject()
+        .field("type", "cross_memory")
+        .field("timestamp", isoTimestampNow())
+        .field("operation", operation_type)
+        .field("process_id", sender_pid)
+        .key("data").beginObject()
+            .field("message", message.view())
+            .field("bytes", bytes)
+            .field("control_bytes", control_bytes)
+            .field("mode", mode)
+            .field("time_ms", time_ms, 3)
+            .field("sender_pid", sender_pid)
+            .field("receiver_pid", receiver_pid)
+            .field("sequence", sequence)
+            .field("latency_us", latency_us, 3)
+        .endObject()
+        .field("status", status_type);
+    if (status_type == "error") json.field("error_message", status);
+    else json.nullField("error_message");
+    json.endObject();
+    return out;
+}
+
+CrossMemoryManager::CrossMemoryManager(CrossMemoryMode mode, size_t capacity)
+    : child_pid_(-1),
+      parent_pid_(getpid()),
+      is_parent_(true),
+      is_active_(false),
+      mode_(mode),
+      capacity_(capacity),
+      remote_region_{0, 0},
+      logger_(Logger::getInstance()),
+      next_sequence_(0) {
+
+    control_fd_[0] = -1;
+    control_fd_[1] = -1;
+
+    last_operation_.bytes = 0;
+    last_operation_.control_bytes = 0;
+    last_operation_.time_ms = 0.0;
+    last_operation_.status = "idle";
+    last_operation_.mode = crossMemoryModeToString(mode_);
+    last_operation_.sender_pid = getpid();
+    last_operation_.receiver_pid = -1;
+
+    logger_.info("CrossMemoryManager criado (modo " + last_operation_.mode + ")", "CROSS_MEMORY");
+}
+
+CrossMemoryManager::~CrossMemoryManager() {
+    closeChannel();
+    logger_.debug("CrossMemoryManager destruído", "CROSS_MEMORY");
+}
+
+// socketpair pro controle + fork; o worker aloca o buffer e anuncia o endereço
+bool CrossMemoryManager::createChannel() {
+    logger_.info("Criando canal cross memory", "CROSS_MEMORY");
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    if (socketpair(AF_UNIX, SOCK_STREAM, 0, control_fd_) == -1) {
+        updateOperation(MessageBuffer(), 0, "error_create");
+        logger_.error("Erro ao criar socketpair: " + std::string(strerror(errno)), "CROSS_MEMORY");
+        return false;
+    }
+
+    parent_pid_ = getpid();
+    child_pid_ = fork();
+
+    if (child_pid_ == -1) {
+        close(control_fd_[0]);
+        close(control_fd_[1]);
+        control_fd_[0] = control_fd_[1] = -1;
+        updateOperation(MessageBuffer(), 0, "error_fork");
+        logger_.error("Erro ao fazer fork: " + std::string(strerror(errno)), "CROSS_MEMORY");
+        return false;
+    }
+
+    if (child_pid_ == 0) {
+        // Worker - só recebe
+        is_parent_ = false;
+        close(control_fd_[1]);
+        control_fd_[1] = -1;
+
+        last_operation_.sender_pid = parent_pid_;
+        last_operation_.receiver_pid = getpid();
+        is_active_ = true;
+
+        logger_.info("Worker cross memory iniciado", "CROSS_MEMORY_CHILD");
+        runChildLoop();
+    }
+
+    // Coordenador - só envia
+    close(control_fd_[0]);
+    control_fd_[0] = -1;
+
+    // Com Yama (ptrace_scope=1) o worker só pode ler a nossa memória se autorizado
+    if (mode_ == CrossMemoryMode::PULL && prctl(PR_SET_PTRACER, child_pid_, 0, 0, 0) == -1 && errno != EINVAL) {
+        logger_.warning("PR_SET_PTRACER falhou: " + std::string(strerror(errno)), "CROSS_MEMORY");
+    }
+
+    is_active_ = true;
+    if (!receiveRegion()) {
+        closeChannel();
+        updateOperation(MessageBuffer(), 0, "error_handshake");
+        return false;
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    last_operation_.sender_pid = getpid();
+    last_operation_.receiver_pid = child_pid_;
+    updateOperation(MessageBuffer(), 0, "ready");
+    last_operation_.time_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    logger_.info("Worker PID " + std::to_string(child_pid_) + " anunciou " +
+                 std::to_string(remote_region_.capacity) + " bytes de buffer", "CROSS_MEMORY");
+    return true;
+}
+
+bool CrossMemoryManager::isParent() const {
+    return is_parent_;
+}
+
+bool CrossMemoryManager::sendMessage(const std::string& message) {
+    return sendMessage(MessageBuffer::copyOf(message));
+}
+
+// Uma cópia só: buffer do pai -> buffer do worker, feita pelo kernel.
+// O socket de controle leva só envelope + descritor, e o ack libera o buffer
+bool CrossMemoryManager::sendMessage(const MessageBuffer& message) {
+    if (!is_active_ || !is_parent_ || control_fd_[1] == -1) {
+        updateOperation(MessageBuffer(), 0, "error_invalid_state");
+        logger_.error("Tentativa de envio inválida", "CROSS_MEMORY");
+        return false;
+    }
+
+    if (message.size() > remote_region_.capacity) {
+        updateOperation(MessageBuffer(), 0, "error_message_too_large");
+        logger_.error("Mensagem muito grande (" + std::to_string(message.size()) + " bytes, máx " +
+                      std::to_string(remote_region_.capacity) + ")", "CROSS_MEMORY");
+        return false;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    CrossMemoryDescriptor descriptor{};
+    descriptor.length = message.size();
+    descriptor.checksum = computeChecksum(message.data(), message.size());
+    descriptor.address = mode_ == CrossMemoryMode::PUSH
+        ? remote_region_.address
+        : reinterpret_cast<uint64_t>(message.data());
+
+    // Envelope antes da cópia - a latência medida no worker inclui a transferência
+    std::string_view descriptor_view(reinterpret_cast<const char*>(&descriptor), sizeof(descriptor));
+    MessageHeader header = makeHeader(MessageType::DATA, descriptor_view, ++next_sequence_);
+
+    if (mode_ == CrossMemoryMode::PUSH && !message.empty()) {
+        struct iovec local = { const_cast<char*>(message.data()), message.size() };
+        struct iovec remote = { reinterpret_cast<void*>(remote_region_.address), message.size() };
+        ssize_t copied = process_vm_writev(child_pid_, &local, 1, &remote, 1, 0);
+        if (copied != static_cast<ssize_t>(message.size())) {
+            updateOperation(MessageBuffer(), 0, "error_process_vm_writev");
+            logger_.error("process_vm_writev falhou: " + std::string(copied < 0 ? strerror(errno) : "cópia parcial"),
+                          "CROSS_MEMORY");
+            return false;
+        }
+    }
+
+    if (writeFrame(control_fd_[1], header, descriptor_view.data(), descriptor_view.size()) == -1) {
+        updateOperation(MessageBuffer(), 0, "error_write");
+        logger_.error("Erro ao escrever descritor: " + std::string(strerror(errno)), "CROSS_MEMORY");
+        return false;
+    }
+
+    // No modo PULL o worker lê do nosso buffer - ele precisa continuar vivo até o ack
+    MessageHeader ack_header;
+    CrossMemoryAck ack{};
+    std::string error;
+    if (!readFrameInto(control_fd_[1], ack_header, &ack, sizeof(ack), error) ||
+        ack_header.length != sizeof(ack) || ack.sequence != header.sequence) {
+        updateOperation(MessageBuffer(), 0, "error_ack");
+        logger_.error("Ack inválido do worker: " + (error.empty() ? "sequência errada" : error), "CROSS_MEMORY");
+        return false;
+    }
+
+    auto end = std::chrono::high_resolution_clock::now();
+    double elapsed = std::chrono::duration<double, std::milli>(end - start).count();
+
+    if (ack.error != 0) {
+        updateOperation(MessageBuffer(), 0, "error_remote_copy");
+        logger_.error("Worker rejeitou a mensagem " + std::to_string(header.sequence) + ": " +
+                      (ack.error < 0 ? "checksum" : strerror(ack.error)), "CROSS_MEMORY");
+        return false;
+    }
+
+    updateOperation(message.slice(0, std::min(message.size(), PREVIEW_BYTES)), message.size(), "sent");
+    last_operation_.control_bytes = 2 * sizeof(MessageHeader) + sizeof(descriptor) + sizeof(ack);
+    last_operation_.time_ms = elapsed;
+    last_operation_.sequence = header.sequence;
+
+    logger_.info("Mensagem transferida: " + std::to_string(message.size()) + " bytes (seq " +
+                 std::to_string(header.sequence) + ", " + last_operation_.mode + ")", "CROSS_MEMORY");
+
+    printJSON();
+    return true;
+}
+
+// Função que o worker usa pra receber uma mensagem
+std::string CrossMemoryManager::receiveMessage() {
+    if (!is_active_ || is_parent_ || control_fd_[0] == -1) {
+        updateOperation(MessageBuffer(), 0, "error_invalid_state");
+        logger_.error("Tentativa de leitura inválida", "CROSS_MEMORY_CHILD");
+        return "";
+    }
+
+    std::string_view payload;
+    std::string error;
+    if (!receiveFrame(payload, error)) {
+        updateOperation(MessageBuffer(), 0, error == "eof" ? "eof" : "error_" + error);
+        return "";
+    }
+    return std::string(payload);
+}
+
+CrossMemoryData CrossMemoryManager::getLastOperation() const {
+    return last_operation_;
+}
+
+void CrossMemoryManager::printJSON() const {
+    std::cout << "CROSS_MEMORY_JSON:" << last_operation_.toJSON() << std::endl;
+    std::cout.flush();
+}
+
+CrossMemoryMode CrossMemoryManager::getMode() const {
+    return mode_;
+}
+
+size_t CrossMemoryManager::getCapacity() const {
+    return capacity_;
+}
+
+void CrossMemoryManager::closeChannel() {
+    if (!is_active_) return;
+
+    logger_.info("Fechando canal cross memory", is_parent_ ? "CROSS_MEMORY" : "CROSS_MEMORY_CHILD");
+
+    if (is_parent_) {
+        // EOF no controle faz o worker sair do loop
+        if (control_fd_[1] != -1) {
+            close(control_fd_[1]);
+            control_fd_[1] = -1;
+        }
+        if (child_pid_ > 0) {
+            int status;
+            waitpid(child_pid_, &status, 0);
+            child_pid_ = -1;
+        }
+    } else if (control_fd_[0] != -1) {
+        close(control_fd_[0]);
+        control_fd_[0] = -1;
+    }
+
+    is_active_ = false;
+    updateOperation(MessageBuffer(), 0, "closed");
+}
+
+bool CrossMemoryManager::isActive() const {
+    return is_active_;
+}
+
+void CrossMemoryManager::updateOperation(const MessageBuffer& msg, size_t bytes, const std::string& status) {
+    last_operation_.message = msg;
+    last_operation_.bytes = bytes;
+    last_operation_.status = status;
+    last_operation_.control_bytes = 0;
+    // tempo é preenchido na função chamadora
+}
+
+// Worker: aloca o buffer de recepção e manda endereço + capacidade pro pai
+bool CrossMemoryManager::sendRegion() {
+    region_.resize(capacity_);
+    CrossMemoryRegion region{ reinterpret_cast<uint64_t>(region_.data()), region_.size() };
+    std::string_view view(reinterpret_cast<const char*>(&region), sizeof(region));
+    MessageHeader header = makeHeader(MessageType::CONTROL, view, 0);
+    return writeFrame(control_fd_[0], header, view.data(), view.size()) != -1;
+}
+
+bool CrossMemoryManager::receiveRegion() {
+    MessageHeader header;
+    std::string error;
+    if (!readFrameInto(control_fd_[1], header, &remote_region_, sizeof(remote_region_), error) ||
+        header.length != sizeof(remote_region_) ||
+        !verifyPayload(header, std::string_view(reinterpret_cast<const char*>(&remote_region_), sizeof(remote_region_)))) {
+        logger_.error("Handshake com o worker falhou: " + (error.empty() ? "região inválida" : error), "CROSS_MEMORY");
+        return false;
+    }
+    return true;
+}
+
+bool CrossMemoryManager::sendAck(uint64_t sequence, int32_t error) {
+    CrossMemoryAck ack{ sequence, error, 0 };
+    std::string_view view(reinterpret_cast<const char*>(&ack), sizeof(ack));
+    MessageHeader header = makeHeader(MessageType::CONTROL, view, sequence);
+    return writeFrame(control_fd_[0], header, view.data(), view.size()) != -1;
+}
+
+// Lê um descritor, traz o payload (PULL) ou confere o que o pai já escreveu (PUSH)
+// e confirma. O payload fica no buffer de recepção - 'payload' aponta pra ele
+bool CrossMemoryManager::receiveFrame(std::string_view& payload, std::string& error) {
+    MessageHeader header;
+    CrossMemoryDescriptor descriptor;
+
+    while (true) {
+        if (!readFrameInto(control_fd_[0], header, &descriptor, sizeof(descriptor), error)) {
+            return false;
+        }
+        if (header.length != sizeof(descriptor) ||
+            !verifyPayload(header, std::string_view(reinterpret_cast<const char*>(&descriptor), sizeof(descriptor)))) {
+            // Sem descritor válido não dá pra confiar no endereço - descarta sem copiar
+            rx_tracker_.checksum_errors++;
+            logger_.warning("Descritor inválido no frame " + std::to_string(header.sequence), "CROSS_MEMORY_CHILD");
+            sendAck(header.sequence, -1);
+            continue;
+        }
+
+        int32_t copy_error = 0;
+        if (descriptor.length > region_.size()) {
+            copy_error = EMSGSIZE;
+        } else if (mode_ == CrossMemoryMode::PULL && descriptor.length > 0) {
+            struct iovec local = { region_.data(), descriptor.length };
+            struct iovec remote = { reinterpret_cast<void*>(descriptor.address), descriptor.length };
+            ssize_t copied = process_vm_readv(parent_pid_, &local, 1, &remote, 1, 0);
+            if (copied != static_cast<ssize_t>(descriptor.length)) {
+                copy_error = copied < 0 ? errno : EIO;
+            }
+        }
+
+        if (copy_error == 0 && computeChecksum(region_.data(), descriptor.length) != descriptor.checksum) {
+            rx_tracker_.checksum_errors++;
+            copy_error = -1;
+        }
+
+        if (!sendAck(header.sequence, copy_error)) {
+            error = std::string("ack: ") + strerror(errno);
+            return false;
+        }
+        if (copy_error != 0) {
+            logger_.warning("Mensagem " + std::to_string(header.sequence) + " descartada (erro " +
+                            std::to_string(copy_error) + ")", "CROSS_MEMORY_CHILD");
+            continue;
+        }
+        break;
+    }
+
+    uint64_t missing = rx_tracker_.observe(header, monotonicNowNs());
+    if (missing > 0) {
+        logger_.warning("Buraco na sequência: " + std::to_string(missing) + " mensagem(ns) perdida(s) antes de " +
+                        std::to_string(header.sequence), "CROSS_MEMORY_CHILD");
+    }
+
+    payload = std::string_view(region_.data(), descriptor.length);
+    last_operation_.sequence = header.sequence;
+    last_operation_.latency_us = rx_tracker_.last_latency_ns / 1000.0;
+    return true;
+}
+
+// Loop principal do worker - termina com EOF no socket de controle
+void CrossMemoryManager::runChildLoop() {
+    if (!sendRegion()) {
+        logger_.error("Falha ao anunciar a região de recepção", "CROSS_MEMORY_CHILD");
+        _exit(1);
+    }
+
+    while (true) {
+        std::string_view payload;
+        std::string error;
+
+        if (!receiveFrame(payload, error)) {
+            if (error == "eof") {
+                logger_.info("EOF recebido - coordenador fechou o controle", "CROSS_MEMORY_CHILD");
+            } else {
+                logger_.error("Erro no socket de controle: " + error, "CROSS_MEMORY_CHILD");
+            }
+            break;
+        }
+
+        // Só a prévia é copiada pro JSON; o payload inteiro fica no buffer de recepção
+        std::string_view preview = payload.substr(0, PREVIEW_BYTES);
+        updateOperation(MessageBuffer::copyOf(preview), payload.size(), "received");
+        printJSON();
+    }
+
+    if (control_fd_[0] != -1) {
+        close(control_fd_[0]);
+    }
+    // Worker não pode rodar os destrutores herdados do pai
+    _exit(0);
+}
+
+} // namespace ipc_project
@@ -0,0 +1,123 @@
+/**
+ * @file cross_memory_manager.h
+ * @brief Transferência direta entre espaços de endereçamento (process_vm_writev/readv)
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <sys/types.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "../common/logger.h"
+#include "../common/message_buffer.h"
+#include "../common/message_header.h"
+
+namespace ipc_project {
+
+// Quem faz a cópia entre os processos
+enum class CrossMemoryMode {
+    PUSH,   // coordenador escreve direto no buffer do worker (process_vm_writev)
+    PULL    // worker lê direto do buffer do coordenador (process_vm_readv)
+};
+
+std::string crossMemoryModeToString(CrossMemoryMode mode);
+bool stringToCrossMemoryMode(const std::string& str, CrossMemoryMode& mode);
+
+// Região de recepção que o worker anuncia no handshake
+struct CrossMemoryRegion {
+    uint64_t address;          // endereço do buffer no espaço do worker
+    uint64_t capacity;         // bytes disponíveis
+};
+
+// Descritor que viaja no socket de controle - o payload nunca passa por ele
+struct CrossMemoryDescriptor {
+    uint64_t address;          // PUSH: destino no worker / PULL: origem no coordenador
+    uint64_t length;           // bytes do payload
+    uint32_t checksum;         // CRC32C do payload (confere a cópia)
+    uint32_t reserved;
+};
+
+// Confirmação do worker - libera o buffer pra próxima mensagem
+struct CrossMemoryAck {
+    uint64_t sequence;         // sequência do descritor confirmado
+    int32_t error;             // 0 = ok, senão errno da cópia ou -1 (checksum)
+    uint32_t reserved;
+};
+
+// Estrutura pra guardar dados da transferência e mandar pro frontend
+struct CrossMemoryData {
+    MessageBuffer message;     // prévia do payload (no máximo PREVIEW_BYTES)
+    size_t bytes;              // bytes copiados entre os processos
+    size_t control_bytes;      // bytes que passaram pelo socket de controle
+    double time_ms;
+    std::string status;
+    std::string mode;
+    pid_t sender_pid;
+    pid_t receiver_pid;
+    uint64_t sequence = 0;     // sequência do envelope (MessageHeader)
+    double latency_us = 0.0;   // latência one-way medida no worker
+
+    std::string toJSON() const; // converte pra JSON
+};
+
+// Quarto mecanismo: o payload vai de um espaço de endereçamento pro outro numa
+// única cópia feita pelo kernel, sem mapeamento compartilhado por mensagem.
+// Só um descritor pequeno (envelope + endereço/tamanho) passa pelo socketpair
+class CrossMemoryManager {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 1 << 20;   // buffer de recepção do worker
+    static constexpr size_t PREVIEW_BYTES = 256;          // quanto do payload vai pro JSON
+
+    explicit CrossMemoryManager(CrossMemoryMode mode = CrossMemoryMode::PUSH,
+                                size_t capacity = DEFAULT_CAPACITY);
+    ~CrossMemoryManager();
+
+    bool createChannel();       // Cria socket de controle, faz fork e handshake
+    bool isParent() const;
+
+    // Comunicação
+    bool sendMessage(const std::string& message);    // Envia mensagem (pai) e espera o ack
+    bool sendMessage(const MessageBuffer& message);  // idem, sem copiar o payload no pai
+    std::string receiveMessage();                    // Recebe mensagem (filho)
+
+    // Monitoramento
+    CrossMemoryData getLastOperation() const;
+    void printJSON() const;
+    CrossMemoryMode getMode() const;
+    size_t getCapacity() const;
+
+    void closeChannel();        // Fecha o controle e espera o worker
+    bool isActive() const;
+
+private:
+    int control_fd_[2];          // [0] worker, [1] coordenador
+    pid_t child_pid_;
+    pid_t parent_pid_;
+    bool is_parent_;
+    bool is_active_;
+    CrossMemoryMode mode_;
+    size_t capacity_;
+
+    std::vector<char> region_;           // buffer de recepção (só no worker)
+    CrossMemoryRegion remote_region_;    // região anunciada pelo worker (pai)
+
+    CrossMemoryData last_operation_;
+    Logger& logger_;
+
+    uint64_t next_sequence_;     // próxima sequência do envelope (pai)
+    FrameTracker rx_tracker_;    // buracos/latência dos descritores recebidos (filho)
+
+    // Auxiliares
+    void updateOperation(const MessageBuffer& msg, size_t bytes, const std::string& status);
+    bool sendRegion();                                          // handshake (filho)
+    bool receiveRegion();                                       // handshake (pai)
+    bool receiveFrame(std::string_view& payload, std::string& error); // descritor + cópia + ack
+    bool sendAck(uint64_t sequence, int32_t error);
+    void runChildLoop();              // Loop principal do processo filho
+};
+
+} // namespace ipc_project
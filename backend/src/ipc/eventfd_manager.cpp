@@ -0,0 +1,399 @@
+/**
+ * @file eventfd_manager.cpp
+ * @brief Implementacao da campainha via eventfd
+ */
+
+#include "eventfd_manager.h"
+#include "../common/json_writer.h"
+#include <iostream>
+#include <cstring>
+#include <errno.h>
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+#include <new>
+#include <sys/eventfd.h>
+#include <sys/epoll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+
+namespace ipc_project {
+
+// Contadores numa página MAP_SHARED criada antes do fork: o filho escreve, o pai lê
+struct EventFdManager::SharedStats {
+    std::atomic<uint64_t> pending_since_ns;   // sinal mais antigo ainda não entregue (0 = nenhum)
+    std::atomic<uint64_t> signals_sent;
+    std::atomic<uint64_t> signals_received;
+    std::atomic<uint64_t> wakeups;
+    std::atomic<uint64_t> latency_samples;
+    std::atomic<uint64_t> latency_total_ns;
+    std::atomic<uint64_t> latency_max_ns;
+    std::atomic<uint32_t> stop;               // pai pede pro filho sair (junto com um sinal)
+};
+
+std::string EventFdConfig::toJSON() const {
+    return std::string("{\"mode\":\"") + (semaphore ? "semaphore" : "counter") + "\"}";
+}
+
+// Converte dados da operação atual pro formato JSON (mesmo formato de pipes/sockets)
+std::string EventFdData::toJSON() const {
+    std::string operation_type = "connect";
+    std::string status_type = "success";
+    if (status == "sent") {
+        operation_type = "write";
+    } else if (status == "received") {
+        operation_type = "read";
+    } else if (status.find("error") != std::string::npos) {
+        status_type = "error";
+    }
+
+    std::string out;
+    out.reserve(256 + message.size());
+    JSONWriter json(out);
+    json.beginObject()
+        .field("type", "eventfd")
+        .field("timestamp", isoTimestampNow())
+        .field("operation", operation_type)
+        .field("process_id", sender_pid)
+        .key("data").beginObject()
+            .field("message", message.view())
+            .field("count", count)
+            .field("mode", mode)
+            .field("time_ms", time_ms, 3)
+            .field("sender_pid", sender_pid)
+            .field("receiver_pid", receiver_pid)
+            .field("signals_sent", signals_sent)
+            .field("signals_received", signals_received)
+            .field("wakeups", wakeups)
+            .field("signals_per_s", signals_per_s, 3)
+            .field("avg_wakeup_latency_us", avg_wakeup_latency_us, 3)
+            .field("max_wakeup_latency_us", max_wakeup_latency_us, 3)
+        .endObject()
+        .field("status", status_type);
+    if (status_type == "error") json.field("error_message", status);
+    else json.nullField("error_message");
+    json.endObject();
+    return out;
+}
+
+bool sendFileDescriptor(int socket_fd, int fd) {
+    char byte = 0;
+    struct iovec iov = { &byte, 1 };   // precisa de pelo menos 1 byte de dado junto
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+
+    struct msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    std::memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+
+    return sendmsg(socket_fd, &msg, MSG_NOSIGNAL) == 1;
+}
+
+int receiveFileDescriptor(int socket_fd) {
+    char byte;
+    struct iovec iov = { &byte, 1 };
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+
+    struct msghdr msg{};
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    if (recvmsg(socket_fd, &msg, MSG_CMSG_CLOEXEC) != 1) {
+        return -1;
+    }
+    struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+    if (!cmsg || cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) {
+        return -1;
+    }
+    int fd;
+    std::memcpy(&fd, CMSG_DATA(cmsg), sizeof(int));
+    return fd;
+}
+
+EventFdManager::EventFdManager(const EventFdConfig& config)
+    : config_(config),
+      event_fd_(-1),
+      epoll_fd_(-1),
+      child_pid_(-1),
+      is_parent_(true),
+      is_active_(false),
+      stats_(nullptr),
+      started_ns_(0),
+      logger_(Logger::getInstance()) {
+
+    last_operation_.count = 0;
+    last_operation_.time_ms = 0.0;
+    last_operation_.status = "idle";
+    last_operation_.mode = config_.semaphore ? "semaphore" : "counter";
+    last_operation_.sender_pid = getpid();
+    last_operation_.receiver_pid = -1;
+
+    logger_.info("EventFdManager criado (modo " + last_operation_.mode + ")", "EVENTFD");
+}
+
+EventFdManager::~EventFdManager() {
+    closeDoorbell();
+    logger_.debug("EventFdManager destruído", "EVENTFD");
+}
+
+// eventfd + página de estatísticas antes do fork - o filho herda os dois
+bool EventFdManager::createDoorbell() {
+    logger_.info("Criando campainha eventfd", "EVENTFD");
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    event_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK | (config_.semaphore ? EFD_SEMAPHORE : 0));
+    if (event_fd_ == -1) {
+        updateOperation(MessageBuffer(), 0, "error_create");
+        logger_.error("Erro ao criar eventfd: " + std::string(strerror(errno)), "EVENTFD");
+        return false;
+    }
+
+    void* page = mmap(nullptr, sizeof(SharedStats), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (page == MAP_FAILED) {
+        close(event_fd_);
+        event_fd_ = -1;
+        updateOperation(MessageBuffer(), 0, "error_mmap");
+        logger_.error("Erro ao mapear estatísticas: " + std::string(strerror(errno)), "EVENTFD");
+        return false;
+    }
+    stats_ = new (page) SharedStats{};
+    started_ns_ = monotonicNowNs();
+
+    child_pid_ = fork();
+
+    if (child_pid_ == -1) {
+        munmap(stats_, sizeof(SharedStats));
+        stats_ = nullptr;
+        close(event_fd_);
+        event_fd_ = -1;
+        updateOperation(MessageBuffer(), 0, "error_fork");
+        logger_.error("Erro ao fazer fork: " + std::string(strerror(errno)), "EVENTFD");
+        return false;
+    }
+
+    if (child_pid_ == 0) {
+        // Processo filho - só espera sinais
+        is_parent_ = false;
+        last_operation_.sender_pid = getppid();
+        last_operation_.receiver_pid = getpid();
+        is_active_ = true;
+
+        logger_.info("Processo filho da campainha iniciado", "EVENTFD_CHILD");
+        runChildLoop();
+    }
+
+    is_active_ = true;
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    last_operation_.sender_pid = getpid();
+    last_operation_.receiver_pid = child_pid_;
+    updateOperation(MessageBuffer(), 0, "ready");
+    last_operation_.time_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    logger_.info("Campainha criada (fd " + std::to_string(event_fd_) + "), filho PID " +
+                 std::to_string(child_pid_), "EVENTFD");
+    return true;
+}
+
+bool EventFdManager::isParent() const {
+    return is_parent_;
+}
+
+// Marca o instante do sinal pendente mais antigo e soma no contador.
+// Um write de 8 bytes - nada de payload, framing ou cópia
+bool EventFdManager::ring(uint64_t count) {
+    if (!is_active_ || !is_parent_ || event_fd_ == -1 || count == 0) {
+        updateOperation(MessageBuffer(), 0, "error_invalid_state");
+        logger_.error("Tentativa de sinalização inválida", "EVENTFD");
+        return false;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    uint64_t expected = 0;
+    stats_->pending_since_ns.compare_exchange_strong(expected, monotonicNowNs());
+
+    if (eventfd_write(event_fd_, count) == -1) {
+        // EAGAIN: contador chegaria no máximo (0xfffffffffffffffe) - o filho está parado
+        updateOperation(MessageBuffer(), 0, errno == EAGAIN ? "error_counter_full" : "error_write");
+        logger_.error("Erro no write do eventfd: " + std::string(strerror(errno)), "EVENTFD");
+        return false;
+    }
+    stats_->signals_sent.fetch_add(count, std::memory_order_relaxed);
+
+    auto end = std::chrono::high_resolution_clock::now();
+    updateOperation(MessageBuffer(), count, "sent");
+    last_operation_.time_ms = std::chrono::duration<double, std::milli>(end - start).count();
+    return true;
+}
+
+bool EventFdManager::sendMessage(const std::string& note) {
+    return sendMessage(MessageBuffer::copyOf(note));
+}
+
+bool EventFdManager::sendMessage(const MessageBuffer& note) {
+    if (!ring(1)) {
+        return false;
+    }
+    last_operation_.message = note;
+
+    logger_.info("Sinal enviado: '" + note.str() + "'", "EVENTFD");
+    printJSON(); // envia resultado pro frontend via stdout
+    return true;
+}
+
+// Junta os contadores da página compartilhada com a última operação local
+EventFdData EventFdManager::getLastOperation() const {
+    EventFdData data = last_operation_;
+    if (!stats_) {
+        return data;
+    }
+
+    data.signals_sent = stats_->signals_sent.load();
+    data.signals_received = stats_->signals_received.load();
+    data.wakeups = stats_->wakeups.load();
+
+    double elapsed_s = (monotonicNowNs() - started_ns_) / 1e9;
+    data.signals_per_s = elapsed_s > 0.0 ? data.signals_sent / elapsed_s : 0.0;
+
+    uint64_t samples = stats_->latency_samples.load();
+    if (samples > 0) {
+        data.avg_wakeup_latency_us = stats_->latency_total_ns.load() / 1000.0 / samples;
+        data.max_wakeup_latency_us = stats_->latency_max_ns.load() / 1000.0;
+    }
+    return data;
+}
+
+void EventFdManager::printJSON() const {
+    std::cout << "EVENTFD_JSON:" << getLastOperation().toJSON() << std::endl;
+    std::cout.flush();
+}
+
+const EventFdConfig& EventFdManager::getConfig() const {
+    return config_;
+}
+
+int EventFdManager::getFd() const {
+    return event_fd_;
+}
+
+pid_t EventFdManager::getChildPid() const {
+    return child_pid_;
+}
+
+void EventFdManager::closeDoorbell() {
+    if (!is_active_) return;
+
+    logger_.info("Fechando campainha", is_parent_ ? "EVENTFD" : "EVENTFD_CHILD");
+
+    if (is_parent_) {
+        // Flag de parada + um sinal pra acordar o epoll do filho
+        if (stats_ && child_pid_ > 0) {
+            stats_->stop.store(1, std::memory_order_seq_cst);
+            if (eventfd_write(event_fd_, 1) == -1) {
+                kill(child_pid_, SIGTERM);
+            }
+        }
+        if (child_pid_ > 0) {
+            int status;
+            waitpid(child_pid_, &status, 0);
+            child_pid_ = -1;
+        }
+        // Congela as estatísticas pro último JSON antes de soltar a página
+        last_operation_ = getLastOperation();
+        if (stats_) {
+            munmap(stats_, sizeof(SharedStats));
+            stats_ = nullptr;
+        }
+    } else if (epoll_fd_ != -1) {
+        close(epoll_fd_);
+        epoll_fd_ = -1;
+    }
+
+    if (event_fd_ != -1) {
+        close(event_fd_);
+        event_fd_ = -1;
+    }
+
+    is_active_ = false;
+    updateOperation(MessageBuffer(), 0, "closed");
+}
+
+bool EventFdManager::isActive() const {
+    return is_active_;
+}
+
+void EventFdManager::updateOperation(const MessageBuffer& msg, uint64_t count, const std::string& status) {
+    last_operation_.message = msg;
+    last_operation_.count = count;
+    last_operation_.status = status;
+    // tempo é preenchido na função chamadora
+}
+
+// Loop principal do filho: dorme no epoll, drena o contador a cada wakeup.
+// No modo contador um read devolve a soma; no semáforo cada read devolve 1
+void EventFdManager::runChildLoop() {
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    struct epoll_event event{};
+    event.events = EPOLLIN;
+    if (epoll_fd_ == -1 || epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, event_fd_, &event) == -1) {
+        logger_.error("Erro ao registrar o eventfd no epoll: " + std::string(strerror(errno)), "EVENTFD_CHILD");
+        _exit(1);
+    }
+
+    while (!stats_->stop.load(std::memory_order_seq_cst)) {
+        struct epoll_event ready;
+        int n = epoll_wait(epoll_fd_, &ready, 1, -1);
+        if (n == -1) {
+            if (errno == EINTR) continue;
+            logger_.error("Erro no epoll: " + std::string(strerror(errno)), "EVENTFD_CHILD");
+            break;
+        }
+
+        uint64_t woke_ns = monotonicNowNs();
+        // Pega o pendente antes de drenar - sinais depois disso marcam um novo instante
+        uint64_t pending_since = stats_->pending_since_ns.exchange(0, std::memory_order_acq_rel);
+
+        uint64_t received = 0;
+        eventfd_t value;
+        while (eventfd_read(event_fd_, &value) == 0) {
+            received += value;
+        }
+        if (received == 0) continue;   // outro leitor (fd compartilhado) já drenou
+
+        if (stats_->stop.load(std::memory_order_seq_cst)) break;
+
+        stats_->signals_received.fetch_add(received, std::memory_order_relaxed);
+        stats_->wakeups.fetch_add(1, std::memory_order_relaxed);
+        if (pending_since != 0 && woke_ns > pending_since) {
+            uint64_t latency = woke_ns - pending_since;
+            stats_->latency_samples.fetch_add(1, std::memory_order_relaxed);
+            stats_->latency_total_ns.fetch_add(latency, std::memory_order_relaxed);
+            if (latency > stats_->latency_max_ns.load(std::memory_order_relaxed)) {
+                stats_->latency_max_ns.store(latency, std::memory_order_relaxed);
+            }
+        }
+
+        updateOperation(MessageBuffer(), received, "received");
+        printJSON();
+    }
+
+    closeDoorbell();
+    // Filho não pode rodar os destrutores herdados do pai
+    _exit(0);
+}
+
+} // namespace ipc_project
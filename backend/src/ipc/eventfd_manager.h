@@ -0,0 +1,96 @@
+/**
+ * @file eventfd_manager.h
+ * @brief Campainha (doorbell) via eventfd - notificação entre processos sem payload
+ */
+
+#pragma once
+
+#include <string>
+#include <cstdint>
+#include <sys/types.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "../common/logger.h"
+#include "../common/message_buffer.h"
+#include "../common/message_header.h"
+
+namespace ipc_project {
+
+// Como o contador do eventfd é consumido
+struct EventFdConfig {
+    bool semaphore = false;    // EFD_SEMAPHORE: cada read consome 1 sinal em vez do contador inteiro
+
+    std::string toJSON() const;
+};
+
+// Estrutura pra guardar dados da operação e mandar pro frontend
+struct EventFdData {
+    MessageBuffer message;          // nota do envio (não trafega - a campainha não tem payload)
+    uint64_t count;                 // sinais somados no último write / lidos no último wakeup
+    double time_ms;
+    std::string status;
+    std::string mode;               // "counter" ou "semaphore"
+    pid_t sender_pid;
+    pid_t receiver_pid;
+    uint64_t signals_sent = 0;
+    uint64_t signals_received = 0;
+    uint64_t wakeups = 0;           // vezes que o epoll do filho acordou
+    double signals_per_s = 0.0;     // sinais enviados por segundo desde o start
+    double avg_wakeup_latency_us = 0.0;  // do sinal pendente mais antigo até o filho acordar
+    double max_wakeup_latency_us = 0.0;
+
+    std::string toJSON() const; // converte pra JSON
+};
+
+// Passa um descritor pra outro processo num socket AF_UNIX (SCM_RIGHTS)
+bool sendFileDescriptor(int socket_fd, int fd);
+int receiveFileDescriptor(int socket_fd);   // -1 em erro
+
+// Sexto mecanismo: só sinaliza ("tem dado novo", "faz flush") - um write de
+// 8 bytes num eventfd. O filho herda o fd e espera nele via epoll; sinais
+// seguidos se acumulam no contador e são entregues num wakeup só.
+// Estatísticas ficam numa página compartilhada, então o pai lê sem canal de volta
+class EventFdManager {
+public:
+    explicit EventFdManager(const EventFdConfig& config = EventFdConfig());
+    ~EventFdManager();
+
+    bool createDoorbell();      // Cria o eventfd e faz fork do filho que espera nele
+    bool isParent() const;
+
+    // Sinalização
+    bool ring(uint64_t count = 1);                // Soma 'count' no contador (pai)
+    bool sendMessage(const std::string& note);    // ring(1) - a nota só vai pro log/JSON
+    bool sendMessage(const MessageBuffer& note);
+
+    // Monitoramento
+    EventFdData getLastOperation() const;
+    void printJSON() const;
+    const EventFdConfig& getConfig() const;
+    int getFd() const;          // pra registrar em outro epoll ou passar via SCM_RIGHTS
+    pid_t getChildPid() const;
+
+    void closeDoorbell();       // Para o filho e fecha o fd
+    bool isActive() const;
+
+private:
+    struct SharedStats;         // contadores na página compartilhada (definido no .cpp)
+
+    EventFdConfig config_;
+    int event_fd_;
+    int epoll_fd_;
+    pid_t child_pid_;
+    bool is_parent_;
+    bool is_active_;
+    SharedStats* stats_;
+    uint64_t started_ns_;
+
+    EventFdData last_operation_;
+    Logger& logger_;
+
+    // Auxiliares
+    void updateOperation(const MessageBuffer& msg, uint64_t count, const std::string& status);
+    void runChildLoop();              // Loop principal do processo filho
+};
+
+} // namespace ipc_project
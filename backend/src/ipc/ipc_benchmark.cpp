@@ -0,0 +1,123 @@
+/**
+ * @file ipc_benchmark.cpp
+ * @brief Implementação do harness de benchmark dos mecanismos IPC
+ */
+
+#include "ipc_benchmark.h"
+#include <algorithm>
+#include <chrono>
+
+namespace ipc_project {
+
+namespace {
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+} // namespace
+
+std::string BenchmarkResult::toJSON() const {
+    std::string out;
+    JSONWriter json(out);
+    writeJSON(json);
+    return out;
+}
+
+void BenchmarkResult::writeJSON(JSONWriter& json) const {
+    json.beginObject()
+        .field("mechanism", mechanism)
+        .field("message_size", message_size)
+        .field("messages", messages)
+        .field("failures", failures)
+        .field("total_ms", total_ms, 3)
+        .field("messages_per_s", messages_per_s, 3)
+        .field("throughput_mb_s", throughput_mb_s, 3)
+        .field("avg_us", avg_us, 3)
+        .field("p50_us", p50_us, 3)
+        .field("p99_us", p99_us, 3)
+        .field("max_us", max_us, 3)
+        .endObject();
+}
+
+std::vector<BenchmarkResult> runBenchmark(IPCCoordinator& coordinator, const BenchmarkConfig& config) {
+    Logger& logger = Logger::getInstance();
+    std::vector<BenchmarkResult> results;
+
+    // Um buffer só pra todos os envios - nenhum mecanismo paga alocação por mensagem
+    MessageBuffer payload = MessageBuffer::copyOf(std::string(config.message_size, 'x'));
+
+    for (IPCMechanism mechanism : config.mechanisms) {
+        BenchmarkResult result;
+        result.mechanism = coordinator.getMechanismStatus(mechanism).name;
+        result.message_size = config.message_size;
+
+        if (!coordinator.startMechanism(mechanism)) {
+            logger.error("Benchmark: falha ao iniciar " + result.mechanism, "BENCHMARK");
+            result.failures = config.messages;
+            results.push_back(result);
+            continue;
+        }
+
+        for (size_t i = 0; i < config.warmup; ++i) {
+            coordinator.sendMessage(mechanism, payload);
+        }
+
+        std::vector<double> samples;
+        samples.reserve(config.messages);
+        auto begin = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < config.messages; ++i) {
+            auto start = std::chrono::steady_clock::now();
+            bool ok = coordinator.sendMessage(mechanism, payload);
+            auto end = std::chrono::steady_clock::now();
+            if (ok) {
+                samples.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+            } else {
+                result.failures++;
+            }
+        }
+        result.total_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+        coordinator.stopMechanism(mechanism);
+
+        result.messages = samples.size();
+        if (!samples.empty()) {
+            double seconds = result.total_ms / 1000.0;
+            result.messages_per_s = static_cast<double>(samples.size()) / seconds;
+            result.throughput_mb_s = static_cast<double>(samples.size() * config.message_size) / (1024.0 * 1024.0) / seconds;
+
+            double sum = 0.0;
+            for (double s : samples) sum += s;
+            result.avg_us = sum / static_cast<double>(samples.size());
+
+            std::sort(samples.begin(), samples.end());
+            result.p50_us = percentile(samples, 0.50);
+            result.p99_us = percentile(samples, 0.99);
+            result.max_us = samples.back();
+        }
+
+        logger.info("Benchmark " + result.mechanism + ": " + result.toJSON(), "BENCHMARK");
+        results.push_back(result);
+    }
+
+    return results;
+}
+
+std::future<std::vector<BenchmarkResult>> runBenchmarkAsync(IPCCoordinator& coordinator, const BenchmarkConfig& config) {
+    return coordinator.runAsync([&coordinator, config] { return runBenchmark(coordinator, config); });
+}
+
+std::string benchmarkToJSON(const std::vector<BenchmarkResult>& results) {
+    std::string out;
+    JSONWriter json(out);
+    json.beginObject().key("results").beginArray();
+    for (const auto& result : results) {
+        result.writeJSON(json);
+    }
+    json.endArray().endObject();
+    return out;
+}
+
+} // namespace ipc_project
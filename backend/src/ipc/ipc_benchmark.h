@@ -0,0 +1,47 @@
+/**
+ * @file ipc_benchmark.h
+ * @brief Harness único pra comparar os mecanismos IPC com a mesma carga
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "ipc_coordinator.h"
+
+namespace ipc_project {
+
+// Carga do benchmark - a mesma mensagem é enviada N vezes em cada mecanismo
+struct BenchmarkConfig {
+    std::vector<IPCMechanism> mechanisms{ALL_MECHANISMS.begin(), ALL_MECHANISMS.end()};
+    size_t message_size = 1024;  // bytes por mensagem
+    size_t messages = 1000;      // envios medidos por mecanismo
+    size_t warmup = 50;          // envios descartados antes da medição
+};
+
+// Resultado de um mecanismo. Latência = chamada sendMessage do coordenador
+// (lane + transporte); pra cross_memory inclui o ack do worker
+struct BenchmarkResult {
+    std::string mechanism;
+    size_t message_size = 0;
+    size_t messages = 0;
+    size_t failures = 0;         // envios recusados (ex.: mensagem maior que o limite do mecanismo)
+    double total_ms = 0.0;
+    double messages_per_s = 0.0;
+    double throughput_mb_s = 0.0;
+    double avg_us = 0.0;
+    double p50_us = 0.0;
+    double p99_us = 0.0;
+    double max_us = 0.0;
+
+    std::string toJSON() const;
+    void writeJSON(JSONWriter& json) const;
+};
+
+// Liga cada mecanismo, mede e desliga de novo. O coordenador precisa estar inicializado
+std::vector<BenchmarkResult> runBenchmark(IPCCoordinator& coordinator, const BenchmarkConfig& config);
+// Mesma coisa no executor do coordenador - quem chamou (ex.: handler HTTP) não fica preso
+std::future<std::vector<BenchmarkResult>> runBenchmarkAsync(IPCCoordinator& coordinator, const BenchmarkConfig& config);
+std::string benchmarkToJSON(const std::vector<BenchmarkResult>& results);
+
+} // namespace ipc_project
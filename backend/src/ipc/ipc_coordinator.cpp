@@ -4,10 +4,14 @@
  */
 
 #include "ipc_coordinator.h"
+#include "../common/json_parser.h"
+#include "../common/json_writer.h"
 #include <chrono>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
+#include <random>
+#include <cstdio>
 #include <csignal>
 
 namespace ipc_project {
@@ -17,74 +21,149 @@ IPCCoordinator* IPCCoordinator::instance_ = nullptr;
 
 // Implementação das estruturas
 
+std::string priorityToString(MessagePriority priority) {
+    switch (priority) {
+        case MessagePriority::CRITICAL: return "critical";
+        case MessagePriority::NORMAL: return "normal";
+        case MessagePriority::BULK: return "bulk";
+        default: return "unknown";
+    }
+}
+
+bool stringToPriority(const std::string& str, MessagePriority& priority) {
+    if (str == "critical") { priority = MessagePriority::CRITICAL; return true; }
+    if (str == "normal") { priority = MessagePriority::NORMAL; return true; }
+    if (str == "bulk") { priority = MessagePriority::BULK; return true; }
+    return false;
+}
+
+// Nomes aceitos na API, no modo interativo e nas opções (com os apelidos)
+bool stringToMechanism(std::string_view str, IPCMechanism& mechanism) {
+    if (str == "pipes") { mechanism = IPCMechanism::PIPES; return true; }
+    if (str == "sockets") { mechanism = IPCMechanism::SOCKETS; return true; }
+    if (str == "shared_memory" || str == "shmem") { mechanism = IPCMechanism::SHARED_MEMORY; return true; }
+    if (str == "cross_memory") { mechanism = IPCMechanism::CROSS_MEMORY; return true; }
+    if (str == "message_queue" || str == "mqueue") { mechanism = IPCMechanism::MESSAGE_QUEUE; return true; }
+    if (str == "eventfd") { mechanism = IPCMechanism::EVENTFD; return true; }
+    if (str == "tcp_bridge") { mechanism = IPCMechanism::TCP_BRIDGE; return true; }
+    return false;
+}
+
+unsigned int toQueuePriority(MessagePriority priority) {
+    switch (priority) {
+        case MessagePriority::CRITICAL: return MessageQueueManager::PRIORITY_CRITICAL;
+        case MessagePriority::BULK: return MessageQueueManager::PRIORITY_BULK;
+        default: return MessageQueueManager::PRIORITY_NORMAL;
+    }
+}
+
+std::string LaneStats::toJSON() const {
+    std::string out;
+    JSONWriter json(out);
+    writeJSON(json);
+    return out;
+}
+
+void LaneStats::writeJSON(JSONWriter& json) const {
+    json.beginObject()
+        .field("priority", priorityToString(priority))
+        .field("queued", queued)
+        .field("sent", sent)
+        .field("failed", failed)
+        .field("avg_wait_us", avg_wait_us)
+        .field("max_wait_us", max_wait_us)
+        .field("avg_latency_us", avg_latency_us)
+        .endObject();
+}
+
 std::string MechanismStatus::toJSON() const {
-    std::stringstream json;
-    json << "{"
-         << "\"type\":\"" << static_cast<int>(type) << "\","
-         << "\"name\":\"" << name << "\","
-         << "\"is_active\":" << (is_active ? "true" : "false") << ","
-         << "\"is_running\":" << (is_running ? "true" : "false") << ","
-         << "\"process_pid\":" << process_pid << ","
-         << "\"last_error\":\"" << last_error << "\","
-         << "\"last_operation\":\"" << last_operation << "\","
-         << "\"uptime_ms\":" << uptime_ms << ","
-         << "\"messages_sent\":" << messages_sent << ","
-         << "\"messages_received\":" << messages_received
-         << "}";
-    return json.str();
+    std::string out;
+    out.reserve(512);
+    JSONWriter json(out);
+    writeJSON(json);
+    return out;
+}
+
+void MechanismStatus::writeJSON(JSONWriter& json) const {
+    json.beginObject()
+        .field("type", std::to_string(static_cast<int>(type)))
+        .field("name", name)
+        .field("is_active", is_active)
+        .field("is_running", is_running)
+        .field("process_pid", process_pid)
+        .field("last_error", last_error)
+        .field("last_operation", last_operation)
+        .field("uptime_ms", uptime_ms)
+        .field("messages_sent", messages_sent)
+        .field("messages_received", messages_received)
+        .key("lanes").beginArray();
+    for (const auto& lane : lanes) {
+        lane.writeJSON(json);
+    }
+    json.endArray().endObject();
 }
 
 std::string CoordinatorStatus::toJSON() const {
-    std::stringstream json;
-    json << "{"
-         << "\"mechanisms\":[";
-    
-    for (size_t i = 0; i < mechanisms.size(); ++i) {
-        json << mechanisms[i].toJSON();
-        if (i < mechanisms.size() - 1) json << ",";
+    std::string out;
+    out.reserve(512 * (mechanisms.size() + 1));
+    JSONWriter json(out);
+    json.beginObject().key("mechanisms").beginArray();
+    for (const auto& mechanism : mechanisms) {
+        mechanism.writeJSON(json);
     }
-    
-    json << "],"
-         << "\"all_active\":" << (all_active ? "true" : "false") << ","
-         << "\"total_processes\":" << total_processes << ","
-         << "\"startup_time\":\"" << startup_time << "\","
-         << "\"total_uptime_ms\":" << total_uptime_ms << ","
-         << "\"status\":\"" << status << "\""
-         << "}";
-    return json.str();
+    json.endArray()
+        .field("all_active", all_active)
+        .field("total_processes", total_processes)
+        .field("startup_time", startup_time)
+        .field("total_uptime_ms", total_uptime_ms)
+        .field("status", status)
+        .endObject();
+    return out;
+}
+
+std::string IPCEvent::toJSON() const {
+    std::string out;
+    out.reserve(160 + detail.size());
+    JSONWriter json(out);
+    writeJSON(json);
+    return out;
+}
+
+void IPCEvent::writeJSON(JSONWriter& json) const {
+    json.beginObject()
+        .field("id", id)
+        .field("mechanism", mechanism_name)
+        .field("type", type)
+        .field("detail", detail)
+        .field("timestamp", timestamp)
+        .endObject();
 }
 
 bool IPCCommand::fromJSON(const std::string& json) {
-    // Parsing JSON melhorado com validação mais robusta
-    
-    // Verifica se JSON tem estrutura mínima válida
-    if (json.empty() || json.find("{") == std::string::npos || json.find("}") == std::string::npos) {
+    // Passada única pelo parser SAX: aceita qualquer ordem de chaves, espaços
+    // e escapes. Campos desconhecidos vão pra parameters.
+    std::string action_value;
+    std::string mechanism_value;
+    std::string priority_value;
+    message.clear();
+    parameters.clear();
+
+    bool parsed = forEachField(json, [&](std::string_view key, const JSONField& field) {
+        if (key == "action" || key == "mechanism" || key == "message" || key == "priority") {
+            if (field.type != JSONType::STRING) return false;   // tipo errado invalida o comando
+            if (key == "action") action_value.assign(field.text);
+            else if (key == "mechanism") mechanism_value.assign(field.text);
+            else if (key == "message") message.assign(field.text);
+            else priority_value.assign(field.text);
+        } else if (field.type != JSONType::NULL_VALUE) {
+            parameters[std::string(key)] = std::string(field.text);
+        }
+        return true;
+    });
+    if (!parsed) {
         return false;
     }
-    
-    // Helper lambda para extrair valor de string JSON de forma mais segura
-    auto extractStringValue = [&json](const std::string& key) -> std::string {
-        std::string search_pattern = "\"" + key + "\":\"";
-        size_t start = json.find(search_pattern);
-        if (start == std::string::npos) return "";
-        
-        start += search_pattern.length();
-        size_t end = start;
-        
-        // Procura o fechamento da string, ignorando escapes
-        while (end < json.length()) {
-            if (json[end] == '"' && (end == start || json[end-1] != '\\')) {
-                break;
-            }
-            end++;
-        }
-        
-        if (end >= json.length()) return "";
-        return json.substr(start, end - start);
-    };
-    
-    // Extrai action
-    std::string action_value = extractStringValue("action");
+
     if (action_value.empty()) {
         return false; // action é obrigatório
     }
@@ -97,21 +176,17 @@ bool IPCCommand::fromJSON(const std::string& json) {
         return false; // action inválida
     }
     
-    // Extrai mechanism
-    std::string mechanism_value = extractStringValue("mechanism");
-    if (mechanism_value == "pipes") {
-        mechanism = IPCMechanism::PIPES;
-    } else if (mechanism_value == "sockets") {
-        mechanism = IPCMechanism::SOCKETS;
-    } else if (mechanism_value == "shared_memory") {
-        mechanism = IPCMechanism::SHARED_MEMORY;
-    } else {
+    // Mapeia mechanism
+    if (!stringToMechanism(mechanism_value, mechanism)) {
         // Se não especificado, usa PIPES como padrão apenas para comandos que não precisam de mechanism
         mechanism = IPCMechanism::PIPES;
     }
     
-    // Extrai message (opcional)
-    message = extractStringValue("message");
+    // priority é opcional, padrão normal
+    priority = MessagePriority::NORMAL;
+    if (!priority_value.empty() && !stringToPriority(priority_value, priority)) {
+        return false; // prioridade desconhecida
+    }
     
     // Validação adicional baseada na action
     if ((action == "start" || action == "stop") && mechanism_value.empty()) {
@@ -126,13 +201,16 @@ bool IPCCommand::fromJSON(const std::string& json) {
 }
 
 std::string IPCCommand::toJSON() const {
-    std::stringstream json;
-    json << "{"
-         << "\"action\":\"" << action << "\","
-         << "\"mechanism\":\"" << static_cast<int>(mechanism) << "\","
-         << "\"message\":\"" << message << "\""
-         << "}";
-    return json.str();
+    std::string out;
+    out.reserve(96 + message.size());
+    JSONWriter json(out);
+    json.beginObject()
+        .field("action", action)
+        .field("mechanism", std::to_string(static_cast<int>(mechanism)))
+        .field("message", message)
+        .field("priority", priorityToString(priority))
+        .endObject();
+    return out;
 }
 
 // Implementação da classe principal
@@ -140,25 +218,42 @@ std::string IPCCommand::toJSON() const {
 IPCCoordinator::IPCCoordinator() 
     : is_running_(false)
     , shutdown_requested_(false)
+    , busy_poll_enabled_(false)
+    , cross_memory_mode_(CrossMemoryMode::PUSH)
+    , cross_memory_capacity_(CrossMemoryManager::DEFAULT_CAPACITY)
+    , executor_(std::make_shared<WorkStealingExecutor>())
+    , async_in_flight_(0)
     , startup_time_(getCurrentTimestamp())
     , logger_(Logger::getInstance()) {
     
     instance_ = this;
     
-    // Inicializa status dos mecanismos como inativos
-    mechanism_status_[IPCMechanism::PIPES] = false;
-    mechanism_status_[IPCMechanism::SOCKETS] = false;
-    mechanism_status_[IPCMechanism::SHARED_MEMORY] = false;
+    // Sem isso um cliente que guardou W/"status-3" de antes do restart recebe
+    // 304 pra um estado que não é o mesmo
+    std::random_device entropy;
+    uint64_t boot = (static_cast<uint64_t>(entropy()) << 32) ^ entropy() ^
+                    static_cast<uint64_t>(std::chrono::system_clock::now().time_since_epoch().count());
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(boot));
+    boot_tag_ = hex;
+    
+    // Inicializa status dos mecanismos como inativos e zera os contadores de mensagens
+    for (IPCMechanism mech : ALL_MECHANISMS) {
+        mechanism_status_[mech] = false;
+        message_counts_[mech] = 0;
+    }
     
-    // Inicializa contadores de mensagens
-    message_counts_[IPCMechanism::PIPES] = 0;
-    message_counts_[IPCMechanism::SOCKETS] = 0;
-    message_counts_[IPCMechanism::SHARED_MEMORY] = 0;
+    // Cria as lanes de prioridade de cada canal (despachantes sobem no initialize)
+    for (const auto& pair : mechanism_status_) {
+        channel_lanes_[pair.first] = std::make_unique<ChannelLanes>();
+    }
     
     logger_.info("IPCCoordinator inicializado", "COORDINATOR");
 }
 
 IPCCoordinator::~IPCCoordinator() {
+    stopBridgeListener();   // listener pode ter subido sem initialize
+    waitForAsync();         // tarefas de fundo usam o coordenador
     shutdown();
     instance_ = nullptr;
 }
@@ -172,13 +267,19 @@ bool IPCCoordinator::initialize() {
         // Inicializa os managers
         pipe_manager_ = std::make_unique<PipeManager>();
         socket_manager_ = std::make_unique<SocketManager>(); 
-        shmem_manager_ = std::make_unique<SharedMemoryManager>();
+        shmem_manager_ = std::make_unique<SharedMemoryManager>(shmem_config_);
+        cross_memory_manager_ = std::make_unique<CrossMemoryManager>(cross_memory_mode_, cross_memory_capacity_);
+        message_queue_manager_ = std::make_unique<MessageQueueManager>(message_queue_config_);
+        eventfd_manager_ = std::make_unique<EventFdManager>(eventfd_config_);
         
         logger_.info("Managers criados com sucesso", "COORDINATOR");
         
         is_running_ = true;
+        shutdown_requested_ = false;
         startup_time_ = getCurrentTimestamp();
         
+        startLaneDispatchers();
+        
         logger_.info("Coordenador IPC inicializado com sucesso", "COORDINATOR");
         return true;
         
@@ -194,18 +295,16 @@ void IPCCoordinator::shutdown() {
     logger_.info("Iniciando shutdown do coordenador...", "COORDINATOR");
     shutdown_requested_ = true;
     
-    // Para todos os mecanismos
-    stopMechanism(IPCMechanism::PIPES);
-    stopMechanism(IPCMechanism::SOCKETS);
-    stopMechanism(IPCMechanism::SHARED_MEMORY);
+    // Para de aceitar mensagens de coordenadores remotos antes de derrubar os mecanismos
+    stopBridgeListener();
     
-    // Espera threads de monitoramento terminarem
-    for (auto& thread : monitoring_threads_) {
-        if (thread.joinable()) {
-            thread.join();
-        }
+    // Despachantes param primeiro - envios pendentes são descartados
+    stopLaneDispatchers();
+    
+    // Para todos os mecanismos
+    for (IPCMechanism mech : ALL_MECHANISMS) {
+        stopMechanism(mech);
     }
-    monitoring_threads_.clear();
     
     // Mata processos filhos se ainda estiverem vivos
     killAllChildren();
@@ -243,6 +342,18 @@ bool IPCCoordinator::startMechanism(IPCMechanism mechanism) {
             case IPCMechanism::SHARED_MEMORY:
                 success = initializeSharedMemory();
                 break;
+            case IPCMechanism::CROSS_MEMORY:
+                success = initializeCrossMemory();
+                break;
+            case IPCMechanism::MESSAGE_QUEUE:
+                success = initializeMessageQueue();
+                break;
+            case IPCMechanism::EVENTFD:
+                success = initializeEventFd();
+                break;
+            case IPCMechanism::TCP_BRIDGE:
+                success = initializeTcpBridge();
+                break;
         }
         
         if (success) {
@@ -250,12 +361,14 @@ bool IPCCoordinator::startMechanism(IPCMechanism mechanism) {
             logMechanismActivity(mechanism, "started");
             logger_.info(mech_name + " started successfully", "COORDINATOR");
         } else {
+            logMechanismActivity(mechanism, "error", "start failed");
             logger_.error("Failed to start " + mech_name, "COORDINATOR");
         }
         
         return success;
         
     } catch (const std::exception& e) {
+        logMechanismActivity(mechanism, "error", std::string("start failed: ") + e.what());
         logger_.error("Exception starting " + mech_name + ": " + e.what(), "COORDINATOR");
         return false;
     }
@@ -285,6 +398,28 @@ bool IPCCoordinator::stopMechanism(IPCMechanism mechanism) {
                     shmem_manager_->destroySharedMemory();
                 }
                 break;
+            case IPCMechanism::CROSS_MEMORY:
+                if (cross_memory_manager_ && cross_memory_manager_->isActive()) {
+                    cross_memory_manager_->closeChannel();
+                }
+                break;
+            case IPCMechanism::MESSAGE_QUEUE:
+                if (message_queue_manager_ && message_queue_manager_->isActive()) {
+                    message_queue_manager_->closeQueue();
+                }
+                break;
+            case IPCMechanism::EVENTFD:
+                if (eventfd_manager_ && eventfd_manager_->isActive()) {
+                    eventfd_manager_->closeDoorbell();
+                }
+                break;
+            case IPCMechanism::TCP_BRIDGE:
+                // Dá uma chance pro que está em voo receber ack antes de fechar
+                if (bridge_link_ && bridge_link_->isRunning()) {
+                    bridge_link_->flush(bridge_config_.send_timeout_ms);
+                    bridge_link_->stop();
+                }
+                break;
         }
     } catch (const std::exception& e) {
         logger_.error("Erro ao parar mecanismo " + mech_name + ": " + e.what(), "COORDINATOR");
@@ -318,12 +453,120 @@ bool IPCCoordinator::restartMechanism(IPCMechanism mechanism) {
     return startMechanism(mechanism);
 }
 
-bool IPCCoordinator::sendMessage(IPCMechanism mechanism, const std::string& message) {
+std::future<bool> IPCCoordinator::sendMessageAsync(IPCMechanism mechanism, const MessageBuffer& message,
+                                                   MessagePriority priority) {
+    return runAsync([this, mechanism, message, priority] {
+        return sendMessage(mechanism, message, priority);
+    });
+}
+
+std::future<bool> IPCCoordinator::restartMechanismAsync(IPCMechanism mechanism) {
+    return runAsync([this, mechanism] { return restartMechanism(mechanism); });
+}
+
+std::shared_ptr<WorkStealingExecutor> IPCCoordinator::getExecutor() const {
+    return executor_;
+}
+
+void IPCCoordinator::asyncDone() {
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    if (--async_in_flight_ == 0) {
+        async_cv_.notify_all();
+    }
+}
+
+void IPCCoordinator::waitForAsync() {
+    std::unique_lock<std::mutex> lock(async_mutex_);
+    async_cv_.wait(lock, [this] { return async_in_flight_ == 0; });
+}
+
+bool IPCCoordinator::sendMessage(IPCMechanism mechanism, const std::string& message, MessagePriority priority) {
+    return sendMessage(mechanism, MessageBuffer::copyOf(message), priority);
+}
+
+// A partir daqui a mensagem só circula como referência ao mesmo buffer:
+// lane -> despachante -> transporte, sem cópias do payload
+bool IPCCoordinator::sendMessage(IPCMechanism mechanism, const MessageBuffer& message, MessagePriority priority) {
     if (!mechanism_status_[mechanism]) {
         logger_.warning("Tentativa de enviar mensagem em mecanismo inativo: " + mechanismToString(mechanism), "COORDINATOR");
         return false;
     }
     
+    // Sem despachante (coordenador não inicializado) o envio é direto
+    auto lanes_it = channel_lanes_.find(mechanism);
+    if (lanes_it == channel_lanes_.end()) {
+        return transmitMessage(mechanism, message, priority);
+    }
+    
+    ChannelLanes& lanes = *lanes_it->second;
+    std::future<bool> result;
+    {
+        std::lock_guard<std::mutex> lock(lanes.mutex);
+        if (!lanes.running) {
+            return transmitMessage(mechanism, message, priority);
+        }
+        
+        PendingSend pending;
+        pending.message = message;
+        pending.enqueued_at = std::chrono::steady_clock::now();
+        result = pending.result.get_future();
+        lanes.queues[static_cast<size_t>(priority)].push_back(std::move(pending));
+    }
+    markStateChanged();   // "queued" da lane mudou
+    lanes.cv.notify_one();
+    
+    return result.get();
+}
+
+std::vector<bool> IPCCoordinator::sendMessages(const std::vector<BatchMessage>& batch) {
+    std::vector<bool> results(batch.size(), false);
+    std::map<IPCMechanism, std::vector<size_t>> by_channel;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        by_channel[batch[i].mechanism].push_back(i);
+    }
+    
+    std::vector<std::pair<size_t, std::future<bool>>> waiting;
+    waiting.reserve(batch.size());
+    for (const auto& [mechanism, indexes] : by_channel) {
+        if (!mechanism_status_[mechanism]) {
+            logger_.warning("Lote com " + std::to_string(indexes.size()) + " mensagens pra mecanismo inativo: " +
+                            mechanismToString(mechanism), "COORDINATOR");
+            continue;
+        }
+        
+        auto lanes_it = channel_lanes_.find(mechanism);
+        if (lanes_it != channel_lanes_.end()) {
+            ChannelLanes& lanes = *lanes_it->second;
+            std::unique_lock<std::mutex> lock(lanes.mutex);
+            if (lanes.running) {
+                auto now = std::chrono::steady_clock::now();
+                for (size_t i : indexes) {
+                    PendingSend pending;
+                    pending.message = batch[i].message;
+                    pending.enqueued_at = now;
+                    waiting.emplace_back(i, pending.result.get_future());
+                    lanes.queues[static_cast<size_t>(batch[i].priority)].push_back(std::move(pending));
+                }
+                lock.unlock();
+                markStateChanged();
+                lanes.cv.notify_one();
+                continue;
+            }
+        }
+        
+        // Sem despachante: direto no transporte, na ordem do lote
+        for (size_t i : indexes) {
+            results[i] = transmitMessage(mechanism, batch[i].message, batch[i].priority);
+        }
+    }
+    
+    for (auto& [index, result] : waiting) {
+        results[index] = result.get();
+    }
+    return results;
+}
+
+bool IPCCoordinator::transmitMessage(IPCMechanism mechanism, const MessageBuffer& message, MessagePriority priority) {
     bool success = false;
     
     try {
@@ -340,17 +583,44 @@ bool IPCCoordinator::sendMessage(IPCMechanism mechanism, const std::string& mess
                 break;
             case IPCMechanism::SHARED_MEMORY:
                 if (shmem_manager_ && shmem_manager_->isActive()) {
-                    success = shmem_manager_->writeMessage(message);
+                    success = shmem_manager_->writeMessage(message.view());
+                }
+                break;
+            case IPCMechanism::CROSS_MEMORY:
+                if (cross_memory_manager_ && cross_memory_manager_->isActive()) {
+                    success = cross_memory_manager_->sendMessage(message);
+                }
+                break;
+            case IPCMechanism::MESSAGE_QUEUE:
+                // A lane já ordenou no coordenador; a prioridade do kernel ordena o que ficou na fila
+                if (message_queue_manager_ && message_queue_manager_->isActive()) {
+                    success = message_queue_manager_->sendMessage(message, toQueuePriority(priority));
+                }
+                break;
+            case IPCMechanism::EVENTFD:
+                // Só o sinal atravessa - a mensagem vira nota no log
+                if (eventfd_manager_ && eventfd_manager_->isActive()) {
+                    success = eventfd_manager_->sendMessage(message);
+                }
+                break;
+            case IPCMechanism::TCP_BRIDGE:
+                // Sucesso = entrou na janela do link; a entrega remota é confirmada por ack
+                if (bridge_link_ && bridge_link_->isRunning()) {
+                    success = bridge_link_->send(bridge_config_.target_mechanism,
+                                                 static_cast<uint8_t>(priority), message);
                 }
                 break;
         }
         
         if (success) {
             message_counts_[mechanism]++;
-            logMechanismActivity(mechanism, "message_sent: " + message);
+            logMechanismActivity(mechanism, "message_sent", message.view());
+        } else {
+            logMechanismActivity(mechanism, "error", "send failed");
         }
         
     } catch (const std::exception& e) {
+        logMechanismActivity(mechanism, "error", std::string("send failed: ") + e.what());
         logger_.error("Erro ao enviar mensagem via " + mechanismToString(mechanism) + ": " + e.what(), "COORDINATOR");
     }
     
@@ -381,13 +651,20 @@ std::string IPCCoordinator::receiveMessage(IPCMechanism mechanism) {
                     message = shmem_manager_->readMessage();
                 }
                 break;
+            case IPCMechanism::CROSS_MEMORY:
+            case IPCMechanism::MESSAGE_QUEUE:
+            case IPCMechanism::EVENTFD:
+            case IPCMechanism::TCP_BRIDGE:
+                // Payload fica no worker/filho/peer - o coordenador não lê de volta
+                break;
         }
         
         if (!message.empty()) {
-            logMechanismActivity(mechanism, "message_received: " + message);
+            logMechanismActivity(mechanism, "message_received", message);
         }
         
     } catch (const std::exception& e) {
+        logMechanismActivity(mechanism, "error", std::string("receive failed: ") + e.what());
         logger_.error("Erro ao receber mensagem via " + mechanismToString(mechanism) + ": " + e.what(), "COORDINATOR");
     }
     
@@ -398,7 +675,7 @@ CoordinatorStatus IPCCoordinator::getFullStatus() const {
     CoordinatorStatus status;
     
     // Status de cada mecanismo
-    for (const auto& mech : {IPCMechanism::PIPES, IPCMechanism::SOCKETS, IPCMechanism::SHARED_MEMORY}) {
+    for (IPCMechanism mech : ALL_MECHANISMS) {
         status.mechanisms.push_back(getMechanismStatus(mech));
     }
     
@@ -432,63 +709,161 @@ MechanismStatus IPCCoordinator::getMechanismStatus(IPCMechanism mechanism) const
     status.uptime_ms = getCurrentTimeMs(); // simplificado
     status.messages_sent = message_counts_.at(mechanism);
     status.messages_received = 0; // simplificado por agora
+    status.lanes = getLaneStats(mechanism);
     
     return status;
 }
 
+std::vector<LaneStats> IPCCoordinator::getLaneStats(IPCMechanism mechanism) const {
+    std::vector<LaneStats> stats;
+    auto it = channel_lanes_.find(mechanism);
+    if (it == channel_lanes_.end()) {
+        return stats;
+    }
+    
+    const ChannelLanes& lanes = *it->second;
+    std::lock_guard<std::mutex> lock(lanes.mutex);
+    for (size_t i = 0; i < PRIORITY_COUNT; ++i) {
+        const LaneCounters& c = lanes.counters[i];
+        size_t done = c.sent + c.failed;
+        LaneStats lane;
+        lane.priority = static_cast<MessagePriority>(i);
+        lane.queued = lanes.queues[i].size();
+        lane.sent = c.sent;
+        lane.failed = c.failed;
+        lane.avg_wait_us = done > 0 ? c.total_wait_us / done : 0.0;
+        lane.max_wait_us = c.max_wait_us;
+        lane.avg_latency_us = done > 0 ? c.total_latency_us / done : 0.0;
+        stats.push_back(lane);
+    }
+    return stats;
+}
+
 std::string IPCCoordinator::executeCommand(const IPCCommand& command) {
     logger_.info("Executando comando: " + command.action + " no " + mechanismToString(command.mechanism), "COORDINATOR");
     
-    std::stringstream response;
-    response << "{\"status\":\"";
+    std::string status;
+    std::string message;
     
     try {
         if (command.action == "start") {
             bool success = startMechanism(command.mechanism);
-            response << (success ? "success" : "error");
-            response << "\",\"message\":\"" << mechanismToString(command.mechanism) 
-                     << (success ? " started" : " failed to start") << "\"}";
+            status = success ? "success" : "error";
+            message = mechanismToString(command.mechanism) + (success ? " started" : " failed to start");
                      
         } else if (command.action == "stop") {
             bool success = stopMechanism(command.mechanism);
-            response << (success ? "success" : "error");
-            response << "\",\"message\":\"" << mechanismToString(command.mechanism) 
-                     << (success ? " stopped" : " failed to stop") << "\"}";
-                     
+            status = success ? "success" : "error";
+            message = mechanismToString(command.mechanism) + (success ? " stopped" : " failed to stop");
+            
         } else if (command.action == "send") {
-            bool success = sendMessage(command.mechanism, command.message);
-            response << (success ? "success" : "error");
-            response << "\",\"message\":\"" << (success ? "message sent" : "failed to send message") << "\"}";
+            bool success = sendMessage(command.mechanism, command.message, command.priority);
+            status = success ? "success" : "error";
+            message = success ? "message sent" : "failed to send message";
             
         } else if (command.action == "status") {
-            response.str(""); // limpa
             return getStatusJSON();
             
         } else if (command.action == "logs") {
             // Por simplicidade, retorna status por enquanto
-            response.str("");
             return getStatusJSON();
             
         } else {
-            response << "error\",\"message\":\"unknown command: " << command.action << "\"}";
+            status = "error";
+            message = "unknown command: " + command.action;
         }
         
     } catch (const std::exception& e) {
-        response.str("");
-        response << "{\"status\":\"error\",\"message\":\"exception: " << e.what() << "\"}";
+        status = "error";
+        message = std::string("exception: ") + e.what();
     }
     
-    return response.str();
+    std::string out;
+    JSONWriter json(out);
+    json.beginObject().field("status", status).field("message", message).endObject();
+    return out;
 }
 
 std::string IPCCoordinator::getStatusJSON() const {
     return getFullStatus().toJSON();
 }
 
+uint64_t IPCCoordinator::getStateVersion() const {
+    return state_version_.load(std::memory_order_acquire);
+}
+
+StateSnapshot IPCCoordinator::getStatusSnapshot() const {
+    return cachedSnapshot(-1, "status", [this] { return getStatusJSON(); });
+}
+
+StateSnapshot IPCCoordinator::getDetailSnapshot(IPCMechanism mechanism) const {
+    return cachedSnapshot(static_cast<int>(mechanism), mechanismToString(mechanism),
+                          [this, mechanism] { return getMechanismDetailJSON(mechanism); });
+}
+
+StateSnapshot IPCCoordinator::getFullSnapshot() const {
+    return cachedSnapshot(-2, "snapshot", [this] { return getSnapshotJSON(); });
+}
+
+// Mesma versão e ainda novo: devolve o ponteiro do cache, sem kill() nem
+// formatação. Processo que morre não gera evento, então a cada montagem a
+// vivacidade é conferida e, se mudou, a versão sobe (muda o ETag)
+StateSnapshot IPCCoordinator::cachedSnapshot(int key, const std::string& name,
+                                             const std::function<std::string()>& build) const {
+    std::lock_guard<std::mutex> lock(snapshot_mutex_);
+    auto now = std::chrono::steady_clock::now();
+    auto it = snapshot_cache_.find(key);
+    if (it != snapshot_cache_.end() &&
+        it->second.snapshot.version == state_version_.load(std::memory_order_acquire) &&
+        now - it->second.built < std::chrono::milliseconds(SNAPSHOT_MAX_AGE_MS)) {
+        return it->second.snapshot;
+    }
+    
+    uint32_t liveness = 0;
+    for (const auto& pair : mechanism_pids_) {
+        if (isProcessAlive(pair.second)) {
+            liveness |= 1u << static_cast<unsigned>(pair.first);
+        }
+    }
+    if (liveness != liveness_mask_) {
+        liveness_mask_ = liveness;
+        markStateChanged();
+    }
+    
+    // Versão lida antes de montar: mudança no meio só faz a próxima remontar
+    CachedSnapshot& cached = snapshot_cache_[key];
+    cached.snapshot.version = state_version_.load(std::memory_order_acquire);
+    cached.snapshot.json = std::make_shared<const std::string>(build());
+    cached.snapshot.etag = "W/\"" + name + "-" + boot_tag_ + "-" + std::to_string(cached.snapshot.version) + "\"";
+    cached.built = now;
+    return cached.snapshot;
+}
+
+// Status e detalhe de todos os mecanismos: o que o dashboard precisa numa
+// requisição só (antes eram uma do status + uma por mecanismo)
+std::string IPCCoordinator::getSnapshotJSON() const {
+    CoordinatorStatus status = getFullStatus();
+    std::string out;
+    out.reserve(8192);
+    JSONWriter json(out);
+    json.beginObject().rawField("status", status.toJSON());
+    json.key("details").beginObject();
+    for (const auto& mechanism : status.mechanisms) {
+        json.rawField(mechanism.name, getMechanismDetailJSON(mechanism.type));
+    }
+    json.endObject().endObject();
+    return out;
+}
+
 std::string IPCCoordinator::getMechanismDetailJSON(IPCMechanism mechanism) const {
-    std::stringstream ss;
+    std::string out;
+    out.reserve(1024);
+    JSONWriter json(out);
+    json.beginObject().field("mechanism", mechanismToString(mechanism));
+
     // Status do mecanismo
-    auto status = getMechanismStatus(mechanism).toJSON();
+    json.key("status");
+    getMechanismStatus(mechanism).writeJSON(json);
 
     // Última operação específica de cada manager (já no formato JSON)
     std::string last_json = "{}";
@@ -508,14 +883,51 @@ std::string IPCCoordinator::getMechanismDetailJSON(IPCMechanism mechanism) const
                 last_json = shmem_manager_->getLastOperation().toJSON();
             }
             break;
+        case IPCMechanism::CROSS_MEMORY:
+            if (cross_memory_manager_ && cross_memory_manager_->isActive()) {
+                last_json = cross_memory_manager_->getLastOperation().toJSON();
+            }
+            break;
+        case IPCMechanism::MESSAGE_QUEUE:
+            if (message_queue_manager_ && message_queue_manager_->isActive()) {
+                last_json = message_queue_manager_->getLastOperation().toJSON();
+            }
+            break;
+        case IPCMechanism::EVENTFD:
+            if (eventfd_manager_ && eventfd_manager_->isActive()) {
+                last_json = eventfd_manager_->getLastOperation().toJSON();
+            }
+            break;
+        case IPCMechanism::TCP_BRIDGE:
+            if (bridge_link_) {
+                last_json = bridge_link_->getStats().toJSON();
+            }
+            break;
     }
 
-    // Monta JSON final com objetos embutidos (sem aspas)
-    ss << "{\"mechanism\":\"" << mechanismToString(mechanism) << "\",";
-    ss << "\"status\":" << status << ",";
-    ss << "\"last_operation\":" << last_json;
-    ss << "}";
-    return ss.str();
+    // Objetos que já vêm serializados entram crus
+    json.rawField("last_operation", last_json);
+    if (mechanism == IPCMechanism::SHARED_MEMORY && busy_poll_enabled_) {
+        json.rawField("busy_poll", getBusyPollStats().toJSON());
+    }
+    if (mechanism == IPCMechanism::SHARED_MEMORY && shmem_manager_) {
+        json.rawField("segment", shmem_manager_->getConfig().toJSON());
+    }
+    if (mechanism == IPCMechanism::MESSAGE_QUEUE && message_queue_manager_) {
+        json.rawField("queue", message_queue_manager_->getConfig().toJSON())
+            .field("queue_depth", message_queue_manager_->getQueueDepth());
+    }
+    if (mechanism == IPCMechanism::EVENTFD && eventfd_manager_) {
+        json.rawField("doorbell", eventfd_manager_->getConfig().toJSON());
+    }
+    if (mechanism == IPCMechanism::TCP_BRIDGE) {
+        json.rawField("bridge", bridge_config_.toJSON());
+        if (bridge_server_) {
+            json.rawField("listener", bridge_server_->getStats().toJSON());
+        }
+    }
+    json.endObject();
+    return out;
 }
 
 void IPCCoordinator::printStatus() const {
@@ -543,17 +955,14 @@ std::string IPCCoordinator::mechanismToString(IPCMechanism mech) const {
         case IPCMechanism::PIPES: return "pipes";
         case IPCMechanism::SOCKETS: return "sockets";
         case IPCMechanism::SHARED_MEMORY: return "shared_memory";
+        case IPCMechanism::CROSS_MEMORY: return "cross_memory";
+        case IPCMechanism::MESSAGE_QUEUE: return "message_queue";
+        case IPCMechanism::EVENTFD: return "eventfd";
+        case IPCMechanism::TCP_BRIDGE: return "tcp_bridge";
         default: return "unknown";
     }
 }
 
-IPCMechanism IPCCoordinator::stringToMechanism(const std::string& str) const {
-    if (str == "pipes") return IPCMechanism::PIPES;
-    if (str == "sockets") return IPCMechanism::SOCKETS;
-    if (str == "shared_memory") return IPCMechanism::SHARED_MEMORY;
-    return IPCMechanism::PIPES; // padrão
-}
-
 std::string IPCCoordinator::getCurrentTimestamp() const {
     auto now = std::chrono::system_clock::now();
     auto time_t = std::chrono::system_clock::to_time_t(now);
@@ -630,21 +1039,351 @@ bool IPCCoordinator::initializeSharedMemory() {
     bool success = shmem_manager_->createSharedMemory();
     if (success) {
         logger_.info("Memória compartilhada inicializada", "SHARED_MEMORY");
+        
+        // Consumidor busy-poll opcional - se falhar, o mecanismo continua funcionando sem ele
+        if (busy_poll_enabled_) {
+            if (shmem_manager_->startBusyPollConsumer(busy_poll_config_)) {
+                mechanism_pids_[IPCMechanism::SHARED_MEMORY] = shmem_manager_->getBusyPollStats().consumer_pid;
+            } else {
+                logger_.warning("Falha ao iniciar consumidor busy-poll", "SHARED_MEMORY");
+            }
+        }
+        return true;
+    }
+    
+    return false;
+}
+
+bool IPCCoordinator::initializeCrossMemory() {
+    if (!cross_memory_manager_) return false;
+    
+    // Worker nunca volta do createChannel - só o coordenador chega aqui
+    if (cross_memory_manager_->createChannel()) {
+        logger_.info("Cross memory inicializado (" + crossMemoryModeToString(cross_memory_manager_->getMode()) + ")",
+                     "CROSS_MEMORY");
+        return true;
+    }
+    
+    return false;
+}
+
+bool IPCCoordinator::initializeMessageQueue() {
+    if (!message_queue_manager_) return false;
+    
+    // Filho nunca volta do createQueue - só o coordenador chega aqui
+    if (message_queue_manager_->createQueue()) {
+        mechanism_pids_[IPCMechanism::MESSAGE_QUEUE] = message_queue_manager_->getChildPid();
+        logger_.info("Fila de mensagens inicializada: " + message_queue_config_.toJSON(), "MQUEUE");
         return true;
     }
     
     return false;
 }
 
-void IPCCoordinator::logMechanismActivity(IPCMechanism mechanism, const std::string& activity) {
+bool IPCCoordinator::initializeEventFd() {
+    if (!eventfd_manager_) return false;
+    
+    // Filho nunca volta do createDoorbell - só o coordenador chega aqui
+    if (eventfd_manager_->createDoorbell()) {
+        mechanism_pids_[IPCMechanism::EVENTFD] = eventfd_manager_->getChildPid();
+        logger_.info("Campainha eventfd inicializada: " + eventfd_config_.toJSON(), "EVENTFD");
+        return true;
+    }
+    
+    return false;
+}
+
+bool IPCCoordinator::initializeTcpBridge() {
+    if (bridge_config_.peer_host.empty()) {
+        logger_.error("Ponte TCP sem peer - use setTcpBridgeConfig (--bridge-peer)", "TCP_BRIDGE");
+        return false;
+    }
+    
+    // Link novo a cada start: sequências e estatísticas recomeçam do zero
+    bridge_link_ = std::make_unique<TcpBridgeLink>(bridge_config_);
+    if (bridge_link_->start()) {
+        logger_.info("Ponte TCP inicializada: " + bridge_config_.toJSON(), "TCP_BRIDGE");
+        return true;
+    }
+    
+    return false;
+}
+
+void IPCCoordinator::startLaneDispatchers() {
+    for (auto& pair : channel_lanes_) {
+        {
+            std::lock_guard<std::mutex> lock(pair.second->mutex);
+            if (pair.second->running) continue;
+            pair.second->running = true;
+        }
+        monitoring_threads_.emplace_back(&IPCCoordinator::laneDispatchLoop, this, pair.first);
+    }
+    logger_.info("Despachantes das lanes de prioridade iniciados", "COORDINATOR");
+}
+
+void IPCCoordinator::stopLaneDispatchers() {
+    for (auto& pair : channel_lanes_) {
+        {
+            std::lock_guard<std::mutex> lock(pair.second->mutex);
+            pair.second->running = false;
+        }
+        pair.second->cv.notify_all();
+    }
+    
+    // Espera threads de monitoramento terminarem
+    for (auto& thread : monitoring_threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    monitoring_threads_.clear();
+    
+    // Quem ainda estava esperando recebe falha
+    for (auto& pair : channel_lanes_) {
+        std::lock_guard<std::mutex> lock(pair.second->mutex);
+        for (size_t i = 0; i < PRIORITY_COUNT; ++i) {
+            for (auto& pending : pair.second->queues[i]) {
+                pending.result.set_value(false);
+                pair.second->counters[i].failed++;
+            }
+            pair.second->queues[i].clear();
+        }
+    }
+    markStateChanged();
+}
+
+/**
+ * Loop do despachante de um canal.
+ * CRITICAL tem prioridade estrita; entre NORMAL e BULK o escalonamento é
+ * ponderado (NORMAL_WEIGHT:1) pra que o BULK nunca fique parado de vez.
+ */
+void IPCCoordinator::laneDispatchLoop(IPCMechanism mechanism) {
+    ChannelLanes& lanes = *channel_lanes_.at(mechanism);
+    auto& critical = lanes.queues[static_cast<size_t>(MessagePriority::CRITICAL)];
+    auto& normal = lanes.queues[static_cast<size_t>(MessagePriority::NORMAL)];
+    auto& bulk = lanes.queues[static_cast<size_t>(MessagePriority::BULK)];
+    
+    while (true) {
+        PendingSend pending;
+        size_t lane = 0;
+        {
+            std::unique_lock<std::mutex> lock(lanes.mutex);
+            lanes.cv.wait(lock, [&] {
+                return !lanes.running || !critical.empty() || !normal.empty() || !bulk.empty();
+            });
+            if (!lanes.running) break;
+            
+            if (!critical.empty()) {
+                lane = static_cast<size_t>(MessagePriority::CRITICAL);
+            } else if (!normal.empty() && (bulk.empty() || lanes.normal_streak < NORMAL_WEIGHT)) {
+                lane = static_cast<size_t>(MessagePriority::NORMAL);
+                lanes.normal_streak++;
+            } else {
+                lane = static_cast<size_t>(MessagePriority::BULK);
+                lanes.normal_streak = 0;
+            }
+            
+            pending = std::move(lanes.queues[lane].front());
+            lanes.queues[lane].pop_front();
+        }
+        
+        auto dequeued_at = std::chrono::steady_clock::now();
+        bool success = transmitMessage(mechanism, pending.message, static_cast<MessagePriority>(lane));
+        auto finished_at = std::chrono::steady_clock::now();
+        
+        double wait_us = std::chrono::duration<double, std::micro>(dequeued_at - pending.enqueued_at).count();
+        double latency_us = std::chrono::duration<double, std::micro>(finished_at - pending.enqueued_at).count();
+        {
+            std::lock_guard<std::mutex> lock(lanes.mutex);
+            LaneCounters& c = lanes.counters[lane];
+            (success ? c.sent : c.failed)++;
+            c.total_wait_us += wait_us;
+            c.max_wait_us = std::max(c.max_wait_us, wait_us);
+            c.total_latency_us += latency_us;
+        }
+        markStateChanged();   // o evento do envio saiu antes dos contadores
+        
+        pending.result.set_value(success);
+    }
+}
+
+void IPCCoordinator::setBusyPoll(bool enabled, const BusyPollConfig& config) {
+    busy_poll_enabled_ = enabled;
+    busy_poll_config_ = config;
+    logger_.info(std::string("Busy-poll ") + (enabled ? "habilitado" : "desabilitado") +
+                 " (cpu=" + std::to_string(config.cpu) + ")", "COORDINATOR");
+}
+
+void IPCCoordinator::setSharedMemoryConfig(const SharedMemoryConfig& config) {
+    shmem_config_ = config;
+    logger_.info("Memória compartilhada configurada: " + config.toJSON(), "COORDINATOR");
+    
+    // Segmento ativo continua com o engine antigo - o novo vale a partir do próximo start
+    if (shmem_manager_ && !shmem_manager_->isActive()) {
+        shmem_manager_ = std::make_unique<SharedMemoryManager>(shmem_config_);
+    }
+}
+
+void IPCCoordinator::setCrossMemoryConfig(CrossMemoryMode mode, size_t capacity) {
+    cross_memory_mode_ = mode;
+    cross_memory_capacity_ = capacity;
+    logger_.info("Cross memory configurado: modo " + crossMemoryModeToString(mode) + ", buffer de " +
+                 std::to_string(capacity) + " bytes", "COORDINATOR");
+    
+    // Canal ativo continua como está - a configuração vale a partir do próximo start
+    if (cross_memory_manager_ && !cross_memory_manager_->isActive()) {
+        cross_memory_manager_ = std::make_unique<CrossMemoryManager>(mode, capacity);
+    }
+}
+
+void IPCCoordinator::setMessageQueueConfig(const MessageQueueConfig& config) {
+    message_queue_config_ = config;
+    logger_.info("Fila de mensagens configurada: " + config.toJSON(), "COORDINATOR");
+    
+    // Fila ativa continua com os atributos antigos - os novos valem a partir do próximo start
+    if (message_queue_manager_ && !message_queue_manager_->isActive()) {
+        message_queue_manager_ = std::make_unique<MessageQueueManager>(config);
+    }
+}
+
+void IPCCoordinator::setEventFdConfig(const EventFdConfig& config) {
+    eventfd_config_ = config;
+    logger_.info("Campainha eventfd configurada: " + config.toJSON(), "COORDINATOR");
+    
+    // Campainha ativa continua no modo antigo - o novo vale a partir do próximo start
+    if (eventfd_manager_ && !eventfd_manager_->isActive()) {
+        eventfd_manager_ = std::make_unique<EventFdManager>(config);
+    }
+}
+
+void IPCCoordinator::setTcpBridgeConfig(const TcpBridgeConfig& config) {
+    bridge_config_ = config;
+    logger_.info("Ponte TCP configurada: " + config.toJSON(), "COORDINATOR");
+}
+
+bool IPCCoordinator::startBridgeListener(const std::string& host, uint16_t port) {
+    if (bridge_server_ && bridge_server_->isRunning()) {
+        return true;
+    }
+    
+    // Cada mensagem recebida entra pela lane do mecanismo local, como um envio daqui
+    bridge_server_ = std::make_unique<TcpBridgeServer>(
+        [this](uint8_t mechanism, uint8_t priority, const MessageBuffer& message) {
+            if (mechanism >= ALL_MECHANISMS.size() || priority >= PRIORITY_COUNT ||
+                ALL_MECHANISMS[mechanism] == IPCMechanism::TCP_BRIDGE) {
+                return false;   // sem reencaminhar em cadeia
+            }
+            return sendMessage(ALL_MECHANISMS[mechanism], message, static_cast<MessagePriority>(priority));
+        });
+    return bridge_server_->start(host, port);
+}
+
+void IPCCoordinator::stopBridgeListener() {
+    if (bridge_server_) {
+        bridge_server_->stop();
+    }
+}
+
+uint16_t IPCCoordinator::getBridgeListenerPort() const {
+    return bridge_server_ && bridge_server_->isRunning() ? bridge_server_->getPort() : 0;
+}
+
+BusyPollStats IPCCoordinator::getBusyPollStats() const {
+    if (!shmem_manager_) {
+        return BusyPollStats();
+    }
+    return shmem_manager_->getBusyPollStats();
+}
+
+void IPCCoordinator::logMechanismActivity(IPCMechanism mechanism, const std::string& activity,
+                                          std::string_view detail) {
+    markStateChanged();
     std::string timestamp = getCurrentTimestamp();
     std::string log_entry = "[" + timestamp + "] " + activity;
+    if (!detail.empty()) {
+        log_entry.append(": ").append(detail);
+    }
     
-    mechanism_logs_[mechanism].push_back(log_entry);
+    {
+        std::lock_guard<std::mutex> lock(logs_mutex_);
+        mechanism_logs_[mechanism].push_back(std::move(log_entry));
+        
+        // Mantém apenas os últimos 1000 logs por mecanismo
+        if (mechanism_logs_[mechanism].size() > 1000) {
+            mechanism_logs_[mechanism].erase(mechanism_logs_[mechanism].begin());
+        }
+    }
     
-    // Mantém apenas os últimos 1000 logs por mecanismo
-    if (mechanism_logs_[mechanism].size() > 1000) {
-        mechanism_logs_[mechanism].erase(mechanism_logs_[mechanism].begin());
+    // O histórico é mantido mesmo sem ouvintes: é dele que sai o replay de
+    // quem reconecta (Last-Event-ID no /ipc/events)
+    IPCEvent event;
+    event.mechanism = mechanism;
+    event.mechanism_name = mechanismToString(mechanism);
+    event.type = activity;
+    size_t cut = std::min(detail.size(), IPCEvent::DETAIL_PREVIEW);
+    while (cut < detail.size() && cut > 0 && (static_cast<unsigned char>(detail[cut]) & 0xC0) == 0x80) {
+        --cut;   // não corta um caractere UTF-8 no meio (frame de texto do WebSocket exige UTF-8 válido)
+    }
+    event.detail.assign(detail.substr(0, cut));
+    event.timestamp = isoTimestampNow();
+    
+    bool notify = listener_count_.load(std::memory_order_acquire) > 0;
+    {
+        std::lock_guard<std::mutex> lock(history_mutex_);
+        event.id = next_event_id_++;
+        IPCEvent& slot = event_ring_[event.id % EVENT_HISTORY];
+        if (notify) {
+            slot = event;
+        } else {
+            slot = std::move(event);
+        }
+    }
+    
+    // Despachantes diferentes podem avisar fora da ordem dos ids; quem
+    // precisa da ordem lê o histórico (getEventsSince)
+    if (notify) {
+        std::lock_guard<std::mutex> lock(listeners_mutex_);
+        for (const auto& entry : event_listeners_) {
+            entry.second(event);
+        }
+    }
+}
+
+uint64_t IPCCoordinator::lastEventId() const {
+    // Com o mutex: o id é reservado e o evento entra no histórico sob ele
+    std::lock_guard<std::mutex> lock(history_mutex_);
+    return next_event_id_ - 1;
+}
+
+std::vector<IPCEvent> IPCCoordinator::getEventsSince(uint64_t last_id, uint64_t* oldest_id) const {
+    std::lock_guard<std::mutex> lock(history_mutex_);
+    uint64_t oldest = next_event_id_ > EVENT_HISTORY ? next_event_id_ - EVENT_HISTORY : 1;
+    if (oldest_id) {
+        *oldest_id = oldest;
+    }
+    std::vector<IPCEvent> events;
+    for (uint64_t id = std::max(last_id + 1, oldest); id < next_event_id_; ++id) {
+        events.push_back(event_ring_[id % EVENT_HISTORY]);
+    }
+    return events;
+}
+
+size_t IPCCoordinator::addEventListener(IPCEventListener listener) {
+    std::lock_guard<std::mutex> lock(listeners_mutex_);
+    size_t id = next_listener_id_++;
+    event_listeners_.emplace_back(id, std::move(listener));
+    listener_count_.store(event_listeners_.size(), std::memory_order_release);
+    return id;
+}
+
+void IPCCoordinator::removeEventListener(size_t listener_id) {
+    std::lock_guard<std::mutex> lock(listeners_mutex_);
+    for (auto it = event_listeners_.begin(); it != event_listeners_.end(); ++it) {
+        if (it->first == listener_id) {
+            event_listeners_.erase(it);
+            listener_count_.store(event_listeners_.size(), std::memory_order_release);
+            break;
+        }
     }
 }
 
@@ -652,8 +1391,16 @@ void IPCCoordinator::cleanup() {
     pipe_manager_.reset();
     socket_manager_.reset();
     shmem_manager_.reset();
+    cross_memory_manager_.reset();
+    message_queue_manager_.reset();
+    eventfd_manager_.reset();
+    bridge_link_.reset();
+    bridge_server_.reset();
     
-    mechanism_logs_.clear();
+    {
+        std::lock_guard<std::mutex> lock(logs_mutex_);
+        mechanism_logs_.clear();
+    }
     mechanism_pids_.clear();
     
     logger_.info("Cleanup concluído", "COORDINATOR");
@@ -677,6 +1424,7 @@ void IPCCoordinator::waitForAllChildren() {
 }
 
 std::vector<std::string> IPCCoordinator::getLogs(IPCMechanism mechanism, size_t count) {
+    std::lock_guard<std::mutex> lock(logs_mutex_);
     auto& logs = mechanism_logs_[mechanism];
     size_t start = logs.size() > count ? logs.size() - count : 0;
     return std::vector<std::string>(logs.begin() + start, logs.end());
@@ -11,12 +11,26 @@
 #include <map>
 #include <thread>
 #include <atomic>
+#include <array>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <future>
+#include <chrono>
+#include <functional>
+#include <string_view>
 #include <signal.h>
 #include <sys/wait.h>
 #include "pipe_manager.h"
 #include "socket_manager.h"
 #include "shmem_manager.h"
+#include "cross_memory_manager.h"
+#include "message_queue_manager.h"
+#include "eventfd_manager.h"
+#include "tcp_bridge.h"
 #include "../common/logger.h"
+#include "../common/work_stealing_executor.h"
+#include "../common/json_writer.h"
 
 namespace ipc_project {
 
@@ -24,7 +38,49 @@ namespace ipc_project {
 enum class IPCMechanism {
     PIPES,
     SOCKETS, 
-    SHARED_MEMORY
+    SHARED_MEMORY,
+    CROSS_MEMORY,       // process_vm_writev/readv entre coordenador e worker
+    MESSAGE_QUEUE,      // fila POSIX (mq_send/mq_receive) com prioridade do kernel
+    EVENTFD,            // campainha sem payload (eventfd) - só notificação
+    TCP_BRIDGE          // encaminha pra um coordenador remoto via TCP
+};
+
+// Todos os mecanismos, na ordem em que aparecem no status
+constexpr std::array<IPCMechanism, 7> ALL_MECHANISMS = {
+    IPCMechanism::PIPES, IPCMechanism::SOCKETS, IPCMechanism::SHARED_MEMORY, IPCMechanism::CROSS_MEMORY,
+    IPCMechanism::MESSAGE_QUEUE, IPCMechanism::EVENTFD, IPCMechanism::TCP_BRIDGE
+};
+
+// Classes de prioridade das mensagens - cada classe tem sua própria fila (lane) por canal
+enum class MessagePriority {
+    CRITICAL = 0,   // mensagens de controle - sempre passam na frente
+    NORMAL = 1,     // tráfego padrão
+    BULK = 2        // tráfego em massa - só usa a banda que sobra
+};
+
+constexpr size_t PRIORITY_COUNT = 3;
+
+std::string priorityToString(MessagePriority priority);
+bool stringToPriority(const std::string& str, MessagePriority& priority);
+
+// "pipes", "shared_memory"/"shmem", "message_queue"/"mqueue"... false se desconhecido
+bool stringToMechanism(std::string_view str, IPCMechanism& mechanism);
+
+// Prioridade do kernel usada no mq_send de cada classe (maior sai primeiro da fila)
+unsigned int toQueuePriority(MessagePriority priority);
+
+// Estatísticas de uma lane (fila de prioridade) de um canal
+struct LaneStats {
+    MessagePriority priority;
+    size_t queued;              // mensagens esperando na fila agora
+    size_t sent;                // enviadas com sucesso
+    size_t failed;              // falhas de envio
+    double avg_wait_us;         // tempo médio na fila (enfileirar -> começar a enviar)
+    double max_wait_us;         // pior tempo na fila
+    double avg_latency_us;      // tempo médio total (enfileirar -> envio concluído)
+    
+    std::string toJSON() const;
+    void writeJSON(JSONWriter& json) const;    // anexa no writer de quem contém (sem string intermediária)
 };
 
 // Estrutura pra guardar status de um mecanismo específico
@@ -39,8 +95,10 @@ struct MechanismStatus {
     double uptime_ms;
     size_t messages_sent;
     size_t messages_received;
+    std::vector<LaneStats> lanes;  // estatísticas por classe de prioridade
     
     std::string toJSON() const;
+    void writeJSON(JSONWriter& json) const;
 };
 
 // Estrutura geral de status do coordenador
@@ -55,11 +113,47 @@ struct CoordinatorStatus {
     std::string toJSON() const;
 };
 
+// Evento de um mecanismo (start, stop, envio, recebimento), entregue aos
+// ouvintes no momento em que acontece - é o que o push pro navegador usa
+struct IPCEvent {
+    uint64_t id = 0;             // sequencial no coordenador
+    IPCMechanism mechanism = IPCMechanism::PIPES;
+    std::string mechanism_name;  // "pipes", "sockets"...
+    std::string type;            // "started", "stopped", "message_sent", "message_received", "error"
+    std::string detail;          // prévia da mensagem (no máximo DETAIL_PREVIEW bytes)
+    std::string timestamp;
+    
+    static constexpr size_t DETAIL_PREVIEW = 256;
+    
+    std::string toJSON() const;
+    void writeJSON(JSONWriter& json) const;
+};
+
+// Ouvinte de eventos. Roda na thread que gerou o evento (despachante da lane,
+// handler HTTP...), então só deve enfileirar e voltar
+using IPCEventListener = std::function<void(const IPCEvent&)>;
+
+// Uma versão serializada do estado (status geral ou detalhe de um mecanismo).
+// O texto é compartilhado: quem pede a mesma versão recebe o mesmo buffer
+struct StateSnapshot {
+    uint64_t version = 0;
+    std::shared_ptr<const std::string> json;
+    std::string etag;            // W/"status-<boot>-<versão>", W/"pipes-<boot>-<versão>"...
+};
+
+// Um item de envio em lote (POST /ipc/send/batch)
+struct BatchMessage {
+    IPCMechanism mechanism;
+    MessageBuffer message;
+    MessagePriority priority = MessagePriority::NORMAL;
+};
+
 // Estrutura pra comandos que vem do servidor HTTP
 struct IPCCommand {
     std::string action;          // "start", "stop", "send", "status", "logs"
     IPCMechanism mechanism;      // qual mecanismo usar
     std::string message;         // mensagem pra enviar (se aplicável)
+    MessagePriority priority = MessagePriority::NORMAL; // classe de prioridade do envio
     std::map<std::string, std::string> parameters; // parâmetros extras
     
     bool fromJSON(const std::string& json);
@@ -67,7 +161,7 @@ struct IPCCommand {
 };
 
 // Classe principal que coordena todos os mecanismos IPC
-// Responsável por inicializar, gerenciar e coordenar Pipes, Sockets e Shared Memory
+// Responsável por inicializar, gerenciar e coordenar Pipes, Sockets, Shared Memory, Cross Memory, Message Queue, eventfd e a ponte TCP
 class IPCCoordinator {
 public:
     IPCCoordinator();
@@ -83,21 +177,84 @@ public:
     bool stopMechanism(IPCMechanism mechanism);  // Para um mecanismo específico
     bool restartMechanism(IPCMechanism mechanism); // Reinicia mecanismo
     
-    // Envio de mensagens
-    bool sendMessage(IPCMechanism mechanism, const std::string& message);
+    // Envio de mensagens - passa pela lane da prioridade escolhida
+    bool sendMessage(IPCMechanism mechanism, const std::string& message,
+                     MessagePriority priority = MessagePriority::NORMAL);
+    bool sendMessage(IPCMechanism mechanism, const MessageBuffer& message,
+                     MessagePriority priority = MessagePriority::NORMAL);  // sem copia
+    // Rajada: cada canal recebe os seus itens de uma vez (uma trava, um
+    // notify) e o despachante drena em sequência. Resultado na ordem do lote
+    std::vector<bool> sendMessages(const std::vector<BatchMessage>& batch);
     std::string receiveMessage(IPCMechanism mechanism);
     
+    // Versões assíncronas - rodam no executor compartilhado em vez de prender quem chamou
+    std::future<bool> sendMessageAsync(IPCMechanism mechanism, const MessageBuffer& message,
+                                       MessagePriority priority = MessagePriority::NORMAL);
+    std::future<bool> restartMechanismAsync(IPCMechanism mechanism);
+    
+    // Agenda qualquer trabalho de fundo no executor. O destrutor espera essas
+    // tarefas, então elas podem usar o coordenador sem risco
+    template <typename F>
+    auto runAsync(F&& fn) -> std::future<decltype(fn())>;
+    
+    // Pool com roubo de tarefas compartilhado com o servidor HTTP
+    std::shared_ptr<WorkStealingExecutor> getExecutor() const;
+    
     // Status e monitoramento
     CoordinatorStatus getFullStatus() const;     // Status completo de tudo
     MechanismStatus getMechanismStatus(IPCMechanism mechanism) const;
+    std::vector<LaneStats> getLaneStats(IPCMechanism mechanism) const;
     std::vector<std::string> getLogs(IPCMechanism mechanism, size_t count = 100);
     
+    // Eventos dos mecanismos em tempo real. O id serve pra remover o ouvinte;
+    // depois do remove nenhuma chamada dele está em andamento
+    size_t addEventListener(IPCEventListener listener);
+    void removeEventListener(size_t listener_id);
+    // Eventos recentes com id > last_id (os últimos EVENT_HISTORY). oldest_id
+    // diz onde o histórico começa - se for maior que last_id + 1, houve perda
+    std::vector<IPCEvent> getEventsSince(uint64_t last_id, uint64_t* oldest_id = nullptr) const;
+    uint64_t lastEventId() const;                // 0 = nenhum evento ainda
+    static constexpr size_t EVENT_HISTORY = 1024;
+    
     // Interface pro servidor HTTP
     std::string executeCommand(const IPCCommand& command);  // Executa comando e retorna JSON
     std::string getStatusJSON() const;           // Status em formato JSON
     std::string getMechanismDetailJSON(IPCMechanism mechanism) const; // Última operação + status
+    std::string getSnapshotJSON() const;   // {"status":..., "details":{"pipes":...}} num documento só
+    
+    // Mesmos documentos, versionados e em cache. A versão sobe a cada mudança
+    // de estado (start/stop, envio, fila das lanes); o JSON só é refeito quando
+    // ela muda ou quando passa SNAPSHOT_MAX_AGE_MS (uptime, processo que morreu)
+    uint64_t getStateVersion() const;
+    StateSnapshot getStatusSnapshot() const;
+    StateSnapshot getDetailSnapshot(IPCMechanism mechanism) const;
+    StateSnapshot getFullSnapshot() const;
+    static constexpr long SNAPSHOT_MAX_AGE_MS = 1000;
     void printStatus() const;                    // Imprime status no stdout
     
+    // Modo busy-poll da memória compartilhada (consumidor de baixa latência)
+    void setBusyPoll(bool enabled, const BusyPollConfig& config = BusyPollConfig());
+    BusyPollStats getBusyPollStats() const;
+    
+    // Capacidade / lock / layout do segmento (escolhidos em tempo de compilação, selecionados aqui)
+    void setSharedMemoryConfig(const SharedMemoryConfig& config);
+    
+    // Quem copia no cross memory (push = coordenador escreve, pull = worker lê) e tamanho do buffer
+    void setCrossMemoryConfig(CrossMemoryMode mode, size_t capacity = CrossMemoryManager::DEFAULT_CAPACITY);
+    
+    // Atributos da fila POSIX (mq_maxmsg / mq_msgsize)
+    void setMessageQueueConfig(const MessageQueueConfig& config);
+    
+    // Modo do contador da campainha (normal ou EFD_SEMAPHORE)
+    void setEventFdConfig(const EventFdConfig& config);
+    
+    // Ponte TCP: peer/mecanismo de destino do link de saída e o listener que
+    // recebe de outros coordenadores (entrega no mecanismo local indicado na rota)
+    void setTcpBridgeConfig(const TcpBridgeConfig& config);
+    bool startBridgeListener(const std::string& host, uint16_t port);   // porta 0 = efêmera
+    void stopBridgeListener();
+    uint16_t getBridgeListenerPort() const;
+    
     // Gerenciamento de processos
     void waitForAllChildren();                   // Espera todos os processos filhos
     void killAllChildren();                      // Mata todos os processos filhos
@@ -114,21 +271,98 @@ private:
     std::unique_ptr<PipeManager> pipe_manager_;
     std::unique_ptr<SocketManager> socket_manager_;
     std::unique_ptr<SharedMemoryManager> shmem_manager_;
+    std::unique_ptr<CrossMemoryManager> cross_memory_manager_;
+    std::unique_ptr<MessageQueueManager> message_queue_manager_;
+    std::unique_ptr<EventFdManager> eventfd_manager_;
+    std::unique_ptr<TcpBridgeLink> bridge_link_;
+    std::unique_ptr<TcpBridgeServer> bridge_server_;
     
     // Controle de estado
     std::atomic<bool> is_running_;
     std::atomic<bool> shutdown_requested_;
     std::map<IPCMechanism, bool> mechanism_status_;
     std::map<IPCMechanism, pid_t> mechanism_pids_;
+    bool busy_poll_enabled_;
+    BusyPollConfig busy_poll_config_;
+    SharedMemoryConfig shmem_config_;
+    CrossMemoryMode cross_memory_mode_;
+    size_t cross_memory_capacity_;
+    MessageQueueConfig message_queue_config_;
+    EventFdConfig eventfd_config_;
+    TcpBridgeConfig bridge_config_;
     
-    // Threads pra monitoramento contínuo
+    // Threads pra monitoramento contínuo (inclui os despachantes das lanes)
     std::vector<std::thread> monitoring_threads_;
     
+    // Executor compartilhado + contagem das tarefas do coordenador ainda pendentes
+    std::shared_ptr<WorkStealingExecutor> executor_;
+    std::atomic<size_t> async_in_flight_;
+    std::mutex async_mutex_;
+    std::condition_variable async_cv_;
+    void asyncDone();
+    void waitForAsync();
+    
+    // Envio pendente numa lane - quem enfileirou espera o resultado no future
+    struct PendingSend {
+        MessageBuffer message;      // referencia ao buffer de quem enviou
+        std::chrono::steady_clock::time_point enqueued_at;
+        std::promise<bool> result;
+    };
+    
+    // Contadores acumulados de uma lane
+    struct LaneCounters {
+        size_t sent = 0;
+        size_t failed = 0;
+        double total_wait_us = 0.0;
+        double max_wait_us = 0.0;
+        double total_latency_us = 0.0;
+    };
+    
+    // Lanes de um canal: uma fila por prioridade + um despachante
+    struct ChannelLanes {
+        mutable std::mutex mutex;
+        std::condition_variable cv;
+        std::array<std::deque<PendingSend>, PRIORITY_COUNT> queues;
+        std::array<LaneCounters, PRIORITY_COUNT> counters;
+        size_t normal_streak = 0;   // NORMAL seguidas desde o último BULK (pesos)
+        bool running = false;
+    };
+    
+    // Peso do NORMAL sobre o BULK: a cada NORMAL_WEIGHT mensagens NORMAL, uma BULK passa
+    static constexpr size_t NORMAL_WEIGHT = 4;
+    
+    std::map<IPCMechanism, std::unique_ptr<ChannelLanes>> channel_lanes_;
+    
     // Dados de status
     std::string startup_time_;
     std::map<IPCMechanism, std::vector<std::string>> mechanism_logs_;
+    mutable std::mutex logs_mutex_;  // despachantes de canais diferentes logam em paralelo
     std::map<IPCMechanism, size_t> message_counts_;
     
+    // Ouvintes de eventos (chamados com o mutex seguro - remove espera quem está rodando)
+    mutable std::mutex listeners_mutex_;
+    std::vector<std::pair<size_t, IPCEventListener>> event_listeners_;
+    std::atomic<size_t> listener_count_{0};   // sem ouvinte o envio nem toca no listeners_mutex_
+    
+    // Histórico em anel (evento id fica em id % EVENT_HISTORY). O lock só cobre
+    // reservar o id e mover o evento pro slot - o resto é montado fora dele
+    mutable std::mutex history_mutex_;
+    std::vector<IPCEvent> event_ring_ = std::vector<IPCEvent>(EVENT_HISTORY);
+    uint64_t next_event_id_ = 1;
+    
+    // Versão do estado e os JSONs já montados
+    // (chave: -1 = status, -2 = documento completo, senão o mecanismo)
+    struct CachedSnapshot {
+        StateSnapshot snapshot;
+        std::chrono::steady_clock::time_point built;
+    };
+    mutable std::atomic<uint64_t> state_version_{1};
+    std::string boot_tag_;               // aleatório por instância: a versão recomeça em 1 num restart
+    mutable std::mutex snapshot_mutex_;  // quem chega junto espera o primeiro montar
+    mutable std::map<int, CachedSnapshot> snapshot_cache_;
+    mutable uint32_t liveness_mask_ = 0; // processos vivos na última montagem
+    size_t next_listener_id_ = 1;
+    
     Logger& logger_;
     
     // Instância estática pro signal handler
@@ -136,7 +370,6 @@ private:
     
     // Funções auxiliares
     std::string mechanismToString(IPCMechanism mech) const;
-    IPCMechanism stringToMechanism(const std::string& str) const;
     double getCurrentTimeMs() const;
     
     // Monitoramento de processos
@@ -146,10 +379,43 @@ private:
     bool initializePipes();
     bool initializeSockets(); 
     bool initializeSharedMemory();
+    bool initializeCrossMemory();
+    bool initializeMessageQueue();
+    bool initializeEventFd();
+    bool initializeTcpBridge();
+    
+    // Lanes de prioridade
+    void startLaneDispatchers();
+    void stopLaneDispatchers();
+    void laneDispatchLoop(IPCMechanism mechanism);
+    bool transmitMessage(IPCMechanism mechanism, const MessageBuffer& message,
+                         MessagePriority priority = MessagePriority::NORMAL); // envio direto no transporte
     
     // Cleanup
     void cleanup();
-    void logMechanismActivity(IPCMechanism mechanism, const std::string& activity);
+    void logMechanismActivity(IPCMechanism mechanism, const std::string& activity,
+                              std::string_view detail = {});   // loga e avisa os ouvintes
+    void markStateChanged() const { state_version_.fetch_add(1, std::memory_order_release); }
+    StateSnapshot cachedSnapshot(int key, const std::string& name,
+                                 const std::function<std::string()>& build) const;
 };
 
+template <typename F>
+auto IPCCoordinator::runAsync(F&& fn) -> std::future<decltype(fn())> {
+    using Result = decltype(fn());
+    async_in_flight_++;
+    auto future = executor_->async([this, fn = std::forward<F>(fn)]() mutable -> Result {
+        // Conta como concluída mesmo se a tarefa lançar
+        struct Done {
+            IPCCoordinator* self;
+            ~Done() { self->asyncDone(); }
+        } done{this};
+        return fn();
+    });
+    if (!future.valid()) {
+        asyncDone();    // executor desligado - a tarefa não vai rodar
+    }
+    return future;
+}
+
 } // namespace ipc_project
@@ -0,0 +1,467 @@
+/**
+ * @file message_queue_manager.cpp
+ * @brief Implementacao da fila de mensagens POSIX com prioridades do kernel
+ */
+
+#include "message_queue_manager.h"
+#include "../common/json_writer.h"
+#include <iostream>
+#include <cstring>
+#include <errno.h>
+#include <chrono>
+#include <atomic>
+#include <fcntl.h>
+#include <time.h>
+#include <sys/epoll.h>
+
+namespace ipc_project {
+
+size_t MessageQueueConfig::maxPayload() const {
+    return message_size > static_cast<long>(sizeof(MessageHeader))
+        ? static_cast<size_t>(message_size) - sizeof(MessageHeader)
+        : 0;
+}
+
+std::string MessageQueueConfig::toJSON() const {
+    std::string out;
+    JSONWriter json(out);
+    json.beginObject()
+        .field("max_messages", max_messages)
+        .field("message_size", message_size)
+        .field("max_payload", maxPayload())
+        .field("send_timeout_ms", send_timeout_ms)
+        .endObject();
+    return out;
+}
+
+// Converte dados da operação atual pro formato JSON (mesmo formato de pipes/sockets)
+std::string MessageQueueData::toJSON() const {
+    std::string operation_type = "connect";
+    std::string status_type = "success";
+    if (status == "sent") {
+        operation_type = "write";
+    } else if (status == "received") {
+        operation_type = "read";
+    } else if (status.find("error") != std::string::npos) {
+        status_type = "error";
+    }
+
+    std::string out;
+    out.reserve(256 + message.size());
+    JSONWriter json(out);
+    json.beginObject()
+        .field("type", "message_queue")
+        .field("timestamp", isoTimestampNow())
+        .field("operation", operation_type)
+        .field("process_id", sender_pid)
+        .key("data").beginObject()
+            .field("message", message.view())
+            .field("bytes", bytes)
+            .field("priority", priority)
+            .field("queue_depth", queue_depth)
+            .field("time_ms", time_ms, 3)
+            .field("sender_pid", sender_pid)
+            .field("receiver_pid", receiver_pid)
+            .field("sequence", sequence)
+            .field("latency_us", latency_us, 3)
+        .endObject()
+        .field("status", status_type);
+    if (status_type == "error") json.field("error_message", status);
+    else json.nullField("error_message");
+    json.endObject();
+    return out;
+}
+
+MessageQueueManager::MessageQueueManager(const MessageQueueConfig& config)
+    : config_(config),
+      send_queue_(static_cast<mqd_t>(-1)),
+      receive_queue_(static_cast<mqd_t>(-1)),
+      epoll_fd_(-1),
+      child_pid_(-1),
+      is_parent_(true),
+      is_active_(false),
+      logger_(Logger::getInstance()),
+      next_sequence_{} {
+
+    // Nome único por instância - várias filas podem coexistir no mesmo processo
+    static std::atomic<unsigned> instance_counter{0};
+    queue_name_ = "/ipc_project_mq_" + std::to_string(getpid()) + "_" + std::to_string(instance_counter++);
+
+    last_operation_.bytes = 0;
+    last_operation_.time_ms = 0.0;
+    last_operation_.status = "idle";
+    last_operation_.priority = 0;
+    last_operation_.queue_depth = 0;
+    last_operation_.sender_pid = getpid();
+    last_operation_.receiver_pid = -1;
+
+    logger_.info("MessageQueueManager criado (" + std::to_string(config_.max_messages) + " x " +
+                 std::to_string(config_.message_size) + " bytes)", "MQUEUE");
+}
+
+MessageQueueManager::~MessageQueueManager() {
+    closeQueue();
+    logger_.debug("MessageQueueManager destruído", "MQUEUE");
+}
+
+// Abre os dois lados antes do fork e tira o nome do sistema logo em seguida:
+// a fila vive enquanto houver descritor aberto e nunca sobra em /dev/mqueue
+bool MessageQueueManager::createQueue() {
+    logger_.info("Criando fila " + queue_name_, "MQUEUE");
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    if (config_.max_messages <= 0 || config_.maxPayload() == 0) {
+        updateOperation(MessageBuffer(), 0, "error_invalid_config");
+        logger_.error("Configuração inválida da fila: " + config_.toJSON(), "MQUEUE");
+        return false;
+    }
+
+    struct mq_attr attr{};
+    attr.mq_maxmsg = config_.max_messages;
+    attr.mq_msgsize = config_.message_size;
+
+    send_queue_ = mq_open(queue_name_.c_str(), O_CREAT | O_EXCL | O_WRONLY | O_CLOEXEC, 0600, &attr);
+    if (send_queue_ == static_cast<mqd_t>(-1)) {
+        updateOperation(MessageBuffer(), 0, "error_create");
+        logger_.error("Erro ao criar fila: " + std::string(strerror(errno)) +
+                      (errno == EINVAL ? " (veja /proc/sys/fs/mqueue/msg_max e msgsize_max)" : ""), "MQUEUE");
+        return false;
+    }
+
+    receive_queue_ = mq_open(queue_name_.c_str(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    mq_unlink(queue_name_.c_str());
+    if (receive_queue_ == static_cast<mqd_t>(-1)) {
+        updateOperation(MessageBuffer(), 0, "error_create");
+        logger_.error("Erro ao abrir fila pra leitura: " + std::string(strerror(errno)), "MQUEUE");
+        mq_close(send_queue_);
+        send_queue_ = static_cast<mqd_t>(-1);
+        return false;
+    }
+
+    frame_buffer_.resize(static_cast<size_t>(config_.message_size));
+    child_pid_ = fork();
+
+    if (child_pid_ == -1) {
+        mq_close(send_queue_);
+        mq_close(receive_queue_);
+        send_queue_ = receive_queue_ = static_cast<mqd_t>(-1);
+        updateOperation(MessageBuffer(), 0, "error_fork");
+        logger_.error("Erro ao fazer fork: " + std::string(strerror(errno)), "MQUEUE");
+        return false;
+    }
+
+    if (child_pid_ == 0) {
+        // Processo filho - só lê
+        is_parent_ = false;
+        mq_close(send_queue_);
+        send_queue_ = static_cast<mqd_t>(-1);
+
+        last_operation_.sender_pid = getppid();
+        last_operation_.receiver_pid = getpid();
+        is_active_ = true;
+
+        logger_.info("Processo filho da fila iniciado", "MQUEUE_CHILD");
+        runChildLoop();
+    }
+
+    // Processo pai - só escreve
+    mq_close(receive_queue_);
+    receive_queue_ = static_cast<mqd_t>(-1);
+    is_active_ = true;
+
+    auto end = std::chrono::high_resolution_clock::now();
+
+    last_operation_.sender_pid = getpid();
+    last_operation_.receiver_pid = child_pid_;
+    updateOperation(MessageBuffer(), 0, "ready");
+    last_operation_.time_ms = std::chrono::duration<double, std::milli>(end - start).count();
+
+    logger_.info("Fila criada, filho PID " + std::to_string(child_pid_), "MQUEUE");
+    return true;
+}
+
+bool MessageQueueManager::isParent() const {
+    return is_parent_;
+}
+
+bool MessageQueueManager::sendMessage(const std::string& message, unsigned int priority) {
+    return sendMessage(MessageBuffer::copyOf(message), priority);
+}
+
+// Uma mensagem = um mq_send: a fronteira e a ordem por prioridade ficam por conta do kernel
+bool MessageQueueManager::sendMessage(const MessageBuffer& message, unsigned int priority) {
+    if (message.size() > config_.maxPayload()) {
+        updateOperation(message, 0, "error_message_too_large");
+        logger_.error("Mensagem muito grande (" + std::to_string(message.size()) + " bytes, máx " +
+                      std::to_string(config_.maxPayload()) + ")", "MQUEUE");
+        return false;
+    }
+
+    if (priority > PRIORITY_CRITICAL) {
+        updateOperation(message, 0, "error_invalid_priority");
+        logger_.error("Prioridade inválida: " + std::to_string(priority) + " (máx " +
+                      std::to_string(PRIORITY_CRITICAL) + ")", "MQUEUE");
+        return false;
+    }
+
+    if (!is_active_ || !is_parent_ || send_queue_ == static_cast<mqd_t>(-1)) {
+        updateOperation(message, 0, "error_invalid_state");
+        logger_.error("Tentativa de envio inválida", "MQUEUE");
+        return false;
+    }
+
+    auto start = std::chrono::high_resolution_clock::now();
+
+    std::string error;
+    bool ok = sendFrame(MessageType::DATA, message.view(), priority, error);
+
+    auto end = std::chrono::high_resolution_clock::now();
+    double elapsed = std::chrono::duration<double, std::milli>(end - start).count();
+
+    if (!ok) {
+        updateOperation(message, 0, "error_" + error);
+        logger_.error("Erro no mq_send: " + error, "MQUEUE");
+        return false;
+    }
+
+    updateOperation(message, sizeof(MessageHeader) + message.size(), "sent");
+    last_operation_.time_ms = elapsed;
+    last_operation_.priority = priority;
+    last_operation_.sequence = next_sequence_[priority];
+    last_operation_.queue_depth = getQueueDepth();
+
+    logger_.info("Mensagem enfileirada: '" + message.str() + "' (prioridade " + std::to_string(priority) +
+                 ", seq " + std::to_string(next_sequence_[priority]) + ")", "MQUEUE");
+
+    printJSON(); // envia resultado pro frontend via stdout
+    return true;
+}
+
+// Função que o filho usa pra receber mensagem do pai
+std::string MessageQueueManager::receiveMessage() {
+    if (!is_active_ || is_parent_ || receive_queue_ == static_cast<mqd_t>(-1)) {
+        updateOperation(MessageBuffer(), 0, "error_invalid_state");
+        logger_.error("Tentativa de leitura inválida", "MQUEUE_CHILD");
+        return "";
+    }
+
+    MessageHeader header;
+    std::string_view payload;
+    unsigned int priority = 0;
+    std::string error;
+    if (!receiveFrame(header, payload, priority, error)) {
+        updateOperation(MessageBuffer(), 0, "error_" + error);
+        return "";
+    }
+    return std::string(payload);
+}
+
+MessageQueueData MessageQueueManager::getLastOperation() const {
+    return last_operation_;
+}
+
+void MessageQueueManager::printJSON() const {
+    std::cout << "MQUEUE_JSON:" << last_operation_.toJSON() << std::endl;
+    std::cout.flush();
+}
+
+const MessageQueueConfig& MessageQueueManager::getConfig() const {
+    return config_;
+}
+
+long MessageQueueManager::getQueueDepth() const {
+    mqd_t queue = is_parent_ ? send_queue_ : receive_queue_;
+    struct mq_attr attr{};
+    if (queue == static_cast<mqd_t>(-1) || mq_getattr(queue, &attr) == -1) {
+        return 0;
+    }
+    return attr.mq_curmsgs;
+}
+
+pid_t MessageQueueManager::getChildPid() const {
+    return child_pid_;
+}
+
+void MessageQueueManager::closeQueue() {
+    if (!is_active_) return;
+
+    logger_.info("Fechando fila", is_parent_ ? "MQUEUE" : "MQUEUE_CHILD");
+
+    if (is_parent_) {
+        // Controle com a menor prioridade: o filho só vê depois de drenar os dados
+        std::string error;
+        if (!sendFrame(MessageType::CONTROL, "close", PRIORITY_CONTROL, error) && child_pid_ > 0) {
+            logger_.warning("Controle de fim não entrou na fila (" + error + "), encerrando filho", "MQUEUE");
+            kill(child_pid_, SIGTERM);
+        }
+        if (child_pid_ > 0) {
+            int status;
+            waitpid(child_pid_, &status, 0);
+            child_pid_ = -1;
+        }
+        if (send_queue_ != static_cast<mqd_t>(-1)) {
+            mq_close(send_queue_);
+            send_queue_ = static_cast<mqd_t>(-1);
+        }
+    } else {
+        if (receive_queue_ != static_cast<mqd_t>(-1)) {
+            mq_close(receive_queue_);
+            receive_queue_ = static_cast<mqd_t>(-1);
+        }
+        if (epoll_fd_ != -1) {
+            close(epoll_fd_);
+            epoll_fd_ = -1;
+        }
+    }
+
+    is_active_ = false;
+    updateOperation(MessageBuffer(), 0, "closed");
+}
+
+bool MessageQueueManager::isActive() const {
+    return is_active_;
+}
+
+void MessageQueueManager::updateOperation(const MessageBuffer& msg, size_t bytes, const std::string& status) {
+    last_operation_.message = msg;
+    last_operation_.bytes = bytes;
+    last_operation_.status = status;
+    // tempo é preenchido na função chamadora
+}
+
+// Envelope + payload num buffer contíguo e um mq_timedsend. Com a fila cheia
+// espera até send_timeout_ms em vez de travar o despachante pra sempre
+bool MessageQueueManager::sendFrame(MessageType type, std::string_view payload, unsigned int priority,
+                                    std::string& error) {
+    uint64_t sequence = type == MessageType::DATA ? next_sequence_[priority] + 1 : 0;
+    MessageHeader header = makeHeader(type, payload, sequence);
+
+    std::memcpy(frame_buffer_.data(), &header, sizeof(header));
+    if (!payload.empty()) {
+        std::memcpy(frame_buffer_.data() + sizeof(header), payload.data(), payload.size());
+    }
+
+    struct timespec deadline;
+    clock_gettime(CLOCK_REALTIME, &deadline);
+    deadline.tv_sec += config_.send_timeout_ms / 1000;
+    deadline.tv_nsec += (config_.send_timeout_ms % 1000) * 1000000L;
+    if (deadline.tv_nsec >= 1000000000L) {
+        deadline.tv_sec++;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    while (mq_timedsend(send_queue_, frame_buffer_.data(), sizeof(header) + payload.size(), priority,
+                        &deadline) == -1) {
+        if (errno == EINTR) continue;
+        error = errno == ETIMEDOUT ? "queue_full" : strerror(errno);
+        return false;
+    }
+
+    if (type == MessageType::DATA) {
+        next_sequence_[priority] = sequence;
+    }
+    return true;
+}
+
+// Drena a fila sem bloquear; quando esvazia, dorme no epoll até o kernel
+// avisar que o descritor ficou legível. Frames inválidos são descartados
+bool MessageQueueManager::receiveFrame(MessageHeader& header, std::string_view& payload, unsigned int& priority,
+                                       std::string& error) {
+    while (true) {
+        ssize_t received = mq_receive(receive_queue_, frame_buffer_.data(), frame_buffer_.size(), &priority);
+        if (received == -1) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN) {
+                error = strerror(errno);
+                return false;
+            }
+            struct epoll_event event;
+            if (epoll_wait(epoll_fd_, &event, 1, -1) == -1 && errno != EINTR) {
+                error = std::string("epoll: ") + strerror(errno);
+                return false;
+            }
+            continue;
+        }
+
+        std::string invalid;
+        if (static_cast<size_t>(received) < sizeof(header)) {
+            invalid = "frame curto";
+        } else {
+            // O buffer não é alinhado em 64 - copia o cabeçalho pra fora
+            std::memcpy(&header, frame_buffer_.data(), sizeof(header));
+            payload = std::string_view(frame_buffer_.data() + sizeof(header),
+                                       static_cast<size_t>(received) - sizeof(header));
+            if (!validateHeader(header, config_.maxPayload(), invalid)) {
+                // 'invalid' já explica
+            } else if (header.length != payload.size()) {
+                invalid = "tamanho não bate com o frame";
+            } else if (!verifyPayload(header, payload)) {
+                if (priority < PRIORITY_LEVELS) rx_trackers_[priority].checksum_errors++;
+                invalid = "checksum";
+            }
+        }
+
+        if (!invalid.empty()) {
+            logger_.warning("Frame descartado: " + invalid, "MQUEUE_CHILD");
+            continue;
+        }
+        return true;
+    }
+}
+
+// Loop principal do filho - termina com a mensagem de controle do pai
+void MessageQueueManager::runChildLoop() {
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    struct epoll_event event{};
+    event.events = EPOLLIN;
+    if (epoll_fd_ == -1 || epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, receive_queue_, &event) == -1) {
+        logger_.error("Erro ao registrar a fila no epoll: " + std::string(strerror(errno)), "MQUEUE_CHILD");
+        _exit(1);
+    }
+
+    while (true) {
+        MessageHeader header;
+        std::string_view payload;
+        unsigned int priority = 0;
+        std::string error;
+
+        if (!receiveFrame(header, payload, priority, error)) {
+            logger_.error("Erro na fila: " + error, "MQUEUE_CHILD");
+            break;
+        }
+
+        if (header.messageType() == MessageType::CONTROL) {
+            logger_.info("Controle de fim recebido - pai fechou a fila", "MQUEUE_CHILD");
+            break;
+        }
+
+        if (priority >= PRIORITY_LEVELS) {
+            logger_.warning("Frame com prioridade fora da faixa: " + std::to_string(priority), "MQUEUE_CHILD");
+            continue;
+        }
+
+        // Sequências comparadas só dentro da mesma prioridade - entre níveis o
+        // kernel reordena de propósito
+        FrameTracker& tracker = rx_trackers_[priority];
+        uint64_t missing = tracker.observe(header, monotonicNowNs());
+        if (missing > 0) {
+            logger_.warning("Buraco na sequência (prioridade " + std::to_string(priority) + "): " +
+                            std::to_string(missing) + " mensagem(ns) perdida(s) antes de " +
+                            std::to_string(header.sequence), "MQUEUE_CHILD");
+        }
+
+        updateOperation(MessageBuffer::copyOf(payload), payload.size(), "received");
+        last_operation_.priority = priority;
+        last_operation_.sequence = header.sequence;
+        last_operation_.latency_us = tracker.last_latency_ns / 1000.0;
+        last_operation_.queue_depth = getQueueDepth();
+        printJSON();
+    }
+
+    closeQueue();
+    // Filho não pode rodar os destrutores herdados do pai
+    _exit(0);
+}
+
+} // namespace ipc_project
@@ -0,0 +1,111 @@
+/**
+ * @file message_queue_manager.h
+ * @brief Fila de mensagens POSIX (mq_open/mq_send/mq_receive) com prioridades do kernel
+ */
+
+#pragma once
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+#include <mqueue.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "../common/logger.h"
+#include "../common/message_buffer.h"
+#include "../common/message_header.h"
+
+namespace ipc_project {
+
+// Atributos da fila - sem root o kernel limita a /proc/sys/fs/mqueue/{msg_max,msgsize_max}
+struct MessageQueueConfig {
+    long max_messages = 10;        // mq_maxmsg: mensagens na fila antes do mq_send bloquear
+    long message_size = 8192;      // mq_msgsize: envelope (64 bytes) + payload
+    long send_timeout_ms = 1000;   // quanto o mq_timedsend espera com a fila cheia
+
+    size_t maxPayload() const;     // message_size menos o envelope
+    std::string toJSON() const;
+};
+
+// Estrutura pra guardar dados da operação e mandar pro frontend
+struct MessageQueueData {
+    MessageBuffer message;
+    size_t bytes;
+    double time_ms;
+    std::string status;
+    unsigned int priority;     // prioridade do kernel usada no mq_send / vista no mq_receive
+    long queue_depth;          // mensagens na fila depois da operação (mq_curmsgs)
+    pid_t sender_pid;
+    pid_t receiver_pid;
+    uint64_t sequence = 0;     // sequência do envelope (MessageHeader)
+    double latency_us = 0.0;   // latência one-way medida no filho
+
+    std::string toJSON() const; // converte pra JSON
+};
+
+// Quinto mecanismo: a fila preserva as fronteiras das mensagens e entrega em
+// ordem de prioridade direto no kernel - sem framing em espaço de usuário.
+// O filho espera no descritor da fila via epoll (no Linux mqd_t é um fd)
+class MessageQueueManager {
+public:
+    // Prioridades do kernel (maior sai primeiro). 0 fica pro controle, que só
+    // é entregue depois de todos os dados pendentes
+    static constexpr unsigned int PRIORITY_CONTROL = 0;
+    static constexpr unsigned int PRIORITY_BULK = 1;
+    static constexpr unsigned int PRIORITY_NORMAL = 16;
+    static constexpr unsigned int PRIORITY_CRITICAL = 31;   // maior valor garantido pelo POSIX (MQ_PRIO_MAX - 1)
+    static constexpr size_t PRIORITY_LEVELS = PRIORITY_CRITICAL + 1;
+
+    explicit MessageQueueManager(const MessageQueueConfig& config = MessageQueueConfig());
+    ~MessageQueueManager();
+
+    bool createQueue();         // Cria a fila, faz fork e tira o nome do sistema
+    bool isParent() const;
+
+    // Comunicação
+    bool sendMessage(const std::string& message, unsigned int priority = PRIORITY_NORMAL);
+    bool sendMessage(const MessageBuffer& message, unsigned int priority = PRIORITY_NORMAL);
+    std::string receiveMessage();   // Recebe mensagem (filho) - espera no epoll
+
+    // Monitoramento
+    MessageQueueData getLastOperation() const;
+    void printJSON() const;
+    const MessageQueueConfig& getConfig() const;
+    long getQueueDepth() const;     // mq_curmsgs agora
+    pid_t getChildPid() const;
+
+    void closeQueue();          // Manda controle de fim, espera o filho e fecha
+    bool isActive() const;
+
+private:
+    MessageQueueConfig config_;
+    std::string queue_name_;
+    mqd_t send_queue_;          // pai: O_WRONLY, bloqueante (com timeout)
+    mqd_t receive_queue_;       // filho: O_RDONLY | O_NONBLOCK, registrado no epoll
+    int epoll_fd_;
+    pid_t child_pid_;
+    bool is_parent_;
+    bool is_active_;
+
+    std::vector<char> frame_buffer_;    // envelope + payload contíguos (um mq_send por mensagem)
+
+    MessageQueueData last_operation_;
+    Logger& logger_;
+
+    // O kernel entrega a prioridade mais alta primeiro, então a ordem só vale
+    // dentro de cada prioridade: uma sequência e um rastreador por nível
+    std::array<uint64_t, PRIORITY_LEVELS> next_sequence_;      // última sequência enviada (pai)
+    std::array<FrameTracker, PRIORITY_LEVELS> rx_trackers_;    // buracos/latência recebidos (filho)
+
+    // Auxiliares
+    void updateOperation(const MessageBuffer& msg, size_t bytes, const std::string& status);
+    bool sendFrame(MessageType type, std::string_view payload, unsigned int priority, std::string& error);
+    bool receiveFrame(MessageHeader& header, std::string_view& payload, unsigned int& priority,
+                      std::string& error);
+    void runChildLoop();              // Loop principal do processo filho
+};
+
+} // namespace ipc_project
@@ -4,6 +4,7 @@
  */
 
 #include "pipe_manager.h"
+#include "../common/json_writer.h"
 #include <iostream>
 #include <cstring>
 #include <errno.h>
@@ -16,16 +17,6 @@ namespace ipc_project {
 
 // Converte nossa estrutura de dados pro formato JSON seguindo especificação do enunciado
 std::string PipeData::toJSON() const {
-    // Gera timestamp ISO-8601
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now.time_since_epoch()) % 1000;
-    
-    std::ostringstream timestamp;
-    timestamp << std::put_time(std::gmtime(&time_t), "%Y-%m-%dT%H:%M:%S");
-    timestamp << "." << std::setfill('0') << std::setw(3) << ms.count() << "Z";
-    
     // Mapeia status interno para padrão da especificação
     std::string operation_type = "write";
     std::string status_type = "success";
@@ -40,23 +31,28 @@ std::string PipeData::toJSON() const {
         status_type = "error";
     }
     
-    std::ostringstream json;
-    json << "{"
-         << "\"type\":\"pipes\","
-         << "\"timestamp\":\"" << timestamp.str() << "\","
-         << "\"operation\":\"" << operation_type << "\","
-         << "\"process_id\":" << sender_pid << ","
-         << "\"data\":{"
-         << "\"message\":\"" << message << "\","
-         << "\"bytes\":" << bytes << ","
-         << "\"time_ms\":" << std::fixed << std::setprecision(3) << time_ms << ","
-         << "\"sender_pid\":" << sender_pid << ","
-         << "\"receiver_pid\":" << receiver_pid
-         << "},"
-         << "\"status\":\"" << status_type << "\","
-         << "\"error_message\":" << (status_type == "error" ? ("\"" + status + "\"") : "null")
-         << "}";
-    return json.str();
+    std::string out;
+    out.reserve(256 + message.size());
+    JSONWriter json(out);
+    json.beginObject()
+        .field("type", "pipes")
+        .field("timestamp", isoTimestampNow())
+        .field("operation", operation_type)
+        .field("process_id", sender_pid)
+        .key("data").beginObject()
+            .field("message", message.view())
+            .field("bytes", bytes)
+            .field("time_ms", time_ms, 3)
+            .field("sender_pid", sender_pid)
+            .field("receiver_pid", receiver_pid)
+            .field("sequence", sequence)
+            .field("latency_us", latency_us, 3)
+        .endObject()
+        .field("status", status_type);
+    if (status_type == "error") json.field("error_message", status);
+    else json.nullField("error_message");
+    json.endObject();
+    return out;
 }
 
 // Construtor - configura estado inicial mas nao cria o pipe ainda
@@ -64,7 +60,8 @@ PipeManager::PipeManager()
     : child_pid_(-1),
       is_parent_(true),
       is_active_(false),
-      logger_(Logger::getInstance()) {
+      logger_(Logger::getInstance()),
+      next_sequence_(0) {
     
     // Inicializa file descriptors como invalidos
     pipe_fd_[0] = -1;
@@ -72,7 +69,6 @@ PipeManager::PipeManager()
     
     // TODO: talvez seja melhor inicializar isso depois?
     // configura dados da operacao inicial
-    last_operation_.message = "";
     last_operation_.bytes = 0;
     last_operation_.time_ms = 0.0;
     last_operation_.status = "idle";
@@ -154,11 +150,16 @@ bool PipeManager::isParent() const {
 
 // Manda mensagem pelo pipe (so processo pai consegue fazer isso)
 bool PipeManager::sendMessage(const std::string& message) {
+    return sendMessage(MessageBuffer::copyOf(message));
+}
+
+// Versao sem copia - o payload vai direto do buffer pro kernel
+bool PipeManager::sendMessage(const MessageBuffer& message) {
     // Validação de entrada
     const size_t MAX_MESSAGE_SIZE = 8192 - 1; // Tamanho do buffer menos 1 para null terminator
-    if (message.length() > MAX_MESSAGE_SIZE) {
+    if (message.size() > MAX_MESSAGE_SIZE) {
         updateOperation(message, 0, "error_message_too_large");
-        logger_.error("Message too large (" + std::to_string(message.length()) + " bytes, max " + 
+        logger_.error("Message too large (" + std::to_string(message.size()) + " bytes, max " + 
                      std::to_string(MAX_MESSAGE_SIZE) + ")", "PIPE");
         return false;
     }
@@ -171,12 +172,12 @@ bool PipeManager::sendMessage(const std::string& message) {
     
     auto start_time = std::chrono::high_resolution_clock::now();
     
-    // Adiciona newline pra ficar mais facil de ler pro filho
-    std::string msg_final = message + "\n";  // mudei o nome pra ficar mais simples
-    // std::string msg_with_newline = message + "\n";  // nome antigo era muito longo
+    // Envelope binario na frente do payload - o filho le o tamanho exato
+    // em vez de procurar '\n'. writev junta os dois numa syscall so
+    MessageHeader header = makeHeader(MessageType::DATA, message.view(), ++next_sequence_);
     
     // escreve a mensagem no pipe
-    ssize_t bytes_written = write(pipe_fd_[1], msg_final.c_str(), msg_final.length());
+    ssize_t bytes_written = writeFrame(pipe_fd_[1], header, message.data(), message.size());
     
     auto end_time = std::chrono::high_resolution_clock::now();
     double elapsed = std::chrono::duration<double, std::milli>(end_time - start_time).count();
@@ -190,8 +191,10 @@ bool PipeManager::sendMessage(const std::string& message) {
     // atualiza nosso tracking de operacao
     updateOperation(message, static_cast<size_t>(bytes_written), "sent");
     last_operation_.time_ms = elapsed;
+    last_operation_.sequence = header.sequence;
     
-    logger_.info("Sent: '" + message + "' (" + std::to_string(bytes_written) + " bytes)", "PIPE");
+    logger_.info("Sent: '" + message.str() + "' (" + std::to_string(bytes_written) + " bytes, seq " +
+                 std::to_string(header.sequence) + ")", "PIPE");
     
     // Manda JSON pro stdout pra frontend ver o que aconteceu
     printJSON();
@@ -209,40 +212,32 @@ std::string PipeManager::receiveMessage() {
     
     auto start_time = std::chrono::high_resolution_clock::now();
     
-    // buffer pra guardar a mensagem que vamos receber - aumentado para 8KB
-    char buf[8192];  // buffer de 8KB para mensagens maiores
-    ssize_t bytes_read = read(pipe_fd_[0], buf, sizeof(buf) - 1);
+    std::string msg_recebida;  // nome em portugues mesmo
+    std::string error;
+    bool ok = receiveFrame(msg_recebida, error);
     
     auto end_time = std::chrono::high_resolution_clock::now();
     double elapsed = std::chrono::duration<double, std::milli>(end_time - start_time).count();
     
-    if (bytes_read == -1) {
-        updateOperation("", 0, "error_read");
-        logger_.error("Error reading from pipe: " + std::string(strerror(errno)), "PIPE_CHILD");
-        return "";
-    }
-    
-    if (bytes_read == 0) {
-        // pai fechou o pipe - nao vem mais mensagem
-        updateOperation("", 0, "eof");
-        logger_.info("EOF received - pipe closed by parent", "PIPE_CHILD");
+    if (!ok) {
+        if (error == "eof") {
+            // pai fechou o pipe - nao vem mais mensagem
+            updateOperation("", 0, "eof");
+            logger_.info("EOF received - pipe closed by parent", "PIPE_CHILD");
+        } else {
+            updateOperation("", 0, "error_" + error);
+            logger_.error("Error reading from pipe: " + error, "PIPE_CHILD");
+        }
         return "";
     }
     
-    // garante que a string termina direito
-    buf[bytes_read] = '\0';
-    std::string msg_recebida(buf);  // nome em portugues mesmo
-    
-    // remove o newline que o pai colocou
-    if (!msg_recebida.empty() && msg_recebida.back() == '\n') {
-        msg_recebida.pop_back();
-    }
-    
     // atualiza nosso tracking de operacao
-    updateOperation(msg_recebida, static_cast<size_t>(bytes_read), "received");
+    updateOperation(msg_recebida, sizeof(MessageHeader) + msg_recebida.size(), "received");
     last_operation_.time_ms = elapsed;
+    last_operation_.sequence = rx_tracker_.last_sequence;
+    last_operation_.latency_us = rx_tracker_.last_latency_ns / 1000.0;
     
-    logger_.info("Received: '" + msg_recebida + "' (" + std::to_string(bytes_read) + " bytes)", "PIPE_CHILD");
+    logger_.info("Received: '" + msg_recebida + "' (seq " + std::to_string(rx_tracker_.last_sequence) + ")", "PIPE_CHILD");
     
     // manda JSON pro stdout pra frontend ver o que aconteceu
     printJSON();
@@ -316,6 +311,11 @@ double PipeManager::getCurrentTimeMs() const {
 
 // funcao auxiliar pra atualizar dados de tracking das operacoes
 void PipeManager::updateOperation(const std::string& msg, size_t bytes, const std::string& status) {
+    updateOperation(msg.empty() ? MessageBuffer() : MessageBuffer::copyOf(msg), bytes, status);
+}
+
+// Guarda uma referencia ao buffer - nao copia o payload
+void PipeManager::updateOperation(const MessageBuffer& msg, size_t bytes, const std::string& status) {
     last_operation_.message = msg;
     last_operation_.bytes = bytes;
     last_operation_.status = status;
@@ -323,39 +323,57 @@ void PipeManager::updateOperation(const std::string& msg, size_t bytes, const st
     // tentei fazer automatico mas ficou complicado
 }
 
+// Le um envelope inteiro do pipe, confere o checksum e registra sequencia/latencia.
+// Frame com checksum errado ja foi consumido do pipe, entao so e descartado
+bool PipeManager::receiveFrame(std::string& payload, std::string& error) {
+    const size_t MAX_MESSAGE_SIZE = 8192 - 1;
+    MessageHeader header;
+    
+    while (true) {
+        if (!readFrame(pipe_fd_[0], header, payload, MAX_MESSAGE_SIZE, error)) {
+            return false;
+        }
+        if (verifyPayload(header, payload)) {
+            break;
+        }
+        rx_tracker_.checksum_errors++;
+        logger_.warning("Checksum invalido no frame " + std::to_string(header.sequence) + " - descartado", "PIPE_CHILD");
+    }
+    
+    uint64_t missing = rx_tracker_.observe(header, monotonicNowNs());
+    if (missing > 0) {
+        logger_.warning("Buraco na sequencia: " + std::to_string(missing) + " mensagem(ns) perdida(s) antes de " +
+                       std::to_string(header.sequence), "PIPE_CHILD");
+    }
+    return true;
+}
+
 // Loop principal do processo filho para receber mensagens
 void PipeManager::runChildLoop() {
     logger_.info("Iniciando loop do processo filho", "PIPES");
     
     // Loop infinito aguardando mensagens do processo pai
     while (true) {
-        char buf[8192];  // buffer de 8KB para mensagens maiores
-        ssize_t bytes_read = read(pipe_fd_[0], buf, sizeof(buf) - 1);
+        std::string message;
+        std::string error;
         
-        if (bytes_read == -1) {
-            logger_.error("Erro na leitura do pipe: " + std::string(strerror(errno)), "PIPE_CHILD");
-            break;
-        }
-        
-        if (bytes_read == 0) {
-            // Processo pai fechou o pipe
-            logger_.info("EOF recebido - processo pai fechou o pipe", "PIPE_CHILD");
+        if (!receiveFrame(message, error)) {
+            if (error == "eof") {
+                // Processo pai fechou o pipe
+                logger_.info("EOF recebido - processo pai fechou o pipe", "PIPE_CHILD");
+            } else {
+                logger_.error("Erro na leitura do pipe: " + error, "PIPE_CHILD");
+            }
             break;
         }
         
-        buf[bytes_read] = '\0';
-        std::string message(buf);
-        
-        // Remove newline se existir
-        if (!message.empty() && message.back() == '\n') {
-            message.pop_back();
-        }
-        
         if (!message.empty()) {
             logger_.info("Mensagem recebida: " + message, "PIPE_CHILD");
             
             // Atualiza operação e envia JSON
-            updateOperation(message, static_cast<size_t>(bytes_read), "received");
+            updateOperation(message, sizeof(MessageHeader) + message.size(), "received");
+            last_operation_.sequence = rx_tracker_.last_sequence;
+            last_operation_.latency_us = rx_tracker_.last_latency_ns / 1000.0;
             printJSON();
         }
     }
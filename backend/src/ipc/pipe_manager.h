@@ -9,17 +9,21 @@
 #include <unistd.h>
 #include <sys/wait.h>
 #include "../common/logger.h"
+#include "../common/message_buffer.h"
+#include "../common/message_header.h"
 
 namespace ipc_project {
 
 // Estrutura pra guardar dados do pipe e mandar pro frontend
 struct PipeData {
-    std::string message;        
+    MessageBuffer message;     // compartilha o buffer enviado (sem copia)
     size_t bytes;              // quantos bytes foram enviados
     double time_ms;            // Tempo que demorou
     std::string status;        // se funcionou ou deu erro
     pid_t sender_pid;          
     pid_t receiver_pid;        
+    uint64_t sequence = 0;     // sequencia do envelope (MessageHeader)
+    double latency_us = 0.0;   // latencia one-way medida no filho
     
     std::string toJSON() const; // converte pra JSON
 };
@@ -36,6 +40,7 @@ public:
     
     // funcoes de comunicacao
     bool sendMessage(const std::string& message);    // manda mensagem (so o pai)
+    bool sendMessage(const MessageBuffer& message);  // idem, sem copiar o payload
     std::string receiveMessage();                     // Recebe mensagem (so o filho)
     
     // pra monitorar no frontend
@@ -54,10 +59,15 @@ private:
     PipeData last_operation_;     // dados da ultima operacao
     Logger& logger_;              // Logger pra debug
     
+    uint64_t next_sequence_;      // proxima sequencia do envelope (lado do pai)
+    FrameTracker rx_tracker_;     // buracos/latencia dos frames recebidos (filho)
+    
     // funcoes auxiliares
     double getCurrentTimeMs() const;  // Pega tempo atual em ms
     void updateOperation(const std::string& msg, size_t bytes, const std::string& status);
+    void updateOperation(const MessageBuffer& msg, size_t bytes, const std::string& status);
     void runChildLoop();              // Loop principal do processo filho
+    bool receiveFrame(std::string& payload, std::string& error);  // le e valida um envelope
 };
 
 } // namespace ipc_project
\ No newline at end of file
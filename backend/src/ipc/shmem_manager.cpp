@@ -4,51 +4,98 @@
  */
 
 #include "shmem_manager.h"
+#include "../common/json_writer.h"
 #include <iostream>
 #include <cstring>
+#include <algorithm>
 #include <chrono>
 #include <format>
 #include <sys/errno.h>
 #include <signal.h>
+#include <sched.h>
+#include <climits>
+#include <poll.h>
+#include <sys/eventfd.h>
 
 namespace ipc_project {
 
+namespace {
+
+// Monotonic clock in nanoseconds - same clock for every process on the host
+uint64_t monotonicNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+} // namespace
+
+// Implementation of BusyPollStats::toJSON()
+std::string BusyPollStats::toJSON() const {
+    std::string out;
+    JSONWriter json(out);
+    json.beginObject()
+        .field("running", running)
+        .field("consumer_pid", consumer_pid)
+        .field("cpu", cpu)
+        .field("messages", messages)
+        .field("missed", missed)
+        .field("spin_wakeups", spin_wakeups)
+        .field("futex_wakeups", futex_wakeups)
+        .field("min_latency_ns", min_latency_ns)
+        .field("max_latency_ns", max_latency_ns)
+        .field("avg_latency_ns", avg_latency_ns, 1)
+        .endObject();
+    return out;
+}
+
 // Implementation of SharedMemoryData::toJSON()
 std::string SharedMemoryData::toJSON() const {
-    std::string waiting_pids = "[";
-    for (size_t i = 0; i < waiting_processes.size(); ++i) {
-        if (i > 0) waiting_pids += ",";
-        waiting_pids += std::to_string(waiting_processes[i]);
-    }
-    waiting_pids += "]";
-    
-    std::string error_str = error_message.empty() ? "null" : ("\"" + error_message + "\"");
-    
-    return std::format(R"({{
-  "type": "shared_memory",
-  "timestamp": "{}",
-  "operation": "{}",
-  "process_id": {},
-  "data": {{
-    "content": "{}",
-    "size": {},
-    "sync_state": "{}",
-    "waiting_processes": {},
-    "last_modified": "{}"
-  }},
-  "status": "{}",
-  "error_message": {}
-}})", getCurrentTimestamp(), operation, process_id, content, size, sync_state, 
-     waiting_pids, last_modified, status, error_str);
+    std::string out;
+    out.reserve(256 + content.size());
+    JSONWriter json(out);
+    json.beginObject()
+        .field("type", "shared_memory")
+        .field("timestamp", getCurrentTimestamp())
+        .field("operation", operation)
+        .field("process_id", process_id)
+        .key("data").beginObject()
+            .field("content", content)
+            .field("size", size)
+            .field("sync_state", sync_state)
+            .key("waiting_processes").beginArray();
+    for (pid_t pid : waiting_processes) {
+        json.value(pid);
+    }
+    json.endArray()
+            .field("last_modified", last_modified)
+            .field("sequence", sequence)
+        .endObject()
+        .field("status", status);
+    if (error_message.empty()) json.nullField("error_message");
+    else json.field("error_message", error_message);
+    json.endObject();
+    return out;
 }
 
 // Constructor
 SharedMemoryManager::SharedMemoryManager() 
-    : shmid_(-1), semid_(-1), shared_segment_(nullptr), shm_key_(IPC_PRIVATE),
-      is_creator_(false), is_attached_(false), is_parent_(true), child_pid_(-1),
+    : SharedMemoryManager(SharedMemoryConfig()) {
+}
+
+SharedMemoryManager::SharedMemoryManager(const SharedMemoryConfig& config)
+    : shmid_(-1), semid_(-1), shared_segment_(nullptr), backend_(makeSharedMemoryBackend(config)),
+      config_(config), shm_key_(IPC_PRIVATE), is_creator_(false), is_attached_(false),
+      is_parent_(true), child_pid_(-1), consumer_pid_(-1), doorbell_fd_(-1),
       logger_(Logger::getInstance()) {
     
-    logger_.info("SharedMemoryManager created", "SHMEM");
+    // Only a fixed set of capacities is instantiated - fall back to the default engine
+    if (!backend_) {
+        logger_.warning(std::format("Unsupported shared memory capacity {}, using 1024", config.capacity), "SHMEM");
+        config_.capacity = SharedMemoryConfig().capacity;
+        backend_ = makeSharedMemoryBackend(config_);
+    }
+    
+    logger_.info(std::format("SharedMemoryManager created: {}", config_.toJSON()), "SHMEM");
 }
 
 // Destructor
@@ -66,7 +113,7 @@ bool SharedMemoryManager::createSharedMemory(key_t key) {
     logger_.info(std::format("Creating shared memory with key: {}", shm_key_), "SHMEM");
     
     // Create shared memory segment
-    shmid_ = shmget(shm_key_, sizeof(SharedMemorySegment), IPC_CREAT | IPC_EXCL | 0666);
+    shmid_ = shmget(shm_key_, backend_->segmentSize(), IPC_CREAT | IPC_EXCL | 0666);
     if (shmid_ == -1) {
         auto end_time = std::chrono::high_resolution_clock::now();
         double elapsed = std::chrono::duration<double, std::milli>(end_time - start_time).count();
@@ -88,33 +135,26 @@ bool SharedMemoryManager::createSharedMemory(key_t key) {
         return false;
     }
     
-    // Create semaphores
-    if (!createSemaphores()) {
+    // Create semaphores (only the semaphore lock policy needs them)
+    if (backend_->usesSemaphores() && !createSemaphores()) {
         auto end_time = std::chrono::high_resolution_clock::now();
         double elapsed = std::chrono::duration<double, std::milli>(end_time - start_time).count();
         last_operation_.time_ms = elapsed;
         return false;
     }
     
-    // Initialize structure in shared memory safely
-    memset(shared_segment_, 0, sizeof(SharedMemorySegment));
-    shared_segment_->last_writer = getpid();
-    shared_segment_->last_modified = time(nullptr);
-    shared_segment_->reader_count = 0;
-    shared_segment_->is_writing = false;
-    
-    // Use safe string copy
+    // Initialize structure in shared memory (the engine knows the layout)
     const char* init_msg = "Shared memory initialized";
-    strncpy(shared_segment_->data, init_msg, sizeof(shared_segment_->data) - 1);
-    shared_segment_->data[sizeof(shared_segment_->data) - 1] = '\0';
+    backend_->bind(shared_segment_, semid_);
+    backend_->reset(init_msg);
     
     auto end_time = std::chrono::high_resolution_clock::now();
     double elapsed = std::chrono::duration<double, std::milli>(end_time - start_time).count();
     
     updateOperation("create", "success");
     last_operation_.time_ms = elapsed;
-    last_operation_.content = shared_segment_->data;
-    last_operation_.size = sizeof(SharedMemorySegment);
+    last_operation_.content = init_msg;
+    last_operation_.size = backend_->segmentSize();
     
     logger_.info("Shared memory created successfully", "SHMEM");
     return true;
@@ -126,7 +166,7 @@ bool SharedMemoryManager::attachToMemory(key_t key) {
     
     // If we don't have ID, find existing one
     if (shmid_ == -1) {
-        shmid_ = shmget(key, sizeof(SharedMemorySegment), 0666);
+        shmid_ = shmget(key, backend_->segmentSize(), 0666);
         if (shmid_ == -1) {
             std::string error = std::format("Failed to find shared memory: {}", strerror(errno));
             logger_.error(error, "SHMEM");
@@ -136,7 +176,7 @@ bool SharedMemoryManager::attachToMemory(key_t key) {
     }
     
     // Attach segment to address space
-    shared_segment_ = static_cast<SharedMemorySegment*>(shmat(shmid_, nullptr, 0));
+    shared_segment_ = static_cast<SegmentControl*>(shmat(shmid_, nullptr, 0));
     if (shared_segment_ == (void*)-1) {
         std::string error = std::format("Failed to attach shared memory: {}", strerror(errno));
         logger_.error(error, "SHMEM");
@@ -148,17 +188,19 @@ bool SharedMemoryManager::attachToMemory(key_t key) {
     is_attached_ = true;
     
     // Attach to existing semaphores if not creator
-    if (!is_creator_ && !attachToSemaphores()) {
+    if (!is_creator_ && backend_->usesSemaphores() && !attachToSemaphores()) {
         updateOperation("attach", "error", "Failed to attach to semaphores");
         return false;
     }
     
+    backend_->bind(shared_segment_, semid_);
+    
     logger_.info("Attached to shared memory", "SHMEM");
     return true;
 }
 
 // Write message to memory
-bool SharedMemoryManager::writeMessage(const std::string& message) {
+bool SharedMemoryManager::writeMessage(std::string_view message) {
     if (!is_attached_ || !shared_segment_) {
         updateOperation("write", "error", "Not attached to shared memory");
         return false;
@@ -166,8 +208,16 @@ bool SharedMemoryManager::writeMessage(const std::string& message) {
     
     auto start_time = std::chrono::high_resolution_clock::now();
     
-    // Lock for exclusive write
-    if (!lockForWrite()) {
+    if (backend_->usesSemaphores() && semid_ == -1) {
+        updateOperation("write", "error", "Semaphores not initialized");
+        return false;
+    }
+    
+    // Locked copy straight from the caller's buffer (truncated to the capacity); the
+    // envelope sequence continues from whatever the last writer left in the segment
+    size_t length = 0;
+    uint64_t sequence = 0;
+    if (!backend_->write(message, length, sequence)) {
         auto end_time = std::chrono::high_resolution_clock::now();
         double elapsed = std::chrono::duration<double, std::milli>(end_time - start_time).count();
         updateOperation("write", "error", "Failed to acquire write lock");
@@ -175,21 +225,16 @@ bool SharedMemoryManager::writeMessage(const std::string& message) {
         return false;
     }
     
-    // Write to memory
-    strncpy(shared_segment_->data, message.c_str(), sizeof(shared_segment_->data) - 1);
-    shared_segment_->data[sizeof(shared_segment_->data) - 1] = '\0';
-    shared_segment_->last_writer = getpid();
-    shared_segment_->last_modified = time(nullptr);
-    
-    // Release lock
-    unlock();
+    // Publish to busy-poll consumers once the record is complete
+    publishSequence();
     
     auto end_time = std::chrono::high_resolution_clock::now();
     double elapsed = std::chrono::duration<double, std::milli>(end_time - start_time).count();
     
     updateOperation("write", "success");
     last_operation_.time_ms = elapsed;
-    last_operation_.content = shared_segment_->data;
+    last_operation_.content = std::string(message.substr(0, length));
+    last_operation_.sequence = sequence;
     
     logger_.info(std::format("Written to memory: {}", message), "SHMEM");
     return true;
@@ -204,8 +249,15 @@ std::string SharedMemoryManager::readMessage() {
     
     auto start_time = std::chrono::high_resolution_clock::now();
     
-    // Lock for shared read
-    if (!lockForRead()) {
+    if (backend_->usesSemaphores() && semid_ == -1) {
+        updateOperation("read", "error", "Semaphores not initialized");
+        return "";
+    }
+    
+    // Locked copy (or optimistic copy + retry, for the seqlock policy)
+    MessageHeader header;
+    std::string content;
+    if (!backend_->read(content, header)) {
         auto end_time = std::chrono::high_resolution_clock::now();
         double elapsed = std::chrono::duration<double, std::milli>(end_time - start_time).count();
         updateOperation("read", "error", "Failed to acquire read lock");
@@ -213,17 +265,23 @@ std::string SharedMemoryManager::readMessage() {
         return "";
     }
     
-    std::string content(shared_segment_->data);
-    
-    // Release lock
-    unlock();
-    
     auto end_time = std::chrono::high_resolution_clock::now();
     double elapsed = std::chrono::duration<double, std::milli>(end_time - start_time).count();
     
+    // Segment that was never written has no envelope yet
+    std::string error;
+    if (header.magic != 0 && (!validateHeader(header, backend_->capacity(), error) ||
+                              !verifyPayload(header, content))) {
+        updateOperation("read", "error", error.empty() ? "Checksum mismatch" : error);
+        last_operation_.time_ms = elapsed;
+        logger_.error("Invalid envelope in shared memory (seq " + std::to_string(header.sequence) + ")", "SHMEM");
+        return "";
+    }
+    
     updateOperation("read", "success");
     last_operation_.time_ms = elapsed;
     last_operation_.content = content;
+    last_operation_.sequence = header.sequence;
     
     logger_.info(std::format("Read from memory: {}", content), "SHMEM");
     return content;
@@ -233,6 +291,9 @@ std::string SharedMemoryManager::readMessage() {
 void SharedMemoryManager::destroySharedMemory() {
     auto start_time = std::chrono::high_resolution_clock::now();
     
+    // Consumer must be gone before the segment disappears under it
+    stopBusyPollConsumer();
+    
     if (is_creator_ && shmid_ != -1) {
         // Remove semaphores
         if (semid_ != -1) {
@@ -268,101 +329,68 @@ void SharedMemoryManager::destroySharedMemory() {
 }
 
 /**
- * @brief Acquire exclusive write lock using readers-writers synchronization
+ * @brief Acquire exclusive write lock
  * 
- * This implements the "writer" side of the classic readers-writers problem.
- * A writer must wait until all readers have finished and no other writer
- * is active before it can proceed.
+ * Delegates to the configured lock policy. For the semaphore policy this is
+ * the "writer" side of the classic readers-writers problem: a writer waits
+ * until all readers have finished and no other writer is active.
  * 
  * @return true if lock acquired successfully, false on error
  */
 bool SharedMemoryManager::lockForWrite() {
-    if (semid_ == -1) {
+    if (!shared_segment_) {
+        logger_.error("Cannot acquire write lock: not attached to shared memory", "SHMEM");
+        return false;
+    }
+    if (backend_->usesSemaphores() && semid_ == -1) {
         logger_.error("Cannot acquire write lock: semaphores not initialized", "SHMEM");
         return false;
     }
     
-    try {
-        // Block until no readers are active and no other writer holds the lock
-        // This semaphore starts at 1, so first writer gets it, blocking all others
-        semaphoreWait(SEM_WRITE);
-        
-        // Mark that we're now writing to prevent new readers
-        shared_segment_->is_writing = true;
-        return true;
-    } catch (const std::exception& e) {
-        logger_.error(std::format("Write lock error: {}", e.what()), "SHMEM");
+    if (!backend_->lockForWrite()) {
+        logger_.error(std::format("Write lock error ({} policy)", backend_->lockName()), "SHMEM");
         return false;
     }
+    return true;
 }
 
 /**
  * @brief Acquire shared read lock allowing multiple concurrent readers
  * 
- * This implements the "reader" side of the readers-writers problem.
- * Multiple readers can access the shared memory simultaneously, but
- * they block writers from accessing until all readers are done.
- * 
- * The algorithm:
- * 1. Acquire mutex to safely modify reader count
- * 2. Increment reader count
- * 3. If this is the first reader, acquire the write semaphore to block writers
- * 4. Release mutex so other readers can proceed
+ * Multiple readers can access the shared memory simultaneously, but they
+ * block writers until all readers are done. The seqlock policy does not
+ * lock at all - its reads are optimistic (see SharedMemoryEngine::read).
  * 
  * @return true if lock acquired successfully, false on error
  */
 bool SharedMemoryManager::lockForRead() {
-    if (semid_ == -1) {
+    if (!shared_segment_) {
+        logger_.error("Cannot acquire read lock: not attached to shared memory", "SHMEM");
+        return false;
+    }
+    if (backend_->usesSemaphores() && semid_ == -1) {
         logger_.error("Cannot acquire read lock: semaphores not initialized", "SHMEM");
         return false;
     }
     
-    try {
-        // Acquire mutex to safely increment reader count
-        semaphoreWait(SEM_READER_MUTEX);
-        
-        // Add ourselves to the reader count
-        shared_segment_->reader_count++;
-        
-        // If we're the first reader, block any writers from proceeding
-        if (shared_segment_->reader_count == 1) {
-            semaphoreWait(SEM_WRITE);
-        }
-        
-        // Release mutex so other readers can also acquire locks
-        semaphoreSignal(SEM_READER_MUTEX);
-        return true;
-        
-    } catch (const std::exception& e) {
-        // CRITICAL: If we fail after incrementing reader count, we must fix it
-        // Otherwise the system will think there's a reader when there isn't
-        try {
-            semaphoreWait(SEM_READER_MUTEX);
-            if (shared_segment_->reader_count > 0) {
-                shared_segment_->reader_count--;
-            }
-            semaphoreSignal(SEM_READER_MUTEX);
-        } catch (...) {
-            // Log but don't throw - we're already in error handling
-            logger_.error("Failed to clean up reader count after error", "SHMEM");
-        }
-        logger_.error(std::format("Read lock error: {}", e.what()), "SHMEM");
+    if (!backend_->lockForRead()) {
+        logger_.error(std::format("Read lock error ({} policy)", backend_->lockName()), "SHMEM");
         return false;
     }
+    return true;
 }
 
 /**
- * @brief Release either a read or write lock
+ * @brief Release the read or write lock taken through this manager
  * 
- * This function automatically detects whether the caller held a read or write
- * lock and performs the appropriate cleanup. For writers, it simply releases
- * the write semaphore. For readers, it decrements the reader count and releases
- * the write semaphore only when the last reader exits.
+ * The engine remembers which lock it handed out, so a writer releases the
+ * write lock and a reader decrements the reader count (the last reader
+ * lets writers proceed again).
  * 
  * @return true if lock released successfully, false on error
  */
 bool SharedMemoryManager::unlock() {
-    if (semid_ == -1) {
+    if (backend_->usesSemaphores() && semid_ == -1) {
         logger_.warning("Cannot unlock: semaphores not initialized", "SHMEM");
         return false;
     }
@@ -372,45 +400,17 @@ bool SharedMemoryManager::unlock() {
         return false;
     }
     
-    try {
-        if (shared_segment_->is_writing) {
-            // We were a writer - simply release the write lock
-            shared_segment_->is_writing = false;
-            semaphoreSignal(SEM_WRITE);
-            logger_.debug("Released write lock", "SHMEM");
-        } else {
-            // We were a reader - need to decrement count safely
-            semaphoreWait(SEM_READER_MUTEX);
-            
-            if (shared_segment_->reader_count > 0) {
-                shared_segment_->reader_count--;
-                
-                // If we're the last reader, allow writers to proceed
-                if (shared_segment_->reader_count == 0) {
-                    semaphoreSignal(SEM_WRITE);
-                    logger_.debug("Last reader released write lock", "SHMEM");
-                } else {
-                    logger_.debug(std::format("Reader released, {} readers remaining", 
-                                            shared_segment_->reader_count), "SHMEM");
-                }
-            } else {
-                logger_.warning("Unlock called but no active readers", "SHMEM");
-            }
-            
-            semaphoreSignal(SEM_READER_MUTEX);
-        }
-        
-        return true;
-    } catch (const std::exception& e) {
-        logger_.error(std::format("Error releasing lock: {}", e.what()), "SHMEM");
+    if (!backend_->unlock()) {
+        logger_.error("Error releasing lock (no lock held or lock operation failed)", "SHMEM");
         return false;
     }
+    return true;
 }
 
 // Create semaphore set
 bool SharedMemoryManager::createSemaphores() {
     // Create set of 3 semaphores
-    semid_ = semget(shm_key_, SEM_COUNT, IPC_CREAT | IPC_EXCL | 0666);
+    semid_ = semget(shm_key_, SemaphoreLock::SEM_COUNT, IPC_CREAT | IPC_EXCL | 0666);
     if (semid_ == -1) {
         std::string error = std::format("Failed to create semaphores: {}", strerror(errno));
         logger_.error(error, "SHMEM");
@@ -418,9 +418,9 @@ bool SharedMemoryManager::createSemaphores() {
     }
     
     // Initialize semaphores
-    if (semctl(semid_, SEM_MUTEX, SETVAL, 1) == -1 ||
-        semctl(semid_, SEM_READER_MUTEX, SETVAL, 1) == -1 ||
-        semctl(semid_, SEM_WRITE, SETVAL, 1) == -1) {
+    if (semctl(semid_, SemaphoreLock::SEM_MUTEX, SETVAL, 1) == -1 ||
+        semctl(semid_, SemaphoreLock::SEM_READER_MUTEX, SETVAL, 1) == -1 ||
+        semctl(semid_, SemaphoreLock::SEM_WRITE, SETVAL, 1) == -1) {
         
         std::string error = std::format("Failed to initialize semaphores: {}", strerror(errno));
         logger_.error(error, "SHMEM");
@@ -448,7 +448,7 @@ bool SharedMemoryManager::attachToSemaphores() {
     }
     
     // Find existing semaphore set using the same key as shared memory
-    semid_ = semget(shm_key_, SEM_COUNT, 0666);
+    semid_ = semget(shm_key_, SemaphoreLock::SEM_COUNT, 0666);
     if (semid_ == -1) {
         std::string error = std::format("Failed to find semaphores: {}", strerror(errno));
         logger_.error(error, "SHMEM");
@@ -459,84 +459,6 @@ bool SharedMemoryManager::attachToSemaphores() {
     return true;
 }
 
-/**
- * @brief Perform a semaphore operation with timeout and retry logic
- * 
- * This is the core semaphore operation function that all other semaphore
- * operations use. It includes several safety features:
- * 
- * - Timeout to prevent indefinite blocking (5 seconds)
- * - SEM_UNDO flag to automatically release semaphores if process dies
- * - Retry logic for signal interruptions
- * - Comprehensive error handling
- * 
- * @param sem_num Index of semaphore in the set (0, 1, or 2)
- * @param op Operation to perform: -1 (wait/P), +1 (signal/V), or 0 (test)
- * @return true if operation succeeded, false on timeout or error
- */
-bool SharedMemoryManager::semaphoreOp(int sem_num, int op) {
-    if (semid_ == -1) {
-        logger_.error("Cannot perform semaphore operation: not attached", "SHMEM");
-        return false;
-    }
-    
-    // Set up semaphore operation structure
-    // SEM_UNDO ensures automatic cleanup if this process dies unexpectedly
-    struct sembuf semaphore_operation = {
-        .sem_num = static_cast<unsigned short>(sem_num),
-        .sem_op = static_cast<short>(op),
-        .sem_flg = SEM_UNDO
-    };
-    
-    // Set timeout to prevent deadlocks (5 seconds should be plenty)
-    struct timespec timeout = {
-        .tv_sec = 5,
-        .tv_nsec = 0
-    };
-    
-    // Retry up to 3 times if interrupted by signals
-    int max_retries = 3;
-    for (int attempt = 0; attempt < max_retries; attempt++) {
-        int result = semtimedop(semid_, &semaphore_operation, 1, &timeout);
-        
-        if (result == 0) {
-            // Success!
-            return true;
-        }
-        
-        // Handle different types of errors
-        if (errno == EINTR) {
-            // Interrupted by signal - this is recoverable, try again
-            logger_.debug(std::format("Semaphore operation interrupted, retrying (attempt {})", attempt + 1), "SHMEM");
-            continue;
-        } else if (errno == EAGAIN || errno == ETIMEDOUT) {
-            // Timeout - this suggests a deadlock or very slow operation
-            logger_.warning(std::format("Semaphore operation timeout for sem[{}], op={}", sem_num, op), "SHMEM");
-            return false;
-        } else {
-            // Other error - probably a programming error or system issue
-            logger_.error(std::format("Semaphore operation failed: {}", strerror(errno)), "SHMEM");
-            return false;
-        }
-    }
-    
-    // If we get here, we've exhausted all retries
-    logger_.error("Semaphore operation failed after maximum retries", "SHMEM");
-    return false;
-}
-
-void SharedMemoryManager::semaphoreWait(int sem_num) {
-    if (!semaphoreOp(sem_num, -1)) {
-        throw std::runtime_error("Failed semaphore wait operation");
-    }
-}
-
-void SharedMemoryManager::semaphoreSignal(int sem_num) {
-    if (!semaphoreOp(sem_num, 1)) {
-        throw std::runtime_error("Failed semaphore signal operation");
-    }
-}
-
 // Create child process for testing
 bool SharedMemoryManager::forkAndTest() {
     if (!is_attached_) {
@@ -570,6 +492,249 @@ void SharedMemoryManager::waitForChild() {
     }
 }
 
+/**
+ * @brief Publish a new message to busy-poll consumers
+ *
+ * Stores the publication timestamp, bumps the sequence counter and wakes
+ * any consumer that gave up spinning. Both the sequence increment and the
+ * sleeping_consumers check are seq_cst: either we see the sleeper and wake
+ * it, or the sleeper's futex_wait sees the new sequence and returns at once.
+ */
+void SharedMemoryManager::publishSequence() {
+    shared_segment_->publish_ns.store(monotonicNs(), std::memory_order_relaxed);
+    shared_segment_->sequence.fetch_add(1, std::memory_order_seq_cst);
+    
+    if (shared_segment_->sleeping_consumers.load(std::memory_order_seq_cst) > 0) {
+        wakeConsumers();
+    }
+}
+
+void SharedMemoryManager::wakeConsumers() {
+    if (doorbell_fd_ != -1) {
+        eventfd_write(doorbell_fd_, 1);
+    } else {
+        shm_detail::futexWake(&shared_segment_->sequence, INT_MAX);
+    }
+}
+
+/**
+ * @brief Park the consumer until the sequence moves past last_seq
+ *
+ * The caller has already registered in sleeping_consumers. The futex wait
+ * compares the sequence atomically; the doorbell path re-checks it after
+ * registering, so a publication in between either rings the doorbell or is
+ * seen by the re-check. Both give up after 100ms to re-check the stop flag.
+ */
+void SharedMemoryManager::sleepUntilPublished(uint32_t last_seq) {
+    if (doorbell_fd_ == -1) {
+        const timespec sleep_timeout = { .tv_sec = 0, .tv_nsec = 100'000'000 };
+        shm_detail::futexWait(&shared_segment_->sequence, last_seq, &sleep_timeout);
+        return;
+    }
+    
+    if (shared_segment_->sequence.load(std::memory_order_seq_cst) != last_seq) {
+        return;
+    }
+    struct pollfd pfd = { doorbell_fd_, POLLIN, 0 };
+    if (poll(&pfd, 1, 100) > 0) {
+        eventfd_t rings;
+        eventfd_read(doorbell_fd_, &rings);   // reset the counter (non-blocking fd)
+    }
+}
+
+/**
+ * @brief Fork a consumer that busy-polls the segment's sequence counter
+ *
+ * The consumer pins itself to config.cpu, spins with a pause instruction
+ * for up to config.idle_budget_us and then parks on a futex. Every
+ * publication it observes updates the latency statistics in the segment.
+ *
+ * @return true if the consumer was started (or already running)
+ */
+bool SharedMemoryManager::startBusyPollConsumer(const BusyPollConfig& config) {
+    if (!is_attached_ || !shared_segment_) {
+        logger_.error("Cannot start busy-poll consumer without attached memory", "SHMEM");
+        return false;
+    }
+    
+    if (consumer_pid_ > 0) {
+        logger_.info("Busy-poll consumer already running", "SHMEM");
+        return true;
+    }
+    
+    // Reset statistics from any previous consumer
+    shared_segment_->consumer_stop.store(0);
+    shared_segment_->stat_messages.store(0);
+    shared_segment_->stat_missed.store(0);
+    shared_segment_->stat_spin_wakeups.store(0);
+    shared_segment_->stat_futex_wakeups.store(0);
+    shared_segment_->stat_latency_total_ns.store(0);
+    shared_segment_->stat_latency_min_ns.store(UINT64_MAX);
+    shared_segment_->stat_latency_max_ns.store(0);
+    
+    consumer_config_ = config;
+    
+    // Created before the fork so the consumer inherits the doorbell
+    if (config.eventfd_wakeup) {
+        doorbell_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (doorbell_fd_ == -1) {
+            logger_.error(std::format("Busy-poll doorbell failed: {}", strerror(errno)), "SHMEM");
+            return false;
+        }
+    }
+    
+    pid_t pid = fork();
+    if (pid == -1) {
+        logger_.error(std::format("Busy-poll fork failed: {}", strerror(errno)), "SHMEM");
+        if (doorbell_fd_ != -1) {
+            close(doorbell_fd_);
+            doorbell_fd_ = -1;
+        }
+        return false;
+    }
+    
+    if (pid == 0) {
+        is_parent_ = false;
+        runBusyPollConsumer();
+    }
+    
+    consumer_pid_ = pid;
+    logger_.info(std::format("Busy-poll consumer started: pid={} cpu={} idle_budget_us={} wakeup={}",
+                             pid, config.cpu, config.idle_budget_us,
+                             config.eventfd_wakeup ? "eventfd" : "futex"), "SHMEM");
+    return true;
+}
+
+void SharedMemoryManager::stopBusyPollConsumer() {
+    if (consumer_pid_ <= 0 || !is_parent_) {
+        return;
+    }
+    
+    if (shared_segment_) {
+        shared_segment_->consumer_stop.store(1, std::memory_order_seq_cst);
+        // Bump the futex word so a sleeping consumer re-checks the stop flag
+        shared_segment_->sequence.fetch_add(1, std::memory_order_seq_cst);
+        wakeConsumers();
+    } else {
+        kill(consumer_pid_, SIGTERM);
+    }
+    
+    int status;
+    waitpid(consumer_pid_, &status, 0);
+    if (doorbell_fd_ != -1) {
+        close(doorbell_fd_);
+        doorbell_fd_ = -1;
+    }
+    logger_.info("Busy-poll consumer stopped", "SHMEM");
+    consumer_pid_ = -1;
+}
+
+int SharedMemoryManager::getDoorbellFd() const {
+    return doorbell_fd_;
+}
+
+BusyPollStats SharedMemoryManager::getBusyPollStats() const {
+    BusyPollStats stats;
+    stats.consumer_pid = consumer_pid_;
+    stats.running = consumer_pid_ > 0 && kill(consumer_pid_, 0) == 0;
+    stats.cpu = consumer_config_.cpu;
+    
+    if (!shared_segment_) {
+        return stats;
+    }
+    
+    stats.messages = shared_segment_->stat_messages.load();
+    stats.missed = shared_segment_->stat_missed.load();
+    stats.spin_wakeups = shared_segment_->stat_spin_wakeups.load();
+    stats.futex_wakeups = shared_segment_->stat_futex_wakeups.load();
+    stats.max_latency_ns = shared_segment_->stat_latency_max_ns.load();
+    if (stats.messages > 0) {
+        stats.min_latency_ns = shared_segment_->stat_latency_min_ns.load();
+        stats.avg_latency_ns = static_cast<double>(shared_segment_->stat_latency_total_ns.load()) /
+                               static_cast<double>(stats.messages);
+    }
+    return stats;
+}
+
+/**
+ * @brief Main loop of the busy-poll consumer process (never returns)
+ *
+ * Spins on the sequence counter; the latency of each publication is the
+ * difference between the moment we observe it and publish_ns. Reading the
+ * payload still goes through the reader lock, but only after the latency
+ * sample has been taken.
+ */
+void SharedMemoryManager::runBusyPollConsumer() {
+    SegmentControl* seg = shared_segment_;
+    const BusyPollConfig config = consumer_config_;
+    
+    if (config.cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(config.cpu, &set);
+        if (sched_setaffinity(0, sizeof(set), &set) == -1) {
+            logger_.warning(std::format("Failed to pin consumer to CPU {}: {}", config.cpu, strerror(errno)), "SHMEM_CHILD");
+        }
+    }
+    
+    const uint64_t idle_budget_ns = static_cast<uint64_t>(config.idle_budget_us) * 1000;
+    uint32_t last_seq = seg->sequence.load(std::memory_order_acquire);
+    
+    while (!seg->consumer_stop.load(std::memory_order_relaxed)) {
+        uint32_t seq = seg->sequence.load(std::memory_order_acquire);
+        bool slept = false;
+        
+        if (seq == last_seq) {
+            // Spin phase - check the clock only every 256 iterations
+            uint64_t spin_start = monotonicNs();
+            uint32_t iterations = 0;
+            while ((seq = seg->sequence.load(std::memory_order_acquire)) == last_seq) {
+                shm_detail::cpuRelax();
+                if (++iterations % 256 == 0 && config.futex_fallback &&
+                    monotonicNs() - spin_start >= idle_budget_ns) {
+                    break;
+                }
+            }
+            
+            // Idle budget exhausted - sleep in the kernel until the writer wakes us
+            if (seq == last_seq) {
+                seg->sleeping_consumers.fetch_add(1, std::memory_order_seq_cst);
+                sleepUntilPublished(last_seq);
+                seg->sleeping_consumers.fetch_sub(1, std::memory_order_seq_cst);
+                seq = seg->sequence.load(std::memory_order_acquire);
+                slept = true;
+                if (seq == last_seq) continue; // timeout or spurious wakeup
+            }
+        }
+        
+        uint64_t observed_ns = monotonicNs();
+        if (seg->consumer_stop.load(std::memory_order_relaxed)) break;
+        
+        uint64_t published_ns = seg->publish_ns.load(std::memory_order_relaxed);
+        uint64_t latency = observed_ns > published_ns ? observed_ns - published_ns : 0;
+        
+        seg->stat_messages.fetch_add(1, std::memory_order_relaxed);
+        seg->stat_missed.fetch_add(seq - last_seq - 1, std::memory_order_relaxed);
+        (slept ? seg->stat_futex_wakeups : seg->stat_spin_wakeups).fetch_add(1, std::memory_order_relaxed);
+        seg->stat_latency_total_ns.fetch_add(latency, std::memory_order_relaxed);
+        if (latency < seg->stat_latency_min_ns.load(std::memory_order_relaxed)) {
+            seg->stat_latency_min_ns.store(latency, std::memory_order_relaxed);
+        }
+        if (latency > seg->stat_latency_max_ns.load(std::memory_order_relaxed)) {
+            seg->stat_latency_max_ns.store(latency, std::memory_order_relaxed);
+        }
+        last_seq = seq;
+        
+        // Consume the payload outside of the measured window
+        std::string content;
+        MessageHeader header;
+        backend_->read(content, header);
+    }
+    
+    // Child must not run the parent's destructors (they would destroy the segment)
+    _exit(0);
+}
+
 // Utility functions and getters
 SharedMemoryData SharedMemoryManager::getLastOperation() const {
     return last_operation_;
@@ -587,6 +752,10 @@ key_t SharedMemoryManager::getKey() const {
     return shm_key_;
 }
 
+const SharedMemoryConfig& SharedMemoryManager::getConfig() const {
+    return config_;
+}
+
 bool SharedMemoryManager::isParent() const {
     return is_parent_;
 }
@@ -626,15 +795,14 @@ void SharedMemoryManager::updateOperation(const std::string& op, const std::stri
 }
 
 void SharedMemoryManager::cleanup() {
+    stopBusyPollConsumer();
+    
     // Force unlock any locks we might be holding before cleanup
     if (shared_segment_ && shared_segment_ != (void*)-1) {
         try {
-            // Emergency cleanup of any locks we might be holding
+            // Emergency cleanup of any locks we might be holding (no-op if we hold none)
             if (shared_segment_->is_writing) {
-                shared_segment_->is_writing = false;
-                if (semid_ != -1) {
-                    semaphoreSignal(SEM_WRITE);
-                }
+                backend_->unlock();
             }
         } catch (...) {
             // Ignore errors during emergency cleanup
@@ -648,6 +816,7 @@ void SharedMemoryManager::cleanup() {
         }
         shared_segment_ = nullptr;
     }
+    backend_->bind(nullptr, -1);
     
     is_attached_ = false;
     shmid_ = -1;
@@ -6,13 +6,19 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
+#include <atomic>
+#include <memory>
+#include <cstdint>
 #include <sys/ipc.h>
 #include <sys/shm.h>
 #include <sys/sem.h>
 #include <unistd.h>
 #include <sys/wait.h>
 #include "../common/logger.h"
+#include "../common/message_header.h"
+#include "shmem_segment.h"
 
 namespace ipc_project {
 
@@ -33,24 +39,49 @@ struct SharedMemoryData {
     std::string status;                    // Result status: "success" or "error"
     std::string error_message;             // Human-readable error message if operation failed
     double time_ms;                        // Time taken for the operation in milliseconds
+    uint64_t sequence = 0;                 // Envelope sequence of the message written/read
     
     std::string toJSON() const;            // Serialize this data to JSON format
     std::string getCurrentTimestamp() const; // Get current time in ISO format
 };
 
 /**
- * @brief Internal structure that resides in the shared memory segment
- * 
- * This is the actual data structure that gets mapped into shared memory
- * and is accessible by all processes. It contains both the user data
- * and synchronization metadata.
+ * @brief Configuration for the busy-poll (ultra-low-latency) consumer
+ *
+ * The consumer is a child process that spins on the segment's sequence
+ * counter instead of sleeping in the kernel. After spinning for
+ * idle_budget_us without seeing a new message it parks on a futex
+ * (if futex_fallback is enabled) until the writer wakes it up. With
+ * eventfd_wakeup it parks on an eventfd doorbell instead, which can also
+ * be registered in any epoll loop (see getDoorbellFd()).
  */
-struct SharedMemorySegment {
-    char data[1024];                       // User data storage (null-terminated string)
-    pid_t last_writer;                     // Process ID of the last writer
-    time_t last_modified;                  // Unix timestamp of last modification
-    int reader_count;                      // Number of processes currently reading
-    bool is_writing;                       // True if a writer currently holds the lock
+struct BusyPollConfig {
+    int cpu = -1;                          // CPU to pin the consumer to (-1 = no pinning)
+    uint32_t idle_budget_us = 1000;        // How long to spin before falling back to a kernel sleep
+    bool futex_fallback = true;            // If false, the consumer spins forever
+    bool eventfd_wakeup = false;           // Sleep on an eventfd doorbell instead of the futex
+};
+
+/**
+ * @brief Latency statistics measured by the busy-poll consumer
+ *
+ * Latency is one-way: from the writer publishing the sequence number
+ * (CLOCK_MONOTONIC timestamp stored in the segment) to the consumer
+ * observing it.
+ */
+struct BusyPollStats {
+    bool running = false;                  // If the consumer process is alive
+    pid_t consumer_pid = -1;               // PID of the consumer process
+    int cpu = -1;                          // CPU the consumer is pinned to
+    uint64_t messages = 0;                 // Publications observed by the consumer
+    uint64_t missed = 0;                   // Publications overwritten before being observed
+    uint64_t spin_wakeups = 0;             // Messages picked up while spinning
+    uint64_t futex_wakeups = 0;            // Messages picked up after a kernel sleep (futex or eventfd)
+    uint64_t min_latency_ns = 0;
+    uint64_t max_latency_ns = 0;
+    double avg_latency_ns = 0.0;
+
+    std::string toJSON() const;
 };
 
 /**
@@ -71,16 +102,21 @@ struct SharedMemorySegment {
  * - Writers get exclusive access
  * - Readers are blocked while a writer is active
  * - Writers are blocked while any readers are active
+ *
+ * Capacity, lock policy and record layout are compile-time parameters of
+ * SharedMemoryEngine (shmem_segment.h); this class is the type-erased
+ * facade that picks the engine from a SharedMemoryConfig at runtime.
  */
 class SharedMemoryManager {
 public:
     SharedMemoryManager();
+    explicit SharedMemoryManager(const SharedMemoryConfig& config); // Engine chosen from config
     ~SharedMemoryManager();
 
     // Basic shared memory operations
     bool createSharedMemory(key_t key = IPC_PRIVATE);  // Create segment
     bool attachToMemory(key_t key);                    // Attach to existing segment
-    bool writeMessage(const std::string& message);     // Write to memory
+    bool writeMessage(std::string_view message);       // Write to memory (no intermediate copy)
     std::string readMessage();                         // Read from memory
     void destroySharedMemory();                        // Remove segment
     
@@ -94,44 +130,45 @@ public:
     void printJSON() const;                            // Print JSON to stdout
     bool isActive() const;                             // If active
     key_t getKey() const;                              // Segment key
+    const SharedMemoryConfig& getConfig() const;       // Capacity / lock / layout in use
     
     // Multi-process operations
     bool forkAndTest();                                // Create child process for testing
     bool isParent() const;                             // If this is the parent process
     void waitForChild();                               // Wait for child process to finish
+    
+    // Busy-poll consumer (ultra-low-latency mode)
+    bool startBusyPollConsumer(const BusyPollConfig& config = BusyPollConfig()); // Fork pinned consumer
+    void stopBusyPollConsumer();                       // Stop and reap the consumer
+    BusyPollStats getBusyPollStats() const;            // Latency measured by the consumer
+    int getDoorbellFd() const;                         // eventfd the consumer sleeps on (-1 if futex)
 
 private:
     int shmid_;                            // Shared memory segment ID
     int semid_;                            // Semaphore set ID
-    SharedMemorySegment* shared_segment_;  // Pointer to mapped segment
+    SegmentControl* shared_segment_;       // Pointer to mapped segment (control block at offset 0)
+    std::unique_ptr<SharedMemoryBackend> backend_; // Engine for the configured capacity/lock/layout
+    SharedMemoryConfig config_;            // Configuration the engine was built from
     key_t shm_key_;                        // Shared memory key
     bool is_creator_;                      // If this process created the segment
     bool is_attached_;                     // If attached to segment
     bool is_parent_;                       // If this is the parent process
     pid_t child_pid_;                      // Child process PID
+    pid_t consumer_pid_;                   // Busy-poll consumer PID (-1 if not running)
+    BusyPollConfig consumer_config_;       // Config the consumer was started with
+    int doorbell_fd_;                      // eventfd wake-up path (-1 = futex)
     
     SharedMemoryData last_operation_;      // Last operation data
     Logger& logger_;                       // Logger for debugging
     
-    /**
-     * @brief Semaphore indices for the semaphore set
-     * 
-     * We use a set of 3 semaphores to implement the readers-writers synchronization:
-     * - SEM_MUTEX: General purpose mutex (currently unused but reserved)
-     * - SEM_READER_MUTEX: Protects the reader_count variable
-     * - SEM_WRITE: Controls exclusive access for writers and blocks new readers when a writer is waiting
-     */
-    static const int SEM_MUTEX = 0;       // General mutex semaphore (reserved)
-    static const int SEM_READER_MUTEX = 1; // Protects reader_count modifications
-    static const int SEM_WRITE = 2;        // Exclusive write access control
-    static const int SEM_COUNT = 3;        // Total number of semaphores in the set
-    
     // Helper operations
     bool createSemaphores();               // Create semaphore set
     bool attachToSemaphores();             // Attach to existing semaphores
-    bool semaphoreOp(int sem_num, int op); // Generic semaphore operation
-    void semaphoreWait(int sem_num);       // P(semaphore) - decrement
-    void semaphoreSignal(int sem_num);     // V(semaphore) - increment
+    
+    void publishSequence();                // Bump sequence and wake sleeping consumers
+    void wakeConsumers();                  // Futex wake or doorbell ring
+    void sleepUntilPublished(uint32_t last_seq); // Futex wait or doorbell wait (100ms max)
+    [[noreturn]] void runBusyPollConsumer(); // Main loop of the consumer process
     
     double getCurrentTimeMs() const;       // Get current time in ms
     std::string getCurrentTimestamp() const; // Formatted timestamp
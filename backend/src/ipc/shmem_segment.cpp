@@ -0,0 +1,209 @@
+/**
+ * @file shmem_segment.cpp
+ * @brief Out-of-line parts of the shared memory policies and the engine factory
+ */
+
+#include "shmem_segment.h"
+#include "../common/json_writer.h"
+#include "../common/logger.h"
+#include <cerrno>
+#include <climits>
+#include <format>
+#include <linux/futex.h>
+#include <sys/sem.h>
+#include <sys/syscall.h>
+
+namespace ipc_project {
+
+namespace shm_detail {
+
+long futexWait(std::atomic<uint32_t>* word, uint32_t expected, const timespec* timeout) {
+    return syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected, timeout, nullptr, 0);
+}
+
+long futexWake(std::atomic<uint32_t>* word, int count) {
+    return syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, count, nullptr, nullptr, 0);
+}
+
+/**
+ * @brief Perform a semaphore operation with timeout and retry logic
+ *
+ * - Timeout to prevent indefinite blocking (5 seconds)
+ * - SEM_UNDO flag to automatically release semaphores if process dies
+ * - Retry logic for signal interruptions
+ *
+ * @param sem_num Index of semaphore in the set (0, 1, or 2)
+ * @param op Operation to perform: -1 (wait/P), +1 (signal/V), or 0 (test)
+ * @return true if operation succeeded, false on timeout or error
+ */
+bool semaphoreOperation(int semid, int sem_num, int op) {
+    Logger& logger = Logger::getInstance();
+    if (semid == -1) {
+        logger.error("Cannot perform semaphore operation: not attached", "SHMEM");
+        return false;
+    }
+    
+    // SEM_UNDO ensures automatic cleanup if this process dies unexpectedly
+    struct sembuf semaphore_operation = {
+        .sem_num = static_cast<unsigned short>(sem_num),
+        .sem_op = static_cast<short>(op),
+        .sem_flg = SEM_UNDO
+    };
+    
+    // Set timeout to prevent deadlocks (5 seconds should be plenty)
+    struct timespec timeout = {
+        .tv_sec = 5,
+        .tv_nsec = 0
+    };
+    
+    // Retry up to 3 times if interrupted by signals
+    int max_retries = 3;
+    for (int attempt = 0; attempt < max_retries; attempt++) {
+        if (semtimedop(semid, &semaphore_operation, 1, &timeout) == 0) {
+            return true;
+        }
+        
+        if (errno == EINTR) {
+            // Interrupted by signal - this is recoverable, try again
+            logger.debug(std::format("Semaphore operation interrupted, retrying (attempt {})", attempt + 1), "SHMEM");
+            continue;
+        } else if (errno == EAGAIN || errno == ETIMEDOUT) {
+            // Timeout - this suggests a deadlock or very slow operation
+            logger.warning(std::format("Semaphore operation timeout for sem[{}], op={}", sem_num, op), "SHMEM");
+            return false;
+        } else {
+            logger.error(std::format("Semaphore operation failed: {}", strerror(errno)), "SHMEM");
+            return false;
+        }
+    }
+    
+    logger.error("Semaphore operation failed after maximum retries", "SHMEM");
+    return false;
+}
+
+} // namespace shm_detail
+
+/**
+ * Writer side of the readers-writers problem: wait until all readers have
+ * finished and no other writer is active.
+ */
+bool SemaphoreLock::lockWrite(LockContext& ctx) {
+    if (!shm_detail::semaphoreOperation(ctx.semid, SEM_WRITE, -1)) {
+        return false;
+    }
+    // Mark that we're now writing to prevent new readers
+    ctx.control->is_writing = true;
+    return true;
+}
+
+bool SemaphoreLock::unlockWrite(LockContext& ctx) {
+    ctx.control->is_writing = false;
+    return shm_detail::semaphoreOperation(ctx.semid, SEM_WRITE, 1);
+}
+
+/**
+ * Reader side: the first reader takes SEM_WRITE on behalf of all readers,
+ * the last one releases it.
+ */
+bool SemaphoreLock::lockRead(LockContext& ctx) {
+    if (!shm_detail::semaphoreOperation(ctx.semid, SEM_READER_MUTEX, -1)) {
+        return false;
+    }
+    
+    ctx.control->reader_count++;
+    
+    // If we're the first reader, block any writers from proceeding
+    if (ctx.control->reader_count == 1 && !shm_detail::semaphoreOperation(ctx.semid, SEM_WRITE, -1)) {
+        // CRITICAL: undo the increment, otherwise the system will think there's a reader when there isn't
+        ctx.control->reader_count--;
+        shm_detail::semaphoreOperation(ctx.semid, SEM_READER_MUTEX, 1);
+        return false;
+    }
+    
+    // Release mutex so other readers can also acquire locks
+    return shm_detail::semaphoreOperation(ctx.semid, SEM_READER_MUTEX, 1);
+}
+
+bool SemaphoreLock::unlockRead(LockContext& ctx) {
+    if (!shm_detail::semaphoreOperation(ctx.semid, SEM_READER_MUTEX, -1)) {
+        return false;
+    }
+    
+    bool ok = true;
+    if (ctx.control->reader_count > 0) {
+        ctx.control->reader_count--;
+        
+        // If we're the last reader, allow writers to proceed
+        if (ctx.control->reader_count == 0) {
+            ok = shm_detail::semaphoreOperation(ctx.semid, SEM_WRITE, 1);
+        }
+    } else {
+        Logger::getInstance().warning("Unlock called but no active readers", "SHMEM");
+    }
+    
+    return shm_detail::semaphoreOperation(ctx.semid, SEM_READER_MUTEX, 1) && ok;
+}
+
+std::string lockKindToString(ShmLockKind kind) {
+    switch (kind) {
+        case ShmLockKind::SEMAPHORE: return std::string(SemaphoreLock::name);
+        case ShmLockKind::FUTEX: return std::string(FutexLock::name);
+        case ShmLockKind::SEQLOCK: return std::string(SeqLock::name);
+        case ShmLockKind::NONE: return std::string(NoLock::name);
+    }
+    return "unknown";
+}
+
+bool stringToLockKind(const std::string& str, ShmLockKind& kind) {
+    if (str == "semaphore") kind = ShmLockKind::SEMAPHORE;
+    else if (str == "futex") kind = ShmLockKind::FUTEX;
+    else if (str == "seqlock") kind = ShmLockKind::SEQLOCK;
+    else if (str == "none") kind = ShmLockKind::NONE;
+    else return false;
+    return true;
+}
+
+std::string SharedMemoryConfig::toJSON() const {
+    std::string out;
+    JSONWriter json(out);
+    json.beginObject()
+        .field("capacity", capacity)
+        .field("lock", lockKindToString(lock))
+        .field("layout", layout == ShmLayoutKind::TEXT ? "text" : "binary")
+        .endObject();
+    return out;
+}
+
+namespace {
+
+template <size_t Capacity, class LockPolicy>
+std::unique_ptr<SharedMemoryBackend> makeWithLayout(ShmLayoutKind layout) {
+    if (layout == ShmLayoutKind::BINARY) {
+        return std::make_unique<SharedMemoryEngine<Capacity, LockPolicy, BinaryLayout>>();
+    }
+    return std::make_unique<SharedMemoryEngine<Capacity, LockPolicy, TextLayout>>();
+}
+
+template <size_t Capacity>
+std::unique_ptr<SharedMemoryBackend> makeWithLock(const SharedMemoryConfig& config) {
+    switch (config.lock) {
+        case ShmLockKind::SEMAPHORE: return makeWithLayout<Capacity, SemaphoreLock>(config.layout);
+        case ShmLockKind::FUTEX: return makeWithLayout<Capacity, FutexLock>(config.layout);
+        case ShmLockKind::SEQLOCK: return makeWithLayout<Capacity, SeqLock>(config.layout);
+        case ShmLockKind::NONE: return makeWithLayout<Capacity, NoLock>(config.layout);
+    }
+    return nullptr;
+}
+
+} // namespace
+
+std::unique_ptr<SharedMemoryBackend> makeSharedMemoryBackend(const SharedMemoryConfig& config) {
+    switch (config.capacity) {
+        case 1024: return makeWithLock<1024>(config);
+        case 4096: return makeWithLock<4096>(config);
+        case 65536: return makeWithLock<65536>(config);
+        default: return nullptr;
+    }
+}
+
+} // namespace ipc_project
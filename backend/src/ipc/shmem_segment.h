@@ -0,0 +1,489 @@
+/**
+ * @file shmem_segment.h
+ * @brief Compile-time configurable shared memory segment (capacity, lock policy, record layout)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <sys/types.h>
+#include <unistd.h>
+#include "../common/message_header.h"
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace ipc_project {
+
+/**
+ * @brief Control block at offset 0 of every segment, whatever the configuration
+ *
+ * Everything that is not the record itself lives here: bookkeeping shown in
+ * the frontend, the lock words used by the futex/seqlock policies and the
+ * busy-poll fields. Because it never moves, the busy-poll consumer and the
+ * facade can work on any segment through a SegmentControl pointer.
+ */
+struct SegmentControl {
+    pid_t last_writer;                     // Process ID of the last writer
+    time_t last_modified;                  // Unix timestamp of last modification
+    int reader_count;                      // Number of processes currently reading (semaphore policy)
+    bool is_writing;                       // True if a writer currently holds the lock
+
+    // Lock words for the in-segment policies (all-zero = unlocked)
+    std::atomic<uint32_t> lock_word;       // FutexLock readers + writer/waiter bits / SeqLock writer mutex
+    std::atomic<uint32_t> version;         // SeqLock version (odd while a write is in progress)
+
+    // Busy-poll fields - lock-free, so they live outside the lock protocol
+    std::atomic<uint32_t> sequence;        // Bumped after every completed write (also the futex word)
+    std::atomic<uint32_t> sleeping_consumers; // Consumers parked in futex wait
+    std::atomic<uint32_t> consumer_stop;   // Set by the parent to stop the consumer
+    std::atomic<uint64_t> publish_ns;      // CLOCK_MONOTONIC timestamp of the last publication
+
+    // Statistics written by the consumer, read by the parent
+    std::atomic<uint64_t> stat_messages;
+    std::atomic<uint64_t> stat_missed;
+    std::atomic<uint64_t> stat_spin_wakeups;
+    std::atomic<uint64_t> stat_futex_wakeups;
+    std::atomic<uint64_t> stat_latency_total_ns;
+    std::atomic<uint64_t> stat_latency_min_ns;
+    std::atomic<uint64_t> stat_latency_max_ns;
+};
+
+// The segment is shared between processes, so the atomics must never fall back to a lock
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "futex word must be lock-free");
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared counters must be lock-free");
+
+namespace shm_detail {
+
+// Shared (non-private) futex - the word lives in a segment mapped by several processes
+long futexWait(std::atomic<uint32_t>* word, uint32_t expected, const timespec* timeout = nullptr);
+long futexWake(std::atomic<uint32_t>* word, int count);
+
+// SysV semaphore operation with SEM_UNDO, 5s timeout and EINTR retries
+bool semaphoreOperation(int semid, int sem_num, int op);
+
+// Hint to the CPU that we are in a spin loop (saves power, frees the sibling hyperthread)
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+} // namespace shm_detail
+
+// Everything a lock policy needs: the control block and, for SemaphoreLock, the semaphore set
+struct LockContext {
+    SegmentControl* control = nullptr;
+    int semid = -1;
+};
+
+// ---------------------------------------------------------------------------
+// Lock policies
+//
+// Each policy provides lockWrite/unlockWrite/lockRead/unlockRead. Policies with
+// optimistic_reads = true are read with readBegin/readRetry instead of a lock.
+// ---------------------------------------------------------------------------
+
+/**
+ * @brief Classic readers-writers with a SysV semaphore set (the original protocol)
+ *
+ * - SEM_READER_MUTEX protects reader_count
+ * - SEM_WRITE is held by the writer, or by the group of readers as a whole
+ * Survives crashes thanks to SEM_UNDO, at the cost of a syscall per operation.
+ */
+struct SemaphoreLock {
+    static constexpr std::string_view name = "semaphore";
+    static constexpr bool uses_semaphores = true;
+    static constexpr bool optimistic_reads = false;
+
+    static constexpr int SEM_MUTEX = 0;        // General mutex semaphore (reserved)
+    static constexpr int SEM_READER_MUTEX = 1; // Protects reader_count modifications
+    static constexpr int SEM_WRITE = 2;        // Exclusive write access control
+    static constexpr int SEM_COUNT = 3;        // Total number of semaphores in the set
+
+    static bool lockWrite(LockContext& ctx);
+    static bool unlockWrite(LockContext& ctx);
+    static bool lockRead(LockContext& ctx);
+    static bool unlockRead(LockContext& ctx);
+};
+
+/**
+ * @brief Readers-writers lock on a futex word inside the segment
+ *
+ * lock_word = WRITER bit | WAITERS bit | number of readers. A thread sets
+ * WAITERS before it sleeps, and a release only enters the kernel (clearing
+ * the bit and waking everyone) when it finds the bit set. Uncontended
+ * lock/unlock is a single atomic in user space; only waiters enter the kernel.
+ */
+struct FutexLock {
+    static constexpr std::string_view name = "futex";
+    static constexpr bool uses_semaphores = false;
+    static constexpr bool optimistic_reads = false;
+    static constexpr uint32_t WRITER = 0x80000000u;
+    static constexpr uint32_t WAITERS = 0x40000000u;
+
+    static bool lockWrite(LockContext& ctx) {
+        auto& word = ctx.control->lock_word;
+        uint32_t current = word.load(std::memory_order_relaxed);
+        while (true) {
+            // Free (maybe with waiters): take it and leave the bit for our unlock
+            if ((current & ~WAITERS) == 0) {
+                if (word.compare_exchange_weak(current, current | WRITER, std::memory_order_acquire,
+                                               std::memory_order_relaxed)) {
+                    break;
+                }
+                continue;
+            }
+            if (!waitWhile(word, current)) continue;
+            current = word.load(std::memory_order_relaxed);
+        }
+        ctx.control->is_writing = true;
+        return true;
+    }
+
+    static bool unlockWrite(LockContext& ctx) {
+        ctx.control->is_writing = false;
+        if (ctx.control->lock_word.exchange(0, std::memory_order_release) & WAITERS) {
+            shm_detail::futexWake(&ctx.control->lock_word, INT32_MAX);
+        }
+        return true;
+    }
+
+    static bool lockRead(LockContext& ctx) {
+        auto& word = ctx.control->lock_word;
+        uint32_t current = word.load(std::memory_order_relaxed);
+        while (true) {
+            if (current & WRITER) {
+                if (waitWhile(word, current)) {
+                    current = word.load(std::memory_order_relaxed);
+                }
+                continue;
+            }
+            if (word.compare_exchange_weak(current, current + 1, std::memory_order_acquire,
+                                           std::memory_order_relaxed)) {
+                return true;
+            }
+        }
+    }
+
+    static bool unlockRead(LockContext& ctx) {
+        // Last reader out wakes a waiting writer - only if one announced itself
+        auto& word = ctx.control->lock_word;
+        if (word.fetch_sub(1, std::memory_order_release) == (WAITERS | 1)) {
+            uint32_t expected = WAITERS;
+            word.compare_exchange_strong(expected, 0, std::memory_order_relaxed);
+            shm_detail::futexWake(&word, INT32_MAX);
+        }
+        return true;
+    }
+
+private:
+    // Sets WAITERS and sleeps while the word still holds that value. Returns
+    // false if the CAS lost a race; 'current' then has the fresh value
+    static bool waitWhile(std::atomic<uint32_t>& word, uint32_t& current) {
+        if (!(current & WAITERS) &&
+            !word.compare_exchange_weak(current, current | WAITERS, std::memory_order_relaxed,
+                                        std::memory_order_relaxed)) {
+            return false;
+        }
+        shm_detail::futexWait(&word, current | WAITERS);
+        return true;
+    }
+};
+
+/**
+ * @brief Sequence lock: writers serialize on a spin/futex mutex, readers never block
+ *
+ * The writer makes version odd, writes, and makes it even again. Readers copy
+ * the record and retry if the version changed meanwhile. Best for one writer
+ * and many latency-sensitive readers; readers must copy, never hold pointers.
+ * The writer mutex is 0 = free, 1 = held, 2 = held with sleepers (Drepper,
+ * "Futexes Are Tricky"), so an uncontended unlock makes no syscall.
+ */
+struct SeqLock {
+    static constexpr std::string_view name = "seqlock";
+    static constexpr bool uses_semaphores = false;
+    static constexpr bool optimistic_reads = true;
+
+    static bool lockWrite(LockContext& ctx) {
+        auto& word = ctx.control->lock_word;
+        uint32_t state = 0;
+        if (!word.compare_exchange_strong(state, 1, std::memory_order_acquire, std::memory_order_relaxed)) {
+            if (state != 2) {
+                state = word.exchange(2, std::memory_order_acquire);
+            }
+            while (state != 0) {
+                shm_detail::futexWait(&word, 2);
+                state = word.exchange(2, std::memory_order_acquire);
+            }
+        }
+        ctx.control->is_writing = true;
+        ctx.control->version.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        return true;
+    }
+
+    static bool unlockWrite(LockContext& ctx) {
+        ctx.control->version.fetch_add(1, std::memory_order_release);
+        ctx.control->is_writing = false;
+        if (ctx.control->lock_word.exchange(0, std::memory_order_release) == 2) {
+            shm_detail::futexWake(&ctx.control->lock_word, 1);
+        }
+        return true;
+    }
+
+    static bool lockRead(LockContext&) { return true; }
+    static bool unlockRead(LockContext&) { return true; }
+
+    static uint32_t readBegin(LockContext& ctx) {
+        uint32_t version;
+        while ((version = ctx.control->version.load(std::memory_order_acquire)) & 1) {
+            shm_detail::cpuRelax();
+        }
+        return version;
+    }
+
+    static bool readRetry(LockContext& ctx, uint32_t version) {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return ctx.control->version.load(std::memory_order_relaxed) != version;
+    }
+};
+
+/**
+ * @brief No synchronization - single process, or ordering guaranteed elsewhere
+ */
+struct NoLock {
+    static constexpr std::string_view name = "none";
+    static constexpr bool uses_semaphores = false;
+    static constexpr bool optimistic_reads = false;
+
+    static bool lockWrite(LockContext& ctx) { ctx.control->is_writing = true; return true; }
+    static bool unlockWrite(LockContext& ctx) { ctx.control->is_writing = false; return true; }
+    static bool lockRead(LockContext&) { return true; }
+    static bool unlockRead(LockContext&) { return true; }
+};
+
+// ---------------------------------------------------------------------------
+// Record layouts
+//
+// A layout defines the Record stored after the control block and how a
+// message is stored into / loaded from it.
+// ---------------------------------------------------------------------------
+
+// Null-terminated text, truncated to Capacity - 1 bytes (the original layout)
+template <size_t Capacity>
+struct TextLayout {
+    static constexpr std::string_view name = "text";
+    static constexpr size_t max_payload = Capacity - 1;
+
+    struct Record {
+        MessageHeader header;              // Envelope of the message in data (magic 0 = empty)
+        char data[Capacity];               // User data storage (null-terminated string)
+    };
+
+    static size_t store(Record& record, std::string_view message) {
+        size_t length = std::min(message.size(), max_payload);
+        std::memcpy(record.data, message.data(), length);
+        record.data[length] = '\0';
+        return length;
+    }
+
+    static std::string_view payload(const Record& record) {
+        if (record.header.magic == MessageHeader::MAGIC && record.header.length <= max_payload) {
+            return std::string_view(record.data, record.header.length);
+        }
+        return std::string_view(record.data, strnlen(record.data, Capacity));
+    }
+};
+
+// Raw bytes with the length in the header - no terminator, payload starts on a cache line
+template <size_t Capacity>
+struct BinaryLayout {
+    static constexpr std::string_view name = "binary";
+    static constexpr size_t max_payload = Capacity;
+
+    struct Record {
+        MessageHeader header;
+        alignas(64) char data[Capacity];
+    };
+
+    static size_t store(Record& record, std::string_view message) {
+        size_t length = std::min(message.size(), max_payload);
+        std::memcpy(record.data, message.data(), length);
+        return length;
+    }
+
+    static std::string_view payload(const Record& record) {
+        size_t length = record.header.magic == MessageHeader::MAGIC ? record.header.length : 0;
+        return std::string_view(record.data, std::min(length, max_payload));
+    }
+};
+
+// Segment = control block + record of the chosen layout
+template <size_t Capacity, template <size_t> class Layout>
+struct BasicSharedMemorySegment : SegmentControl {
+    static_assert(Capacity >= 2, "segment capacity too small");
+    typename Layout<Capacity>::Record record;
+};
+
+/**
+ * @brief Runtime interface used by SharedMemoryManager (the type-erased facade)
+ *
+ * One virtual call per operation; everything below it is the statically
+ * chosen engine.
+ */
+class SharedMemoryBackend {
+public:
+    virtual ~SharedMemoryBackend() = default;
+
+    virtual size_t segmentSize() const = 0;
+    virtual size_t capacity() const = 0;               // max payload bytes
+    virtual std::string_view lockName() const = 0;
+    virtual std::string_view layoutName() const = 0;
+    virtual bool usesSemaphores() const = 0;
+
+    virtual void bind(void* segment, int semid) = 0;   // segment = nullptr detaches
+    virtual void reset(std::string_view initial) = 0;  // zero a fresh segment and store 'initial'
+
+    virtual bool lockForWrite() = 0;
+    virtual bool lockForRead() = 0;
+    virtual bool unlock() = 0;
+
+    // Locked write; returns the stored length and fills the envelope sequence
+    virtual bool write(std::string_view message, size_t& stored, uint64_t& sequence) = 0;
+    // Locked (or optimistic) read of the record into 'out'
+    virtual bool read(std::string& out, MessageHeader& header) = 0;
+};
+
+/**
+ * @brief Statically configured segment engine
+ *
+ * All policy calls resolve at compile time, so write()/read() are straight-line
+ * code for the chosen combination. Usable directly (bind to any shared mapping)
+ * when even the facade's virtual call matters.
+ */
+template <size_t Capacity, class LockPolicy, template <size_t> class Layout>
+class SharedMemoryEngine final : public SharedMemoryBackend {
+public:
+    using Segment = BasicSharedMemorySegment<Capacity, Layout>;
+    using RecordLayout = Layout<Capacity>;
+
+    size_t segmentSize() const override { return sizeof(Segment); }
+    size_t capacity() const override { return RecordLayout::max_payload; }
+    std::string_view lockName() const override { return LockPolicy::name; }
+    std::string_view layoutName() const override { return RecordLayout::name; }
+    bool usesSemaphores() const override { return LockPolicy::uses_semaphores; }
+
+    void bind(void* segment, int semid) override {
+        segment_ = static_cast<Segment*>(segment);
+        ctx_.control = segment_;
+        ctx_.semid = semid;
+        held_ = Held::NONE;
+    }
+
+    void reset(std::string_view initial) override {
+        // Segment has atomics, so clear it as raw memory (all-zero is a valid state for them)
+        std::memset(static_cast<void*>(segment_), 0, sizeof(Segment));
+        segment_->last_writer = getpid();
+        segment_->last_modified = time(nullptr);
+        size_t length = RecordLayout::store(segment_->record, initial);
+        segment_->record.header = makeHeader(MessageType::CONTROL,
+                                             std::string_view(segment_->record.data, length), 0);
+    }
+
+    bool lockForWrite() override {
+        if (!LockPolicy::lockWrite(ctx_)) return false;
+        held_ = Held::WRITE;
+        return true;
+    }
+
+    bool lockForRead() override {
+        if (!LockPolicy::lockRead(ctx_)) return false;
+        held_ = Held::READ;
+        return true;
+    }
+
+    bool unlock() override {
+        Held held = held_;
+        held_ = Held::NONE;
+        if (held == Held::WRITE) return LockPolicy::unlockWrite(ctx_);
+        if (held == Held::READ) return LockPolicy::unlockRead(ctx_);
+        return false;
+    }
+
+    bool write(std::string_view message, size_t& stored, uint64_t& sequence) override {
+        if (!LockPolicy::lockWrite(ctx_)) return false;
+
+        auto& record = segment_->record;
+        stored = RecordLayout::store(record, message);
+        // Sequence continues from whatever the last writer (possibly another process) left
+        sequence = record.header.sequence + 1;
+        record.header = makeHeader(MessageType::DATA, std::string_view(record.data, stored), sequence,
+                                   stored < message.size() ? MessageFlags::TRUNCATED : MessageFlags::NONE);
+        segment_->last_writer = getpid();
+        segment_->last_modified = time(nullptr);
+
+        return LockPolicy::unlockWrite(ctx_);
+    }
+
+    bool read(std::string& out, MessageHeader& header) override {
+        const auto& record = segment_->record;
+        if constexpr (LockPolicy::optimistic_reads) {
+            uint32_t version;
+            do {
+                version = LockPolicy::readBegin(ctx_);
+                std::memcpy(static_cast<void*>(&header), &record.header, sizeof(MessageHeader));
+                out.assign(RecordLayout::payload(record));
+            } while (LockPolicy::readRetry(ctx_, version));
+            return true;
+        } else {
+            if (!LockPolicy::lockRead(ctx_)) return false;
+            header = record.header;
+            out.assign(RecordLayout::payload(record));
+            return LockPolicy::unlockRead(ctx_);
+        }
+    }
+
+    Segment* segment() const { return segment_; }
+
+private:
+    enum class Held { NONE, READ, WRITE };
+
+    Segment* segment_ = nullptr;
+    LockContext ctx_;
+    Held held_ = Held::NONE;
+};
+
+// Runtime selection for the facade - each combination maps to one engine instantiation
+enum class ShmLockKind { SEMAPHORE, FUTEX, SEQLOCK, NONE };
+enum class ShmLayoutKind { TEXT, BINARY };
+
+struct SharedMemoryConfig {
+    size_t capacity = 1024;                        // 1024, 4096 or 65536
+    ShmLockKind lock = ShmLockKind::SEMAPHORE;
+    ShmLayoutKind layout = ShmLayoutKind::TEXT;
+
+    std::string toJSON() const;
+};
+
+std::string lockKindToString(ShmLockKind kind);
+bool stringToLockKind(const std::string& str, ShmLockKind& kind);
+
+// Returns nullptr for a capacity that has no instantiation
+std::unique_ptr<SharedMemoryBackend> makeSharedMemoryBackend(const SharedMemoryConfig& config);
+
+// The original fixed configuration
+using DefaultSharedMemoryEngine = SharedMemoryEngine<1024, SemaphoreLock, TextLayout>;
+using SharedMemorySegment = DefaultSharedMemoryEngine::Segment;
+
+} // namespace ipc_project
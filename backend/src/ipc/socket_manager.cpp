@@ -4,6 +4,7 @@
  */
 
 #include "socket_manager.h"
+#include "../common/json_writer.h"
 #include <iostream>
 #include <cstring>
 #include <errno.h>
@@ -16,16 +17,6 @@ namespace ipc_project {
 
 // Converte dados da operação atual pro formato JSON seguindo especificação do enunciado
 std::string SocketData::toJSON() const {
-    // Gera timestamp ISO-8601
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now.time_since_epoch()) % 1000;
-    
-    std::ostringstream timestamp;
-    timestamp << std::put_time(std::gmtime(&time_t), "%Y-%m-%dT%H:%M:%S");
-    timestamp << "." << std::setfill('0') << std::setw(3) << ms.count() << "Z";
-    
     // Mapeia status interno para padrão da especificação
     std::string operation_type = "connect";
     std::string status_type = "success";
@@ -43,37 +34,42 @@ std::string SocketData::toJSON() const {
         status_type = "error";
     }
     
-    std::ostringstream json;
-    json << "{"
-         << "\"type\":\"sockets\","
-         << "\"timestamp\":\"" << timestamp.str() << "\","
-         << "\"operation\":\"" << operation_type << "\","
-         << "\"process_id\":" << sender_pid << ","
-         << "\"data\":{"
-         << "\"message\":\"" << message << "\","
-         << "\"bytes\":" << bytes << ","
-         << "\"time_ms\":" << std::fixed << std::setprecision(3) << time_ms << ","
-         << "\"sender_pid\":" << sender_pid << ","
-         << "\"receiver_pid\":" << receiver_pid
-         << "},"
-         << "\"status\":\"" << status_type << "\","
-         << "\"error_message\":" << (status_type == "error" ? ("\"" + status + "\"") : "null")
-         << "}";
-    return json.str();
+    std::string out;
+    out.reserve(256 + message.size());
+    JSONWriter json(out);
+    json.beginObject()
+        .field("type", "sockets")
+        .field("timestamp", isoTimestampNow())
+        .field("operation", operation_type)
+        .field("process_id", sender_pid)
+        .key("data").beginObject()
+            .field("message", message.view())
+            .field("bytes", bytes)
+            .field("time_ms", time_ms, 3)
+            .field("sender_pid", sender_pid)
+            .field("receiver_pid", receiver_pid)
+            .field("sequence", sequence)
+            .field("latency_us", latency_us, 3)
+        .endObject()
+        .field("status", status_type);
+    if (status_type == "error") json.field("error_message", status);
+    else json.nullField("error_message");
+    json.endObject();
+    return out;
 }
 
 // Construtor - inicializa o estado do socket manager
 SocketManager::SocketManager()
     : is_parent_(true),
       is_active_(false),
-      logger_(Logger::getInstance()) {
+      logger_(Logger::getInstance()),
+      next_sequence_(0) {
 
     socket_fd_[0] = -1;
     socket_fd_[1] = -1;
     child_pid_ = -1;
 
     // Inicializa estrutura da operação
-    last_operation_.message = "";
     last_operation_.bytes = 0;
     last_operation_.time_ms = 0.0;
     last_operation_.status = "idle";
@@ -155,11 +151,16 @@ bool SocketManager::isParent() const {
 
 // Função que o pai usa pra enviar mensagem ao filho
 bool SocketManager::sendMessage(const std::string& message) {
+    return sendMessage(MessageBuffer::copyOf(message));
+}
+
+// Versão sem cópia - o payload vai direto do buffer pro kernel
+bool SocketManager::sendMessage(const MessageBuffer& message) {
     // Validação de entrada
     const size_t MAX_MESSAGE_SIZE = 8192 - 1; // Tamanho do buffer menos 1 para null terminator
-    if (message.length() > MAX_MESSAGE_SIZE) {
+    if (message.size() > MAX_MESSAGE_SIZE) {
         updateOperation(message, 0, "error_message_too_large");
-        logger_.error("Message too large (" + std::to_string(message.length()) + " bytes, max " + 
+        logger_.error("Message too large (" + std::to_string(message.size()) + " bytes, max " + 
                      std::to_string(MAX_MESSAGE_SIZE) + ")", "SOCKET");
         return false;
     }
@@ -172,9 +173,11 @@ bool SocketManager::sendMessage(const std::string& message) {
 
     auto start = std::chrono::high_resolution_clock::now();
 
-    std::string msg_final = message + "\n";  // facilita leitura do lado do filho
+    // Envelope binário na frente do payload - o filho lê o tamanho exato
+    // em vez de procurar '\n'. writev manda os dois numa syscall só
+    MessageHeader header = makeHeader(MessageType::DATA, message.view(), ++next_sequence_);
 
-    ssize_t bytes_written = write(socket_fd_[1], msg_final.c_str(), msg_final.size());
+    ssize_t bytes_written = writeFrame(socket_fd_[1], header, message.data(), message.size());
 
     auto end = std::chrono::high_resolution_clock::now();
     double elapsed = std::chrono::duration<double, std::milli>(end - start).count();
@@ -187,8 +190,10 @@ bool SocketManager::sendMessage(const std::string& message) {
 
     updateOperation(message, static_cast<size_t>(bytes_written), "sent");
     last_operation_.time_ms = elapsed;
+    last_operation_.sequence = header.sequence;
 
-    logger_.info("Mensagem enviada: '" + message + "' (" + std::to_string(bytes_written) + " bytes)", "SOCKET");
+    logger_.info("Mensagem enviada: '" + message.str() + "' (" + std::to_string(bytes_written) + " bytes, seq " +
+                 std::to_string(header.sequence) + ")", "SOCKET");
 
     printJSON(); // envia resultado pro frontend via stdout
 
@@ -205,36 +210,31 @@ std::string SocketManager::receiveMessage() {
 
     auto start = std::chrono::high_resolution_clock::now();
 
-    char buf[8192];  // buffer de 8KB para mensagens maiores
-    ssize_t bytes_read = read(socket_fd_[0], buf, sizeof(buf) - 1);
+    std::string msg;
+    std::string error;
+    bool ok = receiveFrame(msg, error);
 
     auto end = std::chrono::high_resolution_clock::now();
     double elapsed = std::chrono::duration<double, std::milli>(end - start).count();
 
-    if (bytes_read == -1) {
-        updateOperation("", 0, "error_read");
-        logger_.error("Erro ao ler do socket: " + std::string(strerror(errno)), "SOCKET_CHILD");
-        return "";
-    }
-
-    if (bytes_read == 0) {
-        // conexão fechada
-        updateOperation("", 0, "eof");
-        logger_.info("Socket fechado pelo pai (EOF)", "SOCKET_CHILD");
+    if (!ok) {
+        if (error == "eof") {
+            // conexão fechada
+            updateOperation("", 0, "eof");
+            logger_.info("Socket fechado pelo pai (EOF)", "SOCKET_CHILD");
+        } else {
+            updateOperation("", 0, "error_" + error);
+            logger_.error("Erro ao ler do socket: " + error, "SOCKET_CHILD");
+        }
         return "";
     }
 
-    buf[bytes_read] = '\0';
-    std::string msg(buf);
-
-    if (!msg.empty() && msg.back() == '\n') {
-        msg.pop_back();  // remove newline
-    }
-
-    updateOperation(msg, static_cast<size_t>(bytes_read), "received");
+    updateOperation(msg, sizeof(MessageHeader) + msg.size(), "received");
     last_operation_.time_ms = elapsed;
+    last_operation_.sequence = rx_tracker_.last_sequence;
+    last_operation_.latency_us = rx_tracker_.last_latency_ns / 1000.0;
 
-    logger_.info("Mensagem recebida: '" + msg + "' (" + std::to_string(bytes_read) + " bytes)", "SOCKET_CHILD");
+    logger_.info("Mensagem recebida: '" + msg + "' (seq " + std::to_string(rx_tracker_.last_sequence) + ")", "SOCKET_CHILD");
 
     printJSON(); // envia resultado pro frontend via stdout
 
@@ -298,45 +298,68 @@ double SocketManager::getCurrentTimeMs() const {
 
 // Atualiza estrutura com dados da operação atual
 void SocketManager::updateOperation(const std::string& msg, size_t bytes, const std::string& status) {
+    updateOperation(msg.empty() ? MessageBuffer() : MessageBuffer::copyOf(msg), bytes, status);
+}
+
+// Guarda uma referência ao buffer - não copia o payload
+void SocketManager::updateOperation(const MessageBuffer& msg, size_t bytes, const std::string& status) {
     last_operation_.message = msg;
     last_operation_.bytes = bytes;
     last_operation_.status = status;
     // tempo é preenchido na função chamadora
 }
 
+// Lê um envelope inteiro do socket, confere o checksum e registra sequência/latência.
+// Frame com checksum errado já foi consumido do stream, então só é descartado
+bool SocketManager::receiveFrame(std::string& payload, std::string& error) {
+    const size_t MAX_MESSAGE_SIZE = 8192 - 1;
+    MessageHeader header;
+
+    while (true) {
+        if (!readFrame(socket_fd_[0], header, payload, MAX_MESSAGE_SIZE, error)) {
+            return false;
+        }
+        if (verifyPayload(header, payload)) {
+            break;
+        }
+        rx_tracker_.checksum_errors++;
+        logger_.warning("Checksum inválido no frame " + std::to_string(header.sequence) + " - descartado", "SOCKET_CHILD");
+    }
+
+    uint64_t missing = rx_tracker_.observe(header, monotonicNowNs());
+    if (missing > 0) {
+        logger_.warning("Buraco na sequência: " + std::to_string(missing) + " mensagem(ns) perdida(s) antes de " +
+                       std::to_string(header.sequence), "SOCKET_CHILD");
+    }
+    return true;
+}
+
 // Loop principal do processo filho para receber mensagens
 void SocketManager::runChildLoop() {
     logger_.info("Iniciando loop do processo filho", "SOCKETS");
     
     // Loop infinito aguardando mensagens do processo pai
     while (true) {
-        char buf[8192];  // buffer de 8KB para mensagens maiores
-        ssize_t bytes_read = read(socket_fd_[0], buf, sizeof(buf) - 1);
+        std::string message;
+        std::string error;
         
-        if (bytes_read == -1) {
-            logger_.error("Erro na leitura do socket: " + std::string(strerror(errno)), "SOCKET_CHILD");
-            break;
-        }
-        
-        if (bytes_read == 0) {
-            // Processo pai fechou o socket
-            logger_.info("EOF recebido - processo pai fechou o socket", "SOCKET_CHILD");
+        if (!receiveFrame(message, error)) {
+            if (error == "eof") {
+                // Processo pai fechou o socket
+                logger_.info("EOF recebido - processo pai fechou o socket", "SOCKET_CHILD");
+            } else {
+                logger_.error("Erro na leitura do socket: " + error, "SOCKET_CHILD");
+            }
             break;
         }
         
-        buf[bytes_read] = '\0';
-        std::string message(buf);
-        
-        // Remove newline se existir
-        if (!message.empty() && message.back() == '\n') {
-            message.pop_back();
-        }
-        
         if (!message.empty()) {
             logger_.info("Mensagem recebida: " + message, "SOCKET_CHILD");
             
             // Atualiza operação e envia JSON
-            updateOperation(message, static_cast<size_t>(bytes_read), "received");
+            updateOperation(message, sizeof(MessageHeader) + message.size(), "received");
+            last_operation_.sequence = rx_tracker_.last_sequence;
+            last_operation_.latency_us = rx_tracker_.last_latency_ns / 1000.0;
             printJSON();
         }
     }
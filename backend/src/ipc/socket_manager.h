@@ -11,17 +11,21 @@
 #include <unistd.h>
 #include <sys/wait.h>
 #include "../common/logger.h"
+#include "../common/message_buffer.h"
+#include "../common/message_header.h"
 
 namespace ipc_project {
 
 // Estrutura pra guardar dados do socket e mandar pro frontend
 struct SocketData {
-    std::string message;
+    MessageBuffer message;     // compartilha o buffer enviado (sem copia)
     size_t bytes;
     double time_ms;
     std::string status;
     pid_t sender_pid;
     pid_t receiver_pid;
+    uint64_t sequence = 0;     // sequência do envelope (MessageHeader)
+    double latency_us = 0.0;   // latência one-way medida no filho
 
     std::string toJSON() const; // converte pra JSON
 };
@@ -38,6 +42,7 @@ public:
 
     // Comunicação
     bool sendMessage(const std::string& message);    // Envia mensagem (pai)
+    bool sendMessage(const MessageBuffer& message);  // idem, sem copiar o payload
     std::string receiveMessage();                    // Recebe mensagem (filho)
 
     // Monitoramento
@@ -56,10 +61,15 @@ private:
     SocketData last_operation_;
     Logger& logger_;
 
+    uint64_t next_sequence_;     // próxima sequência do envelope (pai)
+    FrameTracker rx_tracker_;    // buracos/latência dos frames recebidos (filho)
+
     // Auxiliares
     double getCurrentTimeMs() const;
     void updateOperation(const std::string& msg, size_t bytes, const std::string& status);
+    void updateOperation(const MessageBuffer& msg, size_t bytes, const std::string& status);
     void runChildLoop();              // Loop principal do processo filho
+    bool receiveFrame(std::string& payload, std::string& error);  // lê e valida um envelope
 };
 
 } // namespace ipc_project
@@ -0,0 +1,808 @@
+/**
+ * @file tcp_bridge.cpp
+ * @brief Implementacao da ponte TCP entre coordenadores
+ */
+
+#include "tcp_bridge.h"
+#include "../common/json_writer.h"
+#include <cstring>
+#include <errno.h>
+#include <algorithm>
+#include <limits.h>
+#include <unistd.h>
+#include <netdb.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+namespace ipc_project {
+
+namespace {
+
+// Escreve todos os iovecs, avançando em escrita parcial. MSG_NOSIGNAL: peer
+// fechado vira EPIPE em vez de SIGPIPE
+bool sendAll(int fd, std::vector<struct iovec>& iov, std::string& error) {
+    size_t index = 0;
+    while (index < iov.size()) {
+        struct msghdr msg{};
+        msg.msg_iov = iov.data() + index;
+        msg.msg_iovlen = std::min<size_t>(iov.size() - index, IOV_MAX);
+        ssize_t written = sendmsg(fd, &msg, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            error = std::string("send: ") + strerror(errno);
+            return false;
+        }
+        size_t left = static_cast<size_t>(written);
+        while (index < iov.size() && left >= iov[index].iov_len) {
+            left -= iov[index].iov_len;
+            index++;
+        }
+        if (left > 0) {
+            iov[index].iov_base = static_cast<char*>(iov[index].iov_base) + left;
+            iov[index].iov_len -= left;
+        }
+    }
+    return true;
+}
+
+bool sendControl(int fd, const void* payload, size_t length, std::string& error) {
+    std::string_view view(static_cast<const char*>(payload), length);
+    MessageHeader header = makeHeader(MessageType::CONTROL, view, 0);
+    std::vector<struct iovec> iov = {
+        { &header, sizeof(header) },
+        { const_cast<char*>(view.data()), view.size() }
+    };
+    return sendAll(fd, iov, error);
+}
+
+// Frame CONTROL de tamanho fixo (hello/ack)
+template <typename T>
+bool readControl(int fd, T& out, std::string& error) {
+    MessageHeader header;
+    if (!readFrameInto(fd, header, &out, sizeof(out), error)) {
+        return false;
+    }
+    if (header.messageType() != MessageType::CONTROL || header.length != sizeof(out) ||
+        !verifyPayload(header, std::string_view(reinterpret_cast<const char*>(&out), sizeof(out)))) {
+        error = "invalid_control_frame";
+        return false;
+    }
+    return true;
+}
+
+double elapsedSeconds(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - since).count();
+}
+
+} // namespace
+
+bool parseHostPort(const std::string& text, std::string& host, uint16_t& port) {
+    size_t colon = text.rfind(':');
+    std::string port_text = colon == std::string::npos ? text : text.substr(colon + 1);
+    host = colon == std::string::npos ? "" : text.substr(0, colon);
+    char* end = nullptr;
+    long value = std::strtol(port_text.c_str(), &end, 10);
+    if (port_text.empty() || *end != '\0' || value < 0 || value > 65535) {
+        port = 0;
+        return false;
+    }
+    port = static_cast<uint16_t>(value);
+    return true;
+}
+
+std::string TcpBridgeConfig::toJSON() const {
+    std::string out;
+    JSONWriter json(out);
+    json.beginObject()
+        .field("peer", peer_host + ":" + std::to_string(peer_port))
+        .field("target_mechanism", static_cast<int>(target_mechanism))
+        .field("batch_max_messages", batch_max_messages)
+        .field("batch_max_bytes", batch_max_bytes)
+        .field("window", window)
+        .field("connect_timeout_ms", connect_timeout_ms)
+        .endObject();
+    return out;
+}
+
+std::string BridgeLinkStats::toJSON() const {
+    std::string out;
+    JSONWriter json(out);
+    json.beginObject()
+        .field("type", "tcp_bridge")
+        .field("peer", peer)
+        .field("connected", connected)
+        .field("messages_sent", messages_sent)
+        .field("messages_acked", messages_acked)
+        .field("messages_failed", messages_failed)
+        .field("resent", resent)
+        .field("batches", batches)
+        .field("bytes_sent", bytes_sent)
+        .field("reconnects", reconnects)
+        .field("in_flight", in_flight)
+        .field("queued", queued)
+        .field("avg_batch", avg_batch, 3)
+        .field("messages_per_s", messages_per_s, 3)
+        .field("throughput_mb_s", throughput_mb_s, 3)
+        .field("avg_ack_latency_us", avg_ack_latency_us, 3)
+        .field("max_ack_latency_us", max_ack_latency_us, 3)
+        .field("last_error", last_error)
+        .endObject();
+    return out;
+}
+
+std::string BridgeServerStats::toJSON() const {
+    std::string out;
+    JSONWriter json(out);
+    json.beginObject()
+        .field("port", port)
+        .field("running", running)
+        .field("connections", connections)
+        .field("active_connections", active_connections)
+        .field("batches", batches)
+        .field("messages_delivered", messages_delivered)
+        .field("messages_failed", messages_failed)
+        .field("duplicates", duplicates)
+        .field("bytes_received", bytes_received)
+        .endObject();
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+// TcpBridgeLink - lado que envia
+// ---------------------------------------------------------------------------
+
+TcpBridgeLink::TcpBridgeLink(const TcpBridgeConfig& config)
+    : config_(config),
+      running_(false),
+      connected_(false),
+      socket_fd_(-1),
+      wake_fd_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+      next_sequence_(0),
+      total_ack_latency_us_(0.0),
+      logger_(Logger::getInstance()) {
+
+    // Cada iovec de mensagem ocupa 3 entradas (envelope, rota, payload)
+    config_.batch_max_messages = std::clamp<size_t>(config_.batch_max_messages, 1, (IOV_MAX - 1) / 3);
+    config_.window = std::max<size_t>(config_.window, 1);
+
+    // Identidade do link: sobrevive às reconexões, muda a cada processo/instância
+    link_id_ = monotonicNowNs() ^ (static_cast<uint64_t>(getpid()) << 40) ^ reinterpret_cast<uintptr_t>(this);
+    stats_.peer = config_.peer_host + ":" + std::to_string(config_.peer_port);
+}
+
+TcpBridgeLink::~TcpBridgeLink() {
+    stop();
+    if (wake_fd_ != -1) {
+        close(wake_fd_);
+    }
+}
+
+bool TcpBridgeLink::start() {
+    if (running_) return true;
+    if (config_.peer_host.empty() || config_.peer_port == 0) {
+        logger_.error("Ponte TCP sem peer configurado", "TCP_BRIDGE");
+        return false;
+    }
+
+    // Descarta o aviso de um stop() anterior
+    uint64_t drained;
+    while (wake_fd_ != -1 && read(wake_fd_, &drained, sizeof(drained)) > 0) {}
+
+    running_ = true;
+    started_at_ = std::chrono::steady_clock::now();
+    io_thread_ = std::thread(&TcpBridgeLink::ioLoop, this);
+    logger_.info("Link TCP iniciado para " + stats_.peer, "TCP_BRIDGE");
+    return true;
+}
+
+void TcpBridgeLink::stop() {
+    if (!running_.exchange(false)) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        // Desbloqueia a thread de leitura (ou o hello); o writer acorda pelo cv
+        if (socket_fd_ != -1) {
+            shutdown(socket_fd_, SHUT_RDWR);
+        }
+    }
+    uint64_t one = 1;
+    if (wake_fd_ != -1 && write(wake_fd_, &one, sizeof(one)) < 0) {
+        // eventfd só falha se o contador estourar - já tem aviso pendente
+    }
+    work_cv_.notify_all();
+    space_cv_.notify_all();
+
+    if (io_thread_.joinable()) {
+        io_thread_.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!pending_.empty() || !unacked_.empty()) {
+        logger_.warning("Link TCP parado com " + std::to_string(pending_.size() + unacked_.size()) +
+                        " mensagem(ns) sem ack", "TCP_BRIDGE");
+    }
+    logger_.info("Link TCP parado (" + stats_.peer + ")", "TCP_BRIDGE");
+}
+
+bool TcpBridgeLink::isRunning() const {
+    return running_;
+}
+
+bool TcpBridgeLink::isConnected() const {
+    return connected_;
+}
+
+// Só espera espaço na janela - a confirmação chega depois, em pipeline
+bool TcpBridgeLink::send(uint8_t mechanism, uint8_t priority, const MessageBuffer& message) {
+    if (!running_) return false;
+
+    if (message.size() + sizeof(BridgeRoute) + 2 * sizeof(MessageHeader) > TcpBridgeServer::MAX_BATCH_BYTES) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.last_error = "message_too_large";
+        return false;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    bool has_space = space_cv_.wait_for(lock, std::chrono::milliseconds(config_.send_timeout_ms), [&] {
+        return !running_ || pending_.size() + unacked_.size() < config_.window;
+    });
+    if (!running_) return false;
+    if (!has_space) {
+        stats_.last_error = "window_full";
+        return false;
+    }
+
+    Outgoing out;
+    out.sequence = ++next_sequence_;
+    out.route = BridgeRoute{mechanism, priority, {}};
+    out.message = message;              // referência ao mesmo buffer, sem cópia
+    out.enqueued_at = std::chrono::steady_clock::now();
+    pending_.push_back(std::move(out));
+    lock.unlock();
+
+    work_cv_.notify_one();
+    return true;
+}
+
+bool TcpBridgeLink::flush(long timeout_ms) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return space_cv_.wait_for(lock, std::chrono::milliseconds(timeout_ms), [&] {
+        return pending_.empty() && unacked_.empty();
+    });
+}
+
+BridgeLinkStats TcpBridgeLink::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    BridgeLinkStats stats = stats_;
+    stats.connected = connected_;
+    stats.in_flight = unacked_.size();
+    stats.queued = pending_.size();
+    if (stats.batches > 0) {
+        stats.avg_batch = static_cast<double>(stats.messages_sent) / static_cast<double>(stats.batches);
+    }
+    if (stats.messages_acked > 0) {
+        stats.avg_ack_latency_us = total_ack_latency_us_ / static_cast<double>(stats.messages_acked);
+    }
+    double seconds = running_ ? elapsedSeconds(started_at_) : 0.0;
+    if (seconds > 0.0) {
+        stats.messages_per_s = static_cast<double>(stats.messages_acked) / seconds;
+        stats.throughput_mb_s = static_cast<double>(stats.bytes_sent) / (1024.0 * 1024.0) / seconds;
+    }
+    return stats;
+}
+
+const TcpBridgeConfig& TcpBridgeLink::getConfig() const {
+    return config_;
+}
+
+// Conecta, reconecta com backoff e escreve lotes enquanto a conexão vive
+void TcpBridgeLink::ioLoop() {
+    long backoff_ms = config_.reconnect_initial_ms;
+
+    while (running_) {
+        if (!connectPeer()) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            work_cv_.wait_for(lock, std::chrono::milliseconds(backoff_ms), [&] { return !running_.load(); });
+            backoff_ms = std::min(backoff_ms * 2, config_.reconnect_max_ms);
+            continue;
+        }
+        backoff_ms = config_.reconnect_initial_ms;
+
+        int fd = socket_fd_;
+        std::thread reader(&TcpBridgeLink::readerLoop, this, fd);
+
+        while (running_ && connected_) {
+            std::vector<Outgoing> batch;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                work_cv_.wait(lock, [&] { return !running_ || !connected_ || !pending_.empty(); });
+                if (!running_ || !connected_) break;
+
+                // Junta o que estiver na fila num lote só (um writev)
+                size_t bytes = 0;
+                while (!pending_.empty() && batch.size() < config_.batch_max_messages &&
+                       (batch.empty() || bytes + pending_.front().message.size() <= config_.batch_max_bytes)) {
+                    bytes += pending_.front().message.size();
+                    unacked_.push_back(pending_.front());
+                    batch.push_back(std::move(pending_.front()));
+                    pending_.pop_front();
+                }
+            }
+
+            if (!writeBatch(fd, batch)) {
+                connected_ = false;
+            }
+        }
+
+        // Conexão caiu (ou stop): fecha, espera o leitor e devolve o que ficou sem ack pra fila
+        connected_ = false;
+        shutdown(fd, SHUT_RDWR);
+        reader.join();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        close(fd);
+        socket_fd_ = -1;
+        if (running_) {
+            stats_.reconnects++;
+            stats_.resent += unacked_.size();
+            pending_.insert(pending_.begin(), std::make_move_iterator(unacked_.begin()),
+                            std::make_move_iterator(unacked_.end()));
+            unacked_.clear();
+            logger_.warning("Conexão com " + stats_.peer + " caiu (" + stats_.last_error + "), reconectando", "TCP_BRIDGE");
+        }
+    }
+}
+
+// Resolve, conecta com TCP_NODELAY e faz o hello: o ack do hello diz até onde
+// o servidor já entregou, então o que estava em voo e chegou não é reenviado
+bool TcpBridgeLink::connectPeer() {
+    struct addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    struct addrinfo* addresses = nullptr;
+    std::string port = std::to_string(config_.peer_port);
+
+    int rc = getaddrinfo(config_.peer_host.c_str(), port.c_str(), &hints, &addresses);
+    if (rc != 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.last_error = std::string("resolve: ") + gai_strerror(rc);
+        return false;
+    }
+
+    int fd = -1;
+    std::string error = "connect: no address";
+    for (struct addrinfo* ai = addresses; ai && running_; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC | SOCK_NONBLOCK, ai->ai_protocol);
+        if (fd == -1) continue;
+        {
+            // Publicado já no connect: o stop() derruba o hello pendurado
+            std::lock_guard<std::mutex> lock(mutex_);
+            socket_fd_ = fd;
+        }
+        bool connected = connect(fd, ai->ai_addr, ai->ai_addrlen) == 0;
+        if (!connected && errno == EINPROGRESS) {
+            connected = waitConnected(fd, error);
+        } else if (!connected) {
+            error = std::string("connect: ") + strerror(errno);
+        }
+        if (connected && running_) break;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        socket_fd_ = -1;
+        close(fd);
+        fd = -1;
+    }
+    freeaddrinfo(addresses);
+
+    if (fd == -1) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_) {
+            stats_.last_error = error;
+        }
+        return false;
+    }
+
+    // Daqui pra frente o socket volta a ser bloqueante (writer/leitor dedicados)
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK);
+
+    // Lotes já agregam as mensagens - Nagle só atrasaria o último pedaço de cada um
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+    // O handshake não pode travar o link se o peer aceitar e não responder
+    struct timeval timeout = { config_.connect_timeout_ms / 1000,
+                               static_cast<suseconds_t>((config_.connect_timeout_ms % 1000) * 1000) };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    BridgeHello hello{link_id_, 0};
+    BridgeAck ack{};
+    if (!sendControl(fd, &hello, sizeof(hello), error) || !readControl(fd, ack, error)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        socket_fd_ = -1;
+        close(fd);
+        if (running_) {
+            stats_.last_error = "handshake: " + error;
+        }
+        return false;
+    }
+
+    timeout = { 0, 0 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    handleAck(ack);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        connected_ = true;
+        stats_.last_error.clear();
+    }
+    logger_.info("Conectado a " + stats_.peer + " (entregue até seq " + std::to_string(ack.sequence) + ")",
+                 "TCP_BRIDGE");
+    return true;
+}
+
+// connect não bloqueante: espera o socket ficar gravável até connect_timeout_ms,
+// ou o stop() escrever no eventfd
+bool TcpBridgeLink::waitConnected(int fd, std::string& error) {
+    struct pollfd fds[2] = {
+        { fd, POLLOUT, 0 },
+        { wake_fd_, POLLIN, 0 }
+    };
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(config_.connect_timeout_ms);
+
+    while (true) {
+        long left = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()).count();
+        if (left <= 0) {
+            error = "connect: timeout";
+            return false;
+        }
+        int ready = poll(fds, wake_fd_ == -1 ? 1 : 2, static_cast<int>(std::min<long>(left, INT_MAX)));
+        if (ready == -1) {
+            if (errno == EINTR) continue;
+            error = std::string("connect: ") + strerror(errno);
+            return false;
+        }
+        if (fds[1].revents & POLLIN) {
+            error = "connect: stopped";
+            return false;
+        }
+        if (fds[0].revents) break;
+    }
+
+    int socket_error = 0;
+    socklen_t length = sizeof(socket_error);
+    if (getsockopt(fd, SOL_SOCKET, SO_ERROR, &socket_error, &length) == -1) {
+        socket_error = errno;
+    }
+    if (socket_error != 0) {
+        error = std::string("connect: ") + strerror(socket_error);
+        return false;
+    }
+    return true;
+}
+
+void TcpBridgeLink::readerLoop(int fd) {
+    std::string error;
+    BridgeAck ack{};
+    while (readControl(fd, ack, error)) {
+        handleAck(ack);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (running_ && connected_) {
+            stats_.last_error = error;
+        }
+        connected_ = false;
+    }
+    work_cv_.notify_all();
+}
+
+// Ack cumulativo: libera tudo até a sequência confirmada
+void TcpBridgeLink::handleAck(const BridgeAck& ack) {
+    auto now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto release = [&](std::deque<Outgoing>& queue) {
+            while (!queue.empty() && queue.front().sequence <= ack.sequence) {
+                double latency = std::chrono::duration<double, std::micro>(now - queue.front().enqueued_at).count();
+                total_ack_latency_us_ += latency;
+                stats_.max_ack_latency_us = std::max(stats_.max_ack_latency_us, latency);
+                stats_.messages_acked++;
+                queue.pop_front();
+            }
+        };
+        release(unacked_);
+        release(pending_);     // reenvios que o hello mostrou que já tinham chegado
+        stats_.messages_failed += ack.failed;
+    }
+    space_cv_.notify_all();
+}
+
+// Um frame BATCH com os frames DATA dentro, tudo num sendmsg. Cada frame
+// interno tem o próprio CRC32C (rota + payload); o BATCH externo só delimita
+bool TcpBridgeLink::writeBatch(int fd, std::vector<Outgoing>& batch) {
+    std::vector<MessageHeader> headers(batch.size());
+    std::vector<struct iovec> iov;
+    iov.reserve(1 + 3 * batch.size());
+
+    MessageHeader outer;
+    outer.type = static_cast<uint16_t>(MessageType::BATCH);
+    outer.sender_pid = static_cast<int32_t>(getpid());
+    iov.push_back({ &outer, sizeof(outer) });
+
+    size_t inner_bytes = 0;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        Outgoing& out = batch[i];
+        MessageHeader& header = headers[i];
+        header = makeHeader(MessageType::DATA, out.message.view(), out.sequence,
+                            i + 1 == batch.size() ? MessageFlags::LAST_IN_BATCH : MessageFlags::NONE);
+        header.length += sizeof(BridgeRoute);
+        header.checksum = computeChecksum(out.message.data(), out.message.size(),
+                                          computeChecksum(&out.route, sizeof(BridgeRoute)));
+
+        iov.push_back({ &header, sizeof(header) });
+        iov.push_back({ &out.route, sizeof(BridgeRoute) });
+        if (!out.message.empty()) {
+            iov.push_back({ const_cast<char*>(out.message.data()), out.message.size() });
+        }
+        inner_bytes += sizeof(header) + header.length;
+    }
+    outer.length = static_cast<uint32_t>(inner_bytes);
+    outer.sequence = batch.back().sequence;
+    outer.timestamp_ns = monotonicNowNs();
+
+    std::string error;
+    if (!sendAll(fd, iov, error)) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.last_error = error;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.batches++;
+    stats_.messages_sent += batch.size();
+    stats_.bytes_sent += sizeof(outer) + inner_bytes;
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// TcpBridgeServer - lado que recebe
+// ---------------------------------------------------------------------------
+
+TcpBridgeServer::TcpBridgeServer(DeliverFn deliver)
+    : deliver_(std::move(deliver)),
+      running_(false),
+      listen_fd_(-1),
+      port_(0),
+      logger_(Logger::getInstance()) {
+}
+
+TcpBridgeServer::~TcpBridgeServer() {
+    stop();
+}
+
+bool TcpBridgeServer::start(const std::string& host, uint16_t port) {
+    if (running_) return true;
+
+    listen_fd_ = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listen_fd_ == -1) {
+        logger_.error("Erro ao criar socket da ponte: " + std::string(strerror(errno)), "TCP_BRIDGE");
+        return false;
+    }
+
+    int opt = 1;
+    setsockopt(listen_fd_, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+
+    struct sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(port);
+    if (host.empty() || host == "0.0.0.0" || host == "*") {
+        address.sin_addr.s_addr = INADDR_ANY;
+    } else if (inet_pton(AF_INET, host == "localhost" ? "127.0.0.1" : host.c_str(), &address.sin_addr) != 1) {
+        logger_.error("Endereço inválido pra ponte: " + host, "TCP_BRIDGE");
+        close(listen_fd_);
+        listen_fd_ = -1;
+        return false;
+    }
+
+    if (bind(listen_fd_, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)) == -1 ||
+        listen(listen_fd_, 16) == -1) {
+        logger_.error("Erro no bind/listen da ponte (porta " + std::to_string(port) + "): " +
+                      strerror(errno), "TCP_BRIDGE");
+        close(listen_fd_);
+        listen_fd_ = -1;
+        return false;
+    }
+
+    socklen_t length = sizeof(address);
+    getsockname(listen_fd_, reinterpret_cast<struct sockaddr*>(&address), &length);
+    port_ = ntohs(address.sin_port);
+
+    running_ = true;
+    accept_thread_ = std::thread(&TcpBridgeServer::acceptLoop, this);
+    logger_.info("Ponte TCP escutando na porta " + std::to_string(port_), "TCP_BRIDGE");
+    return true;
+}
+
+void TcpBridgeServer::stop() {
+    if (!running_.exchange(false)) return;
+
+    // shutdown desbloqueia o accept e os reads das conexões
+    shutdown(listen_fd_, SHUT_RDWR);
+    if (accept_thread_.joinable()) {
+        accept_thread_.join();
+    }
+    close(listen_fd_);
+    listen_fd_ = -1;
+
+    std::list<ClientHandler> clients;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto& client : clients_) {
+            if (!client.done) {
+                shutdown(client.fd, SHUT_RDWR);
+            }
+        }
+        clients.swap(clients_);
+    }
+    for (auto& client : clients) {
+        client.thread.join();
+    }
+    logger_.info("Ponte TCP parada (porta " + std::to_string(port_) + ")", "TCP_BRIDGE");
+}
+
+bool TcpBridgeServer::isRunning() const {
+    return running_;
+}
+
+uint16_t TcpBridgeServer::getPort() const {
+    return port_;
+}
+
+BridgeServerStats TcpBridgeServer::getStats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    BridgeServerStats stats = stats_;
+    stats.port = port_;
+    stats.running = running_;
+    stats.active_connections = std::count_if(clients_.begin(), clients_.end(),
+                                             [](const ClientHandler& client) { return !client.done; });
+    return stats;
+}
+
+// Uma thread por link - são poucos (um por coordenador remoto). Cada
+// reconexão abre outra, então as que já terminaram são colhidas a cada accept
+void TcpBridgeServer::acceptLoop() {
+    while (running_) {
+        int fd = accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd == -1) {
+            if (errno == EINTR) continue;
+            if (running_) {
+                logger_.error("Erro no accept da ponte: " + std::string(strerror(errno)), "TCP_BRIDGE");
+            }
+            break;
+        }
+
+        int one = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        reapClients();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        stats_.connections++;
+        clients_.push_back(ClientHandler{fd, false, std::thread()});
+        ClientHandler* client = &clients_.back();
+        client->thread = std::thread(&TcpBridgeServer::handleConnection, this, client);
+    }
+}
+
+// Join das threads de conexões já encerradas (fora do lock - o join espera o
+// handler sair do último lock_guard)
+void TcpBridgeServer::reapClients() {
+    std::list<ClientHandler> finished;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = clients_.begin(); it != clients_.end();) {
+            auto next = std::next(it);
+            if (it->done) {
+                finished.splice(finished.end(), clients_, it);
+            }
+            it = next;
+        }
+    }
+    for (auto& client : finished) {
+        client.thread.join();
+    }
+}
+
+// hello -> ack com o que já foi entregue pro link -> lotes -> um ack por lote
+void TcpBridgeServer::handleConnection(ClientHandler* client) {
+    int fd = client->fd;
+    std::string error;
+    BridgeHello hello{};
+
+    if (readControl(fd, hello, error)) {
+        uint64_t last;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            last = last_delivered_[hello.link_id];
+        }
+        BridgeAck ack{last, 0, 0};
+        bool alive = sendControl(fd, &ack, sizeof(ack), error);
+
+        MessageHeader header;
+        std::string payload;
+        while (alive && readFrame(fd, header, payload, MAX_BATCH_BYTES, error)) {
+            if (header.messageType() != MessageType::BATCH) {
+                logger_.warning("Frame inesperado na ponte: " + messageTypeToString(header.messageType()), "TCP_BRIDGE");
+                continue;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                last = last_delivered_[hello.link_id];
+            }
+
+            BridgeAck batch_ack{last, 0, 0};
+            uint64_t duplicates = 0;
+            std::string_view rest(payload);
+            while (!rest.empty()) {
+                MessageHeader inner;
+                std::string_view frame;
+                size_t consumed = decodeFrame(rest, inner, frame, error);
+                if (consumed == 0 || frame.size() < sizeof(BridgeRoute)) {
+                    // Lote corrompido - derruba a conexão; o cliente reenvia do último ack
+                    logger_.error("Lote inválido da ponte: " + (error.empty() ? "frame curto" : error), "TCP_BRIDGE");
+                    alive = false;
+                    break;
+                }
+                rest.remove_prefix(consumed);
+
+                if (inner.sequence <= batch_ack.sequence) {
+                    duplicates++;
+                    continue;
+                }
+
+                BridgeRoute route;
+                std::memcpy(&route, frame.data(), sizeof(route));
+                MessageBuffer message = MessageBuffer::copyOf(frame.substr(sizeof(route)));
+                bool delivered = deliver_ && deliver_(route.mechanism, route.priority, message);
+                (delivered ? batch_ack.delivered : batch_ack.failed)++;
+                batch_ack.sequence = inner.sequence;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                uint64_t& stored = last_delivered_[hello.link_id];
+                stored = std::max(stored, batch_ack.sequence);
+                stats_.batches++;
+                stats_.messages_delivered += batch_ack.delivered;
+                stats_.messages_failed += batch_ack.failed;
+                stats_.duplicates += duplicates;
+                stats_.bytes_received += sizeof(header) + header.length;
+            }
+
+            if (alive) {
+                alive = sendControl(fd, &batch_ack, sizeof(batch_ack), error);
+            }
+        }
+    }
+
+    if (running_ && error != "eof") {
+        logger_.warning("Conexão da ponte encerrada: " + error, "TCP_BRIDGE");
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    close(fd);
+    client->done = true;
+}
+
+} // namespace ipc_project
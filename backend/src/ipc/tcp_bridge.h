@@ -0,0 +1,205 @@
+/**
+ * @file tcp_bridge.h
+ * @brief Ponte TCP entre coordenadores em máquinas diferentes
+ */
+
+#pragma once
+
+#include <string>
+#include <deque>
+#include <list>
+#include <map>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <cstdint>
+#include "../common/logger.h"
+#include "../common/message_buffer.h"
+#include "../common/message_header.h"
+
+namespace ipc_project {
+
+// Prefixo de cada mensagem dentro do lote: pra qual mecanismo do coordenador
+// remoto ela vai e com qual prioridade. Os valores são os enums do coordenador
+struct BridgeRoute {
+    uint8_t mechanism;
+    uint8_t priority;
+    uint8_t reserved[6];
+};
+
+// Primeiro frame da conexão (CONTROL): identifica o link pra deduplicar reenvios
+struct BridgeHello {
+    uint64_t link_id;
+    uint64_t reserved;
+};
+
+// Ack cumulativo (CONTROL): tudo até 'sequence' já foi entregue no remoto
+struct BridgeAck {
+    uint64_t sequence;
+    uint32_t delivered;        // entregues neste lote
+    uint32_t failed;           // recusadas pelo mecanismo de destino (não são reenviadas)
+};
+
+// Configuração do lado que envia
+struct TcpBridgeConfig {
+    std::string peer_host;                 // vazio = ponte desligada
+    uint16_t peer_port = 0;
+    uint8_t target_mechanism = 0;          // mecanismo no coordenador remoto (IPCMechanism)
+    size_t batch_max_messages = 64;        // mensagens por writev
+    size_t batch_max_bytes = 64 * 1024;
+    size_t window = 1024;                  // mensagens sem ack antes do send bloquear
+    long send_timeout_ms = 1000;           // quanto o send espera por espaço na janela
+    long connect_timeout_ms = 2000;        // connect + hello; peer que não responde vira retry
+    long reconnect_initial_ms = 50;        // backoff exponencial entre tentativas
+    long reconnect_max_ms = 2000;
+
+    std::string toJSON() const;
+};
+
+// Estatísticas de um link (lado que envia)
+struct BridgeLinkStats {
+    std::string peer;
+    bool connected = false;
+    uint64_t messages_sent = 0;            // frames escritos no socket (inclui reenvios)
+    uint64_t messages_acked = 0;
+    uint64_t messages_failed = 0;          // recusadas pelo remoto
+    uint64_t resent = 0;                   // reenviadas depois de reconexão
+    uint64_t batches = 0;
+    uint64_t bytes_sent = 0;
+    uint64_t reconnects = 0;
+    size_t in_flight = 0;                  // enviadas sem ack
+    size_t queued = 0;                     // esperando o writer
+    double avg_batch = 0.0;
+    double messages_per_s = 0.0;           // acked por segundo desde o start
+    double throughput_mb_s = 0.0;
+    double avg_ack_latency_us = 0.0;       // send() -> ack (inclui a entrega no remoto)
+    double max_ack_latency_us = 0.0;
+    std::string last_error;
+
+    std::string toJSON() const;
+};
+
+// Lado que envia: fila -> lotes com TCP_NODELAY -> acks em pipeline.
+// O send só espera espaço na janela; quem confirma é a thread de leitura.
+// Caiu a conexão: reconecta com backoff e reenvia o que não teve ack
+// (o servidor descarta as sequências que já entregou)
+class TcpBridgeLink {
+public:
+    explicit TcpBridgeLink(const TcpBridgeConfig& config);
+    ~TcpBridgeLink();
+
+    bool start();
+    void stop();
+    bool isRunning() const;
+    bool isConnected() const;
+
+    bool send(uint8_t mechanism, uint8_t priority, const MessageBuffer& message);
+    bool flush(long timeout_ms);           // espera tudo ter ack (testes/shutdown)
+
+    BridgeLinkStats getStats() const;
+    const TcpBridgeConfig& getConfig() const;
+
+private:
+    struct Outgoing {
+        uint64_t sequence;
+        BridgeRoute route;
+        MessageBuffer message;
+        std::chrono::steady_clock::time_point enqueued_at;
+    };
+
+    TcpBridgeConfig config_;
+    uint64_t link_id_;
+    std::atomic<bool> running_;
+    std::atomic<bool> connected_;
+    int socket_fd_;                        // também durante o connect/hello, pro stop() derrubar
+    int wake_fd_;                          // eventfd: stop() acorda o poll do connect
+
+    mutable std::mutex mutex_;
+    std::condition_variable work_cv_;      // writer: fila nova, desconexão ou stop
+    std::condition_variable space_cv_;     // send: janela abriu / flush: ack chegou
+    std::deque<Outgoing> pending_;         // ainda não escritas nesta conexão
+    std::deque<Outgoing> unacked_;         // escritas, esperando ack (ordem de sequência)
+    uint64_t next_sequence_;
+    BridgeLinkStats stats_;
+    double total_ack_latency_us_;
+    std::chrono::steady_clock::time_point started_at_;
+
+    std::thread io_thread_;
+    Logger& logger_;
+
+    void ioLoop();
+    bool connectPeer();
+    bool waitConnected(int fd, std::string& error);
+    void readerLoop(int fd);
+    void handleAck(const BridgeAck& ack);
+    bool writeBatch(int fd, std::vector<Outgoing>& batch);
+};
+
+// Estatísticas do lado que recebe
+struct BridgeServerStats {
+    uint16_t port = 0;
+    bool running = false;
+    uint64_t connections = 0;              // aceitas desde o start
+    size_t active_connections = 0;
+    uint64_t batches = 0;
+    uint64_t messages_delivered = 0;
+    uint64_t messages_failed = 0;
+    uint64_t duplicates = 0;               // reenvios descartados
+    uint64_t bytes_received = 0;
+
+    std::string toJSON() const;
+};
+
+// Lado que recebe: aceita links e entrega cada mensagem pelo callback
+// (o coordenador manda pro mecanismo local indicado na rota)
+class TcpBridgeServer {
+public:
+    using DeliverFn = std::function<bool(uint8_t mechanism, uint8_t priority, const MessageBuffer& message)>;
+
+    explicit TcpBridgeServer(DeliverFn deliver);
+    ~TcpBridgeServer();
+
+    bool start(const std::string& host, uint16_t port);   // porta 0 = efêmera
+    void stop();
+    bool isRunning() const;
+    uint16_t getPort() const;              // porta real (depois do bind)
+
+    BridgeServerStats getStats() const;
+
+    static constexpr size_t MAX_BATCH_BYTES = 4 * 1024 * 1024;
+
+private:
+    DeliverFn deliver_;
+    std::atomic<bool> running_;
+    int listen_fd_;
+    uint16_t port_;
+
+    // Handler de uma conexão; 'done' marca a thread pronta pra join
+    struct ClientHandler {
+        int fd;
+        bool done;
+        std::thread thread;
+    };
+
+    mutable std::mutex mutex_;
+    std::list<ClientHandler> clients_;
+    std::map<uint64_t, uint64_t> last_delivered_;   // link_id -> maior sequência entregue
+    BridgeServerStats stats_;
+
+    std::thread accept_thread_;
+    Logger& logger_;
+
+    void acceptLoop();
+    void reapClients();
+    void handleConnection(ClientHandler* client);
+};
+
+// "host:porta" -> partes (porta 0 se inválida)
+bool parseHostPort(const std::string& text, std::string& host, uint16_t& port);
+
+} // namespace ipc_project
@@ -0,0 +1,88 @@
+/**
+ * @file typed_channel.cpp
+ * @brief Partes nao tipadas dos canais tipados (fds, mmap, futex)
+ */
+
+#include "typed_channel.h"
+#include <cerrno>
+#include <climits>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace ipc_project {
+
+namespace channel_detail {
+
+void futexWait(std::atomic<uint32_t>* word, uint32_t expected) {
+    // Timeout curto so pra reavaliar 'closed' caso um wake se perca
+    struct timespec timeout = {0, 100 * 1000 * 1000};
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+}
+
+void futexWake(std::atomic<uint32_t>* word) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+} // namespace channel_detail
+
+StreamTransport::~StreamTransport() {
+    asProducer();
+    shutdown();
+}
+
+void StreamTransport::asProducer() {
+    if (fds_[0] != -1) {
+        close(fds_[0]);
+        fds_[0] = -1;
+    }
+}
+
+void StreamTransport::asConsumer() {
+    shutdown();
+}
+
+void StreamTransport::shutdown() {
+    if (fds_[1] != -1) {
+        close(fds_[1]);
+        fds_[1] = -1;
+    }
+}
+
+bool StreamTransport::sendFrame(const MessageHeader& header, const void* payload, size_t length) {
+    if (fds_[1] == -1) return false;
+    ssize_t written = writeFrame(fds_[1], header, static_cast<const char*>(payload), length);
+    return written == static_cast<ssize_t>(sizeof(MessageHeader) + length);
+}
+
+bool StreamTransport::receiveFrame(MessageHeader& header, void* payload, size_t capacity, std::string& error) {
+    if (fds_[0] == -1) {
+        error = "closed";
+        return false;
+    }
+    return readFrameInto(fds_[0], header, payload, capacity, error);
+}
+
+bool openPipeTransport(int fds[2]) {
+    return pipe(fds) == 0;
+}
+
+bool openSocketTransport(int fds[2]) {
+    // socketpair e bidirecional; o canal usa [0] pra ler e [1] pra escrever
+    return socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0;
+}
+
+void* mapSharedRegion(size_t bytes) {
+    void* region = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    return region == MAP_FAILED ? nullptr : region;
+}
+
+void unmapSharedRegion(void* region, size_t bytes) {
+    if (region) {
+        munmap(region, bytes);
+    }
+}
+
+} // namespace ipc_project
@@ -0,0 +1,333 @@
+/**
+ * @file typed_channel.h
+ * @brief Canais tipados em tempo de compilacao pra structs trivially copyable
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits.h>
+#include <new>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include "../common/message_header.h"
+
+namespace ipc_project {
+
+// So structs que podem ser copiadas byte a byte atravessam o canal sem serializacao
+template <typename T>
+concept ChannelPayload = std::is_trivially_copyable_v<T> && !std::is_pointer_v<T>;
+
+namespace channel_detail {
+
+constexpr size_t roundUp(size_t value, size_t alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+// Nome do tipo extraido da assinatura da funcao (GCC/Clang)
+template <typename T>
+constexpr std::string_view typeName() {
+    std::string_view signature = __PRETTY_FUNCTION__;
+    size_t start = signature.find("T = ") + 4;
+    size_t end = signature.find_first_of(";]", start);
+    return signature.substr(start, end - start);
+}
+
+constexpr uint64_t fnv1a(std::string_view bytes, uint64_t hash = 0xcbf29ce484222325ull) {
+    for (char c : bytes) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+constexpr uint64_t fnv1a(uint64_t value, uint64_t hash) {
+    for (int i = 0; i < 8; ++i) {
+        hash ^= (value >> (i * 8)) & 0xFF;
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+// Versao opcional declarada pelo tipo (static constexpr uint32_t schema_version)
+template <typename T>
+constexpr uint64_t schemaVersion() {
+    if constexpr (requires { T::schema_version; }) {
+        return static_cast<uint64_t>(T::schema_version);
+    } else {
+        return 0;
+    }
+}
+
+// Futex compartilhado entre processos (o anel do canal fica num mmap MAP_SHARED)
+void futexWait(std::atomic<uint32_t>* word, uint32_t expected);
+void futexWake(std::atomic<uint32_t>* word);
+
+} // namespace channel_detail
+
+/**
+ * @brief Tudo que o canal sabe sobre T, calculado em tempo de compilacao
+ *
+ * schema_id identifica o layout (nome do tipo, tamanho, alinhamento e
+ * schema_version opcional) e vai no MessageHeader de cada mensagem: o receptor
+ * recusa frames de um produtor compilado com outro layout.
+ */
+template <ChannelPayload T>
+struct ChannelTraits {
+    static constexpr size_t payload_size = sizeof(T);
+    static constexpr size_t payload_alignment = alignof(T);
+    static constexpr size_t frame_size = sizeof(MessageHeader) + sizeof(T);
+    static constexpr size_t slot_alignment = std::max(alignof(T), alignof(MessageHeader));
+    static constexpr size_t slot_size = channel_detail::roundUp(frame_size, slot_alignment);
+    static constexpr std::string_view type_name = channel_detail::typeName<T>();
+    static constexpr uint64_t schema_id =
+        channel_detail::fnv1a(channel_detail::schemaVersion<T>(),
+            channel_detail::fnv1a(alignof(T),
+                channel_detail::fnv1a(sizeof(T), channel_detail::fnv1a(type_name))));
+
+    static_assert(sizeof(T) <= UINT32_MAX, "payload does not fit MessageHeader::length");
+};
+
+// Trava o layout de T nos dois lados do canal: se alguem mudar a struct, o build
+// quebra em vez de o consumidor ler bytes no lugar errado
+#define IPC_CHANNEL_LAYOUT(T, expected_size, expected_align)                          \
+    static_assert(std::is_trivially_copyable_v<T>, #T " must be trivially copyable"); \
+    static_assert(sizeof(T) == (expected_size), #T " size changed - update both ends of the channel"); \
+    static_assert(alignof(T) == (expected_align), #T " alignment changed - update both ends of the channel")
+
+#define IPC_CHANNEL_FIELD(T, field, expected_offset)                                  \
+    static_assert(offsetof(T, field) == (expected_offset), #T "::" #field " moved - update both ends of the channel")
+
+/**
+ * @brief Transportes em stream (pipe, socketpair)
+ *
+ * Nao conhecem T - so movem frames de tamanho fixo. Criados antes do fork;
+ * cada lado fecha a ponta que nao usa.
+ */
+class StreamTransport {
+public:
+    StreamTransport() = default;
+    ~StreamTransport();
+    StreamTransport(const StreamTransport&) = delete;
+    StreamTransport& operator=(const StreamTransport&) = delete;
+
+    void asProducer();          // depois do fork: produtor fecha a ponta de leitura
+    void asConsumer();          // consumidor fecha a ponta de escrita
+    void shutdown();            // produtor encerrando - consumidor recebe EOF
+    bool isOpen() const { return fds_[0] != -1 || fds_[1] != -1; }
+
+    bool sendFrame(const MessageHeader& header, const void* payload, size_t length);
+    bool receiveFrame(MessageHeader& header, void* payload, size_t capacity, std::string& error);
+
+protected:
+    int fds_[2] = {-1, -1};     // [0] leitura, [1] escrita
+};
+
+// Pipe anonimo. FrameSize <= PIPE_BUF garante que cada frame e escrito atomicamente
+template <size_t FrameSize>
+class PipeTransport : public StreamTransport {
+public:
+    static_assert(FrameSize <= PIPE_BUF, "pipe frames larger than PIPE_BUF may interleave");
+    bool open();
+};
+
+// socketpair AF_UNIX/SOCK_STREAM - sem limite de atomicidade, um produtor por canal
+template <size_t FrameSize>
+class SocketTransport : public StreamTransport {
+public:
+    bool open();
+};
+
+bool openPipeTransport(int fds[2]);
+bool openSocketTransport(int fds[2]);
+
+template <size_t FrameSize>
+bool PipeTransport<FrameSize>::open() { return openPipeTransport(fds_); }
+
+template <size_t FrameSize>
+bool SocketTransport<FrameSize>::open() { return openSocketTransport(fds_); }
+
+// Regiao MAP_SHARED anonima (herdada pelo fork) - base nao tipada do anel
+void* mapSharedRegion(size_t bytes);
+void unmapSharedRegion(void* region, size_t bytes);
+
+/**
+ * @brief Anel SPSC em memoria compartilhada com slots de tamanho fixo
+ *
+ * Cada slot guarda um frame inteiro (cabecalho + payload) e e alinhado pra
+ * linha de cache. Produtor e consumidor so trocam head/tail atomicos; o
+ * consumidor dorme num futex quando o anel esta vazio.
+ */
+template <size_t FrameSize, size_t Capacity = 64>
+class ShmTransport {
+public:
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+    static constexpr size_t SLOT_SIZE = channel_detail::roundUp(FrameSize, alignof(MessageHeader));
+
+    ShmTransport() = default;
+    ~ShmTransport() { unmapSharedRegion(ring_, sizeof(Ring)); }
+    ShmTransport(const ShmTransport&) = delete;
+    ShmTransport& operator=(const ShmTransport&) = delete;
+
+    bool open() {
+        void* region = mapSharedRegion(sizeof(Ring));
+        if (!region) return false;
+        ring_ = new (region) Ring();
+        return true;
+    }
+
+    void asProducer() {}
+    void asConsumer() {}
+    // Produtor encerrando: consumidor termina depois de drenar o anel
+    void shutdown() {
+        if (!ring_) return;
+        ring_->closed.store(1, std::memory_order_release);
+        ring_->published.fetch_add(1, std::memory_order_seq_cst);
+        channel_detail::futexWake(&ring_->published);
+    }
+    bool isOpen() const { return ring_ != nullptr; }
+
+    // Nao bloqueia: anel cheio retorna false (quem chama decide se tenta de novo)
+    bool sendFrame(const MessageHeader& header, const void* payload, size_t length) {
+        uint64_t head = ring_->head.load(std::memory_order_relaxed);
+        if (head - ring_->tail.load(std::memory_order_acquire) >= Capacity) {
+            return false;
+        }
+        Slot& slot = ring_->slots[head & (Capacity - 1)];
+        std::memcpy(static_cast<void*>(&slot.header), &header, sizeof(MessageHeader));
+        std::memcpy(slot.payload, payload, length);
+        ring_->head.store(head + 1, std::memory_order_release);
+
+        // Dekker com o consumidor: publica e depois le a flag do outro lado.
+        // Precisa de seq_cst - com acq_rel o load pode passar na frente do
+        // fetch_add e os dois lados se perdem (ninguem acorda ninguem)
+        ring_->published.fetch_add(1, std::memory_order_seq_cst);
+        if (ring_->sleeping.load(std::memory_order_seq_cst) > 0) {
+            channel_detail::futexWake(&ring_->published);
+        }
+        return true;
+    }
+
+    bool receiveFrame(MessageHeader& header, void* payload, size_t capacity, std::string& error) {
+        uint64_t tail = ring_->tail.load(std::memory_order_relaxed);
+        while (ring_->head.load(std::memory_order_acquire) == tail) {
+            if (ring_->closed.load(std::memory_order_acquire)) {
+                error = "eof";
+                return false;
+            }
+            // Lado do consumidor: anuncia que vai dormir e so entao le o que
+            // foi publicado. Em ordem seq_cst, ou o produtor ve sleeping > 0
+            // e acorda, ou o consumidor ve o head/published novo e nao dorme
+            ring_->sleeping.fetch_add(1, std::memory_order_seq_cst);
+            uint32_t seen = ring_->published.load(std::memory_order_seq_cst);
+            if (ring_->head.load(std::memory_order_acquire) == tail &&
+                !ring_->closed.load(std::memory_order_acquire)) {
+                channel_detail::futexWait(&ring_->published, seen);
+            }
+            ring_->sleeping.fetch_sub(1, std::memory_order_relaxed);
+        }
+
+        const Slot& slot = ring_->slots[tail & (Capacity - 1)];
+        std::memcpy(static_cast<void*>(&header), &slot.header, sizeof(MessageHeader));
+        bool valid = validateHeader(header, capacity, error);
+        if (valid) {
+            std::memcpy(payload, slot.payload, header.length);
+        }
+        ring_->tail.store(tail + 1, std::memory_order_release);
+        return valid;
+    }
+
+private:
+    struct alignas(64) Slot {
+        MessageHeader header;
+        unsigned char payload[SLOT_SIZE - sizeof(MessageHeader)];
+    };
+
+    struct Ring {
+        alignas(64) std::atomic<uint64_t> head{0};      // escrito so pelo produtor
+        alignas(64) std::atomic<uint64_t> tail{0};      // escrito so pelo consumidor
+        alignas(64) std::atomic<uint32_t> published{0}; // palavra do futex
+        std::atomic<uint32_t> sleeping{0};
+        std::atomic<uint32_t> closed{0};
+        Slot slots[Capacity];
+    };
+
+    Ring* ring_ = nullptr;
+};
+
+/**
+ * @brief Canal tipado: send(const T&) / receive() movem os bytes de T crus
+ *
+ * Transport recebe o tamanho do frame em tempo de compilacao, entao o slot do
+ * anel e o limite de atomicidade do pipe sao checados no build. Nenhuma
+ * alocacao no envio nem no recebimento: o cabecalho fica na pilha e o payload
+ * e lido direto no T do chamador.
+ */
+template <ChannelPayload T, template <size_t> class Transport = PipeTransport>
+class Channel {
+public:
+    using Traits = ChannelTraits<T>;
+    using TransportType = Transport<Traits::frame_size>;
+
+    bool open() { return transport_.open(); }
+    void asProducer() { transport_.asProducer(); }
+    void asConsumer() { transport_.asConsumer(); }
+    void shutdown() { transport_.shutdown(); }
+    bool isOpen() const { return transport_.isOpen(); }
+
+    bool send(const T& value) {
+        MessageHeader header = makeHeader(MessageType::DATA,
+            std::string_view(reinterpret_cast<const char*>(&value), sizeof(T)), ++next_sequence_);
+        header.schema_id = Traits::schema_id;
+        return transport_.sendFrame(header, &value, sizeof(T));
+    }
+
+    // Bloqueia ate chegar um T. false em EOF, erro ou frame de outro layout
+    bool receive(T& out) {
+        MessageHeader header;
+        alignas(T) unsigned char raw[sizeof(T)];
+        if (!transport_.receiveFrame(header, raw, sizeof(T), last_error_)) {
+            return false;
+        }
+        if (header.schema_id != Traits::schema_id || header.length != sizeof(T)) {
+            last_error_ = "schema_mismatch";
+            return false;
+        }
+        if (computeChecksum(raw, sizeof(T)) != header.checksum) {
+            tracker_.checksum_errors++;
+            last_error_ = "checksum_mismatch";
+            return false;
+        }
+        std::memcpy(static_cast<void*>(&out), raw, sizeof(T));
+        tracker_.observe(header, monotonicNowNs());
+        return true;
+    }
+
+    std::optional<T> receive() requires std::is_default_constructible_v<T> {
+        T value;
+        if (!receive(value)) return std::nullopt;
+        return value;
+    }
+
+    const FrameTracker& stats() const { return tracker_; }
+    const std::string& lastError() const { return last_error_; }
+    TransportType& transport() { return transport_; }
+
+private:
+    TransportType transport_;
+    uint64_t next_sequence_ = 0;
+    FrameTracker tracker_;
+    std::string last_error_;
+};
+
+template <typename T> using PipeChannel = Channel<T, PipeTransport>;
+template <typename T> using SocketChannel = Channel<T, SocketTransport>;
+template <typename T> using ShmChannel = Channel<T, ShmTransport>;
+
+} // namespace ipc_project
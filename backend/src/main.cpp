@@ -11,9 +11,15 @@
 #include <sstream>
 #include <filesystem>
 #include <cstdlib>
+#include <iterator>
+#include <iomanip>
+#include <fcntl.h>
+#include <unistd.h>
 #include "ipc/ipc_coordinator.h"
+#include "ipc/ipc_benchmark.h"
 #include "common/logger.h"
 #include "server/http_server.h"
+#include "common/message_header.h"
 
 using namespace ipc_project;
 
@@ -36,9 +42,28 @@ void printHelp() {
               << "  -i, --interactive  Interactive mode (default)\n"
               << "  -l, --log <file>  Set log file\n"
               << "  -v, --verbose  Verbose mode (DEBUG)\n"
-              << "  -p, --port <n> HTTP port (default 9000)\n\n"
+              << "  -p, --port <n> HTTP port (default 9000)\n"
+              << "      --http-shards <n>  SO_REUSEPORT listeners, one event loop per core (0 = one per core, default 1)\n"
+              << "  -b, --busy-poll <cpu>  Busy-poll shared memory consumer pinned to <cpu> (-1 = no pinning)\n"
+              << "      --idle-budget <us> Spin time before futex fallback (default 1000, 0 = spin forever)\n"
+              << "      --shm-lock <policy>  Shared memory lock: semaphore (default), futex, seqlock, none\n"
+              << "      --shm-capacity <n>   Shared memory payload capacity: 1024 (default), 4096, 65536\n"
+              << "      --shm-layout <text|binary>  Shared memory record layout (default text)\n"
+              << "      --cross-memory-mode <push|pull>  Who copies in cross_memory (default push)\n"
+              << "      --mq-maxmsg <n>    POSIX message queue depth (default 10)\n"
+              << "      --mq-msgsize <n>   POSIX message queue message size incl. 64-byte envelope (default 8192)\n"
+              << "      --eventfd-semaphore  eventfd doorbell in EFD_SEMAPHORE mode (one signal per read)\n"
+              << "      --shm-wakeup <futex|eventfd>  How the busy-poll consumer sleeps (default futex)\n"
+              << "      --bridge-listen <[host:]port>  Accept messages from remote coordinators over TCP\n"
+              << "      --bridge-peer <host:port>  Forward tcp_bridge messages to a remote coordinator\n"
+              << "      --bridge-target <mechanism>  Mechanism the peer delivers into (default pipes)\n"
+              << "      --bench        Benchmark all mechanisms with the same load and exit\n"
+              << "      --bench-size <n>   Message size in bytes for --bench (default 1024)\n"
+              << "      --bench-count <n>  Messages per mechanism for --bench (default 1000)\n"
+              << "      --encode-frame <message>  Write <message> as a binary envelope to stdout\n"
+              << "      --decode-frame  Read binary envelopes from stdin and print them as JSON\n\n"
               << "Interactive commands:\n"
-              << "  start <mechanism>  - Start mechanism (pipes|sockets|shmem)\n"
+              << "  start <mechanism>  - Start mechanism (pipes|sockets|shmem|cross_memory|mqueue|eventfd|tcp_bridge)\n"
               << "  stop <mechanism>   - Stop mechanism\n"
               << "  send <mechanism> <message>  - Send message\n"
               << "  status             - Show status of all mechanisms\n"
@@ -52,6 +77,10 @@ void printInteractiveHelp() {
               << "start pipes        - Start pipe communication\n"
               << "start sockets      - Start socket communication\n"
               << "start shmem        - Start shared memory\n"
+              << "start cross_memory - Start cross memory attach (process_vm_writev)\n"
+              << "start mqueue       - Start POSIX message queue\n"
+              << "start eventfd      - Start eventfd doorbell (send rings it)\n"
+              << "start tcp_bridge   - Start TCP link to the --bridge-peer coordinator\n"
               << "stop <mechanism>   - Stop specified mechanism\n"
               << "send pipes \"message\"    - Send message via pipes\n"
               << "send sockets \"message\"  - Send message via sockets\n"
@@ -62,11 +91,11 @@ void printInteractiveHelp() {
               << "quit / exit        - Exit\n\n";
 }
 
-IPCMechanism stringToMechanism(const std::string& str) {
-    if (str == "pipes") return IPCMechanism::PIPES;
-    if (str == "sockets") return IPCMechanism::SOCKETS;
-    if (str == "shmem" || str == "shared_memory") return IPCMechanism::SHARED_MEMORY;
-    return IPCMechanism::PIPES; // default
+// Typed name -> mechanism; prints a warning and returns false if unknown
+bool parseMechanismArg(const std::string& name, IPCMechanism& mechanism) {
+    if (stringToMechanism(name, mechanism)) return true;
+    std::cout << "Unknown mechanism: " << name << "\n\n";
+    return false;
 }
 
 void interactiveMode(IPCCoordinator& coordinator) {
@@ -100,7 +129,8 @@ void interactiveMode(IPCCoordinator& coordinator) {
                 continue;
             }
             
-            IPCMechanism mech = stringToMechanism(param1);
+            IPCMechanism mech;
+            if (!parseMechanismArg(param1, mech)) continue;
             if (coordinator.startMechanism(mech)) {
                 std::cout << "✓ Mechanism " << param1 << " started successfully\n\n";
             } else {
@@ -114,7 +144,8 @@ void interactiveMode(IPCCoordinator& coordinator) {
                 continue;
             }
             
-            IPCMechanism mech = stringToMechanism(param1);
+            IPCMechanism mech;
+            if (!parseMechanismArg(param1, mech)) continue;
             if (coordinator.stopMechanism(mech)) {
                 std::cout << "✓ Mechanism " << param1 << " stopped successfully\n\n";
             } else {
@@ -141,7 +172,8 @@ void interactiveMode(IPCCoordinator& coordinator) {
                 param2 = param2.substr(1, param2.length() - 2);
             }
             
-            IPCMechanism mech = stringToMechanism(param1);
+            IPCMechanism mech;
+            if (!parseMechanismArg(param1, mech)) continue;
             if (coordinator.sendMessage(mech, param2)) {
                 std::cout << "✓ Message sent via " << param1 << ": \"" << param2 << "\"\n\n";
             } else {
@@ -155,7 +187,8 @@ void interactiveMode(IPCCoordinator& coordinator) {
                 continue;
             }
             
-            IPCMechanism mech = stringToMechanism(param1);
+            IPCMechanism mech;
+            if (!parseMechanismArg(param1, mech)) continue;
             auto logs = coordinator.getLogs(mech, 20); // last 20 logs
             
             std::cout << "Logs for " << param1 << ":\n";
@@ -175,19 +208,27 @@ void interactiveMode(IPCCoordinator& coordinator) {
     }
 }
 
-void serverMode(IPCCoordinator& coordinator, int http_port) {
+void serverMode(IPCCoordinator& coordinator, int http_port, int http_shards) {
     std::cout << "Starting integrated web server mode...\n";
     
     // Start all mechanisms
     coordinator.startMechanism(IPCMechanism::PIPES);
     coordinator.startMechanism(IPCMechanism::SOCKETS);  
     coordinator.startMechanism(IPCMechanism::SHARED_MEMORY);
+    coordinator.startMechanism(IPCMechanism::CROSS_MEMORY);
+    coordinator.startMechanism(IPCMechanism::MESSAGE_QUEUE);
+    coordinator.startMechanism(IPCMechanism::EVENTFD);
     
     std::cout << "✓ IPC mechanisms started\n";
     
     // Create and start HTTP server
     HTTPServer server(http_port);
     server.setIPCCoordinator(std::shared_ptr<IPCCoordinator>(&coordinator, [](IPCCoordinator*) {}));
+    // Requests and the coordinator's background jobs share one bounded pool
+    server.setExecutor(coordinator.getExecutor());
+    if (http_shards != 1) {
+        server.setShards(static_cast<size_t>(http_shards));
+    }
     
     // Configure path for static files (frontend)
     // Try paths relative to executable/build location for portability
@@ -253,6 +294,37 @@ void serverMode(IPCCoordinator& coordinator, int http_port) {
     std::cout << "Server stopped.\n";
 }
 
+void benchmarkMode(IPCCoordinator& coordinator, const BenchmarkConfig& config) {
+    std::cout << "Benchmark: " << config.messages << " x " << config.message_size << " bytes per mechanism\n";
+    
+    // Child processes print one JSON line per message - keep them out of the results
+    std::cout.flush();
+    int saved_stdout = dup(STDOUT_FILENO);
+    int devnull = open("/dev/null", O_WRONLY);
+    if (devnull != -1) {
+        dup2(devnull, STDOUT_FILENO);
+        close(devnull);
+    }
+    
+    std::vector<BenchmarkResult> results = runBenchmark(coordinator, config);
+    
+    std::cout.flush();
+    if (saved_stdout != -1) {
+        dup2(saved_stdout, STDOUT_FILENO);
+        close(saved_stdout);
+    }
+    
+    std::cout << std::left << std::setw(15) << "mechanism" << std::right
+              << std::setw(10) << "msgs/s" << std::setw(10) << "MB/s"
+              << std::setw(10) << "p50 us" << std::setw(10) << "p99 us" << std::setw(10) << "failed" << "\n";
+    for (const auto& r : results) {
+        std::cout << std::left << std::setw(15) << r.mechanism << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(10) << r.messages_per_s << std::setw(10) << r.throughput_mb_s
+                  << std::setw(10) << r.p50_us << std::setw(10) << r.p99_us << std::setw(10) << r.failures << "\n";
+    }
+    std::cout << benchmarkToJSON(results) << "\n";
+}
+
 void daemonMode(IPCCoordinator& coordinator) {
     std::cout << "Starting daemon mode...\n";
     
@@ -260,6 +332,9 @@ void daemonMode(IPCCoordinator& coordinator) {
     coordinator.startMechanism(IPCMechanism::PIPES);
     coordinator.startMechanism(IPCMechanism::SOCKETS);  
     coordinator.startMechanism(IPCMechanism::SHARED_MEMORY);
+    coordinator.startMechanism(IPCMechanism::CROSS_MEMORY);
+    coordinator.startMechanism(IPCMechanism::MESSAGE_QUEUE);
+    coordinator.startMechanism(IPCMechanism::EVENTFD);
     
     std::cout << "Initial status:\n" << coordinator.getStatusJSON() << "\n\n";
     
@@ -285,6 +360,36 @@ void daemonMode(IPCCoordinator& coordinator) {
     std::cout << "Daemon shutting down...\n";
 }
 
+// Envelope tooling: encode writes a raw frame, decode reads frames from stdin
+// (e.g. `main --encode-frame hi | main --decode-frame`)
+int encodeFrameTool(const std::string& message) {
+    MessageHeader header = makeHeader(MessageType::DATA, message, 1);
+    std::string frame = encodeFrame(header, message);
+    std::cout.write(frame.data(), static_cast<std::streamsize>(frame.size()));
+    std::cout.flush();
+    return 0;
+}
+
+int decodeFrameTool() {
+    std::string input((std::istreambuf_iterator<char>(std::cin)), std::istreambuf_iterator<char>());
+    std::string_view remaining(input);
+    
+    while (!remaining.empty()) {
+        MessageHeader header;
+        std::string_view payload;
+        std::string error;
+        size_t consumed = decodeFrame(remaining, header, payload, error);
+        if (consumed == 0) {
+            std::cerr << "Invalid frame at offset " << (input.size() - remaining.size()) << ": " << error << "\n";
+            return 1;
+        }
+        std::cout << "{\"header\":" << header.toJSON()
+                  << ",\"payload\":\"" << payload << "\"}\n";
+        remaining.remove_prefix(consumed);
+    }
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
     // Initial configuration
     signal(SIGINT, signalHandler);
@@ -295,6 +400,17 @@ int main(int argc, char* argv[]) {
     bool verbose = false;
     std::string log_file = "";
     int http_port = 9000;
+    int http_shards = 1;
+    bool busy_poll = false;
+    BusyPollConfig busy_poll_config;
+    SharedMemoryConfig shmem_config;
+    CrossMemoryMode cross_memory_mode = CrossMemoryMode::PUSH;
+    MessageQueueConfig mq_config;
+    EventFdConfig eventfd_config;
+    TcpBridgeConfig bridge_config;
+    std::string bridge_listen;
+    bool bench_mode = false;
+    BenchmarkConfig bench_config;
     
     // Command line argument parsing
     for (int i = 1; i < argc; i++) {
@@ -331,6 +447,134 @@ int main(int argc, char* argv[]) {
                 return 1;
             }
         }
+        else if (arg == "--http-shards") {
+            http_shards = i + 1 < argc ? std::atoi(argv[++i]) : -1;
+            if (http_shards < 0) {
+                std::cerr << "Error: option --http-shards requires a number of listeners\n";
+                return 1;
+            }
+        }
+        else if (arg == "-b" || arg == "--busy-poll") {
+            if (i + 1 < argc) {
+                busy_poll = true;
+                busy_poll_config.cpu = std::atoi(argv[++i]);
+            } else {
+                std::cerr << "Error: option -b requires CPU number\n";
+                return 1;
+            }
+        }
+        else if (arg == "--idle-budget") {
+            if (i + 1 < argc) {
+                int budget = std::atoi(argv[++i]);
+                busy_poll_config.futex_fallback = budget > 0;
+                busy_poll_config.idle_budget_us = budget > 0 ? static_cast<uint32_t>(budget) : 0;
+            } else {
+                std::cerr << "Error: option --idle-budget requires microseconds\n";
+                return 1;
+            }
+        }
+        else if (arg == "--shm-lock") {
+            if (i + 1 >= argc || !stringToLockKind(argv[++i], shmem_config.lock)) {
+                std::cerr << "Error: option --shm-lock requires semaphore|futex|seqlock|none\n";
+                return 1;
+            }
+        }
+        else if (arg == "--shm-capacity") {
+            if (i + 1 < argc) {
+                shmem_config.capacity = static_cast<size_t>(std::atol(argv[++i]));
+                if (!makeSharedMemoryBackend(shmem_config)) {
+                    std::cerr << "Error: unsupported capacity " << shmem_config.capacity
+                              << " (use 1024, 4096 or 65536)\n";
+                    return 1;
+                }
+            } else {
+                std::cerr << "Error: option --shm-capacity requires a size\n";
+                return 1;
+            }
+        }
+        else if (arg == "--shm-layout") {
+            std::string layout = i + 1 < argc ? argv[++i] : "";
+            if (layout == "text") {
+                shmem_config.layout = ShmLayoutKind::TEXT;
+            } else if (layout == "binary") {
+                shmem_config.layout = ShmLayoutKind::BINARY;
+            } else {
+                std::cerr << "Error: option --shm-layout requires text|binary\n";
+                return 1;
+            }
+        }
+        else if (arg == "--cross-memory-mode") {
+            if (i + 1 >= argc || !stringToCrossMemoryMode(argv[++i], cross_memory_mode)) {
+                std::cerr << "Error: option --cross-memory-mode requires push|pull\n";
+                return 1;
+            }
+        }
+        else if (arg == "--mq-maxmsg" || arg == "--mq-msgsize") {
+            long value = i + 1 < argc ? std::atol(argv[++i]) : 0;
+            if (value <= 0) {
+                std::cerr << "Error: option " << arg << " requires a positive number\n";
+                return 1;
+            }
+            (arg == "--mq-maxmsg" ? mq_config.max_messages : mq_config.message_size) = value;
+        }
+        else if (arg == "--eventfd-semaphore") {
+            eventfd_config.semaphore = true;
+        }
+        else if (arg == "--shm-wakeup") {
+            std::string wakeup = i + 1 < argc ? argv[++i] : "";
+            if (wakeup != "futex" && wakeup != "eventfd") {
+                std::cerr << "Error: option --shm-wakeup requires futex|eventfd\n";
+                return 1;
+            }
+            busy_poll_config.eventfd_wakeup = wakeup == "eventfd";
+        }
+        else if (arg == "--bridge-listen" || arg == "--bridge-peer") {
+            std::string host;
+            uint16_t port = 0;
+            std::string value = i + 1 < argc ? argv[++i] : "";
+            if (!parseHostPort(value, host, port) || (arg == "--bridge-peer" && (host.empty() || port == 0))) {
+                std::cerr << "Error: option " << arg << " requires " << (arg == "--bridge-peer" ? "host:port" : "[host:]port") << "\n";
+                return 1;
+            }
+            if (arg == "--bridge-listen") {
+                bridge_listen = value;
+            } else {
+                bridge_config.peer_host = host;
+                bridge_config.peer_port = port;
+            }
+        }
+        else if (arg == "--bridge-target") {
+            std::string target = i + 1 < argc ? argv[++i] : "";
+            IPCMechanism mechanism;
+            if (!stringToMechanism(target, mechanism) || mechanism == IPCMechanism::TCP_BRIDGE) {
+                std::cerr << "Error: option --bridge-target requires a local mechanism name\n";
+                return 1;
+            }
+            bridge_config.target_mechanism = static_cast<uint8_t>(mechanism);
+        }
+        else if (arg == "--bench") {
+            bench_mode = true;
+            interactive_mode = false;
+            server_mode = false;
+        }
+        else if (arg == "--bench-size" || arg == "--bench-count") {
+            long value = i + 1 < argc ? std::atol(argv[++i]) : 0;
+            if (value <= 0) {
+                std::cerr << "Error: option " << arg << " requires a positive number\n";
+                return 1;
+            }
+            (arg == "--bench-size" ? bench_config.message_size : bench_config.messages) = static_cast<size_t>(value);
+        }
+        else if (arg == "--encode-frame") {
+            if (i + 1 < argc) {
+                return encodeFrameTool(argv[++i]);
+            }
+            std::cerr << "Error: option --encode-frame requires a message\n";
+            return 1;
+        }
+        else if (arg == "--decode-frame") {
+            return decodeFrameTool();
+        }
         else if (arg == "-l" || arg == "--log") {
             if (i + 1 < argc) {
                 log_file = argv[++i];
@@ -374,6 +618,12 @@ int main(int argc, char* argv[]) {
     try {
         // Coordinator initialization
         IPCCoordinator coordinator;
+        coordinator.setBusyPoll(busy_poll, busy_poll_config);
+        coordinator.setSharedMemoryConfig(shmem_config);
+        coordinator.setCrossMemoryConfig(cross_memory_mode);
+        coordinator.setMessageQueueConfig(mq_config);
+        coordinator.setEventFdConfig(eventfd_config);
+        coordinator.setTcpBridgeConfig(bridge_config);
         
         if (!coordinator.initialize()) {
             std::cerr << "Error: Failed to initialize IPC coordinator\n";
@@ -382,11 +632,30 @@ int main(int argc, char* argv[]) {
         
         std::cout << "✓ IPC coordinator initialized successfully\n\n";
         
+        // The bridge needs a peer, so it only starts (or gets benchmarked) when one is configured
+        if (!bridge_listen.empty()) {
+            std::string host;
+            uint16_t port = 0;
+            parseHostPort(bridge_listen, host, port);
+            if (!coordinator.startBridgeListener(host, port)) {
+                std::cerr << "Error: Failed to listen for bridge connections on " << bridge_listen << "\n";
+                return 1;
+            }
+            std::cout << "✓ Bridge listening on port " << coordinator.getBridgeListenerPort() << "\n";
+        }
+        if (bridge_config.peer_host.empty()) {
+            std::erase(bench_config.mechanisms, IPCMechanism::TCP_BRIDGE);
+        } else if (!bench_mode) {
+            coordinator.startMechanism(IPCMechanism::TCP_BRIDGE);
+        }
+        
         // Mode-based execution
-        if (interactive_mode) {
+        if (bench_mode) {
+            benchmarkMode(coordinator, bench_config);
+        } else if (interactive_mode) {
             interactiveMode(coordinator);
         } else if (server_mode) {
-            serverMode(coordinator, http_port);
+            serverMode(coordinator, http_port, http_shards);
         } else {
             daemonMode(coordinator);
         }
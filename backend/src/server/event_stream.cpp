@@ -0,0 +1,169 @@
+/**
+ * @file event_stream.cpp
+ * @brief Server-Sent Events (/ipc/events) com replay por Last-Event-ID
+ */
+
+#include "http_server.h"
+#include "../common/json_writer.h"
+
+namespace ipc_project {
+
+EventStream::EventStream(HTTPServer& server)
+    : server_(server), is_running_(false), listener_id_(0),
+      pending_(false), last_pushed_(0), logger_(Logger::getInstance()) {
+}
+
+EventStream::~EventStream() {
+    stop();
+}
+
+bool EventStream::start() {
+    if (is_running_) return true;
+    if (!coordinator_) {
+        logger_.warning("Stream de eventos sem coordenador - /ipc/events desativado", "HTTP");
+        return false;
+    }
+
+    is_running_ = true;
+    last_pushed_ = coordinator_->lastEventId();
+    // O ouvinte roda na thread do evento: só marca e acorda
+    listener_id_ = coordinator_->addEventListener([this](const IPCEvent&) {
+        {
+            std::lock_guard<std::mutex> lock(wake_mutex_);
+            pending_ = true;
+        }
+        wake_cv_.notify_one();
+    });
+    push_thread_ = std::thread(&EventStream::pushLoop, this);
+    logger_.info("Stream de eventos ativo em /ipc/events", "HTTP");
+    return true;
+}
+
+void EventStream::stop() {
+    if (!is_running_) return;
+
+    if (listener_id_ != 0) {
+        coordinator_->removeEventListener(listener_id_);
+        listener_id_ = 0;
+    }
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+        is_running_ = false;
+    }
+    wake_cv_.notify_all();
+    if (push_thread_.joinable()) {
+        push_thread_.join();
+    }
+}
+
+bool EventStream::isRunning() const {
+    return is_running_;
+}
+
+void EventStream::setIPCCoordinator(std::shared_ptr<IPCCoordinator> coordinator) {
+    coordinator_ = coordinator;
+}
+
+void EventStream::pushLoop() {
+    auto next_heartbeat = std::chrono::steady_clock::now() + std::chrono::milliseconds(HEARTBEAT_INTERVAL_MS);
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(wake_mutex_);
+            wake_cv_.wait_until(lock, next_heartbeat, [this] { return !is_running_ || pending_; });
+            if (!is_running_) break;
+            pending_ = false;
+        }
+
+        // O id é lido antes de contar os clientes: quem ainda não entrou na
+        // contagem vai ler o histórico depois, então já cobre tudo até aqui
+        uint64_t latest = coordinator_->lastEventId();
+        if (server_.getEventStreamClients() == 0) {
+            // Ninguém ouvindo: só acompanha o id (quem chegar pede o replay)
+            last_pushed_ = latest;
+        } else {
+            pushNewEvents();
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now >= next_heartbeat) {
+            static const auto keepalive = std::make_shared<const std::string>(": keepalive\n\n");
+            server_.broadcastEventStream({ { 0, keepalive } });
+            next_heartbeat = now + std::chrono::milliseconds(HEARTBEAT_INTERVAL_MS);
+        }
+    }
+}
+
+// Tudo que entrou no histórico desde a última passada, um pedaço por evento
+// (compartilhado entre os clientes)
+void EventStream::pushNewEvents() {
+    uint64_t oldest = 0;
+    std::vector<IPCEvent> events = coordinator_->getEventsSince(last_pushed_, &oldest);
+    if (events.empty()) return;
+
+    std::vector<HTTPServer::StreamEvent> chunks;
+    chunks.reserve(events.size() + 1);
+    if (oldest > last_pushed_ + 1) {
+        // Rajada maior que o histórico entre duas passadas: avisa a perda
+        chunks.emplace_back(0, std::make_shared<const std::string>(formatResync(oldest)));
+    }
+    for (const auto& event : events) {
+        chunks.emplace_back(event.id, std::make_shared<const std::string>(formatEvent(event)));
+    }
+    last_pushed_ = events.back().id;
+    server_.broadcastEventStream(chunks);
+}
+
+std::string EventStream::openingChunk(std::optional<uint64_t> resume_after, uint64_t& last_sent) const {
+    std::string out = "retry: " + std::to_string(RETRY_MS) + "\n\n";
+    if (!resume_after) {
+        last_sent = coordinator_->lastEventId();
+        return out;
+    }
+
+    // Id do futuro = id de antes de um restart (a sequência recomeça em 1)
+    uint64_t latest = coordinator_->lastEventId();
+    if (*resume_after > latest) {
+        out += formatResync(latest + 1);
+        last_sent = latest;
+        return out;
+    }
+
+    uint64_t oldest = 0;
+    std::vector<IPCEvent> events = coordinator_->getEventsSince(*resume_after, &oldest);
+    if (oldest > *resume_after + 1) {
+        out += formatResync(oldest);
+    }
+    last_sent = *resume_after;
+    for (const auto& event : events) {
+        out += formatEvent(event);
+        last_sent = event.id;
+    }
+    return out;
+}
+
+// O JSON sai numa linha só (quebras de linha vêm escapadas), então um
+// "data:" basta
+std::string EventStream::formatEvent(const IPCEvent& event) {
+    std::string out;
+    out.reserve(192 + event.detail.size());
+    out += "id: ";
+    out += std::to_string(event.id);
+    out += "\nevent: ";
+    out += event.type;
+    out += "\ndata: ";
+    JSONWriter json(out);
+    event.writeJSON(json);
+    out += "\n\n";
+    return out;
+}
+
+std::string EventStream::formatResync(uint64_t oldest_id) {
+    std::string out = "event: resync\ndata: ";
+    JSONWriter json(out);
+    json.beginObject().field("oldest_id", oldest_id).endObject();
+    out += "\n\n";
+    return out;
+}
+
+} // namespace ipc_project
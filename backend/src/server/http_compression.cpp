@@ -0,0 +1,109 @@
+/**
+ * @file http_compression.cpp
+ * @brief Implementação da compressão de respostas HTTP
+ */
+
+#include "http_compression.h"
+#include <zlib.h>
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+
+namespace ipc_project {
+
+namespace {
+
+std::string_view trim(std::string_view text) {
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.front()))) text.remove_prefix(1);
+    while (!text.empty() && std::isspace(static_cast<unsigned char>(text.back()))) text.remove_suffix(1);
+    return text;
+}
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    return a.size() == b.size() &&
+           std::equal(a.begin(), a.end(), b.begin(),
+                      [](char x, char y) { return std::tolower(x) == std::tolower(y); });
+}
+
+} // namespace
+
+// Accept-Encoding: gzip;q=0.8, deflate, *;q=0
+ContentEncoding negotiateEncoding(std::string_view accept_encoding) {
+    double gzip_q = -1.0, deflate_q = -1.0, any_q = -1.0;
+    
+    while (!accept_encoding.empty()) {
+        size_t comma = accept_encoding.find(',');
+        std::string_view item = accept_encoding.substr(0, comma);
+        accept_encoding = comma == std::string_view::npos ? std::string_view() : accept_encoding.substr(comma + 1);
+        
+        double q = 1.0;
+        size_t semicolon = item.find(';');
+        std::string_view name = trim(item.substr(0, semicolon));
+        if (semicolon != std::string_view::npos) {
+            std::string_view param = trim(item.substr(semicolon + 1));
+            if (param.size() > 2 && (param[0] == 'q' || param[0] == 'Q') && param[1] == '=') {
+                q = std::strtod(std::string(param.substr(2)).c_str(), nullptr);
+            }
+        }
+        
+        if (equalsIgnoreCase(name, "gzip") || equalsIgnoreCase(name, "x-gzip")) gzip_q = q;
+        else if (equalsIgnoreCase(name, "deflate")) deflate_q = q;
+        else if (name == "*") any_q = q;
+    }
+    
+    // Codificação não citada herda o q do "*"
+    if (gzip_q < 0) gzip_q = any_q;
+    if (deflate_q < 0) deflate_q = any_q;
+    
+    if (gzip_q > 0 && gzip_q >= deflate_q) return ContentEncoding::GZIP;
+    if (deflate_q > 0) return ContentEncoding::DEFLATE;
+    return ContentEncoding::IDENTITY;
+}
+
+const char* encodingName(ContentEncoding encoding) {
+    switch (encoding) {
+        case ContentEncoding::GZIP: return "gzip";
+        case ContentEncoding::DEFLATE: return "deflate";
+        default: return "";
+    }
+}
+
+bool isCompressible(std::string_view content_type) {
+    return content_type.substr(0, 5) == "text/" ||
+           content_type.find("json") != std::string_view::npos ||
+           content_type.find("javascript") != std::string_view::npos ||
+           content_type.find("svg") != std::string_view::npos;
+}
+
+bool compressBody(std::string_view input, ContentEncoding encoding, std::string& output, int level) {
+    if (encoding == ContentEncoding::IDENTITY || input.empty()) {
+        return false;
+    }
+    
+    // windowBits 15 = zlib; +16 = cabeçalho e trailer gzip
+    z_stream stream{};
+    int window_bits = encoding == ContentEncoding::GZIP ? 15 + 16 : 15;
+    if (deflateInit2(&stream, level, Z_DEFLATED, window_bits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return false;
+    }
+    
+    // deflateBound garante espaço pra terminar tudo num Z_FINISH só
+    output.resize(deflateBound(&stream, static_cast<uLong>(input.size())) + 32);
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(input.data()));
+    stream.avail_in = static_cast<uInt>(input.size());
+    stream.next_out = reinterpret_cast<Bytef*>(output.data());
+    stream.avail_out = static_cast<uInt>(output.size());
+    
+    int result = deflate(&stream, Z_FINISH);
+    size_t produced = stream.total_out;
+    deflateEnd(&stream);
+    
+    if (result != Z_STREAM_END || produced >= input.size()) {
+        output.clear();
+        return false;
+    }
+    output.resize(produced);
+    return true;
+}
+
+} // namespace ipc_project
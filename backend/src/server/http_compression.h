@@ -0,0 +1,34 @@
+/**
+ * @file http_compression.h
+ * @brief Negociação de Accept-Encoding e compressão gzip/deflate (zlib)
+ */
+
+#pragma once
+
+#include <string>
+#include <string_view>
+
+namespace ipc_project {
+
+// Codificações que o servidor sabe produzir
+enum class ContentEncoding {
+    IDENTITY,
+    GZIP,       // RFC 1952
+    DEFLATE     // "deflate" do HTTP = formato zlib (RFC 1950), não deflate cru
+};
+
+// Escolhe a codificação a partir do Accept-Encoding do cliente, respeitando
+// q-values (q=0 recusa). Empate fica com gzip; sem header, IDENTITY
+ContentEncoding negotiateEncoding(std::string_view accept_encoding);
+
+// Nome pro header Content-Encoding ("" pra IDENTITY)
+const char* encodingName(ContentEncoding encoding);
+
+// Tipos que valem a pena comprimir (texto, JSON, JS, SVG). Imagens já vêm comprimidas
+bool isCompressible(std::string_view content_type);
+
+// Comprime input inteiro numa chamada. false se a zlib falhar ou se o
+// resultado não ficar menor que a entrada (aí não compensa mandar comprimido)
+bool compressBody(std::string_view input, ContentEncoding encoding, std::string& output, int level = 6);
+
+} // namespace ipc_project
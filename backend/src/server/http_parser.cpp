@@ -0,0 +1,205 @@
+/**
+ * @file http_parser.cpp
+ * @brief Implementação do parser HTTP incremental
+ */
+
+#include "http_parser.h"
+#include <cctype>
+#include <cstring>
+
+namespace ipc_project {
+
+namespace {
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (std::tolower(static_cast<unsigned char>(a[i])) != std::tolower(static_cast<unsigned char>(b[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool isTokenChar(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || std::strchr("!#$%&'*+-.^_`|~", c) != nullptr;
+}
+
+} // namespace
+
+// HTTPHeaderList
+bool HTTPHeaderList::add(std::string_view name, std::string_view value) {
+    if (count_ == CAPACITY) return false;
+    items_[count_++] = { name, value };
+    return true;
+}
+
+std::string_view HTTPHeaderList::get(std::string_view name) const {
+    for (const auto& header : *this) {
+        if (equalsIgnoreCase(header.name, name)) return header.value;
+    }
+    return {};
+}
+
+bool HTTPHeaderList::contains(std::string_view name) const {
+    for (const auto& header : *this) {
+        if (equalsIgnoreCase(header.name, name)) return true;
+    }
+    return false;
+}
+
+// HTTPRequestParser
+void HTTPRequestParser::reset() {
+    *this = HTTPRequestParser();
+}
+
+bool HTTPRequestParser::headersComplete() const {
+    return state_ == State::BODY || state_ == State::DONE;
+}
+
+HTTPHeaderView HTTPRequestParser::header(size_t index) const {
+    return { view(headers_[index * 2]), view(headers_[index * 2 + 1]) };
+}
+
+std::string_view HTTPRequestParser::header(std::string_view name) const {
+    for (size_t i = 0; i < header_count_; ++i) {
+        if (equalsIgnoreCase(view(headers_[i * 2]), name)) return view(headers_[i * 2 + 1]);
+    }
+    return {};
+}
+
+void HTTPRequestParser::copyHeaders(HTTPHeaderList& list) const {
+    list.clear();
+    for (size_t i = 0; i < header_count_; ++i) {
+        HTTPHeaderView item = header(i);
+        list.add(item.name, item.value);
+    }
+}
+
+HTTPRequestParser::Span HTTPRequestParser::span(size_t begin, size_t end) const {
+    return { static_cast<uint32_t>(begin), static_cast<uint32_t>(end - begin) };
+}
+
+HTTPRequestParser::Result HTTPRequestParser::fail(const char* message) {
+    state_ = State::ERROR;
+    error_ = message;
+    return Result::ERROR;
+}
+
+// Cada chamada examina só os bytes novos: procura fim de linha a partir de
+// scan_ e processa linhas inteiras. O body não é examinado, só contado
+HTTPRequestParser::Result HTTPRequestParser::feed(std::string_view data) {
+    data_ = data;
+    
+    while (state_ == State::REQUEST_LINE || state_ == State::HEADERS) {
+        const void* found = scan_ < data.size()
+            ? std::memchr(data.data() + scan_, '\n', data.size() - scan_) : nullptr;
+        if (!found) {
+            scan_ = data.size();
+            if (data.size() > MAX_HEAD_SIZE) return fail("headers too large");
+            return Result::INCOMPLETE;
+        }
+        
+        size_t newline = static_cast<size_t>(static_cast<const char*>(found) - data.data());
+        size_t line_end = newline > line_start_ && data[newline - 1] == '\r' ? newline - 1 : newline;
+        size_t begin = line_start_;
+        scan_ = line_start_ = newline + 1;
+        if (line_start_ > MAX_HEAD_SIZE) return fail("headers too large");
+        
+        if (state_ == State::REQUEST_LINE) {
+            // Linhas vazias antes da requisição são ignoradas (RFC 7230 3.5)
+            if (line_end == begin) continue;
+            if (!parseRequestLine(begin, line_end)) return fail("bad request line");
+            state_ = State::HEADERS;
+        } else if (line_end == begin) {
+            head_length_ = line_start_;
+            state_ = State::BODY;
+        } else if (!parseHeaderLine(begin, line_end)) {
+            return state_ == State::ERROR ? Result::ERROR : fail("bad header");
+        }
+    }
+    
+    if (state_ == State::BODY && data.size() - head_length_ >= content_length_) {
+        state_ = State::DONE;
+    }
+    if (state_ == State::ERROR) return Result::ERROR;
+    return state_ == State::DONE ? Result::COMPLETE : Result::INCOMPLETE;
+}
+
+// MÉTODO SP alvo SP HTTP/x.y
+bool HTTPRequestParser::parseRequestLine(size_t begin, size_t end) {
+    std::string_view line = data_.substr(begin, end - begin);
+    size_t first = line.find(' ');
+    size_t second = first == std::string_view::npos ? first : line.find(' ', first + 1);
+    if (first == 0 || second == std::string_view::npos || second == first + 1) return false;
+    
+    for (size_t i = 0; i < first; ++i) {
+        if (!isTokenChar(line[i])) return false;
+    }
+    std::string_view version = line.substr(second + 1);
+    if (version.substr(0, 5) != "HTTP/") return false;
+    
+    method_ = span(begin, begin + first);
+    size_t target = begin + first + 1;
+    size_t target_end = begin + second;
+    size_t question = data_.substr(target, target_end - target).find('?');
+    if (question == std::string_view::npos) {
+        path_ = span(target, target_end);
+    } else {
+        path_ = span(target, target + question);
+        query_ = span(target + question + 1, target_end);
+    }
+    version_ = span(begin + second + 1, end);
+    return true;
+}
+
+// nome: OWS valor OWS. Content-Length já é lido aqui pra saber onde o body acaba.
+// Dois Content-Length diferentes, ou Transfer-Encoding junto, deixam o fim do
+// body ambíguo (request smuggling atrás de proxy): recusa com 400
+bool HTTPRequestParser::parseHeaderLine(size_t begin, size_t end) {
+    std::string_view line = data_.substr(begin, end - begin);
+    if (line.front() == ' ' || line.front() == '\t') return false;   // obs-fold
+    
+    size_t colon = line.find(':');
+    if (colon == 0 || colon == std::string_view::npos) return false;
+    for (size_t i = 0; i < colon; ++i) {
+        if (!isTokenChar(line[i])) return false;
+    }
+    
+    size_t value_begin = colon + 1;
+    size_t value_end = line.size();
+    while (value_begin < value_end && (line[value_begin] == ' ' || line[value_begin] == '\t')) value_begin++;
+    while (value_end > value_begin && (line[value_end - 1] == ' ' || line[value_end - 1] == '\t')) value_end--;
+    
+    if (header_count_ == HTTPHeaderList::CAPACITY) {
+        fail("too many headers");
+        return false;
+    }
+    headers_[header_count_ * 2] = span(begin, begin + colon);
+    headers_[header_count_ * 2 + 1] = span(begin + value_begin, begin + value_end);
+    header_count_++;
+    
+    std::string_view name = line.substr(0, colon);
+    std::string_view value = line.substr(value_begin, value_end - value_begin);
+    if (equalsIgnoreCase(name, "Content-Length")) {
+        if (value.empty()) return false;
+        size_t length = 0;
+        for (char c : value) {
+            if (c < '0' || c > '9' || length > (SIZE_MAX - 9) / 10) return false;
+            length = length * 10 + static_cast<size_t>(c - '0');
+        }
+        if (has_content_length_ && length != content_length_) {
+            fail("conflicting content-length");
+            return false;
+        }
+        content_length_ = length;
+        has_content_length_ = true;
+    } else if (equalsIgnoreCase(name, "Transfer-Encoding")) {
+        // Sem suporte a chunked: melhor recusar do que ler o body errado
+        fail(has_content_length_ ? "transfer-encoding with content-length" : "transfer-encoding not supported");
+        return false;
+    }
+    return true;
+}
+
+} // namespace ipc_project
@@ -0,0 +1,103 @@
+/**
+ * @file http_parser.h
+ * @brief Parser HTTP/1.x incremental que trabalha direto no buffer de recepção
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace ipc_project {
+
+// Um header como apareceu na requisição (nome sem normalizar)
+struct HTTPHeaderView {
+    std::string_view name;
+    std::string_view value;
+};
+
+// Lista de headers de tamanho fixo - sem alocação por requisição
+class HTTPHeaderList {
+public:
+    static constexpr size_t CAPACITY = 32;
+    
+    bool add(std::string_view name, std::string_view value);   // false se lotou
+    std::string_view get(std::string_view name) const;         // nome sem diferenciar maiúsculas; "" se faltar
+    bool contains(std::string_view name) const;
+    size_t size() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    void clear() { count_ = 0; }
+    
+    const HTTPHeaderView* begin() const { return items_.data(); }
+    const HTTPHeaderView* end() const { return items_.data() + count_; }
+
+private:
+    std::array<HTTPHeaderView, CAPACITY> items_{};
+    size_t count_ = 0;
+};
+
+// Máquina de estados: linha de requisição -> headers -> body.
+// feed() recebe sempre o buffer inteiro acumulado até agora (ele pode ter
+// mudado de lugar ao crescer) e continua de onde parou, sem reler bytes já
+// vistos. Por isso guarda offsets e só vira string_view nos acessores, sobre
+// o último buffer passado
+class HTTPRequestParser {
+public:
+    enum class Result {
+        INCOMPLETE,     // faltam bytes
+        COMPLETE,       // messageLength() bytes formam uma requisição
+        ERROR           // malformada - responder 400 e fechar
+    };
+    
+    static constexpr size_t MAX_HEAD_SIZE = 16 * 1024;   // linha + headers
+    
+    Result feed(std::string_view data);
+    void reset();                                        // pra próxima requisição (pipelining)
+    
+    bool headersComplete() const;
+    size_t headerLength() const { return head_length_; }   // até o \r\n\r\n, inclusive
+    size_t contentLength() const { return content_length_; }
+    size_t messageLength() const { return head_length_ + content_length_; }
+    const char* error() const { return error_; }
+    
+    // Válidos depois de COMPLETE (ou headersComplete), sobre o último buffer
+    std::string_view method() const { return view(method_); }
+    std::string_view path() const { return view(path_); }       // sem a query
+    std::string_view query() const { return view(query_); }     // depois do '?'
+    std::string_view version() const { return view(version_); }
+    std::string_view body() const { return data_.substr(head_length_, content_length_); }
+    size_t headerCount() const { return header_count_; }
+    HTTPHeaderView header(size_t index) const;
+    std::string_view header(std::string_view name) const;
+    void copyHeaders(HTTPHeaderList& list) const;
+
+private:
+    enum class State { REQUEST_LINE, HEADERS, BODY, DONE, ERROR };
+    
+    struct Span {
+        uint32_t offset = 0;
+        uint32_t length = 0;
+    };
+    
+    State state_ = State::REQUEST_LINE;
+    std::string_view data_;
+    size_t scan_ = 0;               // próximo byte a examinar
+    size_t line_start_ = 0;
+    Span method_, path_, query_, version_;
+    std::array<Span, HTTPHeaderList::CAPACITY * 2> headers_{};   // nome, valor, nome, valor...
+    size_t header_count_ = 0;
+    size_t head_length_ = 0;
+    size_t content_length_ = 0;
+    bool has_content_length_ = false;
+    const char* error_ = "";
+    
+    std::string_view view(Span span) const { return data_.substr(span.offset, span.length); }
+    Span span(size_t begin, size_t end) const;
+    bool parseRequestLine(size_t begin, size_t end);
+    bool parseHeaderLine(size_t begin, size_t end);
+    Result fail(const char* message);
+};
+
+} // namespace ipc_project
@@ -0,0 +1,154 @@
+/**
+ * @file http_router.h
+ * @brief Tabela de rotas montada em tempo de compilação (hash perfeito)
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <utility>
+
+namespace ipc_project {
+
+// Parâmetros capturados da rota ({mechanism}) - views pra dentro do path
+class RouteParams {
+public:
+    static constexpr size_t CAPACITY = 4;
+    
+    // Cria o parâmetro se faltar (lotado: sobrescreve o último)
+    std::string_view& operator[](std::string_view name) {
+        for (size_t i = 0; i < count_; ++i) {
+            if (items_[i].first == name) return items_[i].second;
+        }
+        size_t index = count_ < CAPACITY ? count_++ : CAPACITY - 1;
+        items_[index] = { name, {} };
+        return items_[index].second;
+    }
+    
+    const std::string_view* find(std::string_view name) const {
+        for (size_t i = 0; i < count_; ++i) {
+            if (items_[i].first == name) return &items_[i].second;
+        }
+        return nullptr;
+    }
+    
+    size_t size() const { return count_; }
+    void clear() { count_ = 0; }
+
+private:
+    std::array<std::pair<std::string_view, std::string_view>, CAPACITY> items_{};
+    size_t count_ = 0;
+};
+
+// Rotas fixas: "GET /ipc/status" ou com parâmetro no último segmento,
+// "POST /ipc/start/{mechanism}". A chave do hash é método + path; rota com
+// parâmetro entra com o prefixo ("/ipc/start/") seguido de '{'. Na busca
+// tenta o path inteiro e depois o prefixo até a última '/' - duas contas de
+// hash, nenhuma alocação nem cópia
+template <typename Handler, size_t N>
+class RouteTable {
+public:
+    struct Route {
+        std::string_view method;
+        std::string_view pattern;
+        Handler handler;
+    };
+    
+    static constexpr size_t SLOTS = [] {
+        size_t slots = 8;
+        while (slots < N * 2) slots *= 2;
+        return slots;
+    }();
+    
+    // Procura uma semente sem colisão. Sem solução (rota repetida, parâmetro
+    // fora do último segmento) a compilação falha aqui
+    consteval explicit RouteTable(const std::array<Route, N>& routes) : routes_(routes) {
+        for (const Route& route : routes_) {
+            size_t brace = route.pattern.find('{');
+            if (brace != std::string_view::npos &&
+                (route.pattern[brace - 1] != '/' || route.pattern.back() != '}' ||
+                 route.pattern.find('/', brace) != std::string_view::npos)) {
+                throw "route parameter must be the whole last segment";
+            }
+        }
+        
+        for (uint32_t seed = 0; seed < 100000; ++seed) {
+            std::array<uint8_t, SLOTS> slots{};
+            bool collision = false;
+            for (size_t i = 0; i < N && !collision; ++i) {
+                std::string_view pattern = routes_[i].pattern;
+                size_t slot = slotOf(seed, routes_[i].method, keyOf(pattern), keyOf(pattern) != pattern);
+                collision = slots[slot] != 0;
+                slots[slot] = static_cast<uint8_t>(i + 1);
+            }
+            if (!collision) {
+                seed_ = seed;
+                slots_ = slots;
+                return;
+            }
+        }
+        throw "no perfect hash seed found";
+    }
+    
+    const Route* find(std::string_view method, std::string_view path, RouteParams& params) const {
+        // Rota exata
+        const Route* route = at(slotOf(seed_, method, path));
+        if (route && route->method == method && route->pattern == path) {
+            return route;
+        }
+        
+        // Rota com parâmetro: prefixo até a última '/' + '{'
+        size_t slash = path.rfind('/');
+        if (slash == std::string_view::npos || slash + 1 == path.size()) return nullptr;
+        std::string_view prefix = path.substr(0, slash + 1);
+        route = at(slotOf(seed_, method, prefix, true));
+        if (!route || route->method != method || route->pattern.size() <= prefix.size() + 2 ||
+            route->pattern.substr(0, prefix.size()) != prefix || route->pattern[prefix.size()] != '{') {
+            return nullptr;
+        }
+        
+        std::string_view name = route->pattern.substr(prefix.size() + 1);
+        name.remove_suffix(1);
+        params[name] = path.substr(slash + 1);
+        return route;
+    }
+    
+    uint32_t seed() const { return seed_; }
+    const std::array<Route, N>& routes() const { return routes_; }
+
+private:
+    std::array<Route, N> routes_;
+    std::array<uint8_t, SLOTS> slots_{};   // índice + 1 (0 = vazio)
+    uint32_t seed_ = 0;
+    
+    const Route* at(size_t slot) const {
+        return slots_[slot] ? &routes_[slots_[slot] - 1] : nullptr;
+    }
+    
+    // Pra rota com parâmetro a chave é só o prefixo
+    static constexpr std::string_view keyOf(std::string_view pattern) {
+        size_t brace = pattern.find('{');
+        return brace == std::string_view::npos ? pattern : pattern.substr(0, brace);
+    }
+    
+    static constexpr size_t slotOf(uint32_t seed, std::string_view method, std::string_view path,
+                                   bool parameter = false) {
+        // FNV-1a com semente
+        uint32_t hash = 2166136261u ^ (seed * 0x9E3779B9u);
+        auto mix = [&hash](char c) {
+            hash ^= static_cast<uint8_t>(c);
+            hash *= 16777619u;
+        };
+        for (char c : method) mix(c);
+        mix(' ');
+        for (char c : path) mix(c);
+        if (parameter) mix('{');
+        hash ^= hash >> 15;
+        return hash & (SLOTS - 1);
+    }
+};
+
+} // namespace ipc_project
@@ -4,22 +4,113 @@
  */
 
 #include "http_server.h"
+#include "../common/json_parser.h"
+#include "../common/json_writer.h"
 #include <sys/socket.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
 #include <sstream>
 #include <fstream>
 #include <algorithm>
 #include <cstring>
+#include <cctype>
+#include <charconv>
+#include <ctime>
+#include <filesystem>
 
 namespace ipc_project {
 
+namespace {
+
+// Data HTTP (IMF-fixdate), sempre em GMT
+std::string httpDate(time_t when) {
+    std::tm tm_utc;
+    gmtime_r(&when, &tm_utc);
+    char buffer[64];
+    size_t length = strftime(buffer, sizeof(buffer), "%a, %d %b %Y %H:%M:%S GMT", &tm_utc);
+    return std::string(buffer, length);
+}
+
+// Muda quando o arquivo muda de tamanho ou de mtime
+std::string staticETag(const struct stat& info) {
+    char buffer[64];
+    int length = snprintf(buffer, sizeof(buffer), "\"%llx-%llx\"",
+                          static_cast<unsigned long long>(info.st_size),
+                          static_cast<unsigned long long>(info.st_mtim.tv_sec) * 1000000000ULL +
+                          static_cast<unsigned long long>(info.st_mtim.tv_nsec));
+    return std::string(buffer, static_cast<size_t>(length));
+}
+
+// no-cache: o navegador sempre revalida, mas com 304 não baixa de novo.
+// Vary avisa caches intermediários que o corpo depende do Accept-Encoding
+std::string staticHeaders(const std::string& etag, const std::string& last_modified,
+                          ContentEncoding encoding = ContentEncoding::IDENTITY, bool vary = false) {
+    std::string headers = "ETag: " + etag + "\r\n";
+    if (!last_modified.empty()) {
+        headers += "Last-Modified: " + last_modified + "\r\n";
+    }
+    headers += "Cache-Control: no-cache\r\n";
+    if (encoding != ContentEncoding::IDENTITY) {
+        headers += std::string("Content-Encoding: ") + encodingName(encoding) + "\r\n";
+    }
+    if (vary) {
+        headers += "Vary: Accept-Encoding\r\n";
+    }
+    return headers;
+}
+
+// Busca sem diferenciar maiúsculas e sem copiar o header
+bool containsIgnoreCase(std::string_view text, std::string_view needle) {
+    auto it = std::search(text.begin(), text.end(), needle.begin(), needle.end(),
+                          [](char a, char b) { return std::tolower(static_cast<unsigned char>(a)) ==
+                                                      std::tolower(static_cast<unsigned char>(b)); });
+    return it != text.end();
+}
+
+} // namespace
+
 // Implementação HTTPRequest
 std::string HTTPRequest::getParam(const std::string& key, const std::string& default_val) const {
-    auto it = params.find(key);
-    return (it != params.end()) ? it->second : default_val;
+    const std::string_view* value = params.find(key);
+    return value ? std::string(*value) : default_val;
+}
+
+std::string_view HTTPRequest::getHeader(std::string_view name) const {
+    return headers.get(name);
+}
+
+bool HTTPRequest::wantsKeepAlive() const {
+    std::string_view connection = getHeader("Connection");
+    if (containsIgnoreCase(connection, "close")) return false;
+    if (version == "HTTP/1.0") return containsIgnoreCase(connection, "keep-alive");
+    return true;
+}
+
+// Fatia do body que divide o bloco com raw - usada pra repassar o payload
+// até o transporte IPC sem copiar. Sem raw (request montado na mão) copia.
+MessageBuffer HTTPRequest::bodySlice(size_t pos, size_t length) const {
+    if (pos > body.size()) return MessageBuffer();
+    length = std::min(length, body.size() - pos);
+    if (raw.empty()) {
+        return MessageBuffer::copyOf(body.substr(pos, length));
+    }
+    size_t body_offset = static_cast<size_t>(body.data() - raw.data());
+    return raw.slice(body_offset + pos, length);
+}
+
+const StaticAsset::Variant& StaticAsset::select(ContentEncoding encoding) const {
+    if (encoding == ContentEncoding::GZIP && gzip.body) return gzip;
+    if (encoding == ContentEncoding::DEFLATE && deflate.body) return deflate;
+    return identity;
 }
 
 // Implementação HTTPResponse
@@ -35,27 +126,54 @@ void HTTPResponse::setJSON(const std::string& json_content) {
 void HTTPResponse::setError(int code, const std::string& message) {
     status_code = code;
     content_type = "application/json";
-    body = "{\"error\":\"" + message + "\",\"code\":" + std::to_string(code) + "}";
+    // A mensagem costuma carregar path ou campo vindo do cliente - sempre escapada
+    body.clear();
+    JSONWriter json(body);
+    json.beginObject().field("error", message).field("code", code).endObject();
 }
 
-std::string HTTPResponse::toString() const {
+size_t HTTPResponse::bodyLength() const {
+    if (shared_body) return shared_body->size();
+    if (!file_path.empty()) return file_size;
+    return body.length();
+}
+
+std::string HTTPResponse::head() const {
     std::stringstream response;
     
     // Status line
     response << "HTTP/1.1 " << status_code;
     switch (status_code) {
+        case 101: response << " Switching Protocols"; break;
         case 200: response << " OK"; break;
+        case 304: response << " Not Modified"; break;
         case 404: response << " Not Found"; break;
         case 500: response << " Internal Server Error"; break;
         case 400: response << " Bad Request"; break;
+        case 413: response << " Payload Too Large"; break;
+        case 426: response << " Upgrade Required"; break;
+        case 503: response << " Service Unavailable"; break;
         default: response << " Unknown"; break;
     }
     response << "\r\n";
     
-    // Headers
-    response << "Content-Type: " << content_type << "\r\n";
-    response << "Content-Length: " << body.length() << "\r\n";
-    response << "Connection: close\r\n";
+    // Headers (304 não tem corpo - o cliente reaproveita o que já tem; depois
+    // do 101 os bytes já são do outro protocolo)
+    if (status_code == 101) {
+        response << "Connection: Upgrade\r\n";
+    } else if (event_stream) {
+        // Sem tamanho: o corpo vai até a conexão fechar
+        response << "Content-Type: " << content_type << "\r\n";
+        response << "Cache-Control: no-cache\r\n";
+        response << "Connection: close\r\n";
+    } else {
+        if (status_code != 304) {
+            response << "Content-Type: " << content_type << "\r\n";
+            response << "Content-Length: " << bodyLength() << "\r\n";
+        }
+        response << "Connection: " << (keep_alive ? "keep-alive" : "close") << "\r\n";
+    }
+    response << preset_headers;
     
     // Headers extras
     for (const auto& header : headers) {
@@ -63,16 +181,24 @@ std::string HTTPResponse::toString() const {
     }
     
     response << "\r\n";
-    response << body;
-    
     return response.str();
 }
 
+std::string HTTPResponse::toString() const {
+    return head() + (shared_body ? *shared_body : body);
+}
+
 // Implementação HTTPServer
 HTTPServer::HTTPServer(int port) 
     : port_(port), is_running_(false), shutdown_requested_(false), 
-      cors_enabled_(true), server_socket_(-1), request_count_(0),
-      logger_(Logger::getInstance()) {
+      cors_enabled_(true), keep_alive_enabled_(true), compression_enabled_(true),
+      compression_min_size_(1024), keep_alive_timeout_ms_(5000),
+      keep_alive_max_requests_(100), websocket_enabled_(true), event_stream_enabled_(true),
+      shard_count_(1),
+      worker_count_(std::clamp<size_t>(std::thread::hardware_concurrency(), 2, 4)),
+      owns_executor_(false), in_flight_(0),
+      static_hits_(0), static_not_modified_(0), static_sendfile_(0),
+      compressed_responses_(0), compression_saved_bytes_(0), logger_(Logger::getInstance()) {
     
     logger_.info("HTTPServer criado na porta " + std::to_string(port), "HTTP");
 }
@@ -87,15 +213,57 @@ bool HTTPServer::start() {
         return true;
     }
     
-    if (!createSocket()) {
-        return false;
+    loadStaticCache();
+    
+    shards_.clear();
+    for (size_t i = 0; i < shard_count_; ++i) {
+        auto shard = std::make_unique<Shard>();
+        shard->index = i;
+        if (!createSocket(*shard)) {
+            for (auto& created : shards_) {
+                closeSocket(*created);
+            }
+            shards_.clear();
+            return false;
+        }
+        shards_.push_back(std::move(shard));
+    }
+    
+    // Sem pool compartilhado: cria um só pra este servidor (com shards as
+    // requisições ficam na thread do shard e o pool não é usado)
+    if (shards_.size() == 1 && (!executor_ || !executor_->isRunning())) {
+        executor_ = std::make_shared<WorkStealingExecutor>(worker_count_);
+        owns_executor_ = true;
     }
     
     is_running_ = true;
     shutdown_requested_ = false;
-    server_thread_ = std::make_unique<std::thread>(&HTTPServer::serverLoop, this);
+    for (auto& shard : shards_) {
+        shard->thread = std::thread(&HTTPServer::serverLoop, this, std::ref(*shard));
+    }
     
-    logger_.info("Servidor HTTP iniciado na porta " + std::to_string(port_), "HTTP");
+    // Push ao vivo: sem socket próprio, as conexões ficam nos shards
+    websocket_.reset();
+    if (websocket_enabled_) {
+        websocket_ = std::make_unique<WebSocketServer>(*this);
+        websocket_->setIPCCoordinator(coordinator_);
+        websocket_->start();
+    }
+    event_stream_.reset();
+    if (event_stream_enabled_ && coordinator_) {
+        event_stream_ = std::make_unique<EventStream>(*this);
+        event_stream_->setIPCCoordinator(coordinator_);
+        event_stream_->start();
+    }
+    
+    if (shards_.size() > 1) {
+        logger_.info("Servidor HTTP iniciado na porta " + std::to_string(port_) + " (" +
+                     std::to_string(shards_.size()) + " shards SO_REUSEPORT)", "HTTP");
+    } else {
+        logger_.info("Servidor HTTP iniciado na porta " + std::to_string(port_) + " (" +
+                     std::to_string(executor_->threadCount()) + " workers" +
+                     (owns_executor_ ? "" : ", pool compartilhado") + ")", "HTTP");
+    }
     return true;
 }
 
@@ -103,13 +271,50 @@ void HTTPServer::stop() {
     if (!is_running_) return;
     
     logger_.info("Parando servidor HTTP...", "HTTP");
+    
+    // Push para antes: ele escreve nas conexões que vão ser fechadas
+    if (websocket_) {
+        websocket_->stop();
+    }
+    if (event_stream_) {
+        event_stream_->stop();
+    }
     shutdown_requested_ = true;
     
-    if (server_thread_ && server_thread_->joinable()) {
-        server_thread_->join();
+    // Acorda os epoll_wait na hora
+    uint64_t one = 1;
+    for (auto& shard : shards_) {
+        if (write(shard->wake_fd, &one, sizeof(one)) < 0) {
+            logger_.warning("Falha ao acordar o reactor: " + std::string(strerror(errno)), "HTTP");
+        }
+    }
+    for (auto& shard : shards_) {
+        if (shard->thread.joinable()) {
+            shard->thread.join();
+        }
+    }
+    
+    // Tarefas na fila veem o shutdown e só fecham a conexão; espera todas
+    {
+        std::unique_lock<std::mutex> lock(in_flight_mutex_);
+        in_flight_cv_.wait(lock, [this] { return in_flight_ == 0; });
+    }
+    if (owns_executor_) {
+        executor_->shutdown();
+        executor_.reset();
+        owns_executor_ = false;
     }
     
-    closeSocket();
+    for (auto& shard : shards_) {
+        {
+            std::lock_guard<std::mutex> lock(shard->connections_mutex);
+            for (const auto& pair : shard->connections) {
+                close(pair.first);
+            }
+            shard->connections.clear();
+        }
+        closeSocket(*shard);
+    }
     is_running_ = false;
     logger_.info("Servidor HTTP parado", "HTTP");
 }
@@ -136,29 +341,126 @@ void HTTPServer::setStaticPath(const std::string& path) {
     static_path_ = path;
 }
 
+void HTTPServer::setWorkerThreads(size_t count) {
+    if (!is_running_ && count > 0) {
+        worker_count_ = count;
+    }
+}
+
+void HTTPServer::setKeepAlive(bool enabled, long idle_timeout_ms, size_t max_requests) {
+    keep_alive_enabled_ = enabled && max_requests > 1;
+    keep_alive_timeout_ms_ = idle_timeout_ms;
+    keep_alive_max_requests_ = max_requests;
+}
+
+void HTTPServer::setCompression(bool enabled, size_t min_size) {
+    if (!is_running_) {
+        compression_enabled_ = enabled;
+        compression_min_size_ = min_size;
+    }
+}
+
+size_t HTTPServer::getWorkerThreads() const {
+    return executor_ && !owns_executor_ ? executor_->threadCount() : worker_count_;
+}
+
+void HTTPServer::setShards(size_t count) {
+    if (!is_running_) {
+        shard_count_ = count > 0 ? count : std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    }
+}
+
+size_t HTTPServer::getShardCount() const {
+    return shard_count_;
+}
+
+void HTTPServer::setExecutor(std::shared_ptr<WorkStealingExecutor> executor) {
+    if (!is_running_) {
+        executor_ = std::move(executor);
+        owns_executor_ = false;
+    }
+}
+
+ExecutorStats HTTPServer::getExecutorStats() const {
+    return executor_ ? executor_->getStats() : ExecutorStats();
+}
+
 void HTTPServer::setIPCCoordinator(std::shared_ptr<IPCCoordinator> coordinator) {
     coordinator_ = coordinator;
 }
 
+void HTTPServer::setWebSocket(bool enabled) {
+    websocket_enabled_ = enabled;
+}
+
+WebSocketServer* HTTPServer::getWebSocketServer() const {
+    return websocket_.get();
+}
+
+void HTTPServer::setEventStream(bool enabled) {
+    event_stream_enabled_ = enabled;
+}
+
+// Os contadores ficam nos shards; a soma só é feita quando alguém pergunta.
+// Os shards só somem no próximo start, então ler depois do stop é seguro
 size_t HTTPServer::getRequestCount() const {
-    return request_count_;
+    size_t total = 0;
+    for (const auto& shard : shards_) {
+        total += shard->requests;
+    }
+    return total;
+}
+
+size_t HTTPServer::getActiveConnections() const {
+    size_t total = 0;
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->connections_mutex);
+        total += shard->connections.size();
+    }
+    return total;
+}
+
+size_t HTTPServer::getWebSocketClients() const {
+    return connectionsIn(ConnectionState::WEBSOCKET).size();
+}
+
+size_t HTTPServer::getEventStreamClients() const {
+    return connectionsIn(ConnectionState::EVENT_STREAM).size();
+}
+
+std::vector<size_t> HTTPServer::getShardAccepts() const {
+    std::vector<size_t> accepts;
+    for (const auto& shard : shards_) {
+        accepts.push_back(shard->accepted);
+    }
+    return accepts;
 }
 
 std::vector<std::string> HTTPServer::getAccessLogs(size_t count) {
+    std::lock_guard<std::mutex> lock(logs_mutex_);
     size_t start = access_logs_.size() > count ? access_logs_.size() - count : 0;
     return std::vector<std::string>(access_logs_.begin() + start, access_logs_.end());
 }
 
-bool HTTPServer::createSocket() {
-    server_socket_ = socket(AF_INET, SOCK_STREAM, 0);
-    if (server_socket_ < 0) {
+bool HTTPServer::createSocket(Shard& shard) {
+    int listen_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listen_fd < 0) {
         logger_.error("Falha ao criar socket: " + std::string(strerror(errno)), "HTTP");
         return false;
     }
+    shard.listen_fd = listen_fd;
     
     // Permite reutilizar endereço
     int opt = 1;
-    setsockopt(server_socket_, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    setsockopt(listen_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    
+    // Vários listeners na mesma porta: o kernel distribui as conexões novas
+    // entre eles (hash da origem), sem um accept central
+    if (shard_count_ > 1 && setsockopt(listen_fd, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt)) < 0) {
+        logger_.error("Falha no SO_REUSEPORT: " + std::string(strerror(errno)), "HTTP");
+        closeSocket(shard);
+        return false;
+    }
     
     // Configura endereço
     sockaddr_in address;
@@ -168,160 +470,769 @@ bool HTTPServer::createSocket() {
     address.sin_port = htons(port_);
     
     // Bind
-    if (bind(server_socket_, (struct sockaddr*)&address, sizeof(address)) < 0) {
+    if (bind(listen_fd, (struct sockaddr*)&address, sizeof(address)) < 0) {
         logger_.error("Falha no bind: " + std::string(strerror(errno)), "HTTP");
-        close(server_socket_);
+        closeSocket(shard);
         return false;
     }
     
     // Listen
-    if (listen(server_socket_, 10) < 0) {
+    if (listen(listen_fd, SOMAXCONN) < 0) {
         logger_.error("Falha no listen: " + std::string(strerror(errno)), "HTTP");
-        close(server_socket_);
+        closeSocket(shard);
         return false;
     }
     
+    // epoll com o socket de escuta e o eventfd de parada
+    shard.epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    shard.wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (shard.epoll_fd < 0 || shard.wake_fd < 0) {
+        logger_.error("Falha ao criar epoll: " + std::string(strerror(errno)), "HTTP");
+        closeSocket(shard);
+        return false;
+    }
+    
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLET;
+    event.data.fd = listen_fd;
+    epoll_ctl(shard.epoll_fd, EPOLL_CTL_ADD, listen_fd, &event);
+    event.events = EPOLLIN;
+    event.data.fd = shard.wake_fd;
+    epoll_ctl(shard.epoll_fd, EPOLL_CTL_ADD, shard.wake_fd, &event);
+    
     return true;
 }
 
-void HTTPServer::closeSocket() {
-    if (server_socket_ >= 0) {
-        close(server_socket_);
-        server_socket_ = -1;
+void HTTPServer::closeSocket(Shard& shard) {
+    for (int* fd : { &shard.listen_fd, &shard.epoll_fd, &shard.wake_fd }) {
+        if (*fd >= 0) {
+            close(*fd);
+            *fd = -1;
+        }
     }
 }
 
-void HTTPServer::serverLoop() {
+// Reactor: só faz I/O não bloqueante. Edge-triggered, então cada evento
+// drena o socket até EAGAIN
+void HTTPServer::serverLoop(Shard& shard) {
+    constexpr int MAX_EVENTS = 64;
+    epoll_event events[MAX_EVENTS];
+    auto last_sweep = std::chrono::steady_clock::now();
+    
+    // Thread por núcleo: cada shard fica num núcleo (o cache das conexões dele
+    // não troca de CPU). Falhar aqui só custa desempenho
+    unsigned cores = std::thread::hardware_concurrency();
+    if (shards_.size() > 1 && cores > 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(shard.index % cores, &set);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+            logger_.warning("Falha ao fixar shard " + std::to_string(shard.index) + " no núcleo", "HTTP");
+        }
+    }
+    
     while (!shutdown_requested_) {
-        fd_set read_fds;
-        FD_ZERO(&read_fds);
-        FD_SET(server_socket_, &read_fds);
+        int count = epoll_wait(shard.epoll_fd, events, MAX_EVENTS, 1000);
+        if (count < 0) {
+            if (errno == EINTR) continue;
+            logger_.error("Erro no epoll_wait: " + std::string(strerror(errno)), "HTTP");
+            break;
+        }
         
-        timeval timeout;
-        timeout.tv_sec = 1;
-        timeout.tv_usec = 0;
+        for (int i = 0; i < count && !shutdown_requested_; ++i) {
+            int fd = events[i].data.fd;
+            if (fd == shard.listen_fd) {
+                acceptConnections(shard);
+                continue;
+            }
+            if (fd == shard.wake_fd) {
+                continue;
+            }
+            
+            std::shared_ptr<Connection> conn;
+            {
+                std::lock_guard<std::mutex> lock(shard.connections_mutex);
+                auto it = shard.connections.find(fd);
+                if (it == shard.connections.end()) continue;
+                conn = it->second;
+            }
+            
+            // Conexão com um worker não é mexida aqui - ele decide o que fazer
+            ConnectionState state = conn->state;
+            if (state == ConnectionState::READING && (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))) {
+                handleReadable(conn);
+            } else if (state == ConnectionState::WRITING && (events[i].events & (EPOLLOUT | EPOLLHUP | EPOLLERR))) {
+                handleWritable(conn);
+            } else if (state == ConnectionState::WEBSOCKET || state == ConnectionState::EVENT_STREAM) {
+                handlePushConnection(conn, events[i].events);
+            }
+        }
         
-        int activity = select(server_socket_ + 1, &read_fds, nullptr, nullptr, &timeout);
+        auto now = std::chrono::steady_clock::now();
+        if (now - last_sweep >= std::chrono::seconds(1)) {
+            closeIdleConnections(shard);
+            last_sweep = now;
+        }
+    }
+}
+
+void HTTPServer::acceptConnections(Shard& shard) {
+    while (true) {
+        int client_socket = accept4(shard.listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (client_socket < 0) {
+            if (errno == EINTR) continue;
+            if (errno != EAGAIN && errno != EWOULDBLOCK) {
+                logger_.warning("Erro no accept: " + std::string(strerror(errno)), "HTTP");
+            }
+            return;
+        }
         
-        if (activity < 0 && errno != EINTR) {
-            logger_.error("Erro no select: " + std::string(strerror(errno)), "HTTP");
-            break;
+        auto conn = std::make_shared<Connection>();
+        conn->fd = client_socket;
+        conn->shard = &shard;
+        conn->touch();
+        {
+            std::lock_guard<std::mutex> lock(shard.connections_mutex);
+            shard.connections[client_socket] = conn;
         }
+        shard.accepted++;
         
-        if (activity > 0 && FD_ISSET(server_socket_, &read_fds)) {
-            sockaddr_in client_addr;
-            socklen_t client_len = sizeof(client_addr);
-            
-            int client_socket = accept(server_socket_, (struct sockaddr*)&client_addr, &client_len);
-            if (client_socket >= 0) {
-                std::thread client_thread(&HTTPServer::handleClient, this, client_socket);
-                client_thread.detach();
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLRDHUP | EPOLLET;
+        event.data.fd = client_socket;
+        if (epoll_ctl(shard.epoll_fd, EPOLL_CTL_ADD, client_socket, &event) < 0) {
+            closeConnection(shard, client_socket);
+        }
+    }
+}
+
+// Lê tudo que o kernel tem. Requisição completa vai pra fila dos workers
+void HTTPServer::handleReadable(const std::shared_ptr<Connection>& conn) {
+    constexpr size_t READ_CHUNK = 4096;
+    conn->touch();
+    
+    while (true) {
+        conn->in.reserve(READ_CHUNK);
+        ssize_t bytes = recv(conn->fd, conn->in.tail(), conn->in.tailroom(), 0);
+        if (bytes < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            closeConnection(*conn->shard, conn->fd);
+            return;
+        }
+        if (bytes == 0) {
+            // Cliente fechou antes de mandar a requisição inteira
+            closeConnection(*conn->shard, conn->fd);
+            return;
+        }
+        conn->in.commit(static_cast<size_t>(bytes));
+        conn->between_requests = false;
+        
+        HTTPRequestParser::Result result = requestComplete(*conn);
+        if (result == HTTPRequestParser::Result::COMPLETE) {
+            conn->state = ConnectionState::PROCESSING;
+            dispatch(conn);
+            return;
+        }
+        
+        // Resposta curta de erro - a conexão fecha depois que ela sair
+        if (result == HTTPRequestParser::Result::ERROR) {
+            rejectRequest(*conn, 400, std::string("Malformed request: ") + conn->parser.error());
+        } else if (conn->in.size() > MAX_REQUEST_SIZE || conn->parser.contentLength() > MAX_REQUEST_SIZE) {
+            rejectRequest(*conn, 413, "Request too large");
+        } else {
+            continue;
+        }
+        conn->state = ConnectionState::WRITING;
+        handleWritable(conn);
+        return;
+    }
+}
+
+void HTTPServer::handleWritable(const std::shared_ptr<Connection>& conn) {
+    conn->touch();
+    bool would_block = false;
+    if (!flushOutput(*conn, would_block)) {
+        closeConnection(*conn->shard, conn->fd);
+    } else if (!would_block) {
+        finishWrite(conn);
+    }
+}
+
+// Respostas enviadas: fecha (Connection: close) ou volta a esperar a próxima
+// requisição. O MOD rearma a borda - se o cliente já mandou mais bytes
+// (pipelining), o EPOLLIN chega na hora
+void HTTPServer::finishWrite(const std::shared_ptr<Connection>& conn) {
+    if (conn->close_after_write || shutdown_requested_) {
+        closeConnection(*conn->shard, conn->fd);
+        return;
+    }
+    
+    conn->out.clear();
+    conn->out_offset = 0;
+    conn->between_requests = conn->requests > 0 && conn->in.empty();
+    conn->touch();
+    conn->state = ConnectionState::READING;
+    
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLRDHUP | EPOLLET;
+    event.data.fd = conn->fd;
+    if (epoll_ctl(conn->shard->epoll_fd, EPOLL_CTL_MOD, conn->fd, &event) < 0) {
+        closeConnection(*conn->shard, conn->fd);
+    }
+}
+
+// Fecha conexões paradas: cliente que abriu e não mandou nada, não lê a
+// resposta, ou conexão persistente ociosa entre requisições
+void HTTPServer::closeIdleConnections(Shard& shard) {
+    int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    auto idleFor = [now](const Connection& conn, long timeout_ms) {
+        return now - conn.last_activity_ns.load(std::memory_order_relaxed) >= timeout_ms * 1000000LL;
+    };
+    std::vector<int> idle;
+    {
+        std::lock_guard<std::mutex> lock(shard.connections_mutex);
+        for (const auto& pair : shard.connections) {
+            const Connection& conn = *pair.second;
+            if (conn.state == ConnectionState::PROCESSING) continue;
+            if (conn.state == ConnectionState::WEBSOCKET) {
+                // O navegador responde os pings sozinho: dois sem resposta = caiu
+                if (idleFor(conn, 2 * WebSocketServer::PING_INTERVAL_MS + 5000)) {
+                    idle.push_back(pair.first);
+                }
+                continue;
+            }
+            if (conn.state == ConnectionState::EVENT_STREAM) continue;   // o keepalive acha quem caiu
+            bool between_requests = conn.state == ConnectionState::READING && conn.between_requests;
+            long timeout_ms = between_requests ? keep_alive_timeout_ms_ : REQUEST_TIMEOUT_MS;
+            if (idleFor(conn, timeout_ms)) {
+                idle.push_back(pair.first);
             }
         }
     }
+    for (int fd : idle) {
+        closeConnection(shard, fd);
+    }
 }
 
-void HTTPServer::handleClient(int client_socket) {
-    std::string raw_request = readFromSocket(client_socket);
-    if (raw_request.empty()) {
-        close(client_socket);
+// Tira do mapa antes de fechar - um fd reaproveitado pelo accept já é outra
+// conexão. O close espera quem está escrevendo (push do WebSocket) e marca
+// closed pra ninguém mais usar o fd
+void HTTPServer::closeConnection(Shard& shard, int fd) {
+    std::shared_ptr<Connection> conn;
+    {
+        std::lock_guard<std::mutex> lock(shard.connections_mutex);
+        auto it = shard.connections.find(fd);
+        if (it == shard.connections.end()) return;
+        conn = std::move(it->second);
+        shard.connections.erase(it);
+    }
+    std::lock_guard<std::mutex> lock(conn->out_mutex);
+    conn->closed = true;
+    shutdown(fd, SHUT_RDWR);   // filho de mecanismo (fork) herda o fd: só o close não manda FIN
+    close(fd);
+}
+
+void HTTPServer::closeConnection(const std::shared_ptr<Connection>& conn) {
+    {
+        std::lock_guard<std::mutex> lock(conn->shard->connections_mutex);
+        auto it = conn->shard->connections.find(conn->fd);
+        if (it == conn->shard->connections.end() || it->second != conn) return;
+        conn->shard->connections.erase(it);
+    }
+    std::lock_guard<std::mutex> lock(conn->out_mutex);
+    conn->closed = true;
+    shutdown(conn->fd, SHUT_RDWR);
+    close(conn->fd);
+}
+
+void HTTPServer::dispatch(const std::shared_ptr<Connection>& conn) {
+    // Com shards a própria thread do reactor atende (thread por núcleo)
+    if (shards_.size() > 1) {
+        processConnection(conn);
         return;
     }
     
-    HTTPRequest request = parseRequest(raw_request);
-    HTTPResponse response = routeRequest(request);
+    in_flight_++;
+    bool queued = executor_->submit([this, conn] {
+        if (shutdown_requested_) {
+            closeConnection(*conn->shard, conn->fd);
+        } else {
+            processConnection(conn);
+        }
+        
+        std::lock_guard<std::mutex> lock(in_flight_mutex_);
+        if (--in_flight_ == 0) {
+            in_flight_cv_.notify_all();
+        }
+    });
     
-    if (cors_enabled_) {
-        addCORSHeaders(response);
+    if (!queued) {
+        // Pool compartilhado já foi desligado
+        in_flight_--;
+        closeConnection(*conn->shard, conn->fd);
     }
+}
+
+// Atende todas as requisições completas que já estão no buffer, na ordem em
+// que chegaram (pipelining), e manda as respostas juntas
+void HTTPServer::processConnection(const std::shared_ptr<Connection>& conn) {
+    do {
+        // Cada requisição é uma fatia do buffer - o body não enxerga a próxima
+        size_t length = conn->parser.messageLength();
+        HTTPRequest request = parseRequest(conn->in.slice(0, length), conn->parser);
+        conn->in.consume(length);
+        conn->parser.reset();
+        conn->requests++;
+        
+        HTTPResponse response = routeRequest(request);
+        
+        // Upgrade aceito: o resto da conexão é WebSocket (nada de pipelining depois)
+        if (response.status_code == 101) {
+            appendResponse(*conn, response);
+            logRequest(request, response);
+            conn->shard->requests++;
+            upgradeConnection(conn);
+            return;
+        }
+        
+        // /ipc/events: cabeçalhos agora, eventos pelo resto da conexão
+        if (response.event_stream) {
+            if (cors_enabled_) {
+                addCORSHeaders(response);
+            }
+            appendResponse(*conn, response);
+            logRequest(request, response);
+            conn->shard->requests++;
+            openEventStream(conn, request.getHeader("Last-Event-ID"));
+            return;
+        }
+        
+        if (cors_enabled_) {
+            addCORSHeaders(response);
+        }
+        compressResponse(request, response);
+        
+        response.keep_alive = keep_alive_enabled_ && !shutdown_requested_ && request.wantsKeepAlive() &&
+                              conn->requests < keep_alive_max_requests_;
+        if (response.keep_alive) {
+            response.headers["Keep-Alive"] = "timeout=" + std::to_string(keep_alive_timeout_ms_ / 1000) +
+                                             ", max=" + std::to_string(keep_alive_max_requests_ - conn->requests);
+        } else {
+            conn->close_after_write = true;
+        }
+        
+        appendResponse(*conn, response);
+        
+        logRequest(request, response);
+        conn->shard->requests++;
+        
+        if (conn->close_after_write) break;
+        HTTPRequestParser::Result next = requestComplete(*conn);
+        if (next == HTTPRequestParser::Result::ERROR) {
+            // Próxima requisição do pipeline é lixo: responde o que veio antes e fecha
+            rejectRequest(*conn, 400, std::string("Malformed request: ") + conn->parser.error());
+        }
+        if (next != HTTPRequestParser::Result::COMPLETE) break;
+    } while (true);
     
-    std::string response_str = response.toString();
-    writeToSocket(client_socket, response_str);
-    
-    logRequest(request, response);
-    request_count_++;
+    // Tenta escrever daqui mesmo - quase sempre cabe no buffer do socket
+    bool would_block = false;
+    if (!flushOutput(*conn, would_block)) {
+        closeConnection(*conn->shard, conn->fd);
+        return;
+    }
+    if (!would_block) {
+        finishWrite(conn);
+        return;
+    }
     
-    close(client_socket);
+    // Socket cheio: o reactor termina quando o EPOLLOUT chegar (o MOD rearma a borda)
+    conn->touch();
+    conn->state = ConnectionState::WRITING;
+    epoll_event event{};
+    event.events = EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    event.data.fd = conn->fd;
+    if (epoll_ctl(conn->shard->epoll_fd, EPOLL_CTL_MOD, conn->fd, &event) < 0) {
+        closeConnection(*conn->shard, conn->fd);
+    }
 }
 
-HTTPRequest HTTPServer::parseRequest(const std::string& raw_request) {
-    HTTPRequest request;
-    std::istringstream stream(raw_request);
-    std::string line;
+HTTPServer::OutChunk::OutChunk(OutChunk&& other) noexcept
+    : data(std::move(other.data)), shared(std::move(other.shared)),
+      file_fd(other.file_fd), file_size(other.file_size) {
+    other.file_fd = -1;
+}
+
+HTTPServer::OutChunk::~OutChunk() {
+    if (file_fd >= 0) {
+        close(file_fd);
+    }
+}
+
+// Cabeçalhos vão pra um pedaço próprio (juntando com o anterior se der);
+// corpo do cache entra por referência e arquivo grande por sendfile
+void HTTPServer::appendResponse(Connection& conn, const HTTPResponse& response) {
+    auto appendBytes = [&conn](const std::string& bytes) {
+        if (conn.out.empty() || !conn.out.back().inMemory() || conn.out.back().shared) {
+            conn.out.emplace_back();
+        }
+        conn.out.back().data += bytes;
+    };
     
-    // Parse primeira linha (método e path)
-    if (std::getline(stream, line)) {
-        std::istringstream first_line(line);
-        first_line >> request.method >> request.path;
+    appendBytes(response.head());
+    if (response.status_code == 304) {
+        return;
     }
     
-    // Parse headers
-    while (std::getline(stream, line) && line != "\r") {
-        size_t colon = line.find(':');
-        if (colon != std::string::npos) {
-            std::string key = line.substr(0, colon);
-            std::string value = line.substr(colon + 2); // pula ': '
-            if (value.back() == '\r') value.pop_back();
-            request.headers[key] = value;
+    if (response.shared_body) {
+        if (!response.shared_body->empty()) {
+            conn.out.emplace_back();
+            conn.out.back().shared = response.shared_body;
         }
+    } else if (!response.file_path.empty()) {
+        int file_fd = open(response.file_path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (file_fd < 0) {
+            // Cabeçalho já promete o tamanho - só resta fechar a conexão
+            conn.close_after_write = true;
+            return;
+        }
+        conn.out.emplace_back();
+        conn.out.back().file_fd = file_fd;
+        conn.out.back().file_size = response.file_size;
+    } else {
+        appendBytes(response.body);
     }
-    
-    // Parse body se houver
-    std::string body;
-    while (std::getline(stream, line)) {
-        body += line + "\n";
+}
+
+// Pedaços em memória saem juntos num sendmsg (iovec, sem juntar num buffer);
+// arquivo sai com sendfile direto do page cache
+bool HTTPServer::flushOutput(Connection& conn, bool& would_block) {
+    constexpr size_t MAX_IOV = 16;
+    would_block = false;
+    
+    while (!conn.out.empty()) {
+        OutChunk& front = conn.out.front();
+        ssize_t sent;
+        
+        if (!front.inMemory()) {
+            off_t offset = static_cast<off_t>(conn.out_offset);
+            sent = sendfile(conn.fd, front.file_fd, &offset, front.file_size - conn.out_offset);
+            if (sent == 0 && conn.out_offset < front.file_size) {
+                return false;   // arquivo encolheu depois do stat
+            }
+        } else {
+            iovec iov[MAX_IOV];
+            size_t count = 0;
+            for (size_t i = 0; i < conn.out.size() && count < MAX_IOV && conn.out[i].inMemory(); ++i) {
+                size_t skip = i == 0 ? conn.out_offset : 0;
+                iov[count].iov_base = const_cast<char*>(conn.out[i].bytes() + skip);
+                iov[count].iov_len = conn.out[i].size() - skip;
+                count++;
+            }
+            msghdr message{};
+            message.msg_iov = iov;
+            message.msg_iovlen = count;
+            sent = sendmsg(conn.fd, &message, MSG_NOSIGNAL);
+        }
+        
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                would_block = true;
+                return true;
+            }
+            return false;
+        }
+        
+        // Avança pelos pedaços escritos
+        size_t remaining = static_cast<size_t>(sent);
+        while (!conn.out.empty()) {
+            size_t left = conn.out.front().size() - conn.out_offset;
+            if (remaining < left) {
+                conn.out_offset += remaining;
+                break;
+            }
+            remaining -= left;
+            conn.out.pop_front();
+            conn.out_offset = 0;
+        }
     }
-    if (!body.empty()) {
-        body.pop_back(); // remove último \n
-        request.body = body;
+    return true;
+}
+
+// Conexões de push (WebSocket e SSE). Depois de abertas ficam registradas
+// com EPOLLIN e EPOLLOUT (borda): o reactor lê o que o cliente manda e
+// termina escritas que o push deixou pela metade. in e out só são mexidos
+// com out_mutex
+
+// 101 e snapshot saem juntos; daqui em diante o push também escreve aqui
+void HTTPServer::upgradeConnection(const std::shared_ptr<Connection>& conn) {
+    std::string snapshot = WebSocketServer::encodeFrame(websocket_->snapshotMessage());
+    bool open = true;
+    {
+        std::lock_guard<std::mutex> lock(conn->out_mutex);
+        conn->out.emplace_back();
+        conn->out.back().data = std::move(snapshot);
+        conn->close_after_write = false;
+        conn->touch();
+        conn->state = ConnectionState::WEBSOCKET;
+        
+        // Frames que o cliente mandou colados no handshake
+        processWebSocketFrames(*conn);
+        bool would_block = false;
+        open = flushOutput(*conn, would_block) && (would_block || !conn->close_after_write);
     }
     
-    return request;
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    event.data.fd = conn->fd;
+    if (!open || epoll_ctl(conn->shard->epoll_fd, EPOLL_CTL_MOD, conn->fd, &event) < 0) {
+        closeConnection(conn);
+    }
 }
 
-HTTPResponse HTTPServer::routeRequest(const HTTPRequest& request) {
-    // OPTIONS para CORS
-    if (request.method == "OPTIONS") {
-        return handleOptions(request);
+// O estado vira EVENT_STREAM antes de ler o histórico, com out_mutex seguro:
+// um push que já enxerga a conexão espera o replay sair e pula pelo
+// last_event_id o que ele já trouxe. Na ordem inversa um evento entre a
+// leitura e a troca de estado não chegaria nem por um nem por outro
+void HTTPServer::openEventStream(const std::shared_ptr<Connection>& conn, std::string_view last_event_id) {
+    std::optional<uint64_t> resume_after;
+    uint64_t parsed = 0;
+    if (!last_event_id.empty() &&
+        std::from_chars(last_event_id.data(), last_event_id.data() + last_event_id.size(), parsed).ec == std::errc()) {
+        resume_after = parsed;
     }
     
-    // Rotas IPC
-    if (request.path == "/ipc/status" && request.method == "GET") {
-        return handleIPCStatus(request);
+    bool open = true;
+    {
+        std::lock_guard<std::mutex> lock(conn->out_mutex);
+        conn->in.consume(conn->in.size());   // nada depois do GET interessa (antes do reactor poder ler)
+        conn->close_after_write = false;
+        conn->state = ConnectionState::EVENT_STREAM;
+        conn->out.emplace_back();
+        conn->out.back().data = event_stream_->openingChunk(resume_after, conn->last_event_id);
+        bool would_block = false;
+        open = flushOutput(*conn, would_block);
     }
     
-    // Start mechanism: POST /ipc/start/{mechanism}
-    std::map<std::string, std::string> params;
-    if (matchRoute("/ipc/start/*", request.path, params) && request.method == "POST") {
-        HTTPRequest modified_request = request;
-        modified_request.params = params;
-        return handleIPCStart(modified_request);
+    epoll_event event{};
+    event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+    event.data.fd = conn->fd;
+    if (!open || epoll_ctl(conn->shard->epoll_fd, EPOLL_CTL_MOD, conn->fd, &event) < 0) {
+        closeConnection(conn);
     }
-    
-    // Stop mechanism: POST /ipc/stop/{mechanism}
-    if (matchRoute("/ipc/stop/*", request.path, params) && request.method == "POST") {
-        HTTPRequest modified_request = request;
-        modified_request.params = params;
-        return handleIPCStop(modified_request);
+}
+
+void HTTPServer::handlePushConnection(const std::shared_ptr<Connection>& conn, uint32_t events) {
+    constexpr size_t READ_CHUNK = 4096;
+    bool open = true;
+    {
+        // O recv também fica sob out_mutex: o estado muda antes de upgrade e
+        // openEventStream terminarem com in, e o reactor já pode estar aqui
+        std::lock_guard<std::mutex> lock(conn->out_mutex);
+        if (conn->closed) return;
+        
+        if (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+            while (true) {
+                conn->in.reserve(READ_CHUNK);
+                ssize_t bytes = recv(conn->fd, conn->in.tail(), conn->in.tailroom(), 0);
+                if (bytes < 0) {
+                    if (errno == EINTR) continue;
+                    if (errno != EAGAIN && errno != EWOULDBLOCK) open = false;
+                    break;
+                }
+                if (bytes == 0) {
+                    open = false;   // cliente fechou (sem frame de close, no WebSocket)
+                    break;
+                }
+                conn->in.commit(static_cast<size_t>(bytes));
+                conn->touch();
+            }
+        }
+        
+        if (open) {
+            if (conn->state == ConnectionState::WEBSOCKET) {
+                processWebSocketFrames(*conn);
+            } else {
+                conn->in.consume(conn->in.size());   // SSE é só de ida
+            }
+            bool would_block = false;
+            // Com close na fila, fecha assim que ele sair (ou no próximo EPOLLOUT)
+            open = flushOutput(*conn, would_block) && (would_block || !conn->close_after_write);
+        }
     }
     
-    // Send message: POST /ipc/send
-    if (request.path == "/ipc/send" && request.method == "POST") {
-        return handleIPCSend(request);
+    if (!open) {
+        closeConnection(conn);
     }
-    
-    // Get logs: GET /ipc/logs/{mechanism}
-    if (matchRoute("/ipc/logs/*", request.path, params) && request.method == "GET") {
-        HTTPRequest modified_request = request;
-        modified_request.params = params;
-        return handleIPCLogs(modified_request);
+}
+
+// Do cliente só importam controles: ping vira pong, close é ecoado e fecha.
+// Texto/binário é ignorado (o canal é só de ida) e o pong só prova que está vivo
+void HTTPServer::processWebSocketFrames(Connection& conn) {
+    auto queue = [&conn](std::string frame) {
+        conn.out.emplace_back();
+        conn.out.back().data = std::move(frame);
+    };
+    
+    WebSocketFrame frame;
+    while (!conn.close_after_write && !conn.in.empty()) {
+        auto result = WebSocketServer::decodeFrame(conn.in.view(), frame, MAX_WEBSOCKET_FRAME);
+        if (result == WebSocketServer::DecodeResult::INCOMPLETE) break;
+        if (result != WebSocketServer::DecodeResult::COMPLETE) {
+            // 1002 = erro de protocolo, 1009 = mensagem grande demais
+            queue(WebSocketServer::encodeClose(result == WebSocketServer::DecodeResult::TOO_LARGE ? 1009 : 1002));
+            conn.close_after_write = true;
+            break;
+        }
+        conn.in.consume(frame.length);
+        
+        if (frame.opcode == WebSocketOpcode::PING) {
+            queue(WebSocketServer::encodeFrame(frame.payload, WebSocketOpcode::PONG));
+        } else if (frame.opcode == WebSocketOpcode::CLOSE) {
+            queue(WebSocketServer::encodeFrame(std::string_view(frame.payload).substr(0, 2), WebSocketOpcode::CLOSE));
+            conn.close_after_write = true;
+        }
+    }
+}
+
+// Cópia da lista: as escritas acontecem sem segurar o mapa
+std::vector<std::shared_ptr<HTTPServer::Connection>> HTTPServer::connectionsIn(ConnectionState state) const {
+    std::vector<std::shared_ptr<Connection>> found;
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard->connections_mutex);
+        for (const auto& pair : shard->connections) {
+            if (pair.second->state == state) {
+                found.push_back(pair.second);
+            }
+        }
+    }
+    return found;
+}
+
+// O pedaço é o mesmo buffer pra todo mundo. false = cliente não acompanha
+bool HTTPServer::queueStreamChunk(Connection& conn, const std::shared_ptr<const std::string>& chunk) {
+    size_t backlog = 0;
+    for (const auto& pending : conn.out) {
+        backlog += pending.size();
+    }
+    backlog -= conn.out_offset;
+    if (backlog + chunk->size() > MAX_STREAM_BACKLOG) {
+        return false;
     }
+    conn.out.emplace_back();
+    conn.out.back().shared = chunk;
+    return true;
+}
 
-    // Get detail: GET /ipc/detail/{mechanism}
-    if (matchRoute("/ipc/detail/*", request.path, params) && request.method == "GET") {
-        HTTPRequest modified_request = request;
-        modified_request.params = params;
-        return handleIPCDetail(modified_request);
+// Chamado pela thread de push. O que não couber no socket o reactor
+// termina no EPOLLOUT
+void HTTPServer::broadcastWebSocket(const std::shared_ptr<const std::string>& frame) {
+    for (const auto& conn : connectionsIn(ConnectionState::WEBSOCKET)) {
+        bool drop = false;
+        {
+            std::lock_guard<std::mutex> lock(conn->out_mutex);
+            if (conn->closed || conn->close_after_write) continue;
+            bool would_block = false;
+            drop = !queueStreamChunk(*conn, frame) || !flushOutput(*conn, would_block);
+        }
+        if (drop) {
+            logger_.warning("Cliente WebSocket não acompanha o push - desconectado", "HTTP");
+            closeConnection(conn);
+        }
+    }
+}
+
+void HTTPServer::broadcastEventStream(const std::vector<StreamEvent>& events) {
+    for (const auto& conn : connectionsIn(ConnectionState::EVENT_STREAM)) {
+        bool drop = false;
+        {
+            std::lock_guard<std::mutex> lock(conn->out_mutex);
+            if (conn->closed) continue;
+            for (const auto& event : events) {
+                if (event.first != 0 && event.first <= conn->last_event_id) continue;
+                if (!queueStreamChunk(*conn, event.second)) {
+                    drop = true;
+                    break;
+                }
+                conn->last_event_id = std::max(conn->last_event_id, event.first);
+            }
+            bool would_block = false;
+            drop = drop || !flushOutput(*conn, would_block);
+        }
+        if (drop) {
+            logger_.warning("Cliente de /ipc/events não acompanha o push - desconectado", "HTTP");
+            closeConnection(conn);
+        }
+    }
+}
+
+// Alimenta o parser com o buffer acumulado. Quando os headers fecham, reserva
+// o body inteiro de uma vez pra ele acabar no mesmo bloco
+HTTPRequestParser::Result HTTPServer::requestComplete(Connection& conn) {
+    bool had_headers = conn.parser.headersComplete();
+    HTTPRequestParser::Result result = conn.parser.feed(conn.in.view());
+    
+    if (result == HTTPRequestParser::Result::INCOMPLETE && !had_headers && conn.parser.headersComplete()) {
+        size_t have = conn.in.size();
+        size_t need = conn.parser.messageLength();
+        if (need > have && conn.parser.contentLength() <= MAX_REQUEST_SIZE) {
+            conn.in.reserve(need - have);
+        }
+    }
+    return result;
+}
+
+void HTTPServer::rejectRequest(Connection& conn, int code, const std::string& message) {
+    HTTPResponse response;
+    response.setError(code, message);
+    appendResponse(conn, response);
+    conn.close_after_write = true;
+}
+
+// Só junta o que o parser já separou: as views apontam pro mesmo bloco que
+// raw, e o parser é reapontado pra ele (o buffer pode ter mudado de lugar)
+HTTPRequest HTTPServer::parseRequest(const MessageBuffer& raw_request, HTTPRequestParser& parser) {
+    HTTPRequest request;
+    request.raw = raw_request;
+    parser.feed(request.raw.view());
+    
+    request.method = parser.method();
+    request.path = parser.path();
+    request.query = parser.query();
+    request.version = parser.version();
+    request.body = parser.body();
+    parser.copyHeaders(request.headers);
+    return request;
+}
+
+// Rotas da API. A tabela (e o hash perfeito dela) é montada pelo compilador;
+// o parâmetro é gravado direto na requisição, sem copiá-la
+HTTPResponse HTTPServer::routeRequest(HTTPRequest& request) {
+    using Table = RouteTable<HTTPResponse (HTTPServer::*)(const HTTPRequest&), 11>;
+    static constexpr Table routes(std::array<Table::Route, 11>{{
+        { "GET",  "/ipc/status",              &HTTPServer::handleIPCStatus },
+        { "POST", "/ipc/start/{mechanism}",   &HTTPServer::handleIPCStart },
+        { "POST", "/ipc/stop/{mechanism}",    &HTTPServer::handleIPCStop },
+        { "POST", "/ipc/send",                &HTTPServer::handleIPCSend },
+        { "POST", "/ipc/send/batch",          &HTTPServer::handleIPCSendBatch },
+        { "GET",  "/ipc/logs/{mechanism}",    &HTTPServer::handleIPCLogs },
+        { "GET",  "/ipc/executor",            &HTTPServer::handleIPCExecutor },
+        { "GET",  "/ipc/detail/{mechanism}",  &HTTPServer::handleIPCDetail },
+        { "GET",  "/ipc/snapshot",            &HTTPServer::handleIPCSnapshot },
+        { "GET",  "/ipc/events",              &HTTPServer::handleIPCEvents },
+        { "GET",  "/ws",                      &HTTPServer::handleWebSocketUpgrade },
+    }});
+    
+    // OPTIONS para CORS
+    if (request.method == "OPTIONS") {
+        return handleOptions(request);
+    }
+    
+    if (const Table::Route* route = routes.find(request.method, request.path, request.params)) {
+        return (this->*route->handler)(request);
     }
     
     // Arquivos estáticos
@@ -339,9 +1250,7 @@ HTTPResponse HTTPServer::handleIPCStatus(const HTTPRequest& request) {
         return response;
     }
     
-    HTTPResponse response;
-    response.setJSON(coordinator_->getStatusJSON());
-    return response;
+    return snapshotResponse(request, "status", coordinator_->getStatusSnapshot());
 }
 
 HTTPResponse HTTPServer::handleIPCStart(const HTTPRequest& request) {
@@ -351,16 +1260,9 @@ HTTPResponse HTTPServer::handleIPCStart(const HTTPRequest& request) {
         return response;
     }
     
-    std::string mechanism = request.getParam("0"); // primeiro parâmetro capturado
+    std::string mechanism = request.getParam("mechanism");
     IPCMechanism mech;
-    
-    if (mechanism == "pipes") {
-        mech = IPCMechanism::PIPES;
-    } else if (mechanism == "sockets") {
-        mech = IPCMechanism::SOCKETS;
-    } else if (mechanism == "shmem" || mechanism == "shared_memory") {
-        mech = IPCMechanism::SHARED_MEMORY;
-    } else {
+    if (!stringToMechanism(mechanism, mech)) {
         HTTPResponse response;
         response.setError(400, "Invalid mechanism: " + mechanism);
         return response;
@@ -370,7 +1272,7 @@ HTTPResponse HTTPServer::handleIPCStart(const HTTPRequest& request) {
     
     HTTPResponse response;
     if (success) {
-        response.setJSON("{\"status\":\"success\",\"message\":\"" + mechanism + " started\"}");
+        response.setJSON("{\"status\":\"success\",\"message\":" + jsonQuote(mechanism + " started") + "}");
     } else {
         response.setError(500, "Failed to start " + mechanism);
     }
@@ -385,16 +1287,9 @@ HTTPResponse HTTPServer::handleIPCStop(const HTTPRequest& request) {
         return response;
     }
     
-    std::string mechanism = request.getParam("0");
+    std::string mechanism = request.getParam("mechanism");
     IPCMechanism mech;
-    
-    if (mechanism == "pipes") {
-        mech = IPCMechanism::PIPES;
-    } else if (mechanism == "sockets") {
-        mech = IPCMechanism::SOCKETS;
-    } else if (mechanism == "shmem" || mechanism == "shared_memory") {
-        mech = IPCMechanism::SHARED_MEMORY;
-    } else {
+    if (!stringToMechanism(mechanism, mech)) {
         HTTPResponse response;
         response.setError(400, "Invalid mechanism: " + mechanism);
         return response;
@@ -404,7 +1299,7 @@ HTTPResponse HTTPServer::handleIPCStop(const HTTPRequest& request) {
     
     HTTPResponse response;
     if (success) {
-        response.setJSON("{\"status\":\"success\",\"message\":\"" + mechanism + " stopped\"}");
+        response.setJSON("{\"status\":\"success\",\"message\":" + jsonQuote(mechanism + " stopped") + "}");
     } else {
         response.setError(500, "Failed to stop " + mechanism);
     }
@@ -419,58 +1314,189 @@ HTTPResponse HTTPServer::handleIPCSend(const HTTPRequest& request) {
         return response;
     }
     
-    // Parse JSON do body (parsing manual simples)
+    BatchMessage item;
     std::string mechanism_str;
-    std::string message;
+    std::string error;
+    if (!parseSendItem(request, request.body, 0, "body", item, mechanism_str, error)) {
+        HTTPResponse response;
+        response.setError(400, error);
+        return response;
+    }
     
-    // Extrai mechanism do JSON
-    size_t mech_pos = request.body.find("\"mechanism\":\"");
-    if (mech_pos != std::string::npos) {
-        mech_pos += 13; // tamanho de "mechanism":"
-        size_t end_pos = request.body.find("\"", mech_pos);
-        if (end_pos != std::string::npos) {
-            mechanism_str = request.body.substr(mech_pos, end_pos - mech_pos);
-        }
+    bool success = coordinator_->sendMessage(item.mechanism, item.message, item.priority);
+    
+    HTTPResponse response;
+    if (success) {
+        response.setJSON("{\"status\":\"success\",\"message\":" + jsonQuote("Message sent via " + mechanism_str) + "}");
+    } else {
+        response.setError(500, "Failed to send message via " + mechanism_str);
     }
     
-    // Extrai message do JSON
-    size_t msg_pos = request.body.find("\"message\":\"");
-    if (msg_pos != std::string::npos) {
-        msg_pos += 11; // tamanho de "message":"
-        size_t end_pos = request.body.find("\"", msg_pos);
-        if (end_pos != std::string::npos) {
-            message = request.body.substr(msg_pos, end_pos - msg_pos);
+    return response;
+}
+
+// Passada única pelo objeto com o parser SAX. A message sem escape vira uma
+// fatia do próprio body (zero-cópia); com escape o parser já decodificou
+// e só então copia.
+bool HTTPServer::parseSendItem(const HTTPRequest& request, std::string_view json, size_t offset,
+                               std::string_view where, BatchMessage& item, std::string& mechanism_name,
+                               std::string& error) const {
+    std::string priority_str;
+    std::string_view bad_field;
+
+    JSONError json_error = JSONError::NONE;
+    bool parsed = forEachField(json, [&](std::string_view key, const JSONField& field) {
+        if (key != "mechanism" && key != "message" && key != "priority") return true;
+        if (field.type != JSONType::STRING) {
+            bad_field = key == "mechanism" ? "mechanism" : key == "message" ? "message" : "priority";
+            return false;
         }
+        if (key == "mechanism") {
+            mechanism_name.assign(field.text);
+        } else if (key == "priority") {
+            priority_str.assign(field.text);
+        } else if (field.escaped) {
+            item.message = MessageBuffer::copyOf(field.text);
+        } else {
+            item.message = request.bodySlice(offset + field.offset, field.text.size());
+        }
+        return true;
+    }, &json_error);
+
+    if (!bad_field.empty()) {
+        error = "Field '" + std::string(bad_field) + "' must be a string";
+        return false;
+    }
+    if (!parsed) {
+        error = "Invalid JSON " + std::string(where) + ": " + jsonErrorToString(json_error);
+        return false;
     }
     
-    if (mechanism_str.empty() || message.empty()) {
+    if (!priority_str.empty() && !stringToPriority(priority_str, item.priority)) {
+        error = "Invalid priority: " + priority_str;
+        return false;
+    }
+    
+    if (mechanism_name.empty() || item.message.empty()) {
+        error = "Missing mechanism or message in request " + std::string(where);
+        return false;
+    }
+    
+    if (!stringToMechanism(mechanism_name, item.mechanism)) {
+        error = "Invalid mechanism: " + mechanism_name;
+        return false;
+    }
+    return true;
+}
+
+// Rajada de envios numa requisição: array JSON ou NDJSON (um objeto por
+// linha). Os itens são lidos em sequência sem montar árvore, as mensagens
+// ficam como fatias do body e o lote vai inteiro pro coordenador. Item
+// inválido não derruba os outros - cada um tem o seu resultado
+HTTPResponse HTTPServer::handleIPCSendBatch(const HTTPRequest& request) {
+    if (!coordinator_) {
         HTTPResponse response;
-        response.setError(400, "Missing mechanism or message in request body");
+        response.setError(503, "IPC Coordinator not available");
         return response;
     }
     
-    IPCMechanism mech;
-    if (mechanism_str == "pipes") {
-        mech = IPCMechanism::PIPES;
-    } else if (mechanism_str == "sockets") {
-        mech = IPCMechanism::SOCKETS;
-    } else if (mechanism_str == "shmem" || mechanism_str == "shared_memory") {
-        mech = IPCMechanism::SHARED_MEMORY;
+    struct ItemResult {
+        std::string mechanism;
+        std::string error;      // vazio = foi pro lote
+        size_t batch_index = 0;
+    };
+    std::vector<ItemResult> items;
+    std::vector<BatchMessage> batch;
+    
+    bool too_large = false;
+    auto addItem = [&](const JSONField* element, std::string_view json, size_t offset) {
+        if (items.size() == MAX_BATCH_ITEMS) {
+            too_large = true;
+            return false;
+        }
+        ItemResult result;
+        BatchMessage item;
+        if (element && element->type != JSONType::OBJECT) {
+            result.error = "Item must be an object";
+        } else if (parseSendItem(request, json, offset, "item", item, result.mechanism, result.error)) {
+            result.batch_index = batch.size();
+            batch.push_back(std::move(item));
+        }
+        items.push_back(std::move(result));
+        return true;
+    };
+    
+    std::string_view body = request.body;
+    size_t first = body.find_first_not_of(" \t\r\n");
+    if (first != std::string_view::npos && body[first] == '[') {
+        JSONError json_error = JSONError::NONE;
+        bool parsed = forEachElement(body, [&](const JSONField& element) {
+            return addItem(&element, element.text, element.offset);
+        }, &json_error);
+        if (!parsed && !too_large) {
+            HTTPResponse response;
+            response.setError(400, "Invalid JSON body: " + jsonErrorToString(json_error));
+            return response;
+        }
     } else {
+        // NDJSON: linhas independentes, linha em branco é ignorada
+        size_t pos = 0;
+        while (pos < body.size() && !too_large) {
+            size_t end = body.find('\n', pos);
+            if (end == std::string_view::npos) end = body.size();
+            std::string_view line = body.substr(pos, end - pos);
+            if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+            if (line.find_first_not_of(" \t") != std::string_view::npos) {
+                addItem(nullptr, line, pos);
+            }
+            pos = end + 1;
+        }
+    }
+    
+    if (too_large) {
         HTTPResponse response;
-        response.setError(400, "Invalid mechanism: " + mechanism_str);
+        response.setError(413, "Batch too large (max " + std::to_string(MAX_BATCH_ITEMS) + " items)");
+        return response;
+    }
+    if (items.empty()) {
+        HTTPResponse response;
+        response.setError(400, "Empty batch");
         return response;
     }
     
-    bool success = coordinator_->sendMessage(mech, message);
+    std::vector<bool> sent = coordinator_->sendMessages(batch);
     
-    HTTPResponse response;
-    if (success) {
-        response.setJSON("{\"status\":\"success\",\"message\":\"Message sent via " + mechanism_str + "\"}");
-    } else {
-        response.setError(500, "Failed to send message via " + mechanism_str);
+    size_t sent_count = 0;
+    for (const auto& result : items) {
+        if (result.error.empty() && sent[result.batch_index]) sent_count++;
     }
     
+    std::string out;
+    out.reserve(96 + items.size() * 48);
+    JSONWriter json(out);
+    json.beginObject()
+        .field("status", sent_count == items.size() ? "success" : sent_count == 0 ? "error" : "partial")
+        .field("total", items.size())
+        .field("sent", sent_count)
+        .field("failed", items.size() - sent_count)
+        .key("results").beginArray();
+    for (size_t i = 0; i < items.size(); ++i) {
+        const ItemResult& result = items[i];
+        json.beginObject().field("index", i);
+        if (!result.mechanism.empty()) json.field("mechanism", result.mechanism);
+        if (!result.error.empty()) {
+            json.field("status", "invalid").field("error", result.error);
+        } else if (sent[result.batch_index]) {
+            json.field("status", "sent");
+        } else {
+            json.field("status", "failed").field("error", "Failed to send message via " + result.mechanism);
+        }
+        json.endObject();
+    }
+    json.endArray().endObject();
+    
+    HTTPResponse response;
+    response.setJSON(out);
     return response;
 }
 
@@ -481,20 +1507,26 @@ HTTPResponse HTTPServer::handleIPCDetail(const HTTPRequest& request) {
         return response;
     }
 
-    std::string mechanism = request.getParam("0");
+    std::string mechanism = request.getParam("mechanism");
     IPCMechanism mech;
-    if (mechanism == "pipes") mech = IPCMechanism::PIPES;
-    else if (mechanism == "sockets") mech = IPCMechanism::SOCKETS;
-    else if (mechanism == "shmem" || mechanism == "shared_memory") mech = IPCMechanism::SHARED_MEMORY;
-    else {
+    if (!stringToMechanism(mechanism, mech)) {
         HTTPResponse response;
         response.setError(400, "Invalid mechanism: " + mechanism);
         return response;
     }
 
-    HTTPResponse response;
-    response.setJSON(coordinator_->getMechanismDetailJSON(mech));
-    return response;
+    return snapshotResponse(request, mechanism, coordinator_->getDetailSnapshot(mech));
+}
+
+// Status + detalhes num documento só (o polling do dashboard sem WebSocket)
+HTTPResponse HTTPServer::handleIPCSnapshot(const HTTPRequest& request) {
+    if (!coordinator_) {
+        HTTPResponse response;
+        response.setError(503, "IPC Coordinator not available");
+        return response;
+    }
+    
+    return snapshotResponse(request, "snapshot", coordinator_->getFullSnapshot());
 }
 
 HTTPResponse HTTPServer::handleIPCLogs(const HTTPRequest& request) {
@@ -504,16 +1536,9 @@ HTTPResponse HTTPServer::handleIPCLogs(const HTTPRequest& request) {
         return response;
     }
     
-    std::string mechanism = request.getParam("0");
+    std::string mechanism = request.getParam("mechanism");
     IPCMechanism mech;
-    
-    if (mechanism == "pipes") {
-        mech = IPCMechanism::PIPES;
-    } else if (mechanism == "sockets") {
-        mech = IPCMechanism::SOCKETS;
-    } else if (mechanism == "shmem" || mechanism == "shared_memory") {
-        mech = IPCMechanism::SHARED_MEMORY;
-    } else {
+    if (!stringToMechanism(mechanism, mech)) {
         HTTPResponse response;
         response.setError(400, "Invalid mechanism: " + mechanism);
         return response;
@@ -521,21 +1546,69 @@ HTTPResponse HTTPServer::handleIPCLogs(const HTTPRequest& request) {
     
     auto logs = coordinator_->getLogs(mech, 100);
     
-    std::string json_logs = "[";
-    for (size_t i = 0; i < logs.size(); ++i) {
-        if (i > 0) json_logs += ",";
-        json_logs += "\"" + logs[i] + "\"";
+    // Linhas de log têm aspas e barras à vontade - passam pelo escape do writer
+    HTTPResponse response;
+    response.content_type = "application/json";
+    JSONWriter json(response.body);
+    json.beginObject().field("mechanism", mechanism).key("logs").beginArray();
+    for (const auto& line : logs) {
+        json.value(line);
     }
-    json_logs += "]";
-    
+    json.endArray().endObject();
+    return response;
+}
+
+HTTPResponse HTTPServer::handleIPCExecutor(const HTTPRequest& /*request*/) {
+    HTTPResponse response;
+    response.setJSON(getExecutorStats().toJSON());
+    return response;
+}
+
+// Stream de eventos (SSE). A troca de modo da conexão fica com o processConnection
+HTTPResponse HTTPServer::handleIPCEvents(const HTTPRequest& /*request*/) {
     HTTPResponse response;
-    response.setJSON("{\"mechanism\":\"" + mechanism + "\",\"logs\":" + json_logs + "}");
+    if (!event_stream_) {
+        response.setError(503, coordinator_ ? "Event stream disabled" : "IPC Coordinator not available");
+        return response;
+    }
+    response.content_type = "text/event-stream";
+    response.event_stream = true;
+    return response;
+}
+
+// Handshake do RFC 6455. Só aceita a versão 13 (a de todos os navegadores)
+HTTPResponse HTTPServer::handleWebSocketUpgrade(const HTTPRequest& request) {
+    HTTPResponse response;
+    if (!websocket_) {
+        response.setError(503, "WebSocket push disabled");
+        return response;
+    }
+    if (!containsIgnoreCase(request.getHeader("Upgrade"), "websocket") ||
+        !containsIgnoreCase(request.getHeader("Connection"), "upgrade")) {
+        response.setError(400, "Expected a WebSocket upgrade request");
+        return response;
+    }
+    if (request.getHeader("Sec-WebSocket-Version") != "13") {
+        response.setError(426, "Unsupported WebSocket version");
+        response.headers["Sec-WebSocket-Version"] = "13";
+        return response;
+    }
+    std::string_view key = request.getHeader("Sec-WebSocket-Key");
+    if (key.size() != 24) {   // base64 de 16 bytes
+        response.setError(400, "Invalid Sec-WebSocket-Key");
+        return response;
+    }
+    
+    response.status_code = 101;
+    response.content_type.clear();
+    response.headers["Upgrade"] = "websocket";
+    response.headers["Sec-WebSocket-Accept"] = WebSocketServer::acceptKey(key);
     return response;
 }
 
 HTTPResponse HTTPServer::handleNotFound(const HTTPRequest& request) {
     HTTPResponse response;
-    response.setError(404, "Endpoint not found: " + request.method + " " + request.path);
+    response.setError(404, "Endpoint not found: " + std::string(request.method) + " " + std::string(request.path));
     return response;
 }
 
@@ -545,52 +1618,207 @@ HTTPResponse HTTPServer::handleOptions(const HTTPRequest& request) {
     return response;
 }
 
+// Cache hit: o corpo é o buffer imutável carregado no start. Fora do cache
+// (grande demais ou criado depois) vai por sendfile, sem ler pro processo
 HTTPResponse HTTPServer::handleStaticFile(const HTTPRequest& request) {
-    std::string file_path = static_path_ + request.path;
-    if (request.path == "/") {
-        file_path += "index.html";
-    }
-    
-    std::ifstream file(file_path, std::ios::binary);
-    if (!file.is_open()) {
+    std::string path = request.path == "/" ? "/index.html" : std::string(request.path);
+    if (path.find("..") != std::string::npos) {
         return handleNotFound(request);
     }
     
-    std::string content((std::istreambuf_iterator<char>(file)),
-                        std::istreambuf_iterator<char>());
-    
-    HTTPResponse response;
-    response.body = content;
+    auto cached = static_cache_.find(path);
+    if (cached != static_cache_.end()) {
+        const StaticAsset& asset = *cached->second;
+        ContentEncoding encoding = compression_enabled_ ? negotiateEncoding(request.getHeader("Accept-Encoding"))
+                                                        : ContentEncoding::IDENTITY;
+        const StaticAsset::Variant& variant = asset.select(encoding);
+        HTTPResponse response(200, asset.content_type);
+        response.preset_headers = variant.preset_headers;
+        if (notModified(request, variant.etag, asset.last_modified)) {
+            response.status_code = 304;
+            static_not_modified_++;
+            return response;
+        }
+        response.shared_body = variant.body;
+        static_hits_++;
+        return response;
+    }
     
-    // Determina MIME type
-    size_t dot = file_path.find_last_of('.');
-    if (dot != std::string::npos) {
-        std::string ext = file_path.substr(dot);
-        response.content_type = getMimeType(ext);
+    std::string file_path = static_path_ + path;
+    struct stat info;
+    if (stat(file_path.c_str(), &info) < 0 || !S_ISREG(info.st_mode)) {
+        return handleNotFound(request);
     }
     
+    std::string etag = staticETag(info);
+    std::string last_modified = httpDate(info.st_mtime);
+    size_t dot = path.find_last_of('.');
+    HTTPResponse response(200, dot != std::string::npos ? getMimeType(path.substr(dot)) : "text/plain");
+    response.preset_headers = staticHeaders(etag, last_modified);
+    if (notModified(request, etag, last_modified)) {
+        response.status_code = 304;
+        static_not_modified_++;
+        return response;
+    }
+    response.file_path = file_path;
+    response.file_size = static_cast<size_t>(info.st_size);
+    static_sendfile_++;
     return response;
 }
 
-bool HTTPServer::matchRoute(const std::string& pattern, const std::string& path, 
-                           std::map<std::string, std::string>& params) {
-    // Implementação simples de matching com wildcards
-    if (pattern.find('*') == std::string::npos) {
-        return pattern == path;
+// Respostas dinâmicas (JSON de status, logs...) a partir do limite. Corpos do
+// cache já vêm na versão certa e arquivos por sendfile vão como estão
+void HTTPServer::compressResponse(const HTTPRequest& request, HTTPResponse& response) {
+    if (!compression_enabled_ || response.shared_body || !response.file_path.empty() ||
+        response.body.size() < compression_min_size_ || !isCompressible(response.content_type) ||
+        response.headers.count("Content-Encoding")) {
+        return;
     }
     
-    size_t star_pos = pattern.find('*');
-    std::string prefix = pattern.substr(0, star_pos);
+    ContentEncoding encoding = negotiateEncoding(request.getHeader("Accept-Encoding"));
+    std::string compressed;
+    if (!compressBody(response.body, encoding, compressed)) {
+        return;
+    }
     
-    if (path.size() < prefix.size() || path.substr(0, prefix.size()) != prefix) {
-        return false;
+    compression_saved_bytes_ += response.body.size() - compressed.size();
+    compressed_responses_++;
+    response.body = std::move(compressed);
+    response.headers["Content-Encoding"] = encodingName(encoding);
+    response.headers["Vary"] = "Accept-Encoding";
+}
+
+// Polling do estado: a resposta só aponta pro JSON do snapshot (sem cópia).
+// ETag fraco - o uptime pode avançar dentro da mesma versão - e, sem mudança
+// desde a última vez, 304 sem corpo
+HTTPResponse HTTPServer::snapshotResponse(const HTTPRequest& request, const std::string& name,
+                                          const StateSnapshot& snapshot) {
+    HTTPResponse response(200, "application/json");
+    bool compressible = compression_enabled_ && snapshot.json->size() >= compression_min_size_;
+    ContentEncoding encoding = compressible ? negotiateEncoding(request.getHeader("Accept-Encoding"))
+                                            : ContentEncoding::IDENTITY;
+    
+    std::shared_ptr<const std::string> body = snapshot.json;
+    std::string etag = snapshot.etag;
+    size_t saved_bytes = 0;
+    if (encoding != ContentEncoding::IDENTITY) {
+        std::lock_guard<std::mutex> lock(compressed_snapshots_mutex_);
+        CompressedSnapshot& cached = compressed_snapshots_[name + "-" + encodingName(encoding)];
+        if (cached.source != snapshot.json) {
+            std::string compressed;
+            cached.source = snapshot.json;
+            cached.body.reset();
+            if (compressBody(*snapshot.json, encoding, compressed)) {
+                cached.saved_bytes = snapshot.json->size() - compressed.size();
+                cached.body = std::make_shared<const std::string>(std::move(compressed));
+            }
+        }
+        if (cached.body) {
+            body = cached.body;
+            saved_bytes = cached.saved_bytes;
+            etag = etag.substr(0, etag.size() - 1) + "-" + encodingName(encoding) + "\"";
+        } else {
+            encoding = ContentEncoding::IDENTITY;
+        }
     }
     
-    // Captura o que vem depois do prefixo
-    std::string captured = path.substr(prefix.size());
-    params["0"] = captured;
+    response.preset_headers = staticHeaders(etag, "", encoding, compressible);
+    if (notModified(request, etag, "")) {
+        response.status_code = 304;
+        return response;
+    }
+    if (encoding != ContentEncoding::IDENTITY) {
+        compressed_responses_++;
+        compression_saved_bytes_ += saved_bytes;
+    }
+    response.shared_body = std::move(body);
+    return response;
+}
+
+// If-None-Match manda; If-Modified-Since só vale sem ele (RFC 7232)
+bool HTTPServer::notModified(const HTTPRequest& request, const std::string& etag,
+                             const std::string& last_modified) const {
+    std::string_view if_none_match = request.getHeader("If-None-Match");
+    if (!if_none_match.empty()) {
+        return if_none_match == "*" || if_none_match.find(etag) != std::string::npos;
+    }
+    std::string_view if_modified_since = request.getHeader("If-Modified-Since");
+    return !if_modified_since.empty() && if_modified_since == last_modified;
+}
+
+// Lê o diretório estático inteiro uma vez. Arquivos grandes e o que passar
+// do limite total ficam de fora (servidos por sendfile)
+void HTTPServer::loadStaticCache() {
+    static_cache_.clear();
+    if (static_path_.empty()) return;
+    
+    namespace fs = std::filesystem;
+    std::error_code ec;
+    fs::path root(static_path_);
+    if (!fs::is_directory(root, ec)) return;
+    
+    size_t total = 0;
+    size_t compressed_total = 0;
+    for (auto it = fs::recursive_directory_iterator(root, ec); !ec && it != fs::recursive_directory_iterator(); it.increment(ec)) {
+        if (!it->is_regular_file(ec)) continue;
+        
+        std::string file_path = it->path().string();
+        struct stat info;
+        if (stat(file_path.c_str(), &info) < 0) continue;
+        size_t size = static_cast<size_t>(info.st_size);
+        if (size > MAX_CACHED_ASSET || total + size > MAX_STATIC_CACHE) continue;
+        
+        std::ifstream file(file_path, std::ios::binary);
+        if (!file.is_open()) continue;
+        auto body = std::make_shared<std::string>(size, '\0');
+        if (!file.read(body->data(), static_cast<std::streamsize>(size))) continue;
+        
+        auto asset = std::make_shared<StaticAsset>();
+        std::string extension = it->path().extension().string();
+        asset->content_type = extension.empty() ? "text/plain" : getMimeType(extension);
+        asset->last_modified = httpDate(info.st_mtime);
+        
+        // Texto é comprimido aqui, uma vez; as requisições só escolhem a versão
+        std::string etag = staticETag(info);
+        bool compressible = compression_enabled_ && isCompressible(asset->content_type);
+        for (ContentEncoding encoding : { ContentEncoding::GZIP, ContentEncoding::DEFLATE }) {
+            std::string compressed;
+            if (!compressible || !compressBody(*body, encoding, compressed, 9)) continue;
+            StaticAsset::Variant& variant = encoding == ContentEncoding::GZIP ? asset->gzip : asset->deflate;
+            variant.etag = etag.substr(0, etag.size() - 1) + "-" + encodingName(encoding) + "\"";
+            variant.preset_headers = staticHeaders(variant.etag, asset->last_modified, encoding, true);
+            variant.body = std::make_shared<const std::string>(std::move(compressed));
+            compressed_total += variant.body->size();
+        }
+        asset->identity.etag = etag;
+        asset->identity.preset_headers = staticHeaders(etag, asset->last_modified, ContentEncoding::IDENTITY, compressible);
+        asset->identity.body = std::move(body);
+        
+        static_cache_["/" + it->path().lexically_relative(root).generic_string()] = std::move(asset);
+        total += size;
+    }
     
-    return true;
+    logger_.info("Cache de estáticos: " + std::to_string(static_cache_.size()) + " arquivos, " +
+                 std::to_string(total) + " bytes (+" + std::to_string(compressed_total) + " comprimidos)", "HTTP");
+}
+
+std::string HTTPServer::getStaticStatsJSON() const {
+    size_t bytes = 0;
+    for (const auto& pair : static_cache_) {
+        bytes += pair.second->identity.body->size();
+    }
+    std::string out;
+    JSONWriter json(out);
+    json.beginObject()
+        .field("cached_files", static_cache_.size())
+        .field("cached_bytes", bytes)
+        .field("hits", static_hits_.load())
+        .field("not_modified", static_not_modified_.load())
+        .field("sendfile", static_sendfile_.load())
+        .field("compressed_responses", compressed_responses_.load())
+        .field("compression_saved_bytes", compression_saved_bytes_.load())
+        .endObject();
+    return out;
 }
 
 std::string HTTPServer::getMimeType(const std::string& file_extension) {
@@ -609,73 +1837,30 @@ void HTTPServer::addCORSHeaders(HTTPResponse& response) {
     response.headers["Access-Control-Allow-Origin"] = "*";
     response.headers["Access-Control-Allow-Methods"] = "GET, POST, PUT, DELETE, OPTIONS";
     response.headers["Access-Control-Allow-Headers"] = "Content-Type, Authorization";
-    // Evita cache para respostas da API
+    // Evita cache para respostas da API. As com ETag (snapshots, estáticos) e o
+    // event stream já trazem o próprio Cache-Control: no-cache - um segundo,
+    // com no-store, impediria o navegador de guardar e revalidar
+    if (response.event_stream || response.preset_headers.find("Cache-Control:") != std::string::npos) {
+        return;
+    }
     response.headers["Cache-Control"] = "no-store, no-cache, must-revalidate";
     response.headers["Pragma"] = "no-cache";
 }
 
 void HTTPServer::logRequest(const HTTPRequest& request, const HTTPResponse& response) {
-    std::string log_entry = request.method + " " + request.path + " " + 
+    std::string log_entry = std::string(request.method) + " " + std::string(request.path) + " " + 
                            std::to_string(response.status_code);
-    access_logs_.push_back(log_entry);
-    
-    // Mantém apenas os últimos 1000 logs
-    if (access_logs_.size() > 1000) {
-        access_logs_.erase(access_logs_.begin());
+    {
+        std::lock_guard<std::mutex> lock(logs_mutex_);
+        access_logs_.push_back(log_entry);
+        
+        // Mantém apenas os últimos 1000 logs
+        if (access_logs_.size() > 1000) {
+            access_logs_.erase(access_logs_.begin());
+        }
     }
     
     logger_.info(log_entry, "HTTP");
 }
 
-std::string HTTPServer::readFromSocket(int socket) {
-    // Lê cabeçalhos primeiro
-    std::string data;
-    char buffer[4096];
-    while (true) {
-        ssize_t bytes = recv(socket, buffer, sizeof(buffer), 0);
-        if (bytes <= 0) break;
-        data.append(buffer, buffer + bytes);
-        // Checa fim de headers
-        auto pos = data.find("\r\n\r\n");
-        if (pos != std::string::npos) {
-            // Descobre Content-Length
-            std::string headers = data.substr(0, pos + 4);
-            size_t cl_pos = headers.find("Content-Length:");
-            size_t content_length = 0;
-            if (cl_pos != std::string::npos) {
-                cl_pos += std::string("Content-Length:").size();
-                // Pula possíveis espaços
-                while (cl_pos < headers.size() && (headers[cl_pos] == ' ' || headers[cl_pos] == '\t')) cl_pos++;
-                size_t end = headers.find("\r\n", cl_pos);
-                if (end != std::string::npos) {
-                    content_length = static_cast<size_t>(std::stol(headers.substr(cl_pos, end - cl_pos)));
-                }
-            }
-
-            size_t have_body = data.size() - (pos + 4);
-            while (have_body < content_length) {
-                ssize_t more = recv(socket, buffer, sizeof(buffer), 0);
-                if (more <= 0) break;
-                data.append(buffer, buffer + more);
-                have_body += static_cast<size_t>(more);
-            }
-            break;
-        }
-        // Proteção: evita loop infinito em requisições sem headers completos
-        if (data.size() > 1'000'000) break; // 1MB
-    }
-    return data;
-}
-
-bool HTTPServer::writeToSocket(int socket, const std::string& data) {
-    size_t total_sent = 0;
-    while (total_sent < data.length()) {
-        ssize_t sent = send(socket, data.c_str() + total_sent, 
-                           data.length() - total_sent, 0);
-        if (sent <= 0) return false;
-        total_sent += sent;
-    }
-    return true;
-}
-
 } // namespace ipc_project
@@ -12,20 +12,37 @@
 #include <atomic>
 #include <functional>
 #include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <optional>
 #include "../ipc/ipc_coordinator.h"
 #include "../common/logger.h"
+#include "../common/message_buffer.h"
+#include "../common/work_stealing_executor.h"
+#include "http_compression.h"
+#include "http_parser.h"
+#include "http_router.h"
 
 namespace ipc_project {
 
-// Estrutura pra requisições HTTP
+// Estrutura pra requisições HTTP. Tudo que é texto aponta pra dentro de raw
+// (o parser não copia nada); montada na mão, aponta pra literais
 struct HTTPRequest {
-    std::string method;          // GET, POST, PUT, DELETE
-    std::string path;            // /ipc/status, /ipc/start/pipes, etc
-    std::string body;            // corpo da requisição (JSON)
-    std::map<std::string, std::string> headers;  // cabeçalhos
-    std::map<std::string, std::string> params;   // parâmetros da URL
+    std::string_view method;     // GET, POST, PUT, DELETE
+    std::string_view path;       // /ipc/status, /ipc/start/pipes, etc (sem a query)
+    std::string_view query;      // depois do '?'
+    std::string_view version;    // HTTP/1.1, HTTP/1.0
+    std::string_view body;       // corpo da requisição (JSON)
+    HTTPHeaderList headers;      // cabeçalhos
+    RouteParams params;          // parâmetros da rota ({mechanism}), views pro path
+    MessageBuffer raw;           // bytes como vieram do socket (dono da memória)
     
     std::string getParam(const std::string& key, const std::string& default_val = "") const;
+    std::string_view getHeader(std::string_view name) const;    // nome sem diferenciar maiúsculas
+    bool wantsKeepAlive() const;     // 1.1 mantém por padrão, 1.0 só com "Connection: keep-alive"
+    MessageBuffer bodySlice(size_t pos, size_t length) const;  // pedaço do body sem copiar
 };
 
 // Estrutura pra respostas HTTP
@@ -34,18 +51,67 @@ struct HTTPResponse {
     std::string content_type;    // "application/json", "text/html"
     std::string body;            // conteúdo da resposta
     std::map<std::string, std::string> headers;  // cabeçalhos extras
+    bool keep_alive = false;     // Connection: keep-alive em vez de close
+    
+    // Corpo que não passa por body: buffer imutável do cache de estáticos
+    // (vai pro socket sem cópia) ou arquivo enviado com sendfile
+    std::shared_ptr<const std::string> shared_body;
+    std::string file_path;
+    size_t file_size = 0;
+    std::string preset_headers;  // linhas prontas ("Nome: valor\r\n"), calculadas uma vez
+    bool event_stream = false;   // text/event-stream: sem Content-Length, a conexão vira stream
     
     HTTPResponse(int code = 200, const std::string& type = "application/json");
     void setJSON(const std::string& json_content);
     void setError(int code, const std::string& message);
-    std::string toString() const;
+    size_t bodyLength() const;
+    std::string head() const;        // linha de status + cabeçalhos, sem o corpo
+    std::string toString() const;    // head() + corpo em memória (não inclui file_path)
+};
+
+// Arquivo estático carregado no start. Imutável depois disso: as threads
+// leem sem lock e várias respostas apontam pro mesmo corpo
+struct StaticAsset {
+    // Uma versão do corpo. Cada codificação tem ETag próprio (bytes diferentes)
+    struct Variant {
+        std::shared_ptr<const std::string> body;   // nullptr = não vale comprimir
+        std::string etag;                          // "tamanho-mtime" em hex (+ "-gzip"...)
+        std::string preset_headers;                // ETag, Last-Modified, Cache-Control, Vary...
+    };
+    
+    std::string content_type;
+    std::string last_modified;                 // data HTTP (IMF-fixdate)
+    Variant identity;
+    Variant gzip;                              // comprimidos uma vez no start
+    Variant deflate;
+    
+    const Variant& select(ContentEncoding encoding) const;   // cai pra identity se faltar
 };
 
 // Tipo pra handlers de rotas
 using RouteHandler = std::function<HTTPResponse(const HTTPRequest&)>;
 
+// Etapa em que uma conexão está no reactor. Quem "é dono" da conexão muda
+// com o estado: READING/WRITING = thread do epoll, PROCESSING = um worker
+enum class ConnectionState {
+    READING,        // juntando bytes até a requisição ficar completa
+    PROCESSING,     // na fila / num worker (roteamento + handler)
+    WRITING,        // resposta não coube no socket - o epoll termina de mandar
+    WEBSOCKET,      // depois do upgrade: o epoll lê frames, o push escreve (out_mutex)
+    EVENT_STREAM    // /ipc/events aberto: só o push escreve, leitura só detecta o fechamento
+};
+
+class WebSocketServer;
+class EventStream;
+
 // Classe principal do servidor HTTP
-// Fornece API REST pra controlar o sistema IPC via web
+// Fornece API REST pra controlar o sistema IPC via web.
+// Uma thread com epoll (edge-triggered, sockets não bloqueantes) aceita e lê;
+// requisições completas viram tarefas no executor com roubo de tarefas
+// (o do coordenador, se compartilhado, ou um próprio).
+// Com shards (setShards > 1) são N sockets de escuta na mesma porta
+// (SO_REUSEPORT), cada um com seu epoll numa thread presa a um núcleo, que
+// também atende as requisições (thread por núcleo, sem passar pelo executor)
 class HTTPServer {
 public:
     HTTPServer(int port = 8080);
@@ -61,40 +127,200 @@ public:
     void setPort(int port);              // Define porta
     void setCORS(bool enable);           // Habilita/desabilita CORS
     void setStaticPath(const std::string& path);  // Diretório de arquivos estáticos
+    void setWorkerThreads(size_t count); // Tamanho do pool próprio (só antes do start)
+    void setExecutor(std::shared_ptr<WorkStealingExecutor> executor);  // Usa um pool compartilhado
+    void setShards(size_t count);        // Listeners SO_REUSEPORT (só antes do start; 0 = um por núcleo)
+    // Conexões persistentes: tempo ocioso entre requisições e máximo por conexão
+    void setKeepAlive(bool enabled, long idle_timeout_ms = 5000, size_t max_requests = 100);
+    // gzip/deflate conforme Accept-Encoding: estáticos pré-comprimidos no start,
+    // respostas dinâmicas comprimidas na hora a partir de min_size bytes
+    void setCompression(bool enabled, size_t min_size = 1024);
+    // Push ao vivo por WebSocket em /ws e Server-Sent Events em /ipc/events
+    // (mesma porta, mesmo reactor)
+    void setWebSocket(bool enabled);
+    void setEventStream(bool enabled);
+    size_t getWorkerThreads() const;
+    size_t getShardCount() const;
     
     // Integração com IPC
     void setIPCCoordinator(std::shared_ptr<IPCCoordinator> coordinator);
     
     // Monitoramento
     size_t getRequestCount() const;      // Total de requisições processadas
+    size_t getActiveConnections() const; // Conexões abertas no reactor agora
+    std::vector<size_t> getShardAccepts() const;  // Conexões aceitas por cada shard
+    ExecutorStats getExecutorStats() const;  // Utilização e roubos por worker
     std::vector<std::string> getAccessLogs(size_t count = 50);  // Logs de acesso
+    std::string getStaticStatsJSON() const;  // Cache de estáticos e compressão: arquivos, bytes, hits, 304
+    size_t getWebSocketClients() const;      // Conexões em modo WebSocket agora
+    WebSocketServer* getWebSocketServer() const;   // nullptr se desligado
+    size_t getEventStreamClients() const;    // Conexões abertas em /ipc/events
+    
+    // Manda um frame já codificado pra todos os clientes WebSocket. Cliente
+    // que não lê (mais de MAX_STREAM_BACKLOG na fila) é desconectado
+    void broadcastWebSocket(const std::shared_ptr<const std::string>& frame);
+    
+    // Eventos SSE já formatados, em ordem de id. Cada cliente só recebe os
+    // que ainda não viu (o replay da conexão pode ter adiantado alguns);
+    // id 0 vai pra todos (keepalive, resync)
+    using StreamEvent = std::pair<uint64_t, std::shared_ptr<const std::string>>;
+    void broadcastEventStream(const std::vector<StreamEvent>& events);
 
 private:
     int port_;
     std::atomic<bool> is_running_;
     std::atomic<bool> shutdown_requested_;
     bool cors_enabled_;
+    bool keep_alive_enabled_;
+    bool compression_enabled_;
+    size_t compression_min_size_;
+    long keep_alive_timeout_ms_;
+    size_t keep_alive_max_requests_;
     std::string static_path_;
+    bool websocket_enabled_;
+    bool event_stream_enabled_;
+    std::unique_ptr<WebSocketServer> websocket_;
+    std::unique_ptr<EventStream> event_stream_;
     
     // IPC integration
     std::shared_ptr<IPCCoordinator> coordinator_;
     
-    // Servidor interno
-    std::unique_ptr<std::thread> server_thread_;
-    int server_socket_;
+    struct Shard;
+    
+    // Pedaço da saída de uma conexão: bytes próprios (cabeçalhos, JSON),
+    // corpo compartilhado do cache ou um arquivo aberto pro sendfile
+    struct OutChunk {
+        std::string data;
+        std::shared_ptr<const std::string> shared;
+        int file_fd = -1;
+        size_t file_size = 0;
+        
+        OutChunk() = default;
+        OutChunk(OutChunk&& other) noexcept;
+        OutChunk& operator=(OutChunk&&) = delete;
+        ~OutChunk();                           // fecha o arquivo
+        
+        bool inMemory() const { return file_fd < 0; }
+        const char* bytes() const { return shared ? shared->data() : data.data(); }
+        size_t size() const { return file_fd >= 0 ? file_size : shared ? shared->size() : data.size(); }
+    };
+    
+    // Estado de uma conexão. A requisição é lida direto num MessageBuffer
+    // (o body segue por referência até o transporte IPC)
+    struct Connection {
+        int fd;
+        Shard* shard = nullptr;                  // reactor que aceitou (e vigia) o fd
+        std::atomic<ConnectionState> state{ConnectionState::READING};
+        MessageBuffer in;
+        HTTPRequestParser parser;                // continua de onde parou a cada leitura
+        std::deque<OutChunk> out;                // respostas serializadas (em ordem, se pipelined)
+        size_t out_offset = 0;                   // quanto do primeiro pedaço já foi escrito
+        bool close_after_write = false;          // última resposta disse Connection: close
+        
+        // Lidos pela varredura de ociosas (thread do reactor) enquanto um
+        // worker pode estar atendendo: atômicos em vez de in/time_point
+        std::atomic<size_t> requests{0};         // requisições atendidas nesta conexão
+        std::atomic<bool> between_requests{false};   // respondeu tudo e nada novo chegou
+        std::atomic<int64_t> last_activity_ns{0};    // steady_clock
+        
+        void touch() {
+            last_activity_ns.store(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count(), std::memory_order_relaxed);
+        }
+        
+        // Em WEBSOCKET o push escreve de outra thread: out/out_offset só com
+        // out_mutex, e closed impede escrever num fd já fechado (e reaproveitado)
+        std::mutex out_mutex;
+        bool closed = false;
+        uint64_t last_event_id = 0;              // EVENT_STREAM: último evento enfileirado
+    };
+    
+    // Um reactor: socket de escuta, epoll e as conexões que ele aceitou.
+    // Nada aqui é compartilhado entre shards - o kernel espalha os accepts
+    struct Shard {
+        size_t index = 0;
+        int listen_fd = -1;
+        int epoll_fd = -1;
+        int wake_fd = -1;                          // eventfd pra acordar o epoll no stop
+        std::thread thread;
+        mutable std::mutex connections_mutex;      // fd -> estado
+        std::map<int, std::shared_ptr<Connection>> connections;
+        std::atomic<size_t> accepted{0};
+        std::atomic<size_t> requests{0};
+    };
     
-    // Estatísticas
-    std::atomic<size_t> request_count_;
+    size_t shard_count_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    
+    // Executor das requisições completas. Tarefas em andamento são contadas
+    // pro stop esperar - o pool pode continuar vivo depois (compartilhado)
+    size_t worker_count_;
+    std::shared_ptr<WorkStealingExecutor> executor_;
+    bool owns_executor_;
+    std::atomic<size_t> in_flight_;
+    std::mutex in_flight_mutex_;
+    std::condition_variable in_flight_cv_;
+    
+    // Cache de estáticos: carregado no start e só lido depois
+    std::map<std::string, std::shared_ptr<const StaticAsset>> static_cache_;
+    std::atomic<size_t> static_hits_;
+    std::atomic<size_t> static_not_modified_;
+    std::atomic<size_t> static_sendfile_;
+    std::atomic<size_t> compressed_responses_;       // dinâmicas comprimidas na hora
+    std::atomic<size_t> compression_saved_bytes_;
+    
+    // Versões comprimidas dos snapshots do coordenador ("status-gzip",
+    // "pipes-deflate"...). Refeitas só quando o snapshot muda
+    struct CompressedSnapshot {
+        std::shared_ptr<const std::string> source;   // JSON de onde saiu
+        std::shared_ptr<const std::string> body;
+        size_t saved_bytes = 0;
+    };
+    std::map<std::string, CompressedSnapshot> compressed_snapshots_;
+    std::mutex compressed_snapshots_mutex_;
+    
+    // Estatísticas (requisições são contadas por shard)
     std::vector<std::string> access_logs_;
+    std::mutex logs_mutex_;              // workers logam em paralelo
     
     Logger& logger_;
     
-    // Thread principal do servidor
-    void serverLoop();
+    static constexpr size_t MAX_REQUEST_SIZE = 1'000'000;     // 1MB
+    static constexpr long REQUEST_TIMEOUT_MS = 10'000;        // conexão parada é fechada
+    static constexpr size_t MAX_CACHED_ASSET = 1'000'000;     // maiores vão por sendfile
+    static constexpr size_t MAX_STATIC_CACHE = 64'000'000;    // total em memória
+    static constexpr size_t MAX_STREAM_BACKLOG = 1'000'000;   // saída parada por cliente lento (push)
+    static constexpr size_t MAX_WEBSOCKET_FRAME = 65'536;     // do cliente só chegam controles
+    static constexpr size_t MAX_BATCH_ITEMS = 10'000;         // por POST /ipc/send/batch
+    
+    // Reactor: aceita, lê e termina escritas pendentes
+    void serverLoop(Shard& shard);
+    void acceptConnections(Shard& shard);
+    void handleReadable(const std::shared_ptr<Connection>& conn);
+    void handleWritable(const std::shared_ptr<Connection>& conn);
+    void closeIdleConnections(Shard& shard);
+    void closeConnection(Shard& shard, int fd);
+    void closeConnection(const std::shared_ptr<Connection>& conn);   // só se o fd ainda for dela
+    
+    // Conexões de push (WebSocket e SSE): abertas no worker, lidas no reactor
+    void upgradeConnection(const std::shared_ptr<Connection>& conn);
+    void openEventStream(const std::shared_ptr<Connection>& conn, std::string_view last_event_id);
+    void handlePushConnection(const std::shared_ptr<Connection>& conn, uint32_t events);
+    void processWebSocketFrames(Connection& conn);   // com out_mutex; respostas vão pra out
+    std::vector<std::shared_ptr<Connection>> connectionsIn(ConnectionState state) const;
+    bool queueStreamChunk(Connection& conn, const std::shared_ptr<const std::string>& chunk);   // com out_mutex
+    
+    // Tarefas no executor: roteiam e respondem
+    void dispatch(const std::shared_ptr<Connection>& conn);
+    void processConnection(const std::shared_ptr<Connection>& conn);
+    bool flushOutput(Connection& conn, bool& would_block);   // false = erro no socket
+    void finishWrite(const std::shared_ptr<Connection>& conn);   // fecha ou volta a ler
+    void appendResponse(Connection& conn, const HTTPResponse& response);
     
     // Processamento de requisições
-    void handleClient(int client_socket);
-    HTTPRequest parseRequest(const std::string& raw_request);
+    HTTPRequestParser::Result requestComplete(Connection& conn);
+    HTTPRequest parseRequest(const MessageBuffer& raw_request, HTTPRequestParser& parser);
+    void rejectRequest(Connection& conn, int code, const std::string& message);   // responde e fecha
     std::string buildResponse(const HTTPResponse& response);
     
     // Handlers das rotas IPC
@@ -102,18 +328,31 @@ private:
     HTTPResponse handleIPCStart(const HTTPRequest& request);
     HTTPResponse handleIPCStop(const HTTPRequest& request);
     HTTPResponse handleIPCSend(const HTTPRequest& request);
+    HTTPResponse handleIPCSendBatch(const HTTPRequest& request);
     HTTPResponse handleIPCLogs(const HTTPRequest& request);
     HTTPResponse handleIPCDetail(const HTTPRequest& request);
+    HTTPResponse handleIPCSnapshot(const HTTPRequest& request);
+    HTTPResponse handleIPCExecutor(const HTTPRequest& request);
+    HTTPResponse handleWebSocketUpgrade(const HTTPRequest& request);
+    HTTPResponse handleIPCEvents(const HTTPRequest& request);
     
     // Handlers gerais
     HTTPResponse handleNotFound(const HTTPRequest& request);
     HTTPResponse handleOptions(const HTTPRequest& request);  // Para CORS
     HTTPResponse handleStaticFile(const HTTPRequest& request);
+    void loadStaticCache();
+    void compressResponse(const HTTPRequest& request, HTTPResponse& response);
+    HTTPResponse snapshotResponse(const HTTPRequest& request, const std::string& name,
+                                  const StateSnapshot& snapshot);
+    // Um objeto {mechanism, message, priority} que começa em 'offset' no body.
+    // 'where' entra nas mensagens de erro ("body", "item")
+    bool parseSendItem(const HTTPRequest& request, std::string_view json, size_t offset,
+                       std::string_view where, BatchMessage& item, std::string& mechanism_name,
+                       std::string& error) const;
+    bool notModified(const HTTPRequest& request, const std::string& etag, const std::string& last_modified) const;
     
     // Roteamento
-    HTTPResponse routeRequest(const HTTPRequest& request);
-    bool matchRoute(const std::string& pattern, const std::string& path, 
-                    std::map<std::string, std::string>& params);
+    HTTPResponse routeRequest(HTTPRequest& request);   // preenche request.params
     
     // Utilidades
     std::string extractPathParam(const std::string& path, const std::string& pattern, 
@@ -124,46 +363,142 @@ private:
     void logRequest(const HTTPRequest& request, const HTTPResponse& response);
     
     // Socket helpers
-    bool createSocket();
-    void closeSocket();
-    std::string readFromSocket(int socket);
-    bool writeToSocket(int socket, const std::string& data);
+    bool createSocket(Shard& shard);
+    void closeSocket(Shard& shard);
+};
+
+// Opcodes dos frames (RFC 6455, seção 5.2)
+enum class WebSocketOpcode : uint8_t {
+    CONTINUATION = 0x0,
+    TEXT = 0x1,
+    BINARY = 0x2,
+    CLOSE = 0x8,
+    PING = 0x9,
+    PONG = 0xA
 };
 
-// Classe pra servidor WebSocket (pra logs em tempo real)
+// Um frame decodificado (payload já sem a máscara)
+struct WebSocketFrame {
+    WebSocketOpcode opcode = WebSocketOpcode::TEXT;
+    bool fin = true;
+    std::string payload;
+    size_t length = 0;           // bytes do frame inteiro no buffer de entrada
+};
+
+// Push de atualizações ao vivo pro dashboard. Não tem socket próprio: o
+// upgrade acontece em GET /ws no HTTPServer e as conexões continuam no
+// reactor dele. Aqui fica o protocolo e a thread de push, que junta os
+// eventos do coordenador (start/stop/envio/recebimento) e os deltas de
+// status e manda um frame só pra todos os clientes.
+//
+// Mensagens (texto, JSON):
+//   {"type":"snapshot","status":{...},"details":{"pipes":{...},...}}  na conexão
+//   {"type":"events","events":[...],"details":{...}}   assim que acontecem
+//   {"type":"status","mechanisms":[...]}                só os que mudaram
 class WebSocketServer {
 public:
-    WebSocketServer(int port = 8081);
+    enum class DecodeResult { COMPLETE, INCOMPLETE, ERROR, TOO_LARGE };
+    
+    static constexpr long DEFAULT_STATUS_INTERVAL_MS = 250;
+    static constexpr long PING_INTERVAL_MS = 30'000;
+    static constexpr size_t MAX_PENDING_EVENTS = 1024;   // o resto é descartado (e contado)
+    
+    explicit WebSocketServer(HTTPServer& server);
     ~WebSocketServer();
     
-    bool start();
+    bool start();                        // Sobe a thread de push
     void stop();
     bool isRunning() const;
     
-    // Envia mensagem pra todos os clientes conectados
+    // Envia mensagem de texto pra todos os clientes conectados
     void broadcast(const std::string& message);
     
-    // Integração com IPC pra streaming de logs
+    // Eventos e status vêm daqui (registra ouvinte no start)
     void setIPCCoordinator(std::shared_ptr<IPCCoordinator> coordinator);
+    void setStatusInterval(long interval_ms);   // só antes do start
+    
+    std::string snapshotMessage() const; // primeira mensagem de cada cliente
+    size_t getDroppedEvents() const;
+    size_t getMessagesPushed() const;
+    
+    // Protocolo
+    static std::string acceptKey(std::string_view client_key);   // Sec-WebSocket-Accept
+    static std::string encodeFrame(std::string_view payload, WebSocketOpcode opcode = WebSocketOpcode::TEXT);
+    static std::string encodeClose(uint16_t code);
+    // Frame do cliente: exige máscara, controle com no máximo 125 bytes e sem fragmentar
+    static DecodeResult decodeFrame(std::string_view data, WebSocketFrame& frame, size_t max_payload);
 
 private:
-    int port_;
+    HTTPServer& server_;
+    std::atomic<bool> is_running_;
+    std::shared_ptr<IPCCoordinator> coordinator_;
+    size_t listener_id_;
+    long status_interval_ms_;
+    
+    // Eventos esperando a thread de push
+    std::mutex events_mutex_;
+    std::condition_variable events_cv_;
+    std::deque<IPCEvent> pending_events_;
+    std::atomic<size_t> dropped_events_;
+    std::atomic<size_t> messages_pushed_;
+    std::thread push_thread_;
+    
+    // Último status mandado por mecanismo (sem uptime, que muda sempre)
+    std::map<std::string, std::string> last_status_;
+    
+    Logger& logger_;
+    
+    void pushLoop();
+    void onEvent(const IPCEvent& event);
+    void pushEvents(std::deque<IPCEvent>& events);
+    void pushStatusDelta();
+    void send(const std::string& frame);
+};
+
+// Server-Sent Events em GET /ipc/events, pra quem não fala WebSocket (curl,
+// scripts). Cada evento do coordenador vira
+//   id: <id>\nevent: <tipo>\ndata: <IPCEvent em JSON>\n\n
+// A thread de push não tem fila própria: o ouvinte só acorda a thread, que
+// lê do histórico do coordenador tudo depois do último id enviado. Quem
+// reconecta com Last-Event-ID recebe o que perdeu do mesmo histórico; se o
+// id já saiu dele, chega um "event: resync" antes.
+class EventStream {
+public:
+    static constexpr long HEARTBEAT_INTERVAL_MS = 15'000;   // comentário pra proxies não cortarem
+    static constexpr long RETRY_MS = 2000;                  // "retry:" sugerido ao EventSource
+    
+    explicit EventStream(HTTPServer& server);
+    ~EventStream();
+    
+    bool start();
+    void stop();
+    bool isRunning() const;
+    void setIPCCoordinator(std::shared_ptr<IPCCoordinator> coordinator);
+    
+    // Início do stream de uma conexão: retry + eventos depois de last_event_id
+    // (sem Last-Event-ID: só o que acontecer daqui pra frente). last_sent
+    // volta com o id do último evento incluído
+    std::string openingChunk(std::optional<uint64_t> resume_after, uint64_t& last_sent) const;
+    
+    static std::string formatEvent(const IPCEvent& event);
+    static std::string formatResync(uint64_t oldest_id);
+
+private:
+    HTTPServer& server_;
     std::atomic<bool> is_running_;
     std::shared_ptr<IPCCoordinator> coordinator_;
+    size_t listener_id_;
     
-    // Clientes conectados
-    std::vector<int> connected_clients_;
-    std::thread server_thread_;
-    std::thread log_streaming_thread_;
+    std::mutex wake_mutex_;
+    std::condition_variable wake_cv_;
+    bool pending_;                       // chegou evento desde a última passada
+    uint64_t last_pushed_;               // só a thread de push mexe
+    std::thread push_thread_;
     
     Logger& logger_;
     
-    void serverLoop();
-    void logStreamingLoop();
-    void handleWebSocketClient(int client_socket);
-    bool performWebSocketHandshake(int client_socket);
-    std::string encodeWebSocketFrame(const std::string& message);
-    std::string decodeWebSocketFrame(const std::string& frame);
+    void pushLoop();
+    void pushNewEvents();
 };
 
 // Estrutura pra configuração completa do servidor
@@ -0,0 +1,356 @@
+/**
+ * @file websocket_server.cpp
+ * @brief Protocolo WebSocket e push de eventos/status pro dashboard
+ */
+
+#include "http_server.h"
+#include "../common/json_writer.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace ipc_project {
+
+namespace {
+
+constexpr const char* WEBSOCKET_GUID = "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+
+// SHA-1 (FIPS 180-4) - só pro Sec-WebSocket-Accept do handshake, então
+// nada de desempenho: uma mensagem curta por conexão
+std::array<uint8_t, 20> sha1(std::string_view input) {
+    uint32_t h[5] = { 0x67452301, 0xEFCDAB89, 0x98BADCFE, 0x10325476, 0xC3D2E1F0 };
+    auto rotl = [](uint32_t value, int bits) { return (value << bits) | (value >> (32 - bits)); };
+
+    std::string message(input);
+    uint64_t bit_length = static_cast<uint64_t>(input.size()) * 8;
+    message.push_back(static_cast<char>(0x80));
+    while (message.size() % 64 != 56) {
+        message.push_back('\0');
+    }
+    for (int shift = 56; shift >= 0; shift -= 8) {
+        message.push_back(static_cast<char>((bit_length >> shift) & 0xFF));
+    }
+
+    for (size_t block = 0; block < message.size(); block += 64) {
+        uint32_t w[80];
+        for (int i = 0; i < 16; ++i) {
+            const auto* p = reinterpret_cast<const uint8_t*>(message.data() + block + i * 4);
+            w[i] = (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+        }
+        for (int i = 16; i < 80; ++i) {
+            w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+        }
+
+        uint32_t a = h[0], b = h[1], c = h[2], d = h[3], e = h[4];
+        for (int i = 0; i < 80; ++i) {
+            uint32_t f, k;
+            if (i < 20)      { f = (b & c) | (~b & d);          k = 0x5A827999; }
+            else if (i < 40) { f = b ^ c ^ d;                   k = 0x6ED9EBA1; }
+            else if (i < 60) { f = (b & c) | (b & d) | (c & d); k = 0x8F1BBCDC; }
+            else             { f = b ^ c ^ d;                   k = 0xCA62C1D6; }
+            uint32_t temp = rotl(a, 5) + f + e + k + w[i];
+            e = d; d = c; c = rotl(b, 30); b = a; a = temp;
+        }
+        h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e;
+    }
+
+    std::array<uint8_t, 20> digest;
+    for (int i = 0; i < 5; ++i) {
+        digest[i * 4] = static_cast<uint8_t>(h[i] >> 24);
+        digest[i * 4 + 1] = static_cast<uint8_t>(h[i] >> 16);
+        digest[i * 4 + 2] = static_cast<uint8_t>(h[i] >> 8);
+        digest[i * 4 + 3] = static_cast<uint8_t>(h[i]);
+    }
+    return digest;
+}
+
+std::string base64(const uint8_t* data, size_t length) {
+    static constexpr char ALPHABET[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    std::string out;
+    out.reserve((length + 2) / 3 * 4);
+    for (size_t i = 0; i < length; i += 3) {
+        uint32_t chunk = uint32_t(data[i]) << 16;
+        if (i + 1 < length) chunk |= uint32_t(data[i + 1]) << 8;
+        if (i + 2 < length) chunk |= data[i + 2];
+        out.push_back(ALPHABET[(chunk >> 18) & 0x3F]);
+        out.push_back(ALPHABET[(chunk >> 12) & 0x3F]);
+        out.push_back(i + 1 < length ? ALPHABET[(chunk >> 6) & 0x3F] : '=');
+        out.push_back(i + 2 < length ? ALPHABET[chunk & 0x3F] : '=');
+    }
+    return out;
+}
+
+// Status do mecanismo sem o uptime - é o que decide se ele "mudou"
+std::string statusSignature(const MechanismStatus& status) {
+    MechanismStatus copy = status;
+    copy.uptime_ms = 0;
+    return copy.toJSON();
+}
+
+} // namespace
+
+WebSocketServer::WebSocketServer(HTTPServer& server)
+    : server_(server), is_running_(false), listener_id_(0),
+      status_interval_ms_(DEFAULT_STATUS_INTERVAL_MS),
+      dropped_events_(0), messages_pushed_(0), logger_(Logger::getInstance()) {
+}
+
+WebSocketServer::~WebSocketServer() {
+    stop();
+}
+
+bool WebSocketServer::start() {
+    if (is_running_) return true;
+
+    is_running_ = true;
+    if (coordinator_) {
+        listener_id_ = coordinator_->addEventListener([this](const IPCEvent& event) { onEvent(event); });
+    }
+    push_thread_ = std::thread(&WebSocketServer::pushLoop, this);
+    logger_.info("Push WebSocket ativo em /ws (status a cada " + std::to_string(status_interval_ms_) + "ms)", "HTTP");
+    return true;
+}
+
+void WebSocketServer::stop() {
+    if (!is_running_) return;
+
+    // Sem ouvinte primeiro: depois do remove nenhum evento entra na fila
+    if (coordinator_ && listener_id_ != 0) {
+        coordinator_->removeEventListener(listener_id_);
+        listener_id_ = 0;
+    }
+    {
+        std::lock_guard<std::mutex> lock(events_mutex_);
+        is_running_ = false;
+        pending_events_.clear();
+    }
+    events_cv_.notify_all();
+    if (push_thread_.joinable()) {
+        push_thread_.join();
+    }
+    last_status_.clear();
+}
+
+bool WebSocketServer::isRunning() const {
+    return is_running_;
+}
+
+void WebSocketServer::broadcast(const std::string& message) {
+    send(encodeFrame(message));
+}
+
+void WebSocketServer::setIPCCoordinator(std::shared_ptr<IPCCoordinator> coordinator) {
+    coordinator_ = coordinator;
+}
+
+void WebSocketServer::setStatusInterval(long interval_ms) {
+    status_interval_ms_ = std::max(10L, interval_ms);
+}
+
+size_t WebSocketServer::getDroppedEvents() const {
+    return dropped_events_;
+}
+
+size_t WebSocketServer::getMessagesPushed() const {
+    return messages_pushed_;
+}
+
+void WebSocketServer::send(const std::string& frame) {
+    server_.broadcastWebSocket(std::make_shared<const std::string>(frame));
+    messages_pushed_++;
+}
+
+// Roda na thread que gerou o evento (lane, handler HTTP): só enfileira
+void WebSocketServer::onEvent(const IPCEvent& event) {
+    {
+        std::lock_guard<std::mutex> lock(events_mutex_);
+        if (!is_running_) return;
+        if (pending_events_.size() >= MAX_PENDING_EVENTS) {
+            dropped_events_++;
+            return;
+        }
+        pending_events_.push_back(event);
+    }
+    events_cv_.notify_one();
+}
+
+// Acorda com evento novo (manda na hora) ou no intervalo do status. Tudo que
+// chegou enquanto o frame anterior era montado sai junto no próximo
+void WebSocketServer::pushLoop() {
+    auto interval = std::chrono::milliseconds(status_interval_ms_);
+    auto next_status = std::chrono::steady_clock::now() + interval;
+    auto next_ping = std::chrono::steady_clock::now() + std::chrono::milliseconds(PING_INTERVAL_MS);
+
+    while (true) {
+        std::deque<IPCEvent> events;
+        {
+            std::unique_lock<std::mutex> lock(events_mutex_);
+            events_cv_.wait_until(lock, next_status, [this] { return !is_running_ || !pending_events_.empty(); });
+            if (!is_running_) break;
+            events.swap(pending_events_);
+        }
+
+        // Ninguém conectado: não monta nada (quem chegar recebe o snapshot)
+        if (server_.getWebSocketClients() == 0) {
+            last_status_.clear();
+            next_status = std::chrono::steady_clock::now() + interval;
+            continue;
+        }
+
+        if (!events.empty()) {
+            pushEvents(events);
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now >= next_status) {
+            pushStatusDelta();
+            next_status = now + interval;
+        }
+        if (now >= next_ping) {
+            send(encodeFrame("", WebSocketOpcode::PING));
+            next_ping = now + std::chrono::milliseconds(PING_INTERVAL_MS);
+        }
+    }
+}
+
+// Um frame por lote. Junto vai o detalhe atual de cada mecanismo envolvido -
+// o dashboard não precisa buscar /ipc/detail depois de cada evento
+void WebSocketServer::pushEvents(std::deque<IPCEvent>& events) {
+    std::string out;
+    out.reserve(256 * events.size());
+    JSONWriter json(out);
+    json.beginObject().field("type", "events").key("events").beginArray();
+    std::map<IPCMechanism, const std::string*> touched;
+    for (const auto& event : events) {
+        event.writeJSON(json);
+        touched.emplace(event.mechanism, &event.mechanism_name);
+    }
+    json.endArray();
+
+    if (coordinator_) {
+        json.key("details").beginObject();
+        for (const auto& entry : touched) {
+            json.rawField(*entry.second, coordinator_->getMechanismDetailJSON(entry.first));
+        }
+        json.endObject();
+    }
+    json.endObject();
+    send(encodeFrame(out));
+}
+
+// Só os mecanismos cuja assinatura mudou desde o último envio
+void WebSocketServer::pushStatusDelta() {
+    if (!coordinator_) return;
+
+    CoordinatorStatus status = coordinator_->getFullStatus();
+    std::string out;
+    JSONWriter json(out);
+    json.beginObject().field("type", "status").key("mechanisms").beginArray();
+    size_t changed = 0;
+    for (const auto& mechanism : status.mechanisms) {
+        std::string signature = statusSignature(mechanism);
+        auto it = last_status_.find(mechanism.name);
+        if (it != last_status_.end() && it->second == signature) continue;
+        last_status_[mechanism.name] = std::move(signature);
+        mechanism.writeJSON(json);
+        changed++;
+    }
+    json.endArray().endObject();
+
+    if (changed > 0) {
+        send(encodeFrame(out));
+    }
+}
+
+std::string WebSocketServer::snapshotMessage() const {
+    if (!coordinator_) {
+        return "{\"type\":\"snapshot\",\"status\":null}";
+    }
+    // Mesmo documento do GET /ipc/snapshot (cache por versão), com o tipo na frente
+    auto snapshot = coordinator_->getFullSnapshot();
+    std::string out = "{\"type\":\"snapshot\",";
+    out.append(*snapshot.json, 1, std::string::npos);
+    return out;
+}
+
+// Protocolo
+
+std::string WebSocketServer::acceptKey(std::string_view client_key) {
+    std::string input(client_key);
+    input += WEBSOCKET_GUID;
+    auto digest = sha1(input);
+    return base64(digest.data(), digest.size());
+}
+
+// Servidor nunca mascara. Tamanho: 7 bits, 16 bits (126) ou 64 bits (127)
+std::string WebSocketServer::encodeFrame(std::string_view payload, WebSocketOpcode opcode) {
+    std::string frame;
+    frame.reserve(payload.size() + 10);
+    frame.push_back(static_cast<char>(0x80 | static_cast<uint8_t>(opcode)));   // FIN
+    size_t length = payload.size();
+    if (length < 126) {
+        frame.push_back(static_cast<char>(length));
+    } else if (length <= 0xFFFF) {
+        frame.push_back(static_cast<char>(126));
+        frame.push_back(static_cast<char>(length >> 8));
+        frame.push_back(static_cast<char>(length & 0xFF));
+    } else {
+        frame.push_back(static_cast<char>(127));
+        for (int shift = 56; shift >= 0; shift -= 8) {
+            frame.push_back(static_cast<char>((static_cast<uint64_t>(length) >> shift) & 0xFF));
+        }
+    }
+    frame.append(payload);
+    return frame;
+}
+
+std::string WebSocketServer::encodeClose(uint16_t code) {
+    char payload[2] = { static_cast<char>(code >> 8), static_cast<char>(code & 0xFF) };
+    return encodeFrame(std::string_view(payload, 2), WebSocketOpcode::CLOSE);
+}
+
+WebSocketServer::DecodeResult WebSocketServer::decodeFrame(std::string_view data, WebSocketFrame& frame,
+                                                           size_t max_payload) {
+    if (data.size() < 2) return DecodeResult::INCOMPLETE;
+
+    auto byte = [&data](size_t i) { return static_cast<uint8_t>(data[i]); };
+    bool fin = (byte(0) & 0x80) != 0;
+    if ((byte(0) & 0x70) != 0) return DecodeResult::ERROR;   // RSV sem extensão negociada
+    uint8_t opcode = byte(0) & 0x0F;
+    bool is_control = (opcode & 0x08) != 0;
+    if (opcode > 0x2 && !is_control) return DecodeResult::ERROR;
+    if (opcode > 0xA) return DecodeResult::ERROR;
+    if ((byte(1) & 0x80) == 0) return DecodeResult::ERROR;   // cliente sempre mascara
+
+    uint64_t length = byte(1) & 0x7F;
+    size_t header = 2;
+    if (length == 126) {
+        if (data.size() < 4) return DecodeResult::INCOMPLETE;
+        length = (uint64_t(byte(2)) << 8) | byte(3);
+        header = 4;
+    } else if (length == 127) {
+        if (data.size() < 10) return DecodeResult::INCOMPLETE;
+        length = 0;
+        for (size_t i = 2; i < 10; ++i) {
+            length = (length << 8) | byte(i);
+        }
+        header = 10;
+    }
+    if (is_control && (length > 125 || !fin)) return DecodeResult::ERROR;
+    if (length > max_payload) return DecodeResult::TOO_LARGE;
+
+    size_t total = header + 4 + static_cast<size_t>(length);
+    if (data.size() < total) return DecodeResult::INCOMPLETE;
+
+    const uint8_t* mask = reinterpret_cast<const uint8_t*>(data.data() + header);
+    frame.opcode = static_cast<WebSocketOpcode>(opcode);
+    frame.fin = fin;
+    frame.payload.assign(data.data() + header + 4, static_cast<size_t>(length));
+    for (size_t i = 0; i < frame.payload.size(); ++i) {
+        frame.payload[i] = static_cast<char>(static_cast<uint8_t>(frame.payload[i]) ^ mask[i & 3]);
+    }
+    frame.length = total;
+    return DecodeResult::COMPLETE;
+}
+
+} // namespace ipc_project
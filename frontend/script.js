@@ -5,10 +5,19 @@ class IPCDashboard {
         this.methods = {
             pipes: { name: 'Anonymous Pipes', active: false },
             sockets: { name: 'Local Sockets', active: false },
-            shared_memory: { name: 'Shared Memory', active: false }
+            shared_memory: { name: 'Shared Memory', active: false },
+            cross_memory: { name: 'Cross Memory Attach', active: false },
+            message_queue: { name: 'POSIX Message Queue', active: false },
+            eventfd: { name: 'eventfd Doorbell', active: false },
+            tcp_bridge: { name: 'TCP Bridge', active: false }
         };
         
         this.messages = [];
+        // Canal de push (WebSocket em /ws); polling só enquanto ele está fora
+        this.socket = null;
+        this.live = false;
+        this.reconnectDelay = 1000;
+        this.poller = null;
         // Inicializa tudo quando a classe é criada
         this.setup();
     }
@@ -17,9 +26,90 @@ class IPCDashboard {
     setup() {
         this.bindEvents();
         this.logMessage('System initialized. Ready to start IPC testing.', 'info');
-        // Atualizações periódicas
+        // Atualizações chegam por push; o snapshot da conexão substitui o primeiro fetch
+        this.connectLive();
+    }
+
+    // Abre o WebSocket. O servidor manda um snapshot ao conectar e depois só
+    // o que muda: eventos (start/stop/envio) e deltas de status
+    connectLive() {
+        const scheme = window.location.protocol === 'https:' ? 'wss' : 'ws';
+        let socket;
+        try {
+            socket = new WebSocket(`${scheme}://${window.location.host}/ws`);
+        } catch (e) {
+            this.startPolling();
+            return;
+        }
+        this.socket = socket;
+
+        socket.onopen = () => {
+            this.live = true;
+            this.reconnectDelay = 1000;
+            this.stopPolling();
+        };
+        socket.onmessage = (event) => {
+            let message;
+            try {
+                message = JSON.parse(event.data);
+            } catch (e) {
+                return;
+            }
+            this.handleLiveMessage(message);
+        };
+        socket.onclose = () => {
+            this.live = false;
+            this.socket = null;
+            // Sem push: volta a perguntar (devagar) e tenta reconectar com backoff
+            this.startPolling();
+            setTimeout(() => this.connectLive(), this.reconnectDelay);
+            this.reconnectDelay = Math.min(this.reconnectDelay * 2, 30000);
+        };
+    }
+
+    handleLiveMessage(message) {
+        switch (message.type) {
+            case 'snapshot':
+                if (message.status) this.applyStatus(message.status.mechanisms);
+                this.applyDetails(message.details);
+                break;
+            case 'status':
+                this.applyStatus(message.mechanisms);
+                break;
+            case 'events':
+                (message.events || []).forEach(e => this.logEvent(e));
+                this.applyDetails(message.details);
+                break;
+        }
+    }
+
+    // Eventos que o backend viu (inclusive os disparados por outros clientes)
+    logEvent(event) {
+        const name = this.methods[event.mechanism]?.name || event.mechanism;
+        if (event.type === 'started' || event.type === 'stopped') {
+            this.logMessage(`${name} ${event.type} (backend)`, event.type);
+        } else if (event.type === 'message_received') {
+            this.logMessage(`Received via ${name}: ${event.detail}`, 'received');
+        } else if (event.type === 'error') {
+            this.logMessage(`${name}: ${event.detail}`, 'error');
+        }
+    }
+
+    applyDetails(details) {
+        if (!details) return;
+        Object.keys(details).forEach(m => this.updateDetailsUI(m, details[m]));
+    }
+
+    startPolling() {
+        if (this.poller) return;
         this.refreshAll();
-        this.poller = setInterval(() => this.refreshAll(), 1000);
+        this.poller = setInterval(() => this.refreshAll(), 5000);
+    }
+
+    stopPolling() {
+        if (!this.poller) return;
+        clearInterval(this.poller);
+        this.poller = null;
     }
 
     // Conecta todos os eventos da interface com suas funções
@@ -70,8 +160,8 @@ class IPCDashboard {
                 const card = document.querySelector(`.ipc-card[data-mech="${method}"]`);
                 if (card) this.updateCard(card, true);
                 this.methods[method].active = true;
-                // Atualiza detalhes após start
-                this.refreshDetails(method);
+                // Com push os detalhes chegam junto do evento
+                if (!this.live) this.refreshAll();
             })
             .catch(() => this.logMessage(`Failed to start ${method}`, 'error'));
     }
@@ -100,7 +190,7 @@ class IPCDashboard {
         const select = document.querySelector('.message-controls select');
         
         const text = input.value.trim();
-        const mapSelect = { pipe: 'pipes', socket: 'sockets', shmem: 'shared_memory' };
+        const mapSelect = { pipe: 'pipes', socket: 'sockets', shmem: 'shared_memory', cross: 'cross_memory', mqueue: 'message_queue', eventfd: 'eventfd', tcp_bridge: 'tcp_bridge' };
         const method = mapSelect[select.value] || '';
         
         // Validações antes de enviar
@@ -136,40 +226,35 @@ class IPCDashboard {
            .then(r => r.json().catch(() => ({})))
            .then(() => {
                this.logMessage(`[${time}] Backend acknowledged ${this.methods[method].name}`, 'received');
-               this.refreshDetails(method);
+               if (!this.live) this.refreshAll();
            })
            .catch(() => this.logMessage(`Send failed on ${method}`, 'error'));
     }
 
-    // Atualiza status e detalhes do backend
+    // Atualiza status e detalhes do backend numa requisição só. 'no-cache'
+    // revalida com o ETag: sem mudança o backend responde 304 e o navegador
+    // reaproveita o último corpo
     refreshAll() {
-        this.fetchStatus().then(() => {
-            Object.keys(this.methods).forEach(m => this.refreshDetails(m));
-        });
-    }
-
-    fetchStatus() {
-        return fetch(`${this.baseURL}/ipc/status`, { cache: 'no-store' })
+        return fetch(`${this.baseURL}/ipc/snapshot`, { cache: 'no-cache' })
             .then(r => r.json())
-            .then(status => {
-                if (!status || !Array.isArray(status.mechanisms)) return;
-                status.mechanisms.forEach(mech => {
-                    const method = mech.name; // 'pipes' | 'sockets' | 'shared_memory'
-                    if (this.methods[method] !== undefined) {
-                        this.methods[method].active = !!mech.is_active;
-                        const card = document.querySelector(`.ipc-card[data-mech="${method}"]`);
-                        if (card) this.updateCard(card, !!mech.is_active);
-                    }
-                });
+            .then(snapshot => {
+                this.applyStatus(snapshot?.status?.mechanisms);
+                this.applyDetails(snapshot?.details);
             })
             .catch(() => {});
     }
 
-    refreshDetails(method) {
-        fetch(`${this.baseURL}/ipc/detail/${method}`, { cache: 'no-store' })
-            .then(r => r.json())
-            .then(detail => this.updateDetailsUI(method, detail))
-            .catch(() => {});
+    // Lista completa (status/snapshot) ou só os mecanismos que mudaram (push)
+    applyStatus(mechanisms) {
+        if (!Array.isArray(mechanisms)) return;
+        mechanisms.forEach(mech => {
+            const method = mech.name; // 'pipes' | 'sockets' | 'shared_memory'
+            if (this.methods[method] !== undefined) {
+                this.methods[method].active = !!mech.is_active;
+                const card = document.querySelector(`.ipc-card[data-mech="${method}"]`);
+                if (card) this.updateCard(card, !!mech.is_active);
+            }
+        });
     }
 
     updateDetailsUI(method, detail) {
@@ -63,7 +63,7 @@ TEST_F(FullFlowIntegrationTest, SystemInitialization) {
     // Verifica status inicial do sistema
     auto status = coordinator->getFullStatus();
     EXPECT_EQ(status.status, "running");
-    EXPECT_EQ(status.mechanisms.size(), 3);
+    EXPECT_EQ(status.mechanisms.size(), 7);
     EXPECT_FALSE(status.all_active); // nenhum mecanismo iniciado ainda
 }
 
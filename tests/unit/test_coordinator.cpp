@@ -7,6 +7,8 @@
 #include "ipc/ipc_coordinator.h"
 #include <thread>
 #include <chrono>
+#include <condition_variable>
+#include <mutex>
 
 using namespace ipc_project;
 
@@ -56,7 +58,7 @@ TEST_F(IPCCoordinatorTest, MechanismStatus) {
     
     // Status inicial
     auto status = coordinator->getFullStatus();
-    EXPECT_EQ(status.mechanisms.size(), 3); // PIPES, SOCKETS, SHARED_MEMORY
+    EXPECT_EQ(status.mechanisms.size(), 7); // PIPES, SOCKETS, SHARED_MEMORY, CROSS_MEMORY, MESSAGE_QUEUE, EVENTFD, TCP_BRIDGE
     EXPECT_FALSE(status.all_active);
     EXPECT_EQ(status.status, "running");
     
@@ -195,4 +197,130 @@ TEST_F(IPCCoordinatorTest, TimestampGeneration) {
     std::string timestamp = coordinator->getCurrentTimestamp();
     EXPECT_FALSE(timestamp.empty());
     EXPECT_GT(timestamp.length(), 10); // timestamp deve ter pelo menos 10 chars
-}
\ No newline at end of file
+}
+// Teste das lanes de prioridade
+TEST_F(IPCCoordinatorTest, PriorityLanes) {
+    ASSERT_TRUE(coordinator->initialize());
+    ASSERT_TRUE(coordinator->startMechanism(IPCMechanism::SHARED_MEMORY));
+    
+    EXPECT_TRUE(coordinator->sendMessage(IPCMechanism::SHARED_MEMORY, "controle", MessagePriority::CRITICAL));
+    EXPECT_TRUE(coordinator->sendMessage(IPCMechanism::SHARED_MEMORY, "padrao"));
+    EXPECT_TRUE(coordinator->sendMessage(IPCMechanism::SHARED_MEMORY, "massa 1", MessagePriority::BULK));
+    EXPECT_TRUE(coordinator->sendMessage(IPCMechanism::SHARED_MEMORY, "massa 2", MessagePriority::BULK));
+    
+    auto lanes = coordinator->getLaneStats(IPCMechanism::SHARED_MEMORY);
+    ASSERT_EQ(lanes.size(), PRIORITY_COUNT);
+    EXPECT_EQ(lanes[static_cast<size_t>(MessagePriority::CRITICAL)].sent, 1u);
+    EXPECT_EQ(lanes[static_cast<size_t>(MessagePriority::NORMAL)].sent, 1u);
+    EXPECT_EQ(lanes[static_cast<size_t>(MessagePriority::BULK)].sent, 2u);
+    EXPECT_EQ(lanes[static_cast<size_t>(MessagePriority::BULK)].queued, 0u);
+    
+    // Estatísticas aparecem no status do mecanismo
+    auto json = coordinator->getMechanismStatus(IPCMechanism::SHARED_MEMORY).toJSON();
+    EXPECT_NE(json.find("\"lanes\""), std::string::npos);
+    EXPECT_NE(json.find("\"critical\""), std::string::npos);
+    
+    // Prioridade vem do comando JSON
+    IPCCommand cmd;
+    EXPECT_TRUE(cmd.fromJSON(R"({"action":"send","mechanism":"shared_memory","message":"x","priority":"critical"})"));
+    EXPECT_EQ(cmd.priority, MessagePriority::CRITICAL);
+    EXPECT_FALSE(cmd.fromJSON(R"({"action":"send","mechanism":"shared_memory","message":"x","priority":"urgente"})"));
+}
+
+// Com as três lanes cheias ao mesmo tempo: CRITICAL sai primeiro, depois
+// NORMAL e BULK na proporção NORMAL_WEIGHT:1
+TEST_F(IPCCoordinatorTest, PriorityLanesDequeueOrderWhenBackedUp) {
+    ASSERT_TRUE(coordinator->initialize());
+    ASSERT_TRUE(coordinator->startMechanism(IPCMechanism::SHARED_MEMORY));
+    
+    // O ouvinte roda na thread do despachante: segurando o primeiro envio,
+    // o despachante fica parado enquanto as lanes enchem
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool released = false;
+    std::vector<std::string> order;
+    size_t listener = coordinator->addEventListener([&](const IPCEvent& event) {
+        if (event.type != "message_sent") return;
+        std::unique_lock<std::mutex> lock(mutex);
+        order.push_back(event.detail);
+        cv.notify_all();
+        cv.wait(lock, [&] { return released; });
+    });
+    
+    std::thread blocker([&] {
+        EXPECT_TRUE(coordinator->sendMessage(IPCMechanism::SHARED_MEMORY, "primeira"));
+    });
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        ASSERT_TRUE(cv.wait_for(lock, std::chrono::seconds(5), [&] { return !order.empty(); }));
+    }
+    
+    std::vector<BatchMessage> batch;
+    auto add = [&](const std::string& text, MessagePriority priority) {
+        batch.push_back({ IPCMechanism::SHARED_MEMORY, MessageBuffer::copyOf(text), priority });
+    };
+    for (int i = 1; i <= 6; ++i) add("b" + std::to_string(i), MessagePriority::BULK);
+    for (int i = 1; i <= 8; ++i) add("n" + std::to_string(i), MessagePriority::NORMAL);
+    for (int i = 1; i <= 2; ++i) add("c" + std::to_string(i), MessagePriority::CRITICAL);
+    std::vector<bool> results;
+    std::thread producer([&] { results = coordinator->sendMessages(batch); });
+    
+    // Espera o lote inteiro estar nas filas antes de soltar o despachante
+    auto queued = [&] {
+        size_t total = 0;
+        for (const auto& lane : coordinator->getLaneStats(IPCMechanism::SHARED_MEMORY)) total += lane.queued;
+        return total;
+    };
+    for (int i = 0; i < 500 && queued() < batch.size(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    EXPECT_EQ(queued(), batch.size());
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        released = true;
+    }
+    cv.notify_all();
+    blocker.join();
+    producer.join();
+    coordinator->removeEventListener(listener);
+    
+    EXPECT_EQ(results, std::vector<bool>(batch.size(), true));
+    // "primeira" (NORMAL) já contou 1 no peso: mais 3 NORMAL, 1 BULK, 4 NORMAL...
+    std::vector<std::string> expected = { "primeira", "c1", "c2",
+                                          "n1", "n2", "n3", "b1",
+                                          "n4", "n5", "n6", "n7", "b2",
+                                          "n8", "b3", "b4", "b5", "b6" };
+    EXPECT_EQ(order, expected);
+}
+
+// Histórico em anel: passa de EVENT_HISTORY e guarda só os últimos, em ordem
+TEST_F(IPCCoordinatorTest, EventHistoryKeepsNewestInOrder) {
+    ASSERT_TRUE(coordinator->initialize());
+    ASSERT_TRUE(coordinator->startMechanism(IPCMechanism::SHARED_MEMORY));
+    
+    std::vector<BatchMessage> batch;
+    for (size_t i = 0; i < IPCCoordinator::EVENT_HISTORY + 100; ++i) {
+        batch.push_back({ IPCMechanism::SHARED_MEMORY, MessageBuffer::copyOf("e" + std::to_string(i)),
+                          MessagePriority::NORMAL });
+    }
+    uint64_t before = coordinator->lastEventId();
+    coordinator->sendMessages(batch);
+    for (int i = 0; i < 500 && coordinator->lastEventId() < before + batch.size(); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    uint64_t last = coordinator->lastEventId();
+    ASSERT_GE(last, before + batch.size());
+    
+    uint64_t oldest = 0;
+    auto events = coordinator->getEventsSince(0, &oldest);
+    ASSERT_EQ(events.size(), IPCCoordinator::EVENT_HISTORY);
+    EXPECT_EQ(oldest, last - IPCCoordinator::EVENT_HISTORY + 1);
+    for (size_t i = 0; i < events.size(); ++i) {
+        EXPECT_EQ(events[i].id, oldest + i);
+    }
+    
+    auto tail = coordinator->getEventsSince(last - 3);
+    ASSERT_EQ(tail.size(), 3u);
+    EXPECT_EQ(tail.back().id, last);
+    EXPECT_TRUE(coordinator->getEventsSince(last).empty());
+}
@@ -0,0 +1,148 @@
+/**
+ * @file test_eventfd.cpp
+ * @brief Unit tests for the eventfd doorbell mechanism
+ */
+
+#include <gtest/gtest.h>
+#include "ipc/eventfd_manager.h"
+#include "ipc/ipc_coordinator.h"
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <signal.h>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+using namespace ipc_project;
+
+namespace {
+
+// The child updates the shared counters asynchronously
+bool waitFor(const std::function<bool()>& condition) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (condition()) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return condition();
+}
+
+} // namespace
+
+// Rings that pile up while the child is stopped are delivered in one wakeup
+TEST(EventFdTest, CounterModeCoalescesSignals) {
+    EventFdManager doorbell;
+    ASSERT_TRUE(doorbell.createDoorbell());
+    ASSERT_EQ(kill(doorbell.getChildPid(), SIGSTOP), 0);
+
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(doorbell.ring());
+    }
+    EXPECT_TRUE(doorbell.ring(10));
+    kill(doorbell.getChildPid(), SIGCONT);
+
+    ASSERT_TRUE(waitFor([&] { return doorbell.getLastOperation().signals_received == 15; }));
+    auto op = doorbell.getLastOperation();
+    EXPECT_EQ(op.signals_sent, 15u);
+    EXPECT_EQ(op.wakeups, 1u);
+    EXPECT_GT(op.max_wakeup_latency_us, 0.0);     // measured from the oldest pending ring
+    EXPECT_EQ(op.mode, "counter");
+
+    doorbell.closeDoorbell();
+    EXPECT_FALSE(doorbell.isActive());
+    EXPECT_EQ(doorbell.getFd(), -1);
+}
+
+TEST(EventFdTest, SemaphoreModeCountsEverySignal) {
+    EventFdConfig config;
+    config.semaphore = true;
+    EventFdManager doorbell(config);
+    ASSERT_TRUE(doorbell.createDoorbell());
+
+    for (int i = 0; i < 20; ++i) {
+        ASSERT_TRUE(doorbell.sendMessage("flush"));
+    }
+    ASSERT_TRUE(waitFor([&] { return doorbell.getLastOperation().signals_received == 20; }));
+
+    auto op = doorbell.getLastOperation();
+    EXPECT_EQ(op.mode, "semaphore");
+    EXPECT_GE(op.wakeups, 1u);
+    EXPECT_LE(op.wakeups, 20u);
+    EXPECT_GT(op.signals_per_s, 0.0);
+    EXPECT_NE(op.toJSON().find("\"avg_wakeup_latency_us\""), std::string::npos);
+}
+
+// Another process gets the descriptor over a unix socket and rings directly
+TEST(EventFdTest, DescriptorPassedWithScmRights) {
+    EventFdManager doorbell;
+    ASSERT_TRUE(doorbell.createDoorbell());
+
+    int sv[2];
+    ASSERT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sv), 0);
+
+    pid_t peer = fork();
+    ASSERT_NE(peer, -1);
+    if (peer == 0) {
+        close(sv[0]);
+        int fd = receiveFileDescriptor(sv[1]);
+        _exit(fd >= 0 && eventfd_write(fd, 3) == 0 ? 0 : 1);
+    }
+    close(sv[1]);
+    EXPECT_TRUE(sendFileDescriptor(sv[0], doorbell.getFd()));
+
+    int status = 0;
+    waitpid(peer, &status, 0);
+    close(sv[0]);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+
+    EXPECT_TRUE(waitFor([&] { return doorbell.getLastOperation().signals_received == 3; }));
+    EXPECT_EQ(doorbell.getLastOperation().signals_sent, 0u);   // nothing went through ring()
+}
+
+TEST(EventFdTest, RingRequiresActiveDoorbell) {
+    EventFdManager doorbell;
+    EXPECT_FALSE(doorbell.ring());
+    EXPECT_EQ(doorbell.getLastOperation().status, "error_invalid_state");
+}
+
+TEST(EventFdTest, CoordinatorSendRingsDoorbell) {
+    IPCCoordinator coordinator;
+    ASSERT_TRUE(coordinator.initialize());
+    ASSERT_TRUE(coordinator.startMechanism(IPCMechanism::EVENTFD));
+    EXPECT_TRUE(coordinator.sendMessage(IPCMechanism::EVENTFD, "new data ready"));
+
+    std::string detail = coordinator.getMechanismDetailJSON(IPCMechanism::EVENTFD);
+    EXPECT_NE(detail.find("\"type\":\"eventfd\""), std::string::npos);
+    EXPECT_NE(detail.find("\"signals_sent\":1"), std::string::npos);
+    EXPECT_NE(detail.find("\"doorbell\":{\"mode\":\"counter\"}"), std::string::npos);
+    EXPECT_TRUE(coordinator.stopMechanism(IPCMechanism::EVENTFD));
+    coordinator.shutdown();
+}
+
+// The shared memory busy-poll consumer can park on an eventfd instead of the futex
+TEST(EventFdTest, BusyPollConsumerSleepsOnDoorbell) {
+    SharedMemoryManager manager;
+    ASSERT_TRUE(manager.createSharedMemory());
+
+    BusyPollConfig config;
+    config.idle_budget_us = 100;      // give up spinning quickly
+    config.eventfd_wakeup = true;
+    ASSERT_TRUE(manager.startBusyPollConsumer(config));
+    EXPECT_NE(manager.getDoorbellFd(), -1);
+
+    for (int i = 0; i < 5; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        EXPECT_TRUE(manager.writeMessage("doorbell " + std::to_string(i)));
+    }
+
+    ASSERT_TRUE(waitFor([&] {
+        auto stats = manager.getBusyPollStats();
+        return stats.messages + stats.missed == 5;
+    }));
+    EXPECT_GT(manager.getBusyPollStats().futex_wakeups, 0u);   // woken by the doorbell
+
+    manager.stopBusyPollConsumer();
+    EXPECT_EQ(manager.getDoorbellFd(), -1);
+    manager.destroySharedMemory();
+}
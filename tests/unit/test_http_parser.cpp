@@ -0,0 +1,160 @@
+/**
+ * @file test_http_parser.cpp
+ * @brief Unit tests for the incremental HTTP request parser
+ */
+
+#include <gtest/gtest.h>
+#include "server/http_parser.h"
+#include <string>
+
+using namespace ipc_project;
+
+using Result = HTTPRequestParser::Result;
+
+TEST(HTTPParserTest, ParsesCompleteRequest) {
+    std::string raw = "POST /ipc/send?mode=fast HTTP/1.1\r\n"
+                      "Host: localhost\r\n"
+                      "Content-Type:application/json  \r\n"
+                      "Content-Length: 13\r\n"
+                      "\r\n"
+                      "{\"message\":1}";
+    HTTPRequestParser parser;
+    ASSERT_EQ(parser.feed(raw), Result::COMPLETE);
+
+    EXPECT_EQ(parser.method(), "POST");
+    EXPECT_EQ(parser.path(), "/ipc/send");
+    EXPECT_EQ(parser.query(), "mode=fast");
+    EXPECT_EQ(parser.version(), "HTTP/1.1");
+    EXPECT_EQ(parser.headerCount(), 3u);
+    EXPECT_EQ(parser.header("content-type"), "application/json");
+    EXPECT_EQ(parser.header("HOST"), "localhost");
+    EXPECT_EQ(parser.header("Missing"), "");
+    EXPECT_EQ(parser.body(), "{\"message\":1}");
+    EXPECT_EQ(parser.messageLength(), raw.size());
+
+    // Views point into the caller's buffer, nothing was copied
+    EXPECT_EQ(parser.path().data(), raw.data() + 5);
+    EXPECT_EQ(parser.body().data(), raw.data() + raw.size() - 13);
+}
+
+// Bytes arrive one at a time and the buffer moves between calls
+TEST(HTTPParserTest, ResumesAcrossPartialReads) {
+    std::string full = "GET /ipc/status HTTP/1.1\r\nAccept: */*\r\nContent-Length: 4\r\n\r\nbody";
+    HTTPRequestParser parser;
+    std::string received;
+    for (size_t i = 0; i < full.size(); ++i) {
+        received.push_back(full[i]);
+        std::string moved = received;   // simulates the receive buffer growing elsewhere
+        Result result = parser.feed(moved);
+        if (i + 1 < full.size()) {
+            ASSERT_EQ(result, Result::INCOMPLETE) << "at byte " << i;
+        } else {
+            ASSERT_EQ(result, Result::COMPLETE);
+            EXPECT_EQ(parser.path(), "/ipc/status");
+            EXPECT_EQ(parser.header("Accept"), "*/*");
+            EXPECT_EQ(parser.body(), "body");
+        }
+        EXPECT_EQ(parser.headersComplete(), i + 1 >= full.size() - 4);
+    }
+}
+
+TEST(HTTPParserTest, PipelinedRequestsParsedOneAtATime) {
+    std::string raw = "GET /a HTTP/1.1\r\n\r\nGET /b HTTP/1.1\r\nContent-Length: 2\r\n\r\nokGET /c";
+    HTTPRequestParser parser;
+    ASSERT_EQ(parser.feed(raw), Result::COMPLETE);
+    EXPECT_EQ(parser.path(), "/a");
+    std::string_view rest(raw);
+    rest.remove_prefix(parser.messageLength());
+
+    parser.reset();
+    ASSERT_EQ(parser.feed(rest), Result::COMPLETE);
+    EXPECT_EQ(parser.path(), "/b");
+    EXPECT_EQ(parser.body(), "ok");
+    rest.remove_prefix(parser.messageLength());
+
+    parser.reset();
+    EXPECT_EQ(parser.feed(rest), Result::INCOMPLETE);
+}
+
+TEST(HTTPParserTest, AcceptsBareLineFeedsAndLeadingBlankLines) {
+    HTTPRequestParser parser;
+    ASSERT_EQ(parser.feed("\r\nGET / HTTP/1.0\nX-Test: 1\n\n"), Result::COMPLETE);
+    EXPECT_EQ(parser.method(), "GET");
+    EXPECT_EQ(parser.version(), "HTTP/1.0");
+    EXPECT_EQ(parser.header("x-test"), "1");
+    EXPECT_EQ(parser.body(), "");
+}
+
+TEST(HTTPParserTest, RejectsMalformedRequests) {
+    const char* bad[] = {
+        "GET\r\n\r\n",                                            // no target
+        "GET /  HTTP/1.1\r\n\r\n",                                // empty version
+        "GET / FTP/1.0\r\n\r\n",                                  // not HTTP
+        "G(T / HTTP/1.1\r\n\r\n",                                 // bad method token
+        "GET / HTTP/1.1\r\nNoColon\r\n\r\n",
+        "GET / HTTP/1.1\r\nBad Name: x\r\n\r\n",
+        "GET / HTTP/1.1\r\nA: b\r\n folded\r\n\r\n",
+        "POST / HTTP/1.1\r\nContent-Length: 12a\r\n\r\n",
+        "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n",
+    };
+    for (const char* raw : bad) {
+        HTTPRequestParser parser;
+        EXPECT_EQ(parser.feed(raw), Result::ERROR) << raw;
+        EXPECT_STRNE(parser.error(), "");
+    }
+}
+
+// Ambiguous body framing is refused; an identical repeat is harmless
+TEST(HTTPParserTest, RejectsAmbiguousContentLength) {
+    HTTPRequestParser parser;
+    EXPECT_EQ(parser.feed("POST / HTTP/1.1\r\nContent-Length: 3\r\nContent-Length: 4\r\n\r\nabcd"), Result::ERROR);
+    EXPECT_STREQ(parser.error(), "conflicting content-length");
+
+    parser.reset();
+    EXPECT_EQ(parser.feed("POST / HTTP/1.1\r\nContent-Length: 4\r\nTransfer-Encoding: chunked\r\n\r\n"),
+              Result::ERROR);
+    EXPECT_STREQ(parser.error(), "transfer-encoding with content-length");
+
+    parser.reset();
+    EXPECT_EQ(parser.feed("POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\nContent-Length: 4\r\n\r\n"),
+              Result::ERROR);
+
+    parser.reset();
+    EXPECT_EQ(parser.feed("POST / HTTP/1.1\r\nContent-Length: 4\r\ncontent-length: 4\r\n\r\nabcd"),
+              Result::COMPLETE);
+    EXPECT_EQ(parser.body(), "abcd");
+}
+
+TEST(HTTPParserTest, EnforcesHeaderLimits) {
+    std::string many = "GET / HTTP/1.1\r\n";
+    for (size_t i = 0; i <= HTTPHeaderList::CAPACITY; ++i) {
+        many += "H" + std::to_string(i) + ": v\r\n";
+    }
+    many += "\r\n";
+    HTTPRequestParser parser;
+    EXPECT_EQ(parser.feed(many), Result::ERROR);
+
+    // Head that never ends stops at the size limit, not at the end of memory
+    std::string endless = "GET / HTTP/1.1\r\nX: " + std::string(HTTPRequestParser::MAX_HEAD_SIZE, 'a');
+    parser.reset();
+    EXPECT_EQ(parser.feed(endless), Result::ERROR);
+}
+
+TEST(HTTPParserTest, HeaderListCopiesViews) {
+    std::string raw = "GET / HTTP/1.1\r\nConnection: keep-alive\r\nAccept-Encoding: gzip\r\n\r\n";
+    HTTPRequestParser parser;
+    ASSERT_EQ(parser.feed(raw), Result::COMPLETE);
+
+    HTTPHeaderList headers;
+    parser.copyHeaders(headers);
+    EXPECT_EQ(headers.size(), 2u);
+    EXPECT_EQ(headers.get("accept-encoding"), "gzip");
+    EXPECT_TRUE(headers.contains("CONNECTION"));
+    EXPECT_FALSE(headers.contains("Host"));
+    size_t seen = 0;
+    for (const auto& header : headers) {
+        EXPECT_FALSE(header.name.empty());
+        seen++;
+    }
+    EXPECT_EQ(seen, 2u);
+}
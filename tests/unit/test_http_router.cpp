@@ -0,0 +1,80 @@
+/**
+ * @file test_http_router.cpp
+ * @brief Unit tests for the compile-time route table
+ */
+
+#include <gtest/gtest.h>
+#include "server/http_router.h"
+
+using namespace ipc_project;
+
+namespace {
+
+using Table = RouteTable<int, 6>;
+
+// Built entirely by the compiler: a seed without collisions must exist
+constexpr Table table(std::array<Table::Route, 6>{{
+    { "GET",  "/ipc/status",             1 },
+    { "POST", "/ipc/status",             2 },
+    { "POST", "/ipc/start/{mechanism}",  3 },
+    { "GET",  "/ipc/logs/{mechanism}",   4 },
+    { "GET",  "/ipc/logs",               5 },
+    { "GET",  "/",                       6 },
+}});
+
+static_assert(Table::SLOTS >= 12 && (Table::SLOTS & (Table::SLOTS - 1)) == 0);
+
+int lookup(std::string_view method, std::string_view path, RouteParams& params) {
+    const Table::Route* route = table.find(method, path, params);
+    return route ? route->handler : 0;
+}
+
+} // namespace
+
+TEST(HTTPRouterTest, ExactRoutesMatchMethodAndPath) {
+    RouteParams params;
+    EXPECT_EQ(lookup("GET", "/ipc/status", params), 1);
+    EXPECT_EQ(lookup("POST", "/ipc/status", params), 2);
+    EXPECT_EQ(lookup("GET", "/ipc/logs", params), 5);
+    EXPECT_EQ(lookup("GET", "/", params), 6);
+    EXPECT_EQ(params.size(), 0u);
+
+    EXPECT_EQ(lookup("DELETE", "/ipc/status", params), 0);
+    EXPECT_EQ(lookup("GET", "/ipc/statu", params), 0);
+    EXPECT_EQ(lookup("GET", "/ipc/status/", params), 0);
+    EXPECT_EQ(lookup("GET", "", params), 0);
+}
+
+TEST(HTTPRouterTest, ParameterCapturedAsViewIntoPath) {
+    std::string path = "/ipc/start/shared_memory";
+    RouteParams params;
+    ASSERT_EQ(lookup("POST", path, params), 3);
+
+    const std::string_view* mechanism = params.find("mechanism");
+    ASSERT_NE(mechanism, nullptr);
+    EXPECT_EQ(*mechanism, "shared_memory");
+    EXPECT_EQ(mechanism->data(), path.data() + 11);
+
+    RouteParams logs;
+    ASSERT_EQ(lookup("GET", "/ipc/logs/pipes", logs), 4);
+    EXPECT_EQ(*logs.find("mechanism"), "pipes");
+}
+
+TEST(HTTPRouterTest, ParameterMustBeOneNonEmptySegment) {
+    RouteParams params;
+    EXPECT_EQ(lookup("POST", "/ipc/start/", params), 0);
+    EXPECT_EQ(lookup("POST", "/ipc/start/pipes/extra", params), 0);
+    EXPECT_EQ(lookup("GET", "/ipc/start/pipes", params), 0);   // wrong method
+    EXPECT_EQ(lookup("POST", "/ipc/stop/pipes", params), 0);
+    EXPECT_EQ(params.find("mechanism"), nullptr);
+}
+
+TEST(HTTPRouterTest, RouteParamsFixedCapacity) {
+    RouteParams params;
+    params["a"] = "1";
+    params["a"] = "2";
+    EXPECT_EQ(params.size(), 1u);
+    EXPECT_EQ(*params.find("a"), "2");
+    for (int i = 0; i < 10; ++i) params[i % 2 ? "x" : "y"] = "v";
+    EXPECT_LE(params.size(), RouteParams::CAPACITY);
+}
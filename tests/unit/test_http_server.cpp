@@ -6,11 +6,158 @@
 #include <gtest/gtest.h>
 #include "server/http_server.h"
 #include "ipc/ipc_coordinator.h"
+#include "server/http_compression.h"
+#include <zlib.h>
 #include <thread>
 #include <chrono>
+#include <vector>
+#include <atomic>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <filesystem>
+#include <fstream>
 
 using namespace ipc_project;
 
+namespace {
+
+int connectLocal(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Lê uma resposta inteira (headers + Content-Length). 'pending' guarda o que
+// sobrou de respostas seguintes (pipelining)
+std::string readResponse(int fd, std::string& pending) {
+    char buffer[4096];
+    while (true) {
+        size_t header_end = pending.find("\r\n\r\n");
+        if (header_end != std::string::npos) {
+            size_t cl = pending.find("Content-Length: ");
+            size_t length = cl < header_end ? std::stoul(pending.substr(cl + 16)) : 0;
+            size_t total = header_end + 4 + length;
+            if (pending.size() >= total) {
+                std::string response = pending.substr(0, total);
+                pending.erase(0, total);
+                return response;
+            }
+        }
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) return "";
+        pending.append(buffer, static_cast<size_t>(n));
+    }
+}
+
+// Manda os pedaços com uma pausa entre eles e lê uma resposta
+std::string httpExchange(int port, const std::vector<std::string>& pieces, int pause_ms = 0) {
+    int fd = connectLocal(port);
+    if (fd < 0) return "";
+    for (const auto& piece : pieces) {
+        send(fd, piece.data(), piece.size(), MSG_NOSIGNAL);
+        if (pause_ms > 0) std::this_thread::sleep_for(std::chrono::milliseconds(pause_ms));
+    }
+    std::string pending;
+    std::string response = readResponse(fd, pending);
+    close(fd);
+    return response;
+}
+
+// Quantas vezes o header aparece (só na parte de headers da resposta)
+size_t headerCount(const std::string& response, const std::string& name) {
+    std::string headers = response.substr(0, response.find("\r\n\r\n"));
+    std::string needle = "\r\n" + name + ":";
+    size_t count = 0;
+    for (size_t at = headers.find(needle); at != std::string::npos; at = headers.find(needle, at + 1)) {
+        ++count;
+    }
+    return count;
+}
+
+// Descomprime gzip ou zlib (windowBits 15+32 detecta o formato)
+std::string inflateBody(const std::string& compressed) {
+    z_stream stream{};
+    if (inflateInit2(&stream, 15 + 32) != Z_OK) return "";
+    stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(compressed.data()));
+    stream.avail_in = static_cast<uInt>(compressed.size());
+    std::string output;
+    char chunk[16384];
+    int result = Z_OK;
+    while (result == Z_OK) {
+        stream.next_out = reinterpret_cast<Bytef*>(chunk);
+        stream.avail_out = sizeof(chunk);
+        result = inflate(&stream, Z_NO_FLUSH);
+        output.append(chunk, sizeof(chunk) - stream.avail_out);
+    }
+    inflateEnd(&stream);
+    return result == Z_STREAM_END ? output : "";
+}
+
+std::string responseBody(const std::string& response) {
+    size_t header_end = response.find("\r\n\r\n");
+    return header_end == std::string::npos ? "" : response.substr(header_end + 4);
+}
+
+// Servidor fechou a conexão (recv devolve EOF)
+bool peerClosed(int fd) {
+    char byte;
+    return recv(fd, &byte, 1, 0) == 0;
+}
+
+// Frame de cliente: sempre mascarado (RFC 6455 5.3)
+std::string clientFrame(const std::string& payload, uint8_t opcode) {
+    const uint8_t mask[4] = {0x12, 0x34, 0x56, 0x78};
+    std::string frame;
+    frame.push_back(static_cast<char>(0x80 | opcode));
+    frame.push_back(static_cast<char>(0x80 | payload.size()));   // testes só usam < 126
+    frame.append(reinterpret_cast<const char*>(mask), 4);
+    for (size_t i = 0; i < payload.size(); ++i) {
+        frame.push_back(static_cast<char>(payload[i] ^ mask[i & 3]));
+    }
+    return frame;
+}
+
+// Lê um frame do servidor (sem máscara). opcode -1 = conexão caiu
+int readFrame(int fd, std::string& pending, std::string& payload) {
+    char buffer[4096];
+    while (true) {
+        if (pending.size() >= 2) {
+            size_t length = static_cast<uint8_t>(pending[1]) & 0x7F;
+            size_t header = 2;
+            if (length == 126 && pending.size() >= 4) {
+                length = (static_cast<uint8_t>(pending[2]) << 8) | static_cast<uint8_t>(pending[3]);
+                header = 4;
+            } else if (length == 127 && pending.size() >= 10) {
+                length = 0;
+                for (size_t i = 2; i < 10; ++i) length = (length << 8) | static_cast<uint8_t>(pending[i]);
+                header = 10;
+            }
+            if (length < 126 || header > 2) {
+                if (pending.size() >= header + length) {
+                    int opcode = static_cast<uint8_t>(pending[0]) & 0x0F;
+                    payload = pending.substr(header, length);
+                    pending.erase(0, header + length);
+                    return opcode;
+                }
+            }
+        }
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n <= 0) return -1;
+        pending.append(buffer, static_cast<size_t>(n));
+    }
+}
+
+} // namespace
+
 class HTTPServerTest : public ::testing::Test {
 protected:
     void SetUp() override {
@@ -225,4 +372,677 @@ TEST_F(HTTPServerTest, ServerConfiguration) {
     
     server->stop();
     EXPECT_FALSE(server->isRunning());
-}
\ No newline at end of file
+}
+// Muitos clientes ao mesmo tempo são atendidos pelo pool fixo de workers
+TEST_F(HTTPServerTest, ConcurrentClientsShareWorkerPool) {
+    server->setWorkerThreads(2);
+    ASSERT_TRUE(server->start());
+    EXPECT_EQ(server->getWorkerThreads(), 2u);
+    
+    constexpr int CLIENTS = 64;
+    std::atomic<int> ok{0};
+    std::vector<std::thread> clients;
+    for (int i = 0; i < CLIENTS; ++i) {
+        clients.emplace_back([&] {
+            std::string response = httpExchange(server->getPort(), {"GET /ipc/status HTTP/1.1\r\nHost: x\r\n\r\n"});
+            if (response.find("HTTP/1.1 200") == 0 && response.find("\"mechanisms\"") != std::string::npos) ok++;
+        });
+    }
+    for (auto& client : clients) client.join();
+    
+    EXPECT_EQ(ok, CLIENTS);
+    EXPECT_EQ(server->getRequestCount(), static_cast<size_t>(CLIENTS));
+}
+
+// Requisição chegando aos pedaços (headers e body separados) é remontada pelo reactor
+TEST_F(HTTPServerTest, PartialRequestIsReassembled) {
+    ASSERT_TRUE(coordinator->startMechanism(IPCMechanism::PIPES));
+    ASSERT_TRUE(server->start());
+    
+    std::string body = R"({"mechanism":"pipes","message":"aos pedacos"})";
+    std::string response = httpExchange(server->getPort(), {
+        "POST /ipc/send HTTP/1.1\r\nHost: x\r\n",
+        "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n",
+        body.substr(0, 10),
+        body.substr(10)
+    }, 20);
+    
+    EXPECT_EQ(response.find("HTTP/1.1 200"), 0u) << response;
+    EXPECT_NE(response.find("Message sent via pipes"), std::string::npos);
+}
+
+// Um cliente parado no meio da requisição não segura os outros
+TEST_F(HTTPServerTest, IdleClientDoesNotBlockOthers) {
+    server->setWorkerThreads(1);
+    ASSERT_TRUE(server->start());
+    
+    int idle = connectLocal(server->getPort());
+    ASSERT_GE(idle, 0);
+    std::string partial = "GET /ipc/status HTTP/1.1\r\n";
+    send(idle, partial.data(), partial.size(), 0);
+    
+    std::string response = httpExchange(server->getPort(), {"GET /ipc/status HTTP/1.1\r\n\r\n"});
+    EXPECT_EQ(response.find("HTTP/1.1 200"), 0u);
+    EXPECT_GE(server->getActiveConnections(), 1u);
+    
+    close(idle);
+    server->stop();
+    EXPECT_EQ(server->getActiveConnections(), 0u);
+}
+
+// Várias requisições na mesma conexão, uma depois da outra
+TEST_F(HTTPServerTest, KeepAliveReusesConnection) {
+    ASSERT_TRUE(server->start());
+    int fd = connectLocal(server->getPort());
+    ASSERT_GE(fd, 0);
+    
+    std::string pending;
+    std::string request = "GET /ipc/status HTTP/1.1\r\nHost: x\r\n\r\n";
+    for (int i = 0; i < 3; ++i) {
+        send(fd, request.data(), request.size(), 0);
+        std::string response = readResponse(fd, pending);
+        EXPECT_EQ(response.find("HTTP/1.1 200"), 0u);
+        EXPECT_NE(response.find("Connection: keep-alive"), std::string::npos);
+        EXPECT_NE(response.find("Keep-Alive: timeout=5, max=" + std::to_string(99 - i)), std::string::npos);
+    }
+    EXPECT_EQ(server->getRequestCount(), 3u);
+    EXPECT_EQ(server->getActiveConnections(), 1u);
+    close(fd);
+}
+
+// Requisições pipelined num único write são respondidas na ordem
+TEST_F(HTTPServerTest, PipelinedRequestsAnsweredInOrder) {
+    ASSERT_TRUE(coordinator->startMechanism(IPCMechanism::PIPES));
+    ASSERT_TRUE(server->start());
+    int fd = connectLocal(server->getPort());
+    ASSERT_GE(fd, 0);
+    
+    std::string body = R"({"mechanism":"pipes","message":"pipelined"})";
+    std::string batch =
+        "POST /ipc/send HTTP/1.1\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body +
+        "GET /ipc/detail/pipes HTTP/1.1\r\n\r\n"
+        "GET /nao/existe HTTP/1.1\r\n\r\n"
+        "GET /ipc/status HTTP/1.1\r\nConnection: close\r\n\r\n";
+    send(fd, batch.data(), batch.size(), 0);
+    
+    std::string pending;
+    std::string first = readResponse(fd, pending);
+    std::string second = readResponse(fd, pending);
+    std::string third = readResponse(fd, pending);
+    std::string fourth = readResponse(fd, pending);
+    EXPECT_NE(first.find("Message sent via pipes"), std::string::npos);
+    EXPECT_NE(second.find("\"mechanism\":\"pipes\""), std::string::npos);
+    EXPECT_EQ(third.find("HTTP/1.1 404"), 0u);
+    EXPECT_NE(fourth.find("Connection: close"), std::string::npos);
+    EXPECT_TRUE(pending.empty());
+    EXPECT_TRUE(peerClosed(fd));
+    close(fd);
+}
+
+// Limite de requisições por conexão e HTTP/1.0 sem keep-alive fecham a conexão
+TEST_F(HTTPServerTest, KeepAliveLimits) {
+    server->setKeepAlive(true, 5000, 2);
+    ASSERT_TRUE(server->start());
+    
+    int fd = connectLocal(server->getPort());
+    ASSERT_GE(fd, 0);
+    std::string pending;
+    std::string request = "GET /ipc/status HTTP/1.1\r\n\r\n";
+    send(fd, request.data(), request.size(), 0);
+    EXPECT_NE(readResponse(fd, pending).find("Connection: keep-alive"), std::string::npos);
+    send(fd, request.data(), request.size(), 0);
+    EXPECT_NE(readResponse(fd, pending).find("Connection: close"), std::string::npos);
+    EXPECT_TRUE(peerClosed(fd));
+    close(fd);
+    
+    std::string response = httpExchange(server->getPort(), {"GET /ipc/status HTTP/1.0\r\n\r\n"});
+    EXPECT_NE(response.find("Connection: close"), std::string::npos);
+}
+
+// Conexão persistente ociosa é fechada depois do timeout
+TEST_F(HTTPServerTest, IdleKeepAliveConnectionTimesOut) {
+    server->setKeepAlive(true, 500, 100);
+    ASSERT_TRUE(server->start());
+    int fd = connectLocal(server->getPort());
+    ASSERT_GE(fd, 0);
+    
+    std::string pending;
+    std::string request = "GET /ipc/status HTTP/1.1\r\n\r\n";
+    send(fd, request.data(), request.size(), 0);
+    ASSERT_FALSE(readResponse(fd, pending).empty());
+    
+    timeval timeout = { 3, 0 };
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    EXPECT_TRUE(peerClosed(fd));
+    EXPECT_EQ(server->getActiveConnections(), 0u);
+    close(fd);
+}
+
+// Servidor usando o executor do coordenador em vez de um pool próprio
+TEST_F(HTTPServerTest, SharedExecutorStats) {
+    server->setExecutor(coordinator->getExecutor());
+    ASSERT_TRUE(server->start());
+    EXPECT_EQ(server->getWorkerThreads(), coordinator->getExecutor()->threadCount());
+    
+    std::string response = httpExchange(server->getPort(), {"GET /ipc/executor HTTP/1.1\r\n\r\n"});
+    EXPECT_EQ(response.find("HTTP/1.1 200"), 0u);
+    EXPECT_NE(response.find("\"workers\":[{\"index\":0"), std::string::npos);
+    
+    // Parar o servidor não derruba o pool compartilhado
+    server->stop();
+    EXPECT_TRUE(coordinator->getExecutor()->isRunning());
+    
+    // executed sobe depois da resposta sair: o join dos workers assenta o contador
+    coordinator->getExecutor()->shutdown();
+    EXPECT_GE(coordinator->getExecutor()->getStats().executed, 1u);
+}
+
+// Shards com SO_REUSEPORT: vários listeners na mesma porta, o kernel reparte as conexões
+TEST_F(HTTPServerTest, ReusePortShardsSplitConnections) {
+    server->setShards(4);
+    ASSERT_TRUE(server->start());
+    EXPECT_EQ(server->getShardCount(), 4u);
+    
+    constexpr int CLIENTS = 64;
+    std::atomic<int> ok{0};
+    std::vector<std::thread> clients;
+    for (int i = 0; i < CLIENTS; ++i) {
+        clients.emplace_back([&] {
+            std::string response = httpExchange(server->getPort(), {"GET /ipc/status HTTP/1.1\r\nConnection: close\r\n\r\n"});
+            if (response.find("HTTP/1.1 200") == 0) ok++;
+        });
+    }
+    for (auto& client : clients) client.join();
+    
+    EXPECT_EQ(ok, CLIENTS);
+    EXPECT_EQ(server->getRequestCount(), static_cast<size_t>(CLIENTS));
+    
+    auto accepts = server->getShardAccepts();
+    ASSERT_EQ(accepts.size(), 4u);
+    size_t total = 0, used = 0;
+    for (size_t count : accepts) {
+        total += count;
+        if (count > 0) used++;
+    }
+    EXPECT_EQ(total, static_cast<size_t>(CLIENTS));
+    EXPECT_GT(used, 1u);
+    
+    server->stop();
+    EXPECT_EQ(server->getActiveConnections(), 0u);
+}
+
+// Estáticos: cache em memória com ETag/304, arquivo grande por sendfile
+TEST_F(HTTPServerTest, StaticCacheWithConditionalRequests) {
+    namespace fs = std::filesystem;
+    fs::path dir = fs::temp_directory_path() / ("ipc_static_" + std::to_string(getpid()));
+    fs::create_directories(dir / "css");
+    std::ofstream(dir / "index.html") << "<html>dashboard</html>";
+    std::ofstream(dir / "css" / "app.css") << "body{}";
+    std::string big(1'500'000, 'x');
+    std::ofstream(dir / "big.js", std::ios::binary) << big;
+    
+    server->setStaticPath(dir.string());
+    ASSERT_TRUE(server->start());
+    
+    int fd = connectLocal(server->getPort());
+    ASSERT_GE(fd, 0);
+    std::string pending;
+    auto exchange = [&](const std::string& request) {
+        send(fd, request.data(), request.size(), MSG_NOSIGNAL);
+        return readResponse(fd, pending);
+    };
+    
+    std::string first = exchange("GET / HTTP/1.1\r\n\r\n");
+    EXPECT_EQ(first.find("HTTP/1.1 200"), 0u);
+    EXPECT_NE(first.find("Content-Type: text/html"), std::string::npos);
+    EXPECT_NE(first.find("Last-Modified: "), std::string::npos);
+    EXPECT_NE(first.find("<html>dashboard</html>"), std::string::npos);
+    EXPECT_EQ(headerCount(first, "Cache-Control"), 1u);
+    EXPECT_NE(first.find("Cache-Control: no-cache\r\n"), std::string::npos);
+    EXPECT_EQ(first.find("no-store"), std::string::npos);
+    size_t etag_pos = first.find("ETag: ");
+    ASSERT_NE(etag_pos, std::string::npos);
+    std::string etag = first.substr(etag_pos + 6, first.find("\r\n", etag_pos) - etag_pos - 6);
+    
+    // Mesma versão: 304 sem corpo, e a conexão continua utilizável
+    std::string revalidated = exchange("GET /index.html HTTP/1.1\r\nIf-None-Match: " + etag + "\r\n\r\n");
+    EXPECT_EQ(revalidated.find("HTTP/1.1 304 Not Modified"), 0u);
+    EXPECT_EQ(revalidated.find("Content-Length"), std::string::npos);
+    EXPECT_EQ(revalidated.find("dashboard"), std::string::npos);
+    
+    std::string other_etag = exchange("GET /index.html HTTP/1.1\r\nIf-None-Match: \"0-0\"\r\n\r\n");
+    EXPECT_EQ(other_etag.find("HTTP/1.1 200"), 0u);
+    
+    std::string css = exchange("GET /css/app.css HTTP/1.1\r\n\r\n");
+    EXPECT_NE(css.find("Content-Type: text/css"), std::string::npos);
+    EXPECT_NE(css.find("body{}"), std::string::npos);
+    
+    // Fora do cache (grande demais): corpo inteiro via sendfile
+    std::string large = exchange("GET /big.js HTTP/1.1\r\n\r\n");
+    EXPECT_EQ(large.find("HTTP/1.1 200"), 0u);
+    EXPECT_NE(large.find("Content-Length: 1500000"), std::string::npos);
+    EXPECT_EQ(large.size() - (large.find("\r\n\r\n") + 4), big.size());
+    EXPECT_EQ(headerCount(large, "Cache-Control"), 1u);
+    
+    EXPECT_EQ(exchange("GET /../etc/passwd HTTP/1.1\r\n\r\n").find("HTTP/1.1 404"), 0u);
+    close(fd);
+    
+    std::string stats = server->getStaticStatsJSON();
+    EXPECT_NE(stats.find("\"cached_files\":2"), std::string::npos);
+    EXPECT_NE(stats.find("\"hits\":3"), std::string::npos);
+    EXPECT_NE(stats.find("\"not_modified\":1"), std::string::npos);
+    EXPECT_NE(stats.find("\"sendfile\":1"), std::string::npos);
+    
+    server->stop();
+    fs::remove_all(dir);
+}
+
+TEST(HTTPCompressionTest, NegotiatesAcceptEncoding) {
+    EXPECT_EQ(negotiateEncoding(""), ContentEncoding::IDENTITY);
+    EXPECT_EQ(negotiateEncoding("gzip, deflate, br"), ContentEncoding::GZIP);
+    EXPECT_EQ(negotiateEncoding("deflate"), ContentEncoding::DEFLATE);
+    EXPECT_EQ(negotiateEncoding("gzip;q=0.5, deflate;q=0.9"), ContentEncoding::DEFLATE);
+    EXPECT_EQ(negotiateEncoding("gzip;q=0, deflate;q=0"), ContentEncoding::IDENTITY);
+    EXPECT_EQ(negotiateEncoding("*"), ContentEncoding::GZIP);
+    EXPECT_EQ(negotiateEncoding("br, *;q=0"), ContentEncoding::IDENTITY);
+    
+    EXPECT_TRUE(isCompressible("application/json"));
+    EXPECT_TRUE(isCompressible("text/css"));
+    EXPECT_FALSE(isCompressible("image/png"));
+    
+    std::string text(4096, 'a');
+    std::string compressed;
+    ASSERT_TRUE(compressBody(text, ContentEncoding::GZIP, compressed));
+    EXPECT_LT(compressed.size(), text.size());
+    EXPECT_EQ(inflateBody(compressed), text);
+    ASSERT_TRUE(compressBody(text, ContentEncoding::DEFLATE, compressed));
+    EXPECT_EQ(inflateBody(compressed), text);
+    // Não compensa: entrada curta/aleatória fica como está
+    EXPECT_FALSE(compressBody("ab", ContentEncoding::GZIP, compressed));
+}
+
+// Estáticos pré-comprimidos (ETag por codificação) e JSON grande comprimido na hora
+TEST_F(HTTPServerTest, CompressesStaticAndDynamicResponses) {
+    namespace fs = std::filesystem;
+    fs::path dir = fs::temp_directory_path() / ("ipc_gzip_" + std::to_string(getpid()));
+    fs::create_directories(dir);
+    std::string script;
+    for (int i = 0; i < 200; ++i) script += "function f" + std::to_string(i) + "() { return " + std::to_string(i) + "; }\n";
+    std::ofstream(dir / "script.js") << script;
+    
+    server->setStaticPath(dir.string());
+    server->setCompression(true, 256);
+    ASSERT_TRUE(server->start());
+    int port = server->getPort();
+    
+    std::string plain = httpExchange(port, {"GET /script.js HTTP/1.1\r\n\r\n"});
+    EXPECT_EQ(plain.find("Content-Encoding"), std::string::npos);
+    EXPECT_NE(plain.find("Vary: Accept-Encoding"), std::string::npos);
+    EXPECT_EQ(responseBody(plain), script);
+    
+    std::string gzipped = httpExchange(port, {"GET /script.js HTTP/1.1\r\nAccept-Encoding: gzip, deflate\r\n\r\n"});
+    EXPECT_NE(gzipped.find("Content-Encoding: gzip"), std::string::npos);
+    EXPECT_LT(responseBody(gzipped).size(), script.size());
+    EXPECT_EQ(inflateBody(responseBody(gzipped)), script);
+    
+    // 304 confere o ETag da versão comprimida
+    size_t etag_pos = gzipped.find("ETag: ");
+    ASSERT_NE(etag_pos, std::string::npos);
+    std::string etag = gzipped.substr(etag_pos + 6, gzipped.find("\r\n", etag_pos) - etag_pos - 6);
+    EXPECT_NE(etag.find("-gzip"), std::string::npos);
+    std::string revalidated = httpExchange(port, {"GET /script.js HTTP/1.1\r\nAccept-Encoding: gzip\r\nIf-None-Match: " + etag + "\r\n\r\n"});
+    EXPECT_EQ(revalidated.find("HTTP/1.1 304"), 0u);
+    
+    std::string deflated = httpExchange(port, {"GET /script.js HTTP/1.1\r\nAccept-Encoding: deflate\r\n\r\n"});
+    EXPECT_NE(deflated.find("Content-Encoding: deflate"), std::string::npos);
+    EXPECT_EQ(inflateBody(responseBody(deflated)), script);
+    
+    // Status com 7 mecanismos passa do limite de 256 bytes
+    std::string status = httpExchange(port, {"GET /ipc/status HTTP/1.1\r\nAccept-Encoding: gzip\r\n\r\n"});
+    EXPECT_NE(status.find("Content-Encoding: gzip"), std::string::npos);
+    EXPECT_NE(inflateBody(responseBody(status)).find("\"mechanisms\""), std::string::npos);
+    
+    std::string stats = server->getStaticStatsJSON();
+    EXPECT_NE(stats.find("\"compressed_responses\":1"), std::string::npos);
+    
+    server->stop();
+    fs::remove_all(dir);
+}
+
+// Requisição malformada vira 400 e a conexão fecha; no pipeline, as anteriores são respondidas
+TEST_F(HTTPServerTest, MalformedRequestGets400) {
+    ASSERT_TRUE(server->start());
+    
+    std::string response = httpExchange(server->getPort(), {"BROKEN\r\n\r\n"});
+    EXPECT_EQ(response.find("HTTP/1.1 400"), 0u);
+    EXPECT_NE(response.find("Connection: close"), std::string::npos);
+    
+    int fd = connectLocal(server->getPort());
+    ASSERT_GE(fd, 0);
+    std::string pipeline = "GET /ipc/status?verbose=1 HTTP/1.1\r\n\r\nGET / HTTP/1.1\r\nBad Header\r\n\r\n";
+    send(fd, pipeline.data(), pipeline.size(), MSG_NOSIGNAL);
+    std::string pending;
+    EXPECT_EQ(readResponse(fd, pending).find("HTTP/1.1 200"), 0u);   // query não atrapalha a rota
+    EXPECT_EQ(readResponse(fd, pending).find("HTTP/1.1 400"), 0u);
+    EXPECT_TRUE(peerClosed(fd));
+    close(fd);
+    
+    // Content-Length repetido com valores diferentes deixa o fim do body ambíguo
+    std::string smuggled = httpExchange(server->getPort(), {
+        "POST /ipc/send HTTP/1.1\r\nContent-Length: 2\r\nContent-Length: 30\r\n\r\n{}"});
+    EXPECT_EQ(smuggled.find("HTTP/1.1 400"), 0u);
+    EXPECT_NE(smuggled.find("conflicting content-length"), std::string::npos);
+}
+
+// Body do /ipc/send passa pelo parser JSON: ordem, espaços e escapes livres
+TEST_F(HTTPServerTest, SendBodyParsedAsJSON) {
+    ASSERT_TRUE(coordinator->startMechanism(IPCMechanism::PIPES));
+    ASSERT_TRUE(server->start());
+
+    auto post = [&](const std::string& body) {
+        return httpExchange(server->getPort(), {
+            "POST /ipc/send HTTP/1.1\r\nConnection: close\r\nContent-Length: " +
+            std::to_string(body.size()) + "\r\n\r\n" + body});
+    };
+
+    std::string ok = post("{ \"message\" : \"aspas \\\"aqui\\\" e\\nquebra\\u00e9\",\n"
+                          "  \"priority\": \"bulk\", \"mechanism\" : \"pipes\" }");
+    EXPECT_EQ(ok.find("HTTP/1.1 200"), 0u) << ok;
+    EXPECT_NE(ok.find("Message sent via pipes"), std::string::npos);
+
+    std::string broken = post(R"({"mechanism":"pipes","message":"sem fim)");
+    EXPECT_EQ(broken.find("HTTP/1.1 400"), 0u);
+    EXPECT_NE(broken.find("Invalid JSON body"), std::string::npos);
+
+    std::string wrong_type = post(R"({"mechanism":"pipes","message":123})");
+    EXPECT_EQ(wrong_type.find("HTTP/1.1 400"), 0u);
+    EXPECT_NE(wrong_type.find("must be a string"), std::string::npos);
+
+    std::string missing = post(R"({"mechanism":"pipes"})");
+    EXPECT_NE(missing.find("Missing mechanism or message"), std::string::npos);
+}
+
+// Codec do WebSocket: chave do handshake (exemplo do RFC 6455) e os três tamanhos de frame
+TEST(WebSocketProtocolTest, HandshakeKeyAndFrameCodec) {
+    EXPECT_EQ(WebSocketServer::acceptKey("dGhlIHNhbXBsZSBub25jZQ=="), "s3pPLMBiTxaQ9kYGzzhZRbK+xOo=");
+
+    EXPECT_EQ(WebSocketServer::encodeFrame(std::string(125, 'a')).size(), 2u + 125);
+    std::string medium = WebSocketServer::encodeFrame(std::string(126, 'a'));
+    EXPECT_EQ(medium.size(), 4u + 126);
+    EXPECT_EQ(static_cast<uint8_t>(medium[1]), 126);
+    std::string large = WebSocketServer::encodeFrame(std::string(65536, 'a'), WebSocketOpcode::BINARY);
+    EXPECT_EQ(large.size(), 10u + 65536);
+    EXPECT_EQ(static_cast<uint8_t>(large[0]), 0x82);
+    EXPECT_EQ(static_cast<uint8_t>(large[1]), 127);
+
+    // Frame mascarado do cliente volta ao texto original
+    WebSocketFrame frame;
+    std::string ping = clientFrame("ola", 0x9);
+    EXPECT_EQ(WebSocketServer::decodeFrame(ping.substr(0, 4), frame, 1024), WebSocketServer::DecodeResult::INCOMPLETE);
+    ASSERT_EQ(WebSocketServer::decodeFrame(ping + "resto", frame, 1024), WebSocketServer::DecodeResult::COMPLETE);
+    EXPECT_EQ(frame.opcode, WebSocketOpcode::PING);
+    EXPECT_EQ(frame.payload, "ola");
+    EXPECT_EQ(frame.length, ping.size());
+
+    // Sem máscara, controle grande demais ou opcode reservado: erro de protocolo
+    EXPECT_EQ(WebSocketServer::decodeFrame(WebSocketServer::encodeFrame("x"), frame, 1024),
+              WebSocketServer::DecodeResult::ERROR);
+    std::string big_ping = clientFrame("", 0x9);
+    big_ping[1] = static_cast<char>(0x80 | 126);
+    big_ping.insert(2, std::string("\x00\x80", 2));
+    EXPECT_EQ(WebSocketServer::decodeFrame(big_ping, frame, 1024), WebSocketServer::DecodeResult::ERROR);
+    EXPECT_EQ(WebSocketServer::decodeFrame(clientFrame("x", 0x3), frame, 1024), WebSocketServer::DecodeResult::ERROR);
+    EXPECT_EQ(WebSocketServer::decodeFrame(clientFrame("grande", 0x1), frame, 4), WebSocketServer::DecodeResult::TOO_LARGE);
+}
+
+// Upgrade em /ws: 101 + snapshot, eventos empurrados na hora, ping/pong e close
+TEST_F(HTTPServerTest, WebSocketPushesSnapshotAndEvents) {
+    ASSERT_TRUE(server->start());
+
+    std::string bad = httpExchange(server->getPort(), {"GET /ws HTTP/1.1\r\nUpgrade: websocket\r\n"
+                                                       "Connection: Upgrade\r\nSec-WebSocket-Version: 13\r\n\r\n"});
+    EXPECT_EQ(bad.find("HTTP/1.1 400"), 0u);
+
+    int fd = connectLocal(server->getPort());
+    ASSERT_GE(fd, 0);
+    timeval timeout{5, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    std::string handshake = "GET /ws HTTP/1.1\r\nHost: localhost\r\nUpgrade: websocket\r\n"
+                            "Connection: keep-alive, Upgrade\r\nSec-WebSocket-Key: dGhlIHNhbXBsZSBub25jZQ==\r\n"
+                            "Sec-WebSocket-Version: 13\r\n\r\n";
+    send(fd, handshake.data(), handshake.size(), MSG_NOSIGNAL);
+    std::string pending;
+    std::string response = readResponse(fd, pending);
+    EXPECT_EQ(response.find("HTTP/1.1 101 Switching Protocols"), 0u) << response;
+    EXPECT_NE(response.find("Sec-WebSocket-Accept: s3pPLMBiTxaQ9kYGzzhZRbK+xOo="), std::string::npos);
+    EXPECT_EQ(response.find("Content-Length"), std::string::npos);
+
+    std::string payload;
+    ASSERT_EQ(readFrame(fd, pending, payload), 0x1);
+    EXPECT_NE(payload.find("\"type\":\"snapshot\""), std::string::npos);
+    EXPECT_NE(payload.find("\"details\":{\"pipes\""), std::string::npos);
+    EXPECT_EQ(server->getWebSocketClients(), 1u);
+
+    // Evento do coordenador chega sem ninguém perguntar
+    ASSERT_TRUE(coordinator->startMechanism(IPCMechanism::PIPES));
+    bool got_event = false;
+    for (int i = 0; i < 20 && !got_event; ++i) {
+        if (readFrame(fd, pending, payload) != 0x1) break;
+        got_event = payload.find("\"type\":\"events\"") != std::string::npos &&
+                    payload.find("\"type\":\"started\"") != std::string::npos;
+    }
+    EXPECT_TRUE(got_event);
+
+    // Ping vira pong com o mesmo payload (frames de status podem vir antes)
+    std::string ping = clientFrame("vivo?", 0x9);
+    send(fd, ping.data(), ping.size(), MSG_NOSIGNAL);
+    int opcode = 0;
+    for (int i = 0; i < 20; ++i) {
+        opcode = readFrame(fd, pending, payload);
+        if (opcode != 0x1) break;
+    }
+    EXPECT_EQ(opcode, 0xA);
+    EXPECT_EQ(payload, "vivo?");
+
+    // Close é ecoado e o servidor fecha
+    std::string close_frame = clientFrame(std::string("\x03\xe8", 2), 0x8);
+    send(fd, close_frame.data(), close_frame.size(), MSG_NOSIGNAL);
+    for (int i = 0; i < 20; ++i) {
+        opcode = readFrame(fd, pending, payload);
+        if (opcode != 0x1) break;
+    }
+    EXPECT_EQ(opcode, 0x8);
+    EXPECT_EQ(payload, std::string("\x03\xe8", 2));
+    EXPECT_EQ(readFrame(fd, pending, payload), -1);
+    close(fd);
+}
+
+// /ipc/events: eventos chegam como SSE com id; reconectar com Last-Event-ID
+// reenvia só o que veio depois
+TEST_F(HTTPServerTest, EventStreamResumesWithLastEventID) {
+    ASSERT_TRUE(server->start());
+
+    auto openStream = [&](const std::string& extra_headers) {
+        int fd = connectLocal(server->getPort());
+        timeval timeout{5, 0};
+        setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        std::string request = "GET /ipc/events HTTP/1.1\r\nAccept: text/event-stream\r\n" + extra_headers + "\r\n";
+        send(fd, request.data(), request.size(), MSG_NOSIGNAL);
+        return fd;
+    };
+    // Lê até o texto aparecer (ou o timeout)
+    auto readUntil = [](int fd, std::string& stream, const std::string& needle) {
+        char buffer[4096];
+        while (stream.find(needle) == std::string::npos) {
+            ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+            if (n <= 0) return false;
+            stream.append(buffer, static_cast<size_t>(n));
+        }
+        return true;
+    };
+
+    int fd = openStream("");
+    ASSERT_GE(fd, 0);
+    std::string stream;
+    ASSERT_TRUE(readUntil(fd, stream, "retry: "));
+    EXPECT_EQ(stream.find("HTTP/1.1 200"), 0u);
+    EXPECT_NE(stream.find("Content-Type: text/event-stream"), std::string::npos);
+    EXPECT_EQ(stream.find("Content-Length"), std::string::npos);
+    for (int i = 0; i < 50 && server->getEventStreamClients() == 0; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(server->getEventStreamClients(), 1u);
+
+    ASSERT_TRUE(coordinator->startMechanism(IPCMechanism::PIPES));
+    ASSERT_TRUE(readUntil(fd, stream, "event: started\n"));
+    size_t id_at = stream.rfind("id: ", stream.find("event: started\n"));
+    ASSERT_NE(id_at, std::string::npos);
+    std::string started_id = stream.substr(id_at + 4, stream.find('\n', id_at) - id_at - 4);
+    EXPECT_NE(stream.find("data: {\"id\":" + started_id + ",\"mechanism\":\"pipes\",\"type\":\"started\""),
+              std::string::npos);
+
+    coordinator->stopMechanism(IPCMechanism::PIPES);
+    ASSERT_TRUE(readUntil(fd, stream, "event: stopped\n"));
+    close(fd);
+
+    // Retoma depois do "started": vem o "stopped" de novo, o "started" não
+    fd = openStream("Last-Event-ID: " + started_id + "\r\n");
+    std::string resumed;
+    ASSERT_TRUE(readUntil(fd, resumed, "event: stopped\n"));
+    EXPECT_EQ(resumed.find("event: started\n"), std::string::npos);
+    close(fd);
+
+    // Id que o servidor nunca deu (restart): resync em vez de silêncio
+    fd = openStream("Last-Event-ID: 999999\r\n");
+    std::string reset;
+    EXPECT_TRUE(readUntil(fd, reset, "event: resync\n"));
+    close(fd);
+}
+
+// Polling do estado: mesma versão = mesmo buffer e 304; mudança = ETag novo
+TEST_F(HTTPServerTest, StatusSnapshotsCarryVersionETag) {
+    auto first = coordinator->getStatusSnapshot();
+    auto again = coordinator->getStatusSnapshot();
+    EXPECT_EQ(first.json, again.json);          // compartilhado, sem remontar
+    EXPECT_EQ(first.etag, again.etag);
+    EXPECT_EQ(first.etag.rfind("W/\"status-", 0), 0u);
+    
+    // Outra instância (restart) na mesma versão não pode repetir o ETag
+    IPCCoordinator rebooted;
+    auto after_restart = rebooted.getStatusSnapshot();
+    EXPECT_EQ(after_restart.version, first.version);
+    EXPECT_NE(after_restart.etag, first.etag);
+
+    ASSERT_TRUE(server->start());
+    int port = server->getPort();
+    auto etagOf = [](const std::string& response) {
+        size_t at = response.find("ETag: ");
+        if (at == std::string::npos) return std::string();
+        return response.substr(at + 6, response.find("\r\n", at) - at - 6);
+    };
+
+    std::string status = httpExchange(port, {"GET /ipc/status HTTP/1.1\r\n\r\n"});
+    EXPECT_EQ(status.find("HTTP/1.1 200"), 0u);
+    EXPECT_NE(status.find("Cache-Control: no-cache"), std::string::npos);
+    // Um Cache-Control só, sem no-store - senão o navegador nem guarda nem revalida
+    EXPECT_EQ(headerCount(status, "Cache-Control"), 1u);
+    EXPECT_EQ(status.find("no-store"), std::string::npos);
+    EXPECT_EQ(headerCount(status, "Pragma"), 0u);
+    std::string etag = etagOf(status);
+    ASSERT_FALSE(etag.empty());
+    EXPECT_NE(responseBody(status).find("\"mechanisms\""), std::string::npos);
+
+    std::string unchanged = httpExchange(port, {"GET /ipc/status HTTP/1.1\r\nIf-None-Match: " + etag + "\r\n\r\n"});
+    EXPECT_EQ(unchanged.find("HTTP/1.1 304"), 0u);
+    EXPECT_TRUE(responseBody(unchanged).empty());
+
+    std::string detail = httpExchange(port, {"GET /ipc/detail/pipes HTTP/1.1\r\n\r\n"});
+    std::string detail_etag = etagOf(detail);
+    EXPECT_EQ(detail_etag.rfind("W/\"pipes-", 0), 0u);
+
+    ASSERT_TRUE(coordinator->startMechanism(IPCMechanism::PIPES));
+    std::string changed = httpExchange(port, {"GET /ipc/status HTTP/1.1\r\nIf-None-Match: " + etag + "\r\n\r\n"});
+    EXPECT_EQ(changed.find("HTTP/1.1 200"), 0u);
+    EXPECT_NE(etagOf(changed), etag);
+    EXPECT_GT(coordinator->getStatusSnapshot().version, first.version);
+
+    std::string detail_changed = httpExchange(port, {"GET /ipc/detail/pipes HTTP/1.1\r\nIf-None-Match: " + detail_etag + "\r\n\r\n"});
+    EXPECT_EQ(detail_changed.find("HTTP/1.1 200"), 0u);
+    coordinator->stopMechanism(IPCMechanism::PIPES);
+}
+
+// Um GET traz o que antes eram oito (status + detalhe de cada mecanismo)
+TEST_F(HTTPServerTest, SnapshotCombinesStatusAndDetails) {
+    ASSERT_TRUE(coordinator->startMechanism(IPCMechanism::PIPES));
+    ASSERT_TRUE(server->start());
+
+    std::string response = httpExchange(server->getPort(), {"GET /ipc/snapshot HTTP/1.1\r\n\r\n"});
+    EXPECT_EQ(response.find("HTTP/1.1 200"), 0u);
+    EXPECT_NE(response.find("ETag: W/\"snapshot-"), std::string::npos);
+    std::string body = responseBody(response);
+    EXPECT_EQ(body.rfind("{\"status\":{", 0), 0u);
+    EXPECT_NE(body.find("\"details\":{\"pipes\":"), std::string::npos);
+    for (const char* name : {"sockets", "shared_memory", "cross_memory", "message_queue", "eventfd", "tcp_bridge"}) {
+        EXPECT_NE(body.find(std::string("\"") + name + "\":{"), std::string::npos) << name;
+    }
+    EXPECT_EQ(*coordinator->getFullSnapshot().json, body);
+    coordinator->stopMechanism(IPCMechanism::PIPES);
+}
+
+// Lote: array JSON ou NDJSON, resultado por item, item ruim não derruba o resto
+TEST_F(HTTPServerTest, SendBatchAcceptsArrayAndNDJSON) {
+    ASSERT_TRUE(coordinator->startMechanism(IPCMechanism::PIPES));
+    ASSERT_TRUE(server->start());
+
+    auto post = [&](const std::string& body) {
+        return httpExchange(server->getPort(), {
+            "POST /ipc/send/batch HTTP/1.1\r\nConnection: close\r\nContent-Length: " +
+            std::to_string(body.size()) + "\r\n\r\n" + body});
+    };
+
+    std::string array = post(R"([
+        {"mechanism":"pipes","message":"um"},
+        {"mechanism":"pipes","message":"dois \"escapado\"","priority":"critical"},
+        {"mechanism":"nada","message":"x"},
+        42,
+        {"mechanism":"sockets","message":"inativo"}
+    ])");
+    EXPECT_EQ(array.find("HTTP/1.1 200"), 0u) << array;
+    std::string body = responseBody(array);
+    EXPECT_EQ(body.rfind("{\"status\":\"partial\",\"total\":5,\"sent\":2,\"failed\":3,", 0), 0u) << body;
+    EXPECT_NE(body.find("{\"index\":0,\"mechanism\":\"pipes\",\"status\":\"sent\"}"), std::string::npos);
+    EXPECT_NE(body.find("{\"index\":1,\"mechanism\":\"pipes\",\"status\":\"sent\"}"), std::string::npos);
+    EXPECT_NE(body.find("\"index\":2,\"mechanism\":\"nada\",\"status\":\"invalid\",\"error\":\"Invalid mechanism: nada\""),
+              std::string::npos);
+    EXPECT_NE(body.find("{\"index\":3,\"status\":\"invalid\",\"error\":\"Item must be an object\"}"), std::string::npos);
+    EXPECT_NE(body.find("\"index\":4,\"mechanism\":\"sockets\",\"status\":\"failed\""), std::string::npos);
+
+    std::string ndjson = post("{\"mechanism\":\"pipes\",\"message\":\"a\"}\r\n\n"
+                              "{\"mechanism\":\"pipes\",\"message\":\"b\"}\n"
+                              "{quebrado\n"
+                              "{\"mechanism\":\"pipes\",\"message\":\"c\"}");
+    body = responseBody(ndjson);
+    EXPECT_EQ(body.rfind("{\"status\":\"partial\",\"total\":4,\"sent\":3,\"failed\":1,", 0), 0u) << body;
+    EXPECT_NE(body.find("\"index\":2,\"status\":\"invalid\",\"error\":\"Invalid JSON item"), std::string::npos);
+
+    std::string broken = post(R"([{"mechanism":"pipes","message":"a"},)");
+    EXPECT_EQ(broken.find("HTTP/1.1 400"), 0u);
+    EXPECT_NE(broken.find("Invalid JSON body"), std::string::npos);
+    EXPECT_EQ(post("  \n").find("HTTP/1.1 400"), 0u);
+
+    // Os 5 enviados passaram pelo despachante do canal
+    auto logs = coordinator->getLogs(IPCMechanism::PIPES, 20);
+    size_t sent_logs = 0;
+    std::string joined;
+    for (const auto& log : logs) {
+        if (log.find("message_sent") != std::string::npos) sent_logs++;
+        joined += log + "\n";
+    }
+    EXPECT_EQ(sent_logs, 5u);
+    // Fatias do body no offset certo (elemento do array e linha do NDJSON)
+    EXPECT_NE(joined.find("message_sent: um\n"), std::string::npos) << joined;
+    EXPECT_NE(joined.find("message_sent: dois \"escapado\"\n"), std::string::npos);
+    EXPECT_NE(joined.find("message_sent: b\n"), std::string::npos);
+    coordinator->stopMechanism(IPCMechanism::PIPES);
+}
@@ -0,0 +1,197 @@
+/**
+ * @file test_json_parser.cpp
+ * @brief Unit tests for the single-pass SAX JSON parser
+ */
+
+#include <gtest/gtest.h>
+#include "common/json_parser.h"
+#include "ipc/ipc_coordinator.h"
+#include <string>
+#include <vector>
+
+using namespace ipc_project;
+
+namespace {
+
+// Records every event as a compact token so tests can compare the whole stream
+class RecordingHandler : public JSONHandler {
+public:
+    std::vector<std::string> events;
+
+    bool onObjectStart() override { events.push_back("{"); return true; }
+    bool onObjectEnd() override { events.push_back("}"); return true; }
+    bool onArrayStart() override { events.push_back("["); return true; }
+    bool onArrayEnd() override { events.push_back("]"); return true; }
+    bool onKey(std::string_view key, bool) override { events.push_back("k:" + std::string(key)); return true; }
+    bool onString(std::string_view value, bool) override { events.push_back("s:" + std::string(value)); return true; }
+    bool onNumber(std::string_view text) override { events.push_back("n:" + std::string(text)); return true; }
+    bool onBool(bool value) override { events.push_back(value ? "true" : "false"); return true; }
+    bool onNull() override { events.push_back("null"); return true; }
+};
+
+} // namespace
+
+TEST(JSONParserTest, EmitsEventsInDocumentOrder) {
+    JSONParser parser;
+    RecordingHandler handler;
+    ASSERT_TRUE(parser.parse(R"( {"a": [1, -2.5e3, true, false, null], "b" : {"c":"d"}, "e": {}, "f": []} )",
+                             handler)) << parser.errorMessage();
+
+    std::vector<std::string> expected = {
+        "{", "k:a", "[", "n:1", "n:-2.5e3", "true", "false", "null", "]",
+        "k:b", "{", "k:c", "s:d", "}", "k:e", "{", "}", "k:f", "[", "]", "}"
+    };
+    EXPECT_EQ(handler.events, expected);
+}
+
+TEST(JSONParserTest, DecodesEscapesAndKeepsPlainStringsZeroCopy) {
+    std::string input = R"(["plain text", "q\"b\\s\/\n\t", "\u00e9\u20ac\ud83d\ude00"])";
+
+    struct Capture : JSONHandler {
+        std::vector<std::string> values;
+        std::vector<bool> escaped;
+        std::vector<const char*> data;
+        bool onString(std::string_view value, bool was_escaped) override {
+            values.emplace_back(value);
+            escaped.push_back(was_escaped);
+            data.push_back(value.data());
+            return true;
+        }
+    } capture;
+
+    JSONParser parser;
+    ASSERT_TRUE(parser.parse(input, capture)) << parser.errorMessage();
+    ASSERT_EQ(capture.values.size(), 3u);
+
+    EXPECT_EQ(capture.values[0], "plain text");
+    EXPECT_FALSE(capture.escaped[0]);
+    EXPECT_EQ(capture.data[0], input.data() + 2);      // view into the input, no copy
+
+    EXPECT_EQ(capture.values[1], "q\"b\\s/\n\t");
+    EXPECT_TRUE(capture.escaped[1]);
+    EXPECT_EQ(capture.values[2], "\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80");
+}
+
+TEST(JSONParserTest, ScansLongStringsAcrossVectorBoundaries) {
+    // The closing quote and escapes land at every offset modulo 16
+    for (size_t length = 0; length < 80; ++length) {
+        std::string payload(length, 'x');
+        std::string input = "\"" + payload + "\\\"" + payload + "\"";
+        std::string decoded;
+        struct Capture : JSONHandler {
+            std::string* out;
+            bool onString(std::string_view value, bool) override { out->assign(value); return true; }
+        } capture;
+        capture.out = &decoded;
+
+        JSONParser parser;
+        ASSERT_TRUE(parser.parse(input, capture)) << "length " << length;
+        EXPECT_EQ(decoded, payload + "\"" + payload);
+    }
+
+    // A raw control character is rejected even deep inside a long run
+    std::string bad = "\"" + std::string(37, 'y') + "\x01" + "\"";
+    JSONParser parser;
+    JSONHandler ignore;
+    EXPECT_FALSE(parser.parse(bad, ignore));
+    EXPECT_EQ(parser.error(), JSONError::BAD_STRING);
+    EXPECT_EQ(parser.errorOffset(), 38u);
+}
+
+TEST(JSONParserTest, RejectsMalformedInput) {
+    struct Case { const char* json; JSONError error; };
+    const Case cases[] = {
+        {"", JSONError::UNEXPECTED_END},
+        {"{\"a\":1", JSONError::UNEXPECTED_END},
+        {"{\"a\" 1}", JSONError::UNEXPECTED_CHAR},
+        {"{a:1}", JSONError::UNEXPECTED_CHAR},
+        {"[1,]", JSONError::UNEXPECTED_CHAR},
+        {"[1 2]", JSONError::UNEXPECTED_CHAR},
+        {"{\"a\":1]", JSONError::UNEXPECTED_CHAR},
+        {"\"abc", JSONError::UNEXPECTED_END},
+        {"\"\\x\"", JSONError::BAD_ESCAPE},
+        {"\"\\u12G4\"", JSONError::BAD_ESCAPE},
+        {"\"\\ud800\"", JSONError::BAD_ESCAPE},
+        {"\"\\udc00\"", JSONError::BAD_ESCAPE},
+        {"01", JSONError::TRAILING_DATA},
+        {"-", JSONError::UNEXPECTED_END},
+        {"1.", JSONError::BAD_NUMBER},
+        {"1e+", JSONError::BAD_NUMBER},
+        {"tru", JSONError::UNEXPECTED_END},
+        {"nul1", JSONError::UNEXPECTED_CHAR},
+        {"{} {}", JSONError::TRAILING_DATA},
+    };
+    for (const auto& c : cases) {
+        JSONParser parser;
+        JSONHandler ignore;
+        EXPECT_FALSE(parser.parse(c.json, ignore)) << c.json;
+        EXPECT_EQ(parser.error(), c.error) << c.json << " -> " << parser.errorMessage();
+    }
+
+    std::string deep(JSONParser::MAX_DEPTH + 1, '[');
+    deep += std::string(JSONParser::MAX_DEPTH + 1, ']');
+    JSONParser parser;
+    JSONHandler ignore;
+    EXPECT_FALSE(parser.parse(deep, ignore));
+    EXPECT_EQ(parser.error(), JSONError::TOO_DEEP);
+
+    std::string max_depth(JSONParser::MAX_DEPTH, '[');
+    max_depth += std::string(JSONParser::MAX_DEPTH, ']');
+    EXPECT_TRUE(parser.parse(max_depth, ignore)) << parser.errorMessage();
+}
+
+TEST(JSONParserTest, ForEachFieldWalksTopLevelOnly) {
+    std::string json = R"({"k\u0065y":"v\"1", "num": 42, "nested": {"x": [1, {"y": 2}]}, "list": [3,4], "ok": true, "none": null})";
+    std::vector<std::string> keys;
+    std::string nested, list, value;
+    bool ok_flag = false;
+
+    JSONError error = JSONError::NONE;
+    ASSERT_TRUE(forEachField(json, [&](std::string_view key, const JSONField& field) {
+        keys.emplace_back(key);
+        if (key == "key") value.assign(field.text);
+        if (key == "num") { EXPECT_EQ(json.substr(field.offset, field.text.size()), "42"); }
+        if (key == "nested") { EXPECT_EQ(field.type, JSONType::OBJECT); nested.assign(field.text); }
+        if (key == "list") { EXPECT_EQ(field.type, JSONType::ARRAY); list.assign(field.text); }
+        if (key == "ok") ok_flag = field.boolean;
+        if (key == "none") { EXPECT_EQ(field.type, JSONType::NULL_VALUE); }
+        return true;
+    }, &error));
+
+    EXPECT_EQ(keys, (std::vector<std::string>{"key", "num", "nested", "list", "ok", "none"}));
+    EXPECT_EQ(value, "v\"1");
+    EXPECT_EQ(nested, R"({"x": [1, {"y": 2}]})");
+    EXPECT_EQ(list, "[3,4]");
+    EXPECT_TRUE(ok_flag);
+
+    // Top-level type must match, and callbacks can stop the walk
+    EXPECT_FALSE(forEachField("[1]", [](std::string_view, const JSONField&) { return true; }, &error));
+    EXPECT_EQ(error, JSONError::UNEXPECTED_CHAR);
+    EXPECT_FALSE(forEachField(R"({"a":1})", [](std::string_view, const JSONField&) { return false; }, &error));
+    EXPECT_EQ(error, JSONError::ABORTED);
+
+    size_t elements = 0;
+    EXPECT_TRUE(forEachElement(R"([{"a":1}, "s", 2])", [&](const JSONField& element) {
+        elements++;
+        if (elements == 1) { EXPECT_EQ(element.text, R"({"a":1})"); }
+        return true;
+    }));
+    EXPECT_EQ(elements, 3u);
+}
+
+TEST(JSONParserTest, IPCCommandAcceptsAnyLayout) {
+    IPCCommand cmd;
+    ASSERT_TRUE(cmd.fromJSON(R"({ "message" : "line\nwith \"quotes\"",
+                                  "priority": "critical", "action":"send",
+                                  "mechanism":"sockets", "retries": 3 })"));
+    EXPECT_EQ(cmd.action, "send");
+    EXPECT_EQ(cmd.mechanism, IPCMechanism::SOCKETS);
+    EXPECT_EQ(cmd.message, "line\nwith \"quotes\"");
+    EXPECT_EQ(cmd.priority, MessagePriority::CRITICAL);
+    EXPECT_EQ(cmd.parameters["retries"], "3");
+
+    EXPECT_FALSE(cmd.fromJSON(R"({"action":"send","mechanism":"pipes","message":"x")"));
+    EXPECT_FALSE(cmd.fromJSON(R"({"action":"send","mechanism":"pipes","message":42})"));
+    EXPECT_FALSE(cmd.fromJSON(R"({"action":"explode"})"));
+    EXPECT_TRUE(cmd.fromJSON(R"({"action":"status"})"));
+}
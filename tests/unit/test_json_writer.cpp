@@ -0,0 +1,137 @@
+/**
+ * @file test_json_writer.cpp
+ * @brief Unit tests for the JSON writer and vectorized string escaping
+ */
+
+#include <gtest/gtest.h>
+#include "common/json_writer.h"
+#include "common/json_scan.h"
+#include "common/json_parser.h"
+#include "ipc/ipc_coordinator.h"
+#include <string>
+
+using namespace ipc_project;
+
+namespace {
+
+// Decodes a JSON string literal through the parser (round-trip check)
+std::string decodeString(const std::string& literal) {
+    struct Capture : JSONHandler {
+        std::string value;
+        bool onString(std::string_view v, bool) override { value.assign(v); return true; }
+    } capture;
+    JSONParser parser;
+    EXPECT_TRUE(parser.parse(literal, capture)) << parser.errorMessage() << " in " << literal;
+    return capture.value;
+}
+
+bool isValidJSON(const std::string& json) {
+    JSONParser parser;
+    JSONHandler ignore;
+    bool ok = parser.parse(json, ignore);
+    EXPECT_TRUE(ok) << parser.errorMessage() << " in " << json;
+    return ok;
+}
+
+} // namespace
+
+TEST(JSONWriterTest, EscapesQuotesBackslashesAndControls) {
+    EXPECT_EQ(jsonQuote("plain"), "\"plain\"");
+    EXPECT_EQ(jsonQuote("a\"b\\c"), R"("a\"b\\c")");
+    EXPECT_EQ(jsonQuote("l1\nl2\r\t\b\f"), R"("l1\nl2\r\t\b\f")");
+    EXPECT_EQ(jsonQuote(std::string("\x01\x1f", 2)), R"("\u0001\u001f")");
+    EXPECT_EQ(jsonQuote(std::string("nul\0byte", 8)), R"("nul\u0000byte")");
+    EXPECT_EQ(jsonQuote("caf\xC3\xA9"), "\"caf\xC3\xA9\"");   // UTF-8 passes through
+}
+
+TEST(JSONWriterTest, ScanFindsSpecialAtEveryOffset) {
+    // Covers the vector body and the scalar tail for both AVX2 and SSE2 widths
+    for (size_t length = 1; length < 100; ++length) {
+        for (char special : {'"', '\\', '\n', '\x7f'}) {
+            for (size_t at = 0; at < length; ++at) {
+                std::string data(length, 'a');
+                data[at] = special;
+                size_t expected = special == '\x7f' ? length : at;  // DEL is not escaped
+                ASSERT_EQ(findJSONSpecial(data.data(), data.size()), expected)
+                    << "length " << length << " at " << at;
+            }
+        }
+    }
+    // Bytes >= 0x80 must not look like control characters to the signed compares
+    std::string high(64, '\xC3');
+    EXPECT_EQ(findJSONSpecial(high.data(), high.size()), high.size());
+}
+
+TEST(JSONWriterTest, EscapedOutputRoundTripsThroughParser) {
+    std::string payload;
+    for (int i = 0; i < 2000; ++i) {
+        payload.push_back(static_cast<char>(i % 128));
+        if (i % 7 == 0) payload += "\"quoted\" \\path\\ ";
+    }
+    EXPECT_EQ(decodeString(jsonQuote(payload)), payload);
+}
+
+TEST(JSONWriterTest, BuildsNestedDocumentsWithCommas) {
+    std::string out = "prefix:";      // appends, never clears
+    JSONWriter json(out);
+    json.beginObject()
+        .field("name", "pipes")
+        .field("count", 42)
+        .field("negative", -7)
+        .field("big", uint64_t{18446744073709551615ull})
+        .field("ratio", 0.25)
+        .field("time_ms", 1.0 / 3.0, 3)
+        .field("active", true)
+        .nullField("error")
+        .key("list").beginArray().value(1).value("two").beginObject().endObject().endArray()
+        .rawField("raw", "{\"x\":1}")
+        .key("empty").beginArray().endArray()
+        .endObject();
+
+    EXPECT_EQ(out, "prefix:{\"name\":\"pipes\",\"count\":42,\"negative\":-7,"
+                   "\"big\":18446744073709551615,\"ratio\":0.25,\"time_ms\":0.333,"
+                   "\"active\":true,\"error\":null,\"list\":[1,\"two\",{}],"
+                   "\"raw\":{\"x\":1},\"empty\":[]}");
+    EXPECT_TRUE(isValidJSON(out.substr(7)));
+
+    std::string special;
+    JSONWriter(special).beginArray().value(std::numeric_limits<double>::infinity()).value(0.0 / 0.0, 2).endArray();
+    EXPECT_EQ(special, "[null,null]");
+}
+
+TEST(JSONWriterTest, ToJSONEscapesMessageContent) {
+    PipeData data{};
+    data.message = MessageBuffer::copyOf("say \"hi\"\nand leave");
+    data.bytes = data.message.size();
+    data.time_ms = 1.5;
+    data.status = "error: broken \"pipe\"";
+    std::string json = data.toJSON();
+    ASSERT_TRUE(isValidJSON(json));
+    EXPECT_NE(json.find(R"("message":"say \"hi\"\nand leave")"), std::string::npos);
+    EXPECT_NE(json.find(R"("time_ms":1.500)"), std::string::npos);
+    EXPECT_NE(json.find(R"("error_message":"error: broken \"pipe\"")"), std::string::npos);
+
+    MechanismStatus mechanism{};
+    mechanism.name = "pipes";
+    mechanism.last_error = "bad \"thing\"\\";
+    mechanism.lanes.push_back(LaneStats{MessagePriority::CRITICAL, 1, 2, 0, 1.5, 2.5, 3.5});
+    CoordinatorStatus status{};
+    status.mechanisms = {mechanism, mechanism};
+    status.status = "running";
+    json = status.toJSON();
+    ASSERT_TRUE(isValidJSON(json));
+    EXPECT_NE(json.find(R"("last_error":"bad \"thing\"\\")"), std::string::npos);
+    EXPECT_NE(json.find(R"("lanes":[{"priority":"critical","queued":1)"), std::string::npos);
+
+    IPCCommand cmd;
+    cmd.action = "send";
+    cmd.mechanism = IPCMechanism::PIPES;
+    cmd.message = "{\"nested\": true}";
+    IPCCommand parsed;
+    ASSERT_TRUE(isValidJSON(cmd.toJSON()));
+    ASSERT_TRUE(forEachField(cmd.toJSON(), [&](std::string_view key, const JSONField& field) {
+        if (key == "message") parsed.message.assign(field.text);
+        return true;
+    }));
+    EXPECT_EQ(parsed.message, cmd.message);
+}
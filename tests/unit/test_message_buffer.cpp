@@ -0,0 +1,101 @@
+/**
+ * @file test_message_buffer.cpp
+ * @brief Unit tests for MessageBuffer
+ */
+
+#include <gtest/gtest.h>
+#include "common/message_buffer.h"
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using namespace ipc_project;
+
+// Copying the handle shares the bytes instead of duplicating them
+TEST(MessageBufferTest, CopySharesBlock) {
+    MessageBuffer original = MessageBuffer::copyOf("hello world");
+    EXPECT_EQ(original.view(), "hello world");
+    EXPECT_TRUE(original.unique());
+
+    MessageBuffer copy = original;
+    EXPECT_EQ(copy.data(), original.data());
+    EXPECT_EQ(original.useCount(), 2);
+    EXPECT_FALSE(original.unique());
+
+    MessageBuffer slice = original.slice(6, 5);
+    EXPECT_EQ(slice.view(), "world");
+    EXPECT_EQ(slice.data(), original.data() + 6);
+    EXPECT_EQ(original.useCount(), 3);
+}
+
+// Headroom lets framing be written in front of the payload without moving it
+TEST(MessageBufferTest, PrependUsesHeadroom) {
+    MessageBuffer buffer = MessageBuffer::copyOf("payload");
+    const char* payload = buffer.data();
+    ASSERT_GE(buffer.headroom(), 4u);
+
+    char* header = buffer.prepend(4);
+    ASSERT_NE(header, nullptr);
+    std::memcpy(header, "HDR:", 4);
+    EXPECT_EQ(buffer.view(), "HDR:payload");
+    EXPECT_EQ(buffer.data() + 4, payload);
+
+    // Shared blocks can't be modified in place
+    MessageBuffer other = buffer;
+    EXPECT_EQ(buffer.prepend(1), nullptr);
+
+    buffer.consume(4);
+    EXPECT_EQ(buffer.view(), "payload");
+}
+
+// Growing a buffer keeps the contents, released blocks go back to the pool
+TEST(MessageBufferTest, AppendAndPoolReuse) {
+    MessageBuffer buffer = MessageBuffer::allocate(8);
+    std::string expected;
+    for (int i = 0; i < 100; ++i) {
+        buffer.append("0123456789");
+        expected += "0123456789";
+    }
+    EXPECT_EQ(buffer.view(), expected);
+
+    auto before = MessageBuffer::threadPoolStats();
+    { MessageBuffer temp = MessageBuffer::allocate(100); }
+    { MessageBuffer temp = MessageBuffer::allocate(100); }
+    auto after = MessageBuffer::threadPoolStats();
+
+    EXPECT_EQ(after.allocations - before.allocations, 2u);
+    EXPECT_GE(after.pool_hits - before.pool_hits, 1u);
+}
+
+// Blocks released on another thread (producer -> dispatcher) go back to the
+// pool of the thread that allocated them, not to the releasing thread's pool
+TEST(MessageBufferTest, RemoteReleaseReturnsToOwnerPool) {
+    std::vector<MessageBuffer> handed_off;
+    for (int i = 0; i < 8; ++i) {
+        handed_off.push_back(MessageBuffer::copyOf("remote " + std::to_string(i)));
+    }
+
+    MessageBuffer::PoolStats consumer_stats;
+    std::thread consumer([&] {
+        handed_off.clear();
+        consumer_stats = MessageBuffer::threadPoolStats();
+    });
+    consumer.join();
+    EXPECT_EQ(consumer_stats.cached_blocks, 0u);     // nothing stuck on the consumer
+
+    auto before = MessageBuffer::threadPoolStats();
+    std::vector<MessageBuffer> again;
+    for (int i = 0; i < 8; ++i) {
+        again.push_back(MessageBuffer::copyOf("local " + std::to_string(i)));
+    }
+    auto after = MessageBuffer::threadPoolStats();
+    EXPECT_EQ(after.remote_returns - before.remote_returns, 8u);
+    EXPECT_EQ(after.pool_hits - before.pool_hits, 8u);
+
+    // A pool whose thread already exited frees late returns instead of caching them
+    MessageBuffer orphan;
+    std::thread producer([&] { orphan = MessageBuffer::copyOf("outlives its thread"); });
+    producer.join();
+    EXPECT_EQ(orphan.view(), "outlives its thread");
+    orphan = MessageBuffer();
+}
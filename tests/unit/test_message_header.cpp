@@ -0,0 +1,77 @@
+/**
+ * @file test_message_header.cpp
+ * @brief Unit tests for the binary message envelope
+ */
+
+#include <gtest/gtest.h>
+#include "common/message_header.h"
+#include <unistd.h>
+
+using namespace ipc_project;
+
+// Encode/decode round trip keeps every field and validates the payload
+TEST(MessageHeaderTest, EncodeDecodeRoundTrip) {
+    MessageHeader header = makeHeader(MessageType::CONTROL, "ping", 42, MessageFlags::LAST_IN_BATCH);
+    EXPECT_EQ(header.magic, MessageHeader::MAGIC);
+    EXPECT_EQ(header.length, 4u);
+    EXPECT_EQ(header.sender_pid, getpid());
+    EXPECT_GT(header.timestamp_ns, 0u);
+
+    std::string frame = encodeFrame(header, "ping");
+    ASSERT_EQ(frame.size(), sizeof(MessageHeader) + 4);
+
+    MessageHeader decoded;
+    std::string_view payload;
+    std::string error;
+    EXPECT_EQ(decodeFrame(frame, decoded, payload, error), frame.size());
+    EXPECT_EQ(payload, "ping");
+    EXPECT_EQ(decoded.messageType(), MessageType::CONTROL);
+    EXPECT_EQ(decoded.sequence, 42u);
+    EXPECT_EQ(decoded.flags, MessageFlags::LAST_IN_BATCH);
+    EXPECT_EQ(decoded.checksum, header.checksum);
+
+    // Corrupted payload is rejected
+    frame.back() = 'X';
+    EXPECT_EQ(decodeFrame(frame, decoded, payload, error), 0u);
+    EXPECT_EQ(error, "checksum_mismatch");
+
+    // Truncated frame is reported as incomplete
+    EXPECT_EQ(decodeFrame(std::string_view(frame).substr(0, 10), decoded, payload, error), 0u);
+    EXPECT_EQ(error, "incomplete_header");
+}
+
+// CRC32C reference value ("123456789" -> 0xE3069283)
+TEST(MessageHeaderTest, ChecksumIsCrc32c) {
+    EXPECT_EQ(computeChecksum("123456789", 9), 0xE3069283u);
+}
+
+// Frames written to a pipe are read back whole; sequence gaps are detected
+TEST(MessageHeaderTest, ReadFrameAndTrackGaps) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+
+    for (uint64_t seq : {1u, 2u, 5u}) {
+        std::string payload = "msg" + std::to_string(seq);
+        MessageHeader header = makeHeader(MessageType::DATA, payload, seq);
+        ASSERT_EQ(writeFrame(fds[1], header, payload.data(), payload.size()),
+                  static_cast<ssize_t>(sizeof(MessageHeader) + payload.size()));
+    }
+    close(fds[1]);
+
+    FrameTracker tracker;
+    MessageHeader header;
+    std::string payload;
+    std::string error;
+    while (readFrame(fds[0], header, payload, 8191, error)) {
+        EXPECT_TRUE(verifyPayload(header, payload));
+        EXPECT_EQ(payload, "msg" + std::to_string(header.sequence));
+        tracker.observe(header, monotonicNowNs());
+    }
+    close(fds[0]);
+
+    EXPECT_EQ(error, "eof");
+    EXPECT_EQ(tracker.frames, 3u);
+    EXPECT_EQ(tracker.gaps, 1u);
+    EXPECT_EQ(tracker.lost, 2u);
+    EXPECT_EQ(tracker.last_sequence, 5u);
+}
@@ -0,0 +1,157 @@
+/**
+ * @file test_message_queue.cpp
+ * @brief Unit tests for the POSIX message queue mechanism
+ */
+
+#include <gtest/gtest.h>
+#include "ipc/message_queue_manager.h"
+#include "ipc/ipc_coordinator.h"
+#include <signal.h>
+#include <sstream>
+#include <vector>
+
+using namespace ipc_project;
+
+namespace {
+
+// Messages the child printed as received, in order
+std::vector<std::string> receivedMessages(const std::string& output) {
+    std::vector<std::string> received;
+    std::istringstream lines(output);
+    std::string line;
+    while (std::getline(lines, line)) {
+        if (line.rfind("MQUEUE_JSON:", 0) != 0 || line.find("\"operation\":\"read\"") == std::string::npos) {
+            continue;
+        }
+        size_t start = line.find("\"message\":\"") + 11;
+        received.push_back(line.substr(start, line.find('"', start) - start));
+    }
+    return received;
+}
+
+} // namespace
+
+TEST(MessageQueueTest, SendAndClose) {
+    MessageQueueManager manager;
+    ASSERT_TRUE(manager.createQueue());
+    EXPECT_TRUE(manager.isParent());
+    EXPECT_GT(manager.getChildPid(), 0);
+
+    EXPECT_TRUE(manager.sendMessage("hello queue"));
+    EXPECT_TRUE(manager.sendMessage("second", MessageQueueManager::PRIORITY_CRITICAL));
+
+    // Sequences are counted per priority - the first critical frame is 1
+    auto op = manager.getLastOperation();
+    EXPECT_EQ(op.status, "sent");
+    EXPECT_EQ(op.sequence, 1u);
+    EXPECT_EQ(op.priority, MessageQueueManager::PRIORITY_CRITICAL);
+    EXPECT_EQ(op.bytes, sizeof(MessageHeader) + 6);
+
+    manager.closeQueue();
+    EXPECT_FALSE(manager.isActive());
+}
+
+// With the child stopped the kernel holds the backlog; on resume it must be
+// drained highest priority first, FIFO within the same priority
+TEST(MessageQueueTest, KernelPriorityOrdering) {
+    testing::internal::CaptureStdout();
+    {
+        MessageQueueManager manager;
+        ASSERT_TRUE(manager.createQueue());
+        ASSERT_EQ(kill(manager.getChildPid(), SIGSTOP), 0);
+
+        EXPECT_TRUE(manager.sendMessage("bulk-1", MessageQueueManager::PRIORITY_BULK));
+        EXPECT_TRUE(manager.sendMessage("normal-1", MessageQueueManager::PRIORITY_NORMAL));
+        EXPECT_TRUE(manager.sendMessage("critical", MessageQueueManager::PRIORITY_CRITICAL));
+        EXPECT_TRUE(manager.sendMessage("normal-2", MessageQueueManager::PRIORITY_NORMAL));
+        EXPECT_EQ(manager.getQueueDepth(), 4);
+
+        kill(manager.getChildPid(), SIGCONT);
+        manager.closeQueue();   // close control has the lowest priority - data drains first
+    }
+    auto received = receivedMessages(testing::internal::GetCapturedStdout());
+
+    std::vector<std::string> expected = {"critical", "normal-1", "normal-2", "bulk-1"};
+    EXPECT_EQ(received, expected);
+}
+
+// The kernel reorders across priorities by design, so a mixed backlog must
+// not be reported as lost frames by the child
+TEST(MessageQueueTest, MixedPriorityBurstReportsNoGaps) {
+    testing::internal::CaptureStderr();
+    testing::internal::CaptureStdout();
+    {
+        MessageQueueManager manager;
+        ASSERT_TRUE(manager.createQueue());
+        ASSERT_EQ(kill(manager.getChildPid(), SIGSTOP), 0);
+
+        for (int i = 0; i < 3; ++i) {
+            EXPECT_TRUE(manager.sendMessage("bulk", MessageQueueManager::PRIORITY_BULK));
+            EXPECT_TRUE(manager.sendMessage("normal", MessageQueueManager::PRIORITY_NORMAL));
+            EXPECT_TRUE(manager.sendMessage("critical", MessageQueueManager::PRIORITY_CRITICAL));
+        }
+        EXPECT_FALSE(manager.sendMessage("too-high", MessageQueueManager::PRIORITY_CRITICAL + 1));
+        EXPECT_EQ(manager.getLastOperation().status, "error_invalid_priority");
+
+        kill(manager.getChildPid(), SIGCONT);
+        manager.closeQueue();
+    }
+    auto received = receivedMessages(testing::internal::GetCapturedStdout());
+    std::string errors = testing::internal::GetCapturedStderr();
+
+    EXPECT_EQ(received.size(), 9u);
+    EXPECT_EQ(errors.find("Buraco"), std::string::npos) << errors;
+}
+
+TEST(MessageQueueTest, FullQueueTimesOut) {
+    MessageQueueConfig config;
+    config.max_messages = 2;
+    config.send_timeout_ms = 50;
+    MessageQueueManager manager(config);
+    ASSERT_TRUE(manager.createQueue());
+    ASSERT_EQ(kill(manager.getChildPid(), SIGSTOP), 0);
+
+    EXPECT_TRUE(manager.sendMessage("a"));
+    EXPECT_TRUE(manager.sendMessage("b"));
+    EXPECT_FALSE(manager.sendMessage("c"));
+    EXPECT_EQ(manager.getLastOperation().status, "error_queue_full");
+
+    kill(manager.getChildPid(), SIGCONT);
+    EXPECT_TRUE(manager.sendMessage("c"));
+}
+
+TEST(MessageQueueTest, RejectsOversizedAndInvalidConfig) {
+    MessageQueueConfig config;
+    config.message_size = 256;
+    EXPECT_EQ(config.maxPayload(), 256u - sizeof(MessageHeader));
+
+    MessageQueueManager manager(config);
+    ASSERT_TRUE(manager.createQueue());
+    EXPECT_FALSE(manager.sendMessage(std::string(config.maxPayload() + 1, 'x')));
+    EXPECT_EQ(manager.getLastOperation().status, "error_message_too_large");
+    EXPECT_TRUE(manager.sendMessage(std::string(config.maxPayload(), 'x')));
+
+    MessageQueueConfig invalid;
+    invalid.message_size = 32;      // smaller than the envelope
+    MessageQueueManager broken(invalid);
+    EXPECT_FALSE(broken.createQueue());
+    EXPECT_EQ(broken.getLastOperation().status, "error_invalid_config");
+}
+
+TEST(MessageQueueTest, CoordinatorMapsLanePriority) {
+    EXPECT_GT(toQueuePriority(MessagePriority::CRITICAL), toQueuePriority(MessagePriority::NORMAL));
+    EXPECT_GT(toQueuePriority(MessagePriority::NORMAL), toQueuePriority(MessagePriority::BULK));
+    EXPECT_GT(toQueuePriority(MessagePriority::BULK), MessageQueueManager::PRIORITY_CONTROL);
+
+    IPCCoordinator coordinator;
+    ASSERT_TRUE(coordinator.initialize());
+    ASSERT_TRUE(coordinator.startMechanism(IPCMechanism::MESSAGE_QUEUE));
+    EXPECT_TRUE(coordinator.sendMessage(IPCMechanism::MESSAGE_QUEUE, "via lane", MessagePriority::CRITICAL));
+
+    std::string detail = coordinator.getMechanismDetailJSON(IPCMechanism::MESSAGE_QUEUE);
+    EXPECT_NE(detail.find("\"type\":\"message_queue\""), std::string::npos);
+    EXPECT_NE(detail.find("\"priority\":31"), std::string::npos);
+    EXPECT_NE(detail.find("\"queue\":{\"max_messages\":10"), std::string::npos);
+    EXPECT_TRUE(coordinator.stopMechanism(IPCMechanism::MESSAGE_QUEUE));
+    coordinator.shutdown();
+}
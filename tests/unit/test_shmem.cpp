@@ -5,6 +5,8 @@
 
 #include <gtest/gtest.h>
 #include "ipc/shmem_manager.h"
+#include <thread>
+#include <chrono>
 
 using namespace ipc_project;
 
@@ -131,4 +133,31 @@ TEST_F(SharedMemoryManagerTest, ProcessManagement) {
     
     // We don't test fork here as it can complicate unit tests
     // This would be better tested in integration tests
-}
\ No newline at end of file
+}
+// Busy-poll consumer test - latency must be measured by the consumer process
+TEST_F(SharedMemoryManagerTest, BusyPollConsumerMeasuresLatency) {
+    ASSERT_TRUE(manager->createSharedMemory());
+    
+    BusyPollConfig config;
+    config.idle_budget_us = 200;  // short budget so both spin and futex paths are exercised
+    ASSERT_TRUE(manager->startBusyPollConsumer(config));
+    
+    // Give the consumer time to start spinning
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    
+    for (int i = 0; i < 5; ++i) {
+        EXPECT_TRUE(manager->writeMessage("busy poll " + std::to_string(i)));
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    
+    auto stats = manager->getBusyPollStats();
+    EXPECT_TRUE(stats.running);
+    EXPECT_EQ(stats.messages + stats.missed, 5u);
+    EXPECT_GT(stats.messages, 0u);
+    EXPECT_LE(stats.min_latency_ns, stats.max_latency_ns);
+    EXPECT_NE(stats.toJSON().find("avg_latency_ns"), std::string::npos);
+    EXPECT_EQ(stats.toJSON().find("\"running\":true,\"consumer_pid\":" + std::to_string(stats.consumer_pid)), 1u);
+    
+    manager->stopBusyPollConsumer();
+    EXPECT_FALSE(manager->getBusyPollStats().running);
+}
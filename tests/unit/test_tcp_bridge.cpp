@@ -0,0 +1,266 @@
+/**
+ * @file test_tcp_bridge.cpp
+ * @brief Unit tests for the TCP bridge between coordinators (loopback)
+ */
+
+#include <gtest/gtest.h>
+#include "ipc/tcp_bridge.h"
+#include "ipc/ipc_coordinator.h"
+#include "common/json_parser.h"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace ipc_project;
+
+namespace {
+
+bool waitFor(const std::function<bool()>& condition, int seconds = 5) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(seconds);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (condition()) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return condition();
+}
+
+// Records every delivered payload so duplicates show up
+struct Sink {
+    std::mutex mutex;
+    std::multiset<std::string> messages;
+    std::atomic<size_t> count{0};
+
+    TcpBridgeServer::DeliverFn deliver() {
+        return [this](uint8_t, uint8_t, const MessageBuffer& message) {
+            std::lock_guard<std::mutex> lock(mutex);
+            messages.insert(message.str());
+            count++;
+            return true;
+        };
+    }
+};
+
+TcpBridgeConfig loopbackConfig(uint16_t port) {
+    TcpBridgeConfig config;
+    config.peer_host = "127.0.0.1";
+    config.peer_port = port;
+    config.reconnect_initial_ms = 10;
+    config.reconnect_max_ms = 50;
+    return config;
+}
+
+} // namespace
+
+TEST(TcpBridgeTest, ParseHostPort) {
+    std::string host;
+    uint16_t port = 0;
+    EXPECT_TRUE(parseHostPort("10.0.0.2:7000", host, port));
+    EXPECT_EQ(host, "10.0.0.2");
+    EXPECT_EQ(port, 7000);
+    EXPECT_TRUE(parseHostPort("7001", host, port));
+    EXPECT_EQ(host, "");
+    EXPECT_EQ(port, 7001);
+    EXPECT_FALSE(parseHostPort("host:99999", host, port));
+    EXPECT_FALSE(parseHostPort("host:", host, port));
+}
+
+// Host names and socket errors are free text - the JSON stays valid
+TEST(TcpBridgeTest, StatsJSONEscapesText) {
+    BridgeLinkStats stats;
+    stats.peer = "host\"name:1";
+    stats.last_error = "handshake: bad \\ \"frame\"\n";
+    std::string error;
+    EXPECT_TRUE(forEachField(stats.toJSON(), [&](std::string_view key, const JSONField& field) {
+        if (key == "last_error") error = std::string(field.text);
+        return true;
+    }));
+    EXPECT_EQ(error, stats.last_error);
+
+    TcpBridgeConfig config;
+    config.peer_host = "a\"b";
+    EXPECT_TRUE(forEachField(config.toJSON(), [](std::string_view, const JSONField&) { return true; }));
+}
+
+// Messages sent while the peer is down queue up and go out in full batches on connect
+TEST(TcpBridgeTest, QueuesWhileDisconnectedAndBatchesOnConnect) {
+    Sink sink;
+    TcpBridgeServer server(sink.deliver());
+    ASSERT_TRUE(server.start("127.0.0.1", 0));
+    uint16_t port = server.getPort();
+    server.stop();
+
+    TcpBridgeLink link(loopbackConfig(port));
+    ASSERT_TRUE(link.start());
+    for (int i = 0; i < 200; ++i) {
+        ASSERT_TRUE(link.send(0, 1, MessageBuffer::copyOf("msg " + std::to_string(i))));
+    }
+    EXPECT_FALSE(link.isConnected());
+
+    ASSERT_TRUE(server.start("127.0.0.1", port));
+    ASSERT_TRUE(link.flush(5000));
+
+    auto stats = link.getStats();
+    EXPECT_EQ(stats.messages_acked, 200u);
+    EXPECT_EQ(stats.messages_sent, 200u);
+    EXPECT_EQ(stats.batches, 4u);              // ceil(200 / 64)
+    EXPECT_GT(stats.avg_batch, 1.0);
+    EXPECT_EQ(stats.in_flight, 0u);
+    EXPECT_GT(stats.max_ack_latency_us, 0.0);
+    EXPECT_EQ(sink.count, 200u);
+    EXPECT_EQ(server.getStats().messages_delivered, 200u);
+
+    link.stop();
+    server.stop();
+}
+
+// The server goes away mid-stream: the link reconnects, resends what was not
+// acknowledged and the server drops what it had already delivered
+TEST(TcpBridgeTest, ReconnectsWithoutLosingOrDuplicating) {
+    Sink sink;
+    TcpBridgeServer server(sink.deliver());
+    ASSERT_TRUE(server.start("127.0.0.1", 0));
+    uint16_t port = server.getPort();
+
+    TcpBridgeLink link(loopbackConfig(port));
+    ASSERT_TRUE(link.start());
+    ASSERT_TRUE(waitFor([&] { return link.isConnected(); }));
+
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(link.send(0, 1, MessageBuffer::copyOf("first " + std::to_string(i))));
+    }
+    server.stop();
+    ASSERT_TRUE(waitFor([&] { return !link.isConnected(); }));
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(link.send(0, 1, MessageBuffer::copyOf("second " + std::to_string(i))));
+    }
+
+    ASSERT_TRUE(server.start("127.0.0.1", port));
+    ASSERT_TRUE(link.flush(5000));
+
+    EXPECT_GE(link.getStats().reconnects, 1u);
+    EXPECT_EQ(link.getStats().messages_acked, 200u);
+    EXPECT_EQ(sink.count, 200u);
+    std::set<std::string> unique(sink.messages.begin(), sink.messages.end());
+    EXPECT_EQ(unique.size(), 200u);
+
+    link.stop();
+    server.stop();
+}
+
+// Refusals on the remote side are acknowledged (not resent) and counted
+TEST(TcpBridgeTest, RemoteRefusalsAreCounted) {
+    TcpBridgeServer server([](uint8_t, uint8_t, const MessageBuffer&) { return false; });
+    ASSERT_TRUE(server.start("127.0.0.1", 0));
+
+    TcpBridgeLink link(loopbackConfig(server.getPort()));
+    ASSERT_TRUE(link.start());
+    for (int i = 0; i < 10; ++i) {
+        ASSERT_TRUE(link.send(0, 1, MessageBuffer::copyOf("nope")));
+    }
+    ASSERT_TRUE(link.flush(5000));
+    EXPECT_EQ(link.getStats().messages_failed, 10u);
+    EXPECT_EQ(server.getStats().messages_failed, 10u);
+    link.stop();
+}
+
+// A peer that completes the TCP handshake but never answers the hello: the
+// link gives up after connect_timeout_ms and stop() does not wait for it
+TEST(TcpBridgeTest, SilentPeerTimesOutAndStopWakesConnect) {
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_NE(listener, -1);
+    struct sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    ASSERT_EQ(bind(listener, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)), 0);
+    ASSERT_EQ(listen(listener, 16), 0);     // never accepts - the kernel backlog answers the SYN
+    socklen_t length = sizeof(address);
+    getsockname(listener, reinterpret_cast<struct sockaddr*>(&address), &length);
+
+    TcpBridgeConfig config = loopbackConfig(ntohs(address.sin_port));
+    config.connect_timeout_ms = 100;
+    TcpBridgeLink link(config);
+    ASSERT_TRUE(link.start());
+    ASSERT_TRUE(waitFor([&] { return link.getStats().last_error.rfind("handshake", 0) == 0; }));
+    EXPECT_FALSE(link.isConnected());
+
+    // With a long timeout the link is stuck in the hello when stop() arrives
+    config.connect_timeout_ms = 60000;
+    TcpBridgeLink slow(config);
+    ASSERT_TRUE(slow.start());
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    auto before = std::chrono::steady_clock::now();
+    slow.stop();
+    EXPECT_LT(std::chrono::steady_clock::now() - before, std::chrono::seconds(2));
+
+    link.stop();
+    close(listener);
+}
+
+// Every reconnect opens a new server-side handler; finished ones are reaped
+TEST(TcpBridgeTest, ServerReapsClosedConnections) {
+    Sink sink;
+    TcpBridgeServer server(sink.deliver());
+    ASSERT_TRUE(server.start("127.0.0.1", 0));
+
+    for (int i = 0; i < 5; ++i) {
+        TcpBridgeLink link(loopbackConfig(server.getPort()));
+        ASSERT_TRUE(link.start());
+        ASSERT_TRUE(link.send(0, 1, MessageBuffer::copyOf("round " + std::to_string(i))));
+        ASSERT_TRUE(link.flush(5000));
+        link.stop();
+    }
+
+    ASSERT_TRUE(waitFor([&] { return server.getStats().active_connections == 0; }));
+    EXPECT_EQ(server.getStats().connections, 5u);
+    EXPECT_EQ(sink.count, 5u);
+    server.stop();
+}
+
+TEST(TcpBridgeTest, StartRequiresPeer) {
+    IPCCoordinator coordinator;
+    ASSERT_TRUE(coordinator.initialize());
+    EXPECT_FALSE(coordinator.startMechanism(IPCMechanism::TCP_BRIDGE));
+    coordinator.shutdown();
+}
+
+// Two coordinators on loopback: A forwards over tcp_bridge into B's eventfd
+TEST(TcpBridgeTest, CoordinatorForwardsToRemoteMechanism) {
+    IPCCoordinator remote;
+    ASSERT_TRUE(remote.initialize());
+    ASSERT_TRUE(remote.startMechanism(IPCMechanism::EVENTFD));
+    ASSERT_TRUE(remote.startBridgeListener("127.0.0.1", 0));
+    ASSERT_NE(remote.getBridgeListenerPort(), 0);
+
+    IPCCoordinator local;
+    TcpBridgeConfig config = loopbackConfig(remote.getBridgeListenerPort());
+    config.target_mechanism = static_cast<uint8_t>(IPCMechanism::EVENTFD);
+    local.setTcpBridgeConfig(config);
+    ASSERT_TRUE(local.initialize());
+    ASSERT_TRUE(local.startMechanism(IPCMechanism::TCP_BRIDGE));
+
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(local.sendMessage(IPCMechanism::TCP_BRIDGE, "remote " + std::to_string(i)));
+    }
+
+    ASSERT_TRUE(waitFor([&] {
+        return local.getMechanismDetailJSON(IPCMechanism::TCP_BRIDGE).find("\"messages_acked\":100,") != std::string::npos;
+    }));
+    std::string detail = local.getMechanismDetailJSON(IPCMechanism::TCP_BRIDGE);
+    EXPECT_NE(detail.find("\"type\":\"tcp_bridge\""), std::string::npos);
+    EXPECT_NE(detail.find("\"connected\":true"), std::string::npos);
+
+    std::string listener = remote.getMechanismDetailJSON(IPCMechanism::TCP_BRIDGE);
+    EXPECT_NE(listener.find("\"messages_delivered\":100,"), std::string::npos);
+    EXPECT_NE(remote.getMechanismDetailJSON(IPCMechanism::EVENTFD).find("\"signals_sent\":100,"), std::string::npos);
+
+    EXPECT_TRUE(local.stopMechanism(IPCMechanism::TCP_BRIDGE));
+    local.shutdown();
+    remote.shutdown();
+    EXPECT_EQ(remote.getBridgeListenerPort(), 0);
+}
@@ -0,0 +1,131 @@
+/**
+ * @file test_typed_channel.cpp
+ * @brief Unit tests for compile-time typed channels
+ */
+
+#include <gtest/gtest.h>
+#include "ipc/typed_channel.h"
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace ipc_project;
+
+namespace {
+
+struct Tick {
+    uint64_t id;
+    double price;
+    int32_t quantity;
+    char symbol[8];
+};
+
+// Both ends of a channel pin the layout - changing Tick breaks the build
+IPC_CHANNEL_LAYOUT(Tick, 32, 8);
+IPC_CHANNEL_FIELD(Tick, price, 8);
+
+struct TickV2 {
+    static constexpr uint32_t schema_version = 2;
+    uint64_t id;
+    double price;
+    int32_t quantity;
+    char symbol[8];
+};
+
+struct NotCopyable {
+    std::string text;
+};
+
+static_assert(ChannelPayload<Tick>);
+static_assert(!ChannelPayload<NotCopyable>);
+static_assert(ChannelTraits<Tick>::frame_size == sizeof(MessageHeader) + 32);
+static_assert(ChannelTraits<Tick>::slot_size % 64 == 0);
+static_assert(ChannelTraits<Tick>::schema_id != ChannelTraits<TickV2>::schema_id);
+
+Tick makeTick(uint64_t id) {
+    Tick tick{};
+    tick.id = id;
+    tick.price = 10.5 * static_cast<double>(id);
+    tick.quantity = static_cast<int32_t>(id * 3);
+    std::memcpy(tick.symbol, "PETR4", 6);
+    return tick;
+}
+
+template <typename ChannelType>
+void roundTrip() {
+    ChannelType channel;
+    ASSERT_TRUE(channel.open());
+
+    for (uint64_t i = 1; i <= 10; ++i) {
+        ASSERT_TRUE(channel.send(makeTick(i)));
+    }
+    for (uint64_t i = 1; i <= 10; ++i) {
+        auto tick = channel.receive();
+        ASSERT_TRUE(tick.has_value()) << channel.lastError();
+        EXPECT_EQ(tick->id, i);
+        EXPECT_DOUBLE_EQ(tick->price, 10.5 * static_cast<double>(i));
+        EXPECT_STREQ(tick->symbol, "PETR4");
+    }
+    EXPECT_EQ(channel.stats().frames, 10u);
+    EXPECT_EQ(channel.stats().gaps, 0u);
+}
+
+} // namespace
+
+TEST(TypedChannelTest, PipeRoundTrip) {
+    roundTrip<PipeChannel<Tick>>();
+}
+
+TEST(TypedChannelTest, SocketRoundTrip) {
+    roundTrip<SocketChannel<Tick>>();
+}
+
+TEST(TypedChannelTest, ShmRoundTrip) {
+    roundTrip<ShmChannel<Tick>>();
+}
+
+// Producer and consumer in different processes over the shared memory ring
+TEST(TypedChannelTest, ShmAcrossFork) {
+    ShmChannel<Tick> channel;
+    ASSERT_TRUE(channel.open());
+
+    pid_t child = fork();
+    ASSERT_NE(child, -1);
+    if (child == 0) {
+        channel.asConsumer();
+        uint64_t expected = 1;
+        Tick tick;
+        while (channel.receive(tick)) {
+            if (tick.id != expected++) _exit(1);
+        }
+        _exit(expected == 1001 && channel.lastError() == "eof" ? 0 : 2);
+    }
+
+    channel.asProducer();
+    for (uint64_t i = 1; i <= 1000; ++i) {
+        while (!channel.send(makeTick(i))) {
+            usleep(10);     // ring full - wait for the consumer
+        }
+    }
+    channel.shutdown();
+
+    int status = 0;
+    waitpid(child, &status, 0);
+    ASSERT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
+
+// A consumer built against another layout rejects the frames
+TEST(TypedChannelTest, SchemaMismatchRejected) {
+    PipeChannel<TickV2> consumer;
+    ASSERT_TRUE(consumer.open());
+
+    // Frame as a producer built with the old Tick would write it
+    Tick tick = makeTick(1);
+    MessageHeader header = makeHeader(MessageType::DATA,
+        std::string_view(reinterpret_cast<const char*>(&tick), sizeof(tick)), 1);
+    header.schema_id = ChannelTraits<Tick>::schema_id;
+    ASSERT_TRUE(consumer.transport().sendFrame(header, &tick, sizeof(tick)));
+
+    EXPECT_FALSE(consumer.receive().has_value());
+    EXPECT_EQ(consumer.lastError(), "schema_mismatch");
+}
@@ -0,0 +1,155 @@
+/**
+ * @file test_work_stealing_executor.cpp
+ * @brief Unit tests for the work-stealing executor
+ */
+
+#include <gtest/gtest.h>
+#include "common/work_stealing_executor.h"
+#include "ipc/ipc_coordinator.h"
+#include "ipc/ipc_benchmark.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace ipc_project;
+
+TEST(WorkStealingExecutorTest, RunsEveryTaskOnFixedThreads) {
+    WorkStealingExecutor executor(3);
+    EXPECT_EQ(executor.threadCount(), 3u);
+    EXPECT_FALSE(executor.inWorkerThread());
+
+    std::atomic<int> sum{0};
+    std::vector<std::future<int>> results;
+    for (int i = 1; i <= 1000; ++i) {
+        results.push_back(executor.async([i, &sum] { sum += i; return i; }));
+    }
+    int total = 0;
+    for (auto& result : results) total += result.get();
+
+    EXPECT_EQ(total, 500500);
+    EXPECT_EQ(sum, 500500);
+    executor.shutdown();    // counters settle once the workers are joined
+    auto stats = executor.getStats();
+    EXPECT_EQ(stats.submitted, 1000u);
+    EXPECT_EQ(stats.executed, 1000u);
+    EXPECT_EQ(stats.workers.size(), 3u);
+}
+
+// Tasks spawned inside one worker land on its own deque; idle workers steal them
+TEST(WorkStealingExecutorTest, IdleWorkersStealFromBusyDeque) {
+    WorkStealingExecutor executor(4);
+    std::atomic<int> done{0};
+
+    auto parent = executor.async([&] {
+        EXPECT_TRUE(executor.inWorkerThread());
+        for (int i = 0; i < 64; ++i) {
+            executor.submit([&done] {
+                std::this_thread::sleep_for(std::chrono::milliseconds(2));
+                done++;
+            });
+        }
+    });
+    parent.get();
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (done < 64 && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(done, 64);
+
+    auto stats = executor.getStats();
+    EXPECT_GT(stats.steals, 0u);
+    size_t workers_used = 0;
+    for (const auto& worker : stats.workers) {
+        if (worker.executed > 0) workers_used++;
+        EXPECT_GE(worker.utilization, 0.0);
+        EXPECT_LE(worker.utilization, 1.0);
+    }
+    EXPECT_GT(workers_used, 1u);
+    EXPECT_NE(stats.toJSON().find("\"steals\":"), std::string::npos);
+}
+
+// Shutdown drains accepted work and rejects anything after it
+TEST(WorkStealingExecutorTest, ShutdownDrainsThenRejects) {
+    WorkStealingExecutor executor(2);
+    std::atomic<int> done{0};
+    for (int i = 0; i < 100; ++i) {
+        executor.submit([&done] { done++; });
+    }
+    executor.shutdown();
+    EXPECT_EQ(done, 100);
+    EXPECT_FALSE(executor.isRunning());
+
+    EXPECT_FALSE(executor.submit([] {}));
+    EXPECT_FALSE(executor.async([] { return 1; }).valid());
+    EXPECT_EQ(executor.getStats().rejected, 2u);
+}
+
+// A submit racing shutdown is either rejected or run - never accepted and dropped
+TEST(WorkStealingExecutorTest, ConcurrentSubmitAndShutdownLosesNothing) {
+    for (int round = 0; round < 100; ++round) {
+        WorkStealingExecutor executor(2);
+        std::atomic<int> accepted{0};
+        std::atomic<int> done{0};
+        std::atomic<int> started{0};
+
+        // Submitters keep going until they are refused, so shutdown always lands mid-stream
+        std::vector<std::thread> submitters;
+        for (int t = 0; t < 4; ++t) {
+            submitters.emplace_back([&] {
+                started++;
+                while (executor.submit([&done] { done++; })) accepted++;
+            });
+        }
+        while (started < 4) std::this_thread::yield();
+        executor.shutdown();
+        for (auto& submitter : submitters) submitter.join();
+
+        auto stats = executor.getStats();
+        ASSERT_EQ(done, accepted) << "round " << round;
+        EXPECT_EQ(stats.executed, static_cast<uint64_t>(accepted));
+        EXPECT_EQ(stats.rejected, 4u);
+    }
+}
+
+TEST(WorkStealingExecutorTest, ExceptionDoesNotKillWorker) {
+    WorkStealingExecutor executor(1);
+    executor.submit([] { throw std::runtime_error("boom"); });
+    EXPECT_EQ(executor.async([] { return 7; }).get(), 7);
+
+    // Through async the exception reaches the caller instead
+    auto failing = executor.async([]() -> int { throw std::runtime_error("boom"); });
+    EXPECT_THROW(failing.get(), std::runtime_error);
+}
+
+TEST(WorkStealingExecutorTest, CoordinatorAsyncOperations) {
+    IPCCoordinator coordinator;
+    ASSERT_TRUE(coordinator.initialize());
+    ASSERT_TRUE(coordinator.startMechanism(IPCMechanism::PIPES));
+
+    std::vector<std::future<bool>> sends;
+    for (int i = 0; i < 20; ++i) {
+        sends.push_back(coordinator.sendMessageAsync(IPCMechanism::PIPES,
+                                                     MessageBuffer::copyOf("async " + std::to_string(i))));
+    }
+    for (auto& sent : sends) EXPECT_TRUE(sent.get());
+
+    EXPECT_TRUE(coordinator.restartMechanismAsync(IPCMechanism::PIPES).get());
+    EXPECT_TRUE(coordinator.getMechanismStatus(IPCMechanism::PIPES).is_active);
+
+    BenchmarkConfig config;
+    config.mechanisms = {IPCMechanism::PIPES};
+    config.messages = 10;
+    config.warmup = 0;
+    auto results = runBenchmarkAsync(coordinator, config).get();
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].messages, 10u);
+
+    // executed is bumped after the task returns (after the future is ready):
+    // joining the workers settles it
+    auto executor = coordinator.getExecutor();
+    coordinator.shutdown();
+    executor->shutdown();
+    EXPECT_GE(executor->getStats().executed, 22u);
+}